@@ -60,13 +60,12 @@ RC_t RamLogger<maxNumberOfMessages, maxMessageLength, maxTimestampStrLength>::lo
 
 template <uint32_t maxNumberOfMessages, uint32_t maxMessageLength, uint32_t maxTimestampStrLength>
 RC_t RamLogger<maxNumberOfMessages, maxMessageLength, maxTimestampStrLength>::logf(const char* format, va_list args) {
-    char* buf = new char[msgLen];
+    char buf[maxMessageLength];
     // n contains the number of bits written if buffer is sufficiently large
     // not counting the null-terminator
     // on an encoding error, it receives a negative value
     int n = vsnprintf(buf, msgLen, format, args);
     RamLogger<maxNumberOfMessages, maxMessageLength, maxTimestampStrLength>::log(buf);
-    delete[] buf;
     if(n < msgLen - 1 && n >= 0) {
         return RC_SUCCESS;
     }
@@ -0,0 +1,116 @@
+#include "AdcAcquisition.h"
+
+AdcAcquisition::Channel::Channel(AdcAcquisition& acquisition, uint32_t channel, uint32_t oversampling)
+    : m_acquisition(acquisition), m_channel(channel), m_decimator(oversampling) {}
+
+AdcAcquisition::Channel::~Channel() { m_acquisition.closeChannel(this); }
+
+void AdcAcquisition::Channel::push(uint16_t sample) {
+    float_t value;
+    if(!m_decimator.push(sample, value)) return;
+    if(m_count < ADC_CHANNEL_BUFFER_SIZE) {
+        m_buffer[(m_start + m_count) % ADC_CHANNEL_BUFFER_SIZE] = value;
+        m_count++;
+    } else {
+        // Overwrite the oldest value
+        m_buffer[m_start] = value;
+        m_start = (m_start + 1) % ADC_CHANNEL_BUFFER_SIZE;
+        m_overflows++;
+    }
+}
+
+uint32_t AdcAcquisition::Channel::read(float_t values[], uint32_t maxCount) {
+    std::lock_guard<std::mutex> lock(m_acquisition.m_bufferMutex);
+    // Skip the oldest values if they do not fit
+    if(m_count > maxCount) {
+        m_start = (m_start + m_count - maxCount) % ADC_CHANNEL_BUFFER_SIZE;
+        m_count = maxCount;
+    }
+    const uint32_t count = m_count;
+    for(uint32_t i = 0; i < count; i++) values[i] = m_buffer[(m_start + i) % ADC_CHANNEL_BUFFER_SIZE];
+    m_start = 0;
+    m_count = 0;
+    return count;
+}
+
+uint32_t AdcAcquisition::Channel::getOverflowCount() const {
+    std::lock_guard<std::mutex> lock(m_acquisition.m_bufferMutex);
+    return m_overflows;
+}
+
+AdcAcquisition::AdcAcquisition(SampleSource& source, uint32_t sampleRateHz)
+    : m_source(source), m_sampleRateHz(sampleRateHz) {}
+
+std::shared_ptr<AdcAcquisition::Channel> AdcAcquisition::openChannel(uint32_t pin, uint32_t oversampling) {
+    uint32_t channel;
+    if(RC_SUCCESS != m_source.channelFromPin(pin, channel) || channel >= ADC_MAX_CHANNELS) return nullptr;
+
+    // Created before locking, so that on failure it is destroyed after the mutexes are released
+    std::shared_ptr<Channel> ch(new Channel(*this, channel, oversampling));
+    std::lock_guard<std::mutex> sourceLock(m_sourceMutex);
+    {
+        std::lock_guard<std::mutex> bufferLock(m_bufferMutex);
+        if(m_channels[channel] != nullptr) return nullptr;
+        m_channels[channel] = ch.get();
+        m_openChannels |= 1u << channel;
+    }
+    if(RC_SUCCESS != restartSource()) {
+        {
+            std::lock_guard<std::mutex> bufferLock(m_bufferMutex);
+            m_channels[channel] = nullptr;
+            m_openChannels &= ~(1u << channel);
+        }
+        // Keep the other channels running
+        restartSource();
+        return nullptr;
+    }
+    return ch;
+}
+
+void AdcAcquisition::closeChannel(const Channel* ch) {
+    std::lock_guard<std::mutex> sourceLock(m_sourceMutex);
+    {
+        std::lock_guard<std::mutex> bufferLock(m_bufferMutex);
+        // Channels which failed to open were never registered
+        if(m_channels[ch->m_channel] != ch) return;
+        m_channels[ch->m_channel] = nullptr;
+        m_openChannels &= ~(1u << ch->m_channel);
+    }
+    restartSource();
+}
+
+RC_t AdcAcquisition::restartSource() {
+    if(m_openChannels == 0) {
+        m_source.stop();
+        return RC_SUCCESS;
+    }
+    // Partial blocks belong to the previous conversion pattern
+    for(Channel* ch : m_channels) {
+        if(ch != nullptr) ch->m_decimator.reset();
+    }
+    return m_source.start(m_openChannels, m_sampleRateHz);
+}
+
+RC_t AdcAcquisition::poll(uint32_t timeoutMs) {
+    std::lock_guard<std::mutex> sourceLock(m_sourceMutex);
+    if(m_openChannels == 0) return RC_ERROR_INVALID_STATE;
+    const uint32_t count = m_source.read(m_block, ADC_READ_BLOCK_SIZE, timeoutMs);
+    if(count == 0) return RC_ERROR_BUFFER_EMPTY;
+
+    std::lock_guard<std::mutex> bufferLock(m_bufferMutex);
+    for(uint32_t i = 0; i < count; i++) {
+        const AdcSample_t& sample = m_block[i];
+        if(sample.channel < ADC_MAX_CHANNELS && m_channels[sample.channel] != nullptr)
+            m_channels[sample.channel]->push(sample.value);
+    }
+    return RC_SUCCESS;
+}
+
+uint32_t AdcAcquisition::getChannelSampleRateHz() const {
+    std::lock_guard<std::mutex> lock(m_bufferMutex);
+    uint32_t channels = 0;
+    for(Channel* ch : m_channels) {
+        if(ch != nullptr) channels++;
+    }
+    return channels > 0 ? m_sampleRateHz / channels : 0;
+}
@@ -0,0 +1,130 @@
+#ifndef ADC_ACQUISITION_H
+#define ADC_ACQUISITION_H
+#include <memory>
+#include <mutex>
+
+#include "Decimator.h"
+#include "SampleSource.h"
+#include "global.h"
+
+/**
+ * @brief Distributes the samples of a continuously running SampleSource to the channels
+ * which are in use. Every channel decimates its samples and keeps the results until
+ * they are read by its sensor.
+ *
+ * poll() is meant to be called in a loop by a dedicated task, so that the DMA buffers
+ * are emptied independently of the sensor polling interval. The sensors only take the
+ * decimated values of their channel, which never waits for the source.
+ */
+class AdcAcquisition {
+   public:
+    /**
+     * @brief Decimated values of one ADC channel. Closed when destroyed.
+     */
+    class Channel {
+       public:
+        ~Channel();
+
+        /**
+         * @brief Takes the decimated values collected since the last call
+         *
+         * @param values [OUT] Values in chronological order
+         * @param maxCount [IN] Size of values. If more values are available, only the newest ones are returned
+         * @return uint32_t Number of values written to values
+         */
+        uint32_t read(float_t values[], uint32_t maxCount);
+
+        /**
+         * @brief Returns the number of values which were overwritten before they were read
+         *
+         * @return uint32_t
+         */
+        uint32_t getOverflowCount() const;
+
+        inline uint32_t getOversampling() const { return m_decimator.getFactor(); }
+
+       private:
+        friend class AdcAcquisition;
+
+        Channel(AdcAcquisition& acquisition, uint32_t channel, uint32_t oversampling);
+
+        /**
+         * @brief Decimates a sample. Called with the buffer mutex held
+         */
+        void push(uint16_t sample);
+
+        AdcAcquisition& m_acquisition;
+        const uint32_t m_channel;
+        Decimator m_decimator;
+        float_t m_buffer[ADC_CHANNEL_BUFFER_SIZE];
+        /**
+         * @brief Position of the oldest value
+         */
+        uint32_t m_start = 0;
+        uint32_t m_count = 0;
+        uint32_t m_overflows = 0;
+    };
+
+    /**
+     * @brief Constructor
+     *
+     * @param source [IN] Source of the samples. Has to outlive the acquisition
+     * @param sampleRateHz [IN] Total conversion rate, shared by all open channels
+     */
+    AdcAcquisition(SampleSource& source, uint32_t sampleRateHz = ADC_SAMPLE_RATE_HZ);
+
+    /**
+     * @brief Opens the ADC channel of a pin and restarts the source with it
+     *
+     * @param pin [IN] GPIO pin number
+     * @param oversampling [IN] Number of samples which are averaged into one value
+     * @return std::shared_ptr<Channel> Channel or nullptr if the pin has no ADC channel,
+     *  the channel is already open or the source could not be started
+     */
+    std::shared_ptr<Channel> openChannel(uint32_t pin, uint32_t oversampling);
+
+    /**
+     * @brief Reads one block of samples from the source and distributes it to the channels
+     *
+     * @param timeoutMs [IN] Maximum time to wait for samples
+     * @return RC_t RC_SUCCESS on success,
+     *  RC_ERROR_BUFFER_EMPTY if the source had no samples,
+     *  RC_ERROR_INVALID_STATE if no channel is open
+     */
+    RC_t poll(uint32_t timeoutMs);
+
+    /**
+     * @brief Returns the number of samples each open channel gets per second
+     *
+     * @return uint32_t
+     */
+    uint32_t getChannelSampleRateHz() const;
+
+   private:
+    /**
+     * @brief Removes a channel and restarts the source without it
+     */
+    void closeChannel(const Channel* ch);
+
+    /**
+     * @brief Starts the source with the channels which are currently open.
+     * Called with the source mutex held.
+     */
+    RC_t restartSource();
+
+    SampleSource& m_source;
+    const uint32_t m_sampleRateHz;
+    /**
+     * @brief Guards the source. Held while waiting for samples
+     */
+    std::mutex m_sourceMutex;
+    /**
+     * @brief Guards the channel table and the channel buffers. Only held briefly
+     */
+    mutable std::mutex m_bufferMutex;
+    Channel* m_channels[ADC_MAX_CHANNELS] = {};
+    uint32_t m_openChannels = 0;
+    AdcSample_t m_block[ADC_READ_BLOCK_SIZE];
+};
+
+#endif  // ADC_ACQUISITION_H
@@ -0,0 +1,75 @@
+#include "ContinuousAdcSource.h"
+
+ContinuousAdcSource::~ContinuousAdcSource() { stop(); }
+
+RC_t ContinuousAdcSource::channelFromPin(uint32_t pin, uint32_t& channel) {
+    const int8_t ch = digitalPinToAnalogChannel(pin);
+    // Only ADC1 supports the continuous mode on all targets
+    if(ch < 0 || ch >= ADC1_CHANNEL_MAX || ch >= ADC_MAX_CHANNELS) return RC_ERROR_RANGE;
+    channel = ch;
+    return RC_SUCCESS;
+}
+
+RC_t ContinuousAdcSource::start(uint32_t channelMask, uint32_t sampleRateHz) {
+    stop();
+    if(channelMask == 0) return RC_SUCCESS;
+
+    adc_digi_init_config_t initConfig = {};
+    initConfig.max_store_buf_size = ADC_DMA_BUFFER_SIZE;
+    initConfig.conv_num_each_intr = sizeof(m_readBuffer);
+    initConfig.adc1_chan_mask = channelMask;
+    initConfig.adc2_chan_mask = 0;
+    if(ESP_OK != adc_digi_initialize(&initConfig)) return RC_ERROR_LIB;
+
+    // One conversion per channel and pattern run
+    adc_digi_pattern_config_t pattern[ADC_MAX_CHANNELS];
+    uint32_t patternLength = 0;
+    for(uint32_t channel = 0; channel < ADC_MAX_CHANNELS; channel++) {
+        if((channelMask & (1u << channel)) == 0) continue;
+        // Same attenuation as analogRead, which gives the full input range
+        pattern[patternLength].atten = ADC_ATTEN_DB_11;
+        pattern[patternLength].channel = channel;
+        pattern[patternLength].unit = 0;
+        pattern[patternLength].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+        patternLength++;
+    }
+
+    adc_digi_configuration_t config = {};
+    config.conv_limit_en = false;
+    config.pattern_num = patternLength;
+    config.adc_pattern = pattern;
+    config.sample_freq_hz = sampleRateHz;
+    config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+    if(ESP_OK != adc_digi_controller_configure(&config) || ESP_OK != adc_digi_start()) {
+        adc_digi_deinitialize();
+        return RC_ERROR_LIB;
+    }
+    m_running = true;
+    return RC_SUCCESS;
+}
+
+void ContinuousAdcSource::stop() {
+    if(!m_running) return;
+    adc_digi_stop();
+    adc_digi_deinitialize();
+    m_running = false;
+}
+
+uint32_t ContinuousAdcSource::read(AdcSample_t samples[], uint32_t maxCount, uint32_t timeoutMs) {
+    if(!m_running) return 0;
+    uint32_t maxBytes = maxCount * SOC_ADC_DIGI_RESULT_BYTES;
+    if(maxBytes > sizeof(m_readBuffer)) maxBytes = sizeof(m_readBuffer);
+    uint32_t length = 0;
+    const esp_err_t err = adc_digi_read_bytes(m_readBuffer, maxBytes, &length, timeoutMs);
+    // ESP_ERR_INVALID_STATE means that the driver buffer overflowed, the returned data is still valid
+    if(err != ESP_OK && err != ESP_ERR_INVALID_STATE) return 0;
+
+    uint32_t count = 0;
+    for(uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= length; i += SOC_ADC_DIGI_RESULT_BYTES) {
+        const adc_digi_output_data_t* result = reinterpret_cast<const adc_digi_output_data_t*>(&m_readBuffer[i]);
+        if(result->type2.unit != 0) continue;
+        samples[count++] = {static_cast<uint16_t>(result->type2.data), static_cast<uint8_t>(result->type2.channel)};
+    }
+    return count;
+}
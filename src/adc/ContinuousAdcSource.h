@@ -0,0 +1,33 @@
+#ifndef CONTINUOUS_ADC_SOURCE_H
+#define CONTINUOUS_ADC_SOURCE_H
+#include <driver/adc.h>
+
+#include "SampleSource.h"
+
+/**
+ * @brief SampleSource using the continuous (DMA) mode of ADC1. The conversions run in
+ * hardware and are collected in the driver's buffer until they are read.
+ *
+ * @note While the continuous mode is running, analogRead must not be used on ADC1.
+ */
+class ContinuousAdcSource : public SampleSource {
+   public:
+    ContinuousAdcSource() = default;
+    ~ContinuousAdcSource() override;
+
+    RC_t channelFromPin(uint32_t pin, uint32_t& channel) override;
+
+    RC_t start(uint32_t channelMask, uint32_t sampleRateHz) override;
+
+    void stop() override;
+
+    uint32_t read(AdcSample_t samples[], uint32_t maxCount, uint32_t timeoutMs) override;
+
+    inline uint32_t getResolutionBits() const override { return SOC_ADC_DIGI_MAX_BITWIDTH; }
+
+   private:
+    bool m_running = false;
+    uint8_t m_readBuffer[ADC_READ_BLOCK_SIZE * SOC_ADC_DIGI_RESULT_BYTES];
+};
+
+#endif  // CONTINUOUS_ADC_SOURCE_H
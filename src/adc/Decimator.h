@@ -0,0 +1,57 @@
+#ifndef DECIMATOR_H
+#define DECIMATOR_H
+#include "global.h"
+
+/**
+ * @brief Averages every block of factor consecutive samples into one output value.
+ *
+ * Trades sample rate for resolution: uncorrelated noise of the mean shrinks with the
+ * square root of the factor, so every factor of 4 adds about one bit of effective resolution.
+ * The output is not rounded back to integers to keep these extra bits.
+ */
+class Decimator {
+   public:
+    /**
+     * @brief Constructor
+     *
+     * @param factor [IN] Number of input samples per output value. 0 is treated as 1
+     */
+    explicit Decimator(uint32_t factor) : m_factor(factor > 0 ? factor : 1) {}
+
+    /**
+     * @brief Adds an input sample
+     *
+     * @param sample [IN]
+     * @param output [OUT] Mean of the last factor samples, only written if true is returned
+     * @return true if a block was completed
+     * @return false otherwise
+     */
+    inline bool push(uint16_t sample, float_t& output) {
+        m_sum += sample;
+        if(++m_count < m_factor) return false;
+        output = static_cast<float_t>(m_sum) / static_cast<float_t>(m_factor);
+        m_sum = 0;
+        m_count = 0;
+        return true;
+    }
+
+    /**
+     * @brief Discards a partially collected block
+     */
+    inline void reset() {
+        m_sum = 0;
+        m_count = 0;
+    }
+
+    inline uint32_t getFactor() const { return m_factor; }
+
+   private:
+    const uint32_t m_factor;
+    /**
+     * @brief 16 bit samples can not overflow this for factors up to 65536
+     */
+    uint32_t m_sum = 0;
+    uint32_t m_count = 0;
+};
+
+#endif  // DECIMATOR_H
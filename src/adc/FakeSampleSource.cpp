@@ -0,0 +1,41 @@
+#include "FakeSampleSource.h"
+
+RC_t FakeSampleSource::channelFromPin(uint32_t pin, uint32_t& channel) {
+    if(pin >= ADC_MAX_CHANNELS) return RC_ERROR_RANGE;
+    channel = pin;
+    return RC_SUCCESS;
+}
+
+RC_t FakeSampleSource::start(uint32_t channelMask, uint32_t sampleRateHz) {
+    m_samples.clear();
+    m_channelMask = channelMask;
+    m_sampleRateHz = sampleRateHz;
+    m_startCount++;
+    return RC_SUCCESS;
+}
+
+void FakeSampleSource::stop() {
+    m_samples.clear();
+    m_channelMask = 0;
+}
+
+uint32_t FakeSampleSource::read(AdcSample_t samples[], uint32_t maxCount, uint32_t timeoutMs) {
+    uint32_t count = 0;
+    while(count < maxCount && !m_samples.empty()) {
+        samples[count++] = m_samples.front();
+        m_samples.pop_front();
+    }
+    return count;
+}
+
+uint32_t FakeSampleSource::push(uint32_t channel, const uint16_t values[], uint32_t count) {
+    if(channel >= ADC_MAX_CHANNELS || (m_channelMask & (1u << channel)) == 0) return 0;
+    for(uint32_t i = 0; i < count; i++) m_samples.push_back({values[i], static_cast<uint8_t>(channel)});
+    return count;
+}
+
+void FakeSampleSource::pushPattern(const uint16_t values[ADC_MAX_CHANNELS]) {
+    for(uint32_t channel = 0; channel < ADC_MAX_CHANNELS; channel++) {
+        if(m_channelMask & (1u << channel)) m_samples.push_back({values[channel], static_cast<uint8_t>(channel)});
+    }
+}
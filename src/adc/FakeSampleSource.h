@@ -0,0 +1,71 @@
+#ifndef FAKE_SAMPLE_SOURCE_H
+#define FAKE_SAMPLE_SOURCE_H
+#include <deque>
+
+#include "SampleSource.h"
+
+/**
+ * @brief SampleSource without hardware. Samples are fed by the caller and returned in the
+ * same order. Like the hardware, only channels which were started produce samples.
+ * Pin n is mapped to channel n.
+ */
+class FakeSampleSource : public SampleSource {
+   public:
+    /**
+     * @brief Constructor
+     *
+     * @param resolutionBits [IN] Resolution reported to users of the source
+     */
+    explicit FakeSampleSource(uint32_t resolutionBits = 12) : m_resolutionBits(resolutionBits) {}
+
+    RC_t channelFromPin(uint32_t pin, uint32_t& channel) override;
+
+    RC_t start(uint32_t channelMask, uint32_t sampleRateHz) override;
+
+    void stop() override;
+
+    /**
+     * @brief Returns the available samples immediately, never waits for the timeout
+     */
+    uint32_t read(AdcSample_t samples[], uint32_t maxCount, uint32_t timeoutMs) override;
+
+    inline uint32_t getResolutionBits() const override { return m_resolutionBits; }
+
+    /**
+     * @brief Adds samples of a channel. Samples of channels which are not started are dropped.
+     *
+     * @param channel [IN] ADC channel
+     * @param values [IN] Sample values
+     * @param count [IN] Number of values
+     * @return uint32_t Number of samples which were added
+     */
+    uint32_t push(uint32_t channel, const uint16_t values[], uint32_t count);
+
+    /**
+     * @brief Adds one sample for each started channel, in ascending channel order,
+     * like the conversion pattern of the hardware
+     *
+     * @param values [IN] One value per channel, indexed by channel number
+     */
+    void pushPattern(const uint16_t values[ADC_MAX_CHANNELS]);
+
+    inline uint32_t getChannelMask() const { return m_channelMask; }
+
+    inline uint32_t getSampleRateHz() const { return m_sampleRateHz; }
+
+    /**
+     * @brief Returns how often the source was started
+     *
+     * @return uint32_t
+     */
+    inline uint32_t getStartCount() const { return m_startCount; }
+
+   private:
+    const uint32_t m_resolutionBits;
+    uint32_t m_channelMask = 0;
+    uint32_t m_sampleRateHz = 0;
+    uint32_t m_startCount = 0;
+    std::deque<AdcSample_t> m_samples;
+};
+
+#endif  // FAKE_SAMPLE_SOURCE_H
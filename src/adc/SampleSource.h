@@ -0,0 +1,70 @@
+#ifndef SAMPLE_SOURCE_H
+#define SAMPLE_SOURCE_H
+#include "global.h"
+
+/**
+ * @brief Highest ADC channel number plus one which can be used with a SampleSource
+ */
+#define ADC_MAX_CHANNELS (10)
+
+/**
+ * @brief A single ADC conversion result
+ */
+typedef struct {
+    uint16_t value;
+    uint8_t channel;
+} AdcSample_t;
+
+/**
+ * @brief Producer of continuously converted ADC samples. The hardware implementation
+ * fills DMA buffers in the background, the native one is fed by the caller,
+ * which allows testing and benchmarking everything built on top off-device.
+ */
+class SampleSource {
+   public:
+    SampleSource() = default;
+    virtual ~SampleSource() = default;
+
+    /**
+     * @brief Maps a GPIO pin to its ADC channel
+     *
+     * @param pin [IN] GPIO pin number
+     * @param channel [OUT] ADC channel, smaller than ADC_MAX_CHANNELS
+     * @return RC_t RC_SUCCESS on success, RC_ERROR_RANGE if the pin has no usable ADC channel
+     */
+    virtual RC_t channelFromPin(uint32_t pin, uint32_t& channel) = 0;
+
+    /**
+     * @brief Starts continuous conversion of the given channels. Restarts the conversion
+     * if it is already running. Samples which were not read yet are discarded.
+     *
+     * @param channelMask [IN] Bit n set means that channel n is converted. 0 stops the conversion
+     * @param sampleRateHz [IN] Total number of conversions per second, shared by all channels
+     * @return RC_t RC_SUCCESS on success, RC_ERROR_LIB if the driver could not be started
+     */
+    virtual RC_t start(uint32_t channelMask, uint32_t sampleRateHz) = 0;
+
+    /**
+     * @brief Stops the conversion
+     */
+    virtual void stop() = 0;
+
+    /**
+     * @brief Takes converted samples of all channels in the order of conversion
+     *
+     * @param samples [OUT] Buffer for the samples
+     * @param maxCount [IN] Size of samples
+     * @param timeoutMs [IN] Maximum time to wait if no samples are available
+     * @return uint32_t Number of samples written to samples
+     */
+    virtual uint32_t read(AdcSample_t samples[], uint32_t maxCount, uint32_t timeoutMs) = 0;
+
+    /**
+     * @brief Returns the resolution of the samples
+     *
+     * @return uint32_t Number of bits
+     */
+    virtual uint32_t getResolutionBits() const = 0;
+};
+
+#endif  // SAMPLE_SOURCE_H
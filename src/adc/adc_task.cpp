@@ -0,0 +1,14 @@
+#include "adc_task.h"
+
+#include "global.h"
+#include "global_objects.h"
+
+TaskHandle_t adcTaskHandle;
+
+void adcTask(void* pvParameters) {
+    while(1) {
+        // Blocks until conversion results are available
+        const RC_t err = adcAcquisition.poll(ADC_READ_TIMEOUT_MS);
+        if(RC_ERROR_INVALID_STATE == err) vTaskDelay(pdMS_TO_TICKS(ADC_TASK_IDLE_DELAY_MS));
+    }
+}
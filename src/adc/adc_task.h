@@ -0,0 +1,23 @@
+#ifndef ADC_TASK_H
+#define ADC_TASK_H
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#define ADC_TASK_NAME ("ADC_Task")
+#define ADC_TASK_STACK_SIZE (2048)
+// Above the loop task so that the DMA buffer is emptied while the sensors are polled
+#define ADC_TASK_PRIORITY (LOOP_TASK_PRIORITY + 1)
+// Time in ms the task sleeps while no pin is in continuous mode
+#define ADC_TASK_IDLE_DELAY_MS (1000)
+
+extern TaskHandle_t adcTaskHandle;
+
+/**
+ * @brief ADC Task function. Should never return.
+ * Continuously moves the conversion results of the continuous ADC mode
+ * to the channels of the global AdcAcquisition, see there.
+ *
+ * @param pvParameters
+ */
+void adcTask(void* pvParameters);
+#endif  // ADC_TASK_H
@@ -43,13 +43,42 @@
 #define TRANSFORMER_CFG_CLOSE_CHAR "}"
 // Characters with which the beginning and end of comments in the config files are marked
 #define CONFIG_FILE_COMMENT_DELIMITER "//"
+// Size of the buffer through which the sensor config file is read. Limits the length of a single
+// sensor definition including its transformers, but not the size of the file
+#define SENSOR_CFG_READ_BUFFER_SIZE (4096)
 
 // General
 // ============================================
 
-// Defines (in seconds) how often the sensor is read and its
-// result printed to serial
+// Defines (in seconds) how often a sensor is read and its
+// result published if its config does not set publishIntervalS
 #define SENSOR_POLLING_INTERVAL_S 10
+// Shortest sampleIntervalMs which may be set in the sensor config
+#define SENSOR_MIN_SAMPLE_INTERVAL_MS 100
+// Longest time in ms for which the sensor loop sleeps. Bounds the delay with which
+// config reloads and reboot requests are handled
+#define SENSOR_LOOP_MAX_SLEEP_MS 1000
+// Size of the buffer for a published payload of aggregated samples
+#define SENSOR_AGGREGATE_PAYLOAD_SIZE 256
+// Largest number of decimals with which values are published. Used if the sensor config does not set
+// decimals, which gives the same text as "%f"
+#define FLOAT_FORMAT_MAX_DECIMALS 6
+// Size of a buffer which holds any value formatted by formatFloat
+#define FLOAT_FORMAT_BUFFER_SIZE 48
+// Number of urgent events which can wait for the MQTT task. When full, the oldest event is dropped
+#define URGENT_EVENT_QUEUE_SIZE 16
+// Time a single sensor read may take if the sensor config does not set timeBudgetMs.
+// Sensors which take longer are skipped for a while so that the other sensors keep their cadence
+#define SENSOR_DEFAULT_TIME_BUDGET_MS 250
+// Number of failed reads in a row after which a sensor is skipped
+#define SENSOR_FAULT_THRESHOLD 3
+// Longest time in ms for which a faulty sensor is skipped before it is retried
+#define SENSOR_MAX_BACKOFF_MS (10 * 60 * 1000)
+// Factor by which the sample interval of an adaptive sensor grows per sample while its signal is quiet
+#define SENSOR_ADAPTIVE_GROWTH_FACTOR (1.5f)
+// Weight of the newest sample in the variance with which adaptive sensors detect changes.
+// Higher values react faster but also to single outliers
+#define SENSOR_ADAPTIVE_EWMA_ALPHA (0.2f)
 
 // Top-level topic for this sensor platform
 #define MQTT_BASE_TOPIC "MultiSensor-MQTT"
@@ -57,16 +86,101 @@
 // Name of the general configuration file. Keep in mind that
 // LittleFS requires absolute file paths.
 #define CONFIG_FILENAME "/config.txt"
+// Longest line of the general configuration file including its line ending.
+// Longer lines are ignored.
+#define SETTINGS_FILE_MAX_LINE_LENGTH (256)
+// Appended to the name of the configuration file while it is rewritten
+#define SETTINGS_TEMP_FILE_SUFFIX ".tmp"
+// Time in ms after the first change of a setting until the changed settings are written.
+// All changes within this time are written together
+#define SETTINGS_WRITE_DELAY_MS (3000)
 
 // Time after which the controller automatically reboots in seconds
 #define AUTO_REBOOT_INTERVAL_S (86400)
 
+// Size in bytes of the buffer in which a ReplaySensor reads its file.
+// Every ReplaySensor has its own buffer.
+#define REPLAY_SENSOR_BUFFER_SIZE (256)
+
+// Maximum number of values a sensor can hand to its transformer pipeline in one reading.
+// Only sensors which acquire continuously in the background deliver more than one value.
+#define SENSOR_MAX_BLOCK_SIZE (64)
+
+// Sensor history
+// ============================================
+
+// Total amount of RAM in bytes used for storing the history of all sensors.
+// The budget is split evenly between the sensors.
+#define HISTORY_MEMORY_BUDGET_BYTES (32768)
+// Number of 1-hour aggregates stored per sensor.
+// More than the auto reboot interval is not useful since the history is kept in RAM.
+#define HISTORY_HOUR_TIER_CAPACITY (AUTO_REBOOT_INTERVAL_S / 3600)
+// Number of points returned by a history query if no point count is requested
+#define HISTORY_DEFAULT_QUERY_POINTS (100)
+// Maximum number of points which can be requested by a single history query
+#define HISTORY_MAX_QUERY_POINTS (500)
+
+// Sample log
+// ============================================
+
+// Path and name prefix of the log segment files in which samples are kept
+// while the MQTT broker is unreachable
+#define SAMPLE_LOG_FILENAME_PREFIX "/samplelog_"
+// Size in bytes after which a new log segment is started
+#define SAMPLE_LOG_SEGMENT_SIZE (16384)
+// Maximum number of log segments. When reached, the oldest segment is dropped.
+#define SAMPLE_LOG_MAX_SEGMENTS (16)
+// Maximum number of different sensors per log segment
+#define SAMPLE_LOG_MAX_SENSORS (32)
+// Maximum number of sensor values per log record
+#define SAMPLE_LOG_MAX_ENTRIES_PER_RECORD (32)
+// Size of the RAM buffer in which records are collected before they are written to flash.
+// Larger buffers mean less flash writes but more samples lost on power loss.
+#define SAMPLE_LOG_WRITE_BUFFER_SIZE (512)
+// Size of the RAM buffer used for reading back the log
+#define SAMPLE_LOG_READ_BUFFER_SIZE (512)
+// Interval in seconds after which the write buffer is flushed even if it is not full
+#define SAMPLE_LOG_FLUSH_INTERVAL_S (300)
+// Maximum number of logged records which are published per polling cycle
+// once the MQTT broker is reachable again
+#define SAMPLE_LOG_REPLAY_RECORDS_PER_CYCLE (30)
+
+// I2C
+// ============================================
+
+// Clock frequency of the I2C bus
+#define I2C_CLOCK_HZ (100000)
+// Time in ms after which a hung I2C transaction is aborted
+#define I2C_TIMEOUT_MS (50)
+// Time in ms between two measurement cycles of the I2C devices
+#define I2C_CYCLE_INTERVAL_MS (1000)
+
+// Continuous ADC
+// ============================================
+
+// Total conversion rate in Hz of the ADC in continuous mode.
+// The rate is shared evenly between all pins used by continuous ADCSensors.
+#define ADC_SAMPLE_RATE_HZ (20000)
+// Number of decimated values kept per pin between two readings of the sensor.
+// When full, the oldest values are overwritten.
+#define ADC_CHANNEL_BUFFER_SIZE (SENSOR_MAX_BLOCK_SIZE)
+// Number of conversion results which are taken from the DMA buffer at once
+#define ADC_READ_BLOCK_SIZE (128)
+// Size in bytes of the driver buffer between the DMA and the ADC task
+#define ADC_DMA_BUFFER_SIZE (4096)
+// Time in ms the ADC task waits for new conversion results
+#define ADC_READ_TIMEOUT_MS (100)
+// Largest oversampling factor which can be configured for an ADCSensor
+#define ADC_MAX_OVERSAMPLING (4096)
+
 // Webserver configuration
 // ============================================
 
 // The maximum size of a dynamically allocated JSON response string.
 // This limits, how many sensor values can be returned at once over the REST API
 #define DYNAMIC_JSON_DOCUMENT_SIZE (2048)
+// Additional JSON document size for the status of each sensor in the system information
+#define SYSTEM_INFO_JSON_SIZE_PER_SENSOR (256)
 // Enables UART logging calls for when a request was received or answered by the webserver.
 // Disabled when not debugging for better performance
 #define ENABLE_WEBSERVER_REQUEST_LOGGING (0)
@@ -77,8 +191,26 @@
 // Defines in seconds how long to keep the mqtt connection open when
 // no packages are being sent or received
 #define MQTT_CONNECTION_KEEPALIVE_S 15
-// Defines in which interval incoming messages are processed and the
-// connection to the server is refreshed
-#define MQTT_TASK_CYCLE_TIME_MS (5000)
+// Size of the document in which all sensors of a polling cycle are published if
+// MQTT_Publish_Mode is device. Sensors which do not fit are published in a further document
+#define MQTT_DEVICE_PAYLOAD_SIZE (1024)
+// Measurement of the lines if MQTT_Payload_Format is influx
+#define MQTT_INFLUX_MEASUREMENT "multisensor"
+// Size in bytes of the ring in which messages wait for the MQTT task. Holds them while the broker is
+// unreachable, until MQTT_Outbox_Drop makes room
+#define MQTT_OUTBOX_SIZE (8192)
+// Longest topic and payload of a message in the outbox
+#define MQTT_OUTBOX_MAX_TOPIC_LENGTH (256)
+#define MQTT_OUTBOX_MAX_PAYLOAD_LENGTH (MQTT_DEVICE_PAYLOAD_SIZE)
+// Messages which the MQTT task publishes before it services the connection again
+#define MQTT_OUTBOX_BATCH_SIZE (16)
+// Defines in which interval incoming messages are processed while connected
+#define MQTT_POLL_INTERVAL_MS (50)
+// Longest time in seconds the client waits for the broker to answer while connecting
+#define MQTT_SOCKET_TIMEOUT_S (2)
+// Delay before the connection is retried after the first failed attempt. Doubles with
+// each further failure up to MQTT_RECONNECT_MAX_BACKOFF_MS and is jittered by up to half
+#define MQTT_RECONNECT_MIN_BACKOFF_MS (1000)
+#define MQTT_RECONNECT_MAX_BACKOFF_MS (120000)
 
 #endif  // CFG_H
\ No newline at end of file
@@ -0,0 +1,209 @@
+#include "GorillaCodec.h"
+
+#include <cstring>
+
+// Marks that there is no previous window of meaningful bits yet
+#define NO_WINDOW (32)
+
+static inline uint32_t floatToBits(float_t f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+static inline float_t bitsToFloat(uint32_t bits) {
+    float_t f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+GorillaEncoder::GorillaEncoder(uint8_t* block, uint32_t capacity) : m_block(block), m_capacityBits(capacity * 8) {
+    reset();
+}
+
+void GorillaEncoder::reset() {
+    m_bitPos = GORILLA_BLOCK_HEADER_SIZE * 8;
+    m_count = 0;
+    m_prevTimestamp = 0;
+    m_prevDelta = 0;
+    m_prevValue = 0;
+    m_prevLeading = NO_WINDOW;
+    m_prevTrailing = 0;
+    if(m_capacityBits >= m_bitPos) memset(m_block, 0, GORILLA_BLOCK_HEADER_SIZE);
+}
+
+void GorillaEncoder::writeBits(uint32_t value, uint32_t nBits) {
+    while(nBits > 0) {
+        const uint32_t bitOffset = m_bitPos % 8;
+        const uint32_t freeBits = 8 - bitOffset;
+        const uint32_t take = (nBits < freeBits) ? nBits : freeBits;
+        const uint8_t chunk = static_cast<uint8_t>((value >> (nBits - take)) & ((1u << take) - 1));
+        // Bytes are not cleared in advance, so the first write to a byte overwrites it
+        if(bitOffset == 0) m_block[m_bitPos / 8] = 0;
+        m_block[m_bitPos / 8] |= static_cast<uint8_t>(chunk << (freeBits - take));
+        m_bitPos += take;
+        nBits -= take;
+    }
+}
+
+RC_t GorillaEncoder::append(uint32_t timestamp, float_t value) {
+    if(m_bitPos + GORILLA_MAX_SAMPLE_BITS > m_capacityBits || m_count == UINT16_MAX) return RC_ERROR_BUFFER_FULL;
+    const uint32_t valueBits = floatToBits(value);
+
+    if(m_count == 0) {
+        // First timestamp goes into the header, the first value is stored as is
+        for(uint32_t i = 0; i < 4; i++) m_block[2 + i] = static_cast<uint8_t>(timestamp >> (8 * i));
+        writeBits(valueBits, 32);
+    } else {
+        if(timestamp < m_prevTimestamp) return RC_ERROR_BAD_PARAM;
+        const int32_t delta = static_cast<int32_t>(timestamp - m_prevTimestamp);
+        // Wrapping arithmetic, the decoder reverses it the same way
+        const int32_t dod = static_cast<int32_t>(static_cast<uint32_t>(delta) - static_cast<uint32_t>(m_prevDelta));
+        if(dod == 0) {
+            writeBits(0x0, 1);
+        } else if(dod >= -63 && dod <= 64) {
+            writeBits(0x2, 2);
+            writeBits(static_cast<uint32_t>(dod + 63), 7);
+        } else if(dod >= -255 && dod <= 256) {
+            writeBits(0x6, 3);
+            writeBits(static_cast<uint32_t>(dod + 255), 9);
+        } else if(dod >= -2047 && dod <= 2048) {
+            writeBits(0xE, 4);
+            writeBits(static_cast<uint32_t>(dod + 2047), 12);
+        } else {
+            writeBits(0xF, 4);
+            writeBits(static_cast<uint32_t>(dod), 32);
+        }
+        m_prevDelta = delta;
+
+        const uint32_t xorValue = valueBits ^ m_prevValue;
+        if(xorValue == 0) {
+            writeBits(0x0, 1);
+        } else {
+            uint32_t leading = __builtin_clz(xorValue);
+            const uint32_t trailing = __builtin_ctz(xorValue);
+            // Only 5 bits are available for the leading zeros
+            if(leading > 31) leading = 31;
+            if(leading >= m_prevLeading && trailing >= m_prevTrailing) {
+                // Meaningful bits fit in the window of the previous value
+                writeBits(0x2, 2);
+                writeBits(xorValue >> m_prevTrailing, 32 - m_prevLeading - m_prevTrailing);
+            } else {
+                const uint32_t meaningful = 32 - leading - trailing;
+                writeBits(0x3, 2);
+                writeBits(leading, 5);
+                writeBits(meaningful, 6);
+                writeBits(xorValue >> trailing, meaningful);
+                m_prevLeading = leading;
+                m_prevTrailing = trailing;
+            }
+        }
+    }
+
+    m_prevTimestamp = timestamp;
+    m_prevValue = valueBits;
+    m_count++;
+    m_block[0] = static_cast<uint8_t>(m_count);
+    m_block[1] = static_cast<uint8_t>(m_count >> 8);
+    return RC_SUCCESS;
+}
+
+GorillaDecoder::GorillaDecoder(const uint8_t* block, uint32_t size)
+    : m_block(block),
+      m_sizeBits(size * 8),
+      m_count(size >= GORILLA_BLOCK_HEADER_SIZE ? (block[0] | (block[1] << 8)) : 0) {
+    rewind();
+}
+
+void GorillaDecoder::rewind() {
+    m_bitPos = GORILLA_BLOCK_HEADER_SIZE * 8;
+    m_decoded = 0;
+    m_prevTimestamp = 0;
+    m_prevDelta = 0;
+    m_prevValue = 0;
+    m_prevLeading = 0;
+    m_prevTrailing = 0;
+}
+
+uint32_t GorillaDecoder::getFirstTimestamp(const uint8_t* block) {
+    return block[2] | (block[3] << 8) | (block[4] << 16) | (static_cast<uint32_t>(block[5]) << 24);
+}
+
+RC_t GorillaDecoder::readBits(uint32_t nBits, uint32_t& value) {
+    if(m_bitPos + nBits > m_sizeBits) return RC_ERROR_BAD_DATA;
+    value = 0;
+    while(nBits > 0) {
+        const uint32_t bitOffset = m_bitPos % 8;
+        const uint32_t availableBits = 8 - bitOffset;
+        const uint32_t take = (nBits < availableBits) ? nBits : availableBits;
+        const uint32_t chunk = (m_block[m_bitPos / 8] >> (availableBits - take)) & ((1u << take) - 1);
+        value = (value << take) | chunk;
+        m_bitPos += take;
+        nBits -= take;
+    }
+    return RC_SUCCESS;
+}
+
+RC_t GorillaDecoder::next(uint32_t& timestamp, float_t& value) {
+    if(m_decoded >= m_count) return RC_ERROR_BUFFER_EMPTY;
+    uint32_t bits;
+
+    if(m_decoded == 0) {
+        if(RC_SUCCESS != readBits(32, bits)) return RC_ERROR_BAD_DATA;
+        m_prevTimestamp = getFirstTimestamp(m_block);
+        m_prevValue = bits;
+    } else {
+        // Count the leading one bits of the timestamp control code
+        uint32_t ones = 0;
+        do {
+            if(RC_SUCCESS != readBits(1, bits)) return RC_ERROR_BAD_DATA;
+            if(bits == 1) ones++;
+        } while(bits == 1 && ones < 4);
+
+        int32_t dod = 0;
+        switch(ones) {
+            case 0:
+                break;
+            case 1:
+                if(RC_SUCCESS != readBits(7, bits)) return RC_ERROR_BAD_DATA;
+                dod = static_cast<int32_t>(bits) - 63;
+                break;
+            case 2:
+                if(RC_SUCCESS != readBits(9, bits)) return RC_ERROR_BAD_DATA;
+                dod = static_cast<int32_t>(bits) - 255;
+                break;
+            case 3:
+                if(RC_SUCCESS != readBits(12, bits)) return RC_ERROR_BAD_DATA;
+                dod = static_cast<int32_t>(bits) - 2047;
+                break;
+            default:
+                if(RC_SUCCESS != readBits(32, bits)) return RC_ERROR_BAD_DATA;
+                dod = static_cast<int32_t>(bits);
+                break;
+        }
+        m_prevDelta = static_cast<int32_t>(static_cast<uint32_t>(m_prevDelta) + static_cast<uint32_t>(dod));
+        m_prevTimestamp += static_cast<uint32_t>(m_prevDelta);
+
+        if(RC_SUCCESS != readBits(1, bits)) return RC_ERROR_BAD_DATA;
+        if(bits == 1) {
+            if(RC_SUCCESS != readBits(1, bits)) return RC_ERROR_BAD_DATA;
+            if(bits == 1) {
+                // New window
+                uint32_t leading, meaningful;
+                if(RC_SUCCESS != readBits(5, leading)) return RC_ERROR_BAD_DATA;
+                if(RC_SUCCESS != readBits(6, meaningful)) return RC_ERROR_BAD_DATA;
+                if(meaningful == 0 || leading + meaningful > 32) return RC_ERROR_BAD_DATA;
+                m_prevLeading = leading;
+                m_prevTrailing = 32 - leading - meaningful;
+            }
+            uint32_t xorValue;
+            if(RC_SUCCESS != readBits(32 - m_prevLeading - m_prevTrailing, xorValue)) return RC_ERROR_BAD_DATA;
+            m_prevValue ^= xorValue << m_prevTrailing;
+        }
+    }
+
+    timestamp = m_prevTimestamp;
+    value = bitsToFloat(m_prevValue);
+    m_decoded++;
+    return RC_SUCCESS;
+}
@@ -0,0 +1,155 @@
+#ifndef GORILLA_CODEC_H
+#define GORILLA_CODEC_H
+#include "global.h"
+
+/**
+ * @brief Size of the block header: 16 bit sample count and 32 bit first timestamp
+ */
+#define GORILLA_BLOCK_HEADER_SIZE (6)
+
+/**
+ * @brief Maximum number of bits a single sample can take up in a block
+ */
+#define GORILLA_MAX_SAMPLE_BITS (36 + 45)
+
+/**
+ * @brief Compresses (timestamp, value) samples into a fixed-size block of memory, following the
+ * scheme of Facebook's Gorilla time series database.
+ *
+ * Timestamps are stored as the difference between consecutive deltas (delta-of-delta), which is
+ * 0 for a fixed polling interval and takes a single bit then:
+ *  - '0' if the delta-of-delta is 0
+ *  - '10' followed by 7 bits for values in [-63, 64]
+ *  - '110' followed by 9 bits for values in [-255, 256]
+ *  - '1110' followed by 12 bits for values in [-2047, 2048]
+ *  - '1111' followed by 32 bits otherwise
+ *
+ * Values are XORed with the previous value. Since consecutive measurements tend to be close,
+ * the result has many leading and trailing zero bits:
+ *  - '0' if the value is unchanged
+ *  - '10' followed by the meaningful bits, if they fit in the window of the previous value
+ *  - '11' followed by 5 bits of leading zeros, 6 bits of meaningful bit count and the bits
+ *
+ * Block layout: 16 bit little endian sample count, 32 bit little endian timestamp of the first
+ * sample, then the bit stream (MSB first) starting with the raw first value.
+ *
+ * Every block can be decoded on its own. Fixed-size blocks therefore keep random access cheap:
+ * the block containing a timestamp is found by the first timestamps in the headers and only
+ * that block has to be decoded.
+ *
+ * @note Does not allocate memory. The block buffer is provided by the caller.
+ */
+class GorillaEncoder {
+   public:
+    /**
+     * @brief Starts a new block in the given buffer
+     *
+     * @param block [IN] Buffer for the block. Has to stay valid while encoding
+     * @param capacity [IN] Size of the buffer in bytes
+     */
+    GorillaEncoder(uint8_t* block, uint32_t capacity);
+
+    /**
+     * @brief Appends a sample to the block.
+     *
+     * @param timestamp [IN] Timestamp of the sample. Has to be greater or equal to the previous one
+     * @param value [IN]
+     * @return RC_t RC_SUCCESS on success,
+     *  RC_ERROR_BUFFER_FULL if the block might not have enough space left for the sample,
+     *  RC_ERROR_BAD_PARAM if the timestamp is older than the previous one
+     */
+    RC_t append(uint32_t timestamp, float_t value);
+
+    /**
+     * @brief Clears the block to start encoding from scratch
+     */
+    void reset();
+
+    /**
+     * @brief Returns the number of bytes of the block which are in use
+     *
+     * @return uint32_t
+     */
+    inline uint32_t getSize() const { return (m_bitPos + 7) / 8; }
+
+    /**
+     * @brief Returns the number of samples in the block
+     *
+     * @return uint32_t
+     */
+    inline uint32_t getCount() const { return m_count; }
+
+   private:
+    void writeBits(uint32_t value, uint32_t nBits);
+
+    uint8_t* const m_block;
+    const uint32_t m_capacityBits;
+    uint32_t m_bitPos = 0;
+    uint32_t m_count = 0;
+    uint32_t m_prevTimestamp = 0;
+    int32_t m_prevDelta = 0;
+    uint32_t m_prevValue = 0;
+    uint32_t m_prevLeading = 0;
+    uint32_t m_prevTrailing = 0;
+};
+
+/**
+ * @brief Decodes a block written by GorillaEncoder, see there for the format
+ */
+class GorillaDecoder {
+   public:
+    /**
+     * @brief Constructor
+     *
+     * @param block [IN] Encoded block. Has to stay valid while decoding
+     * @param size [IN] Number of valid bytes of the block
+     */
+    GorillaDecoder(const uint8_t* block, uint32_t size);
+
+    /**
+     * @brief Decodes the next sample
+     *
+     * @param timestamp [OUT]
+     * @param value [OUT]
+     * @return RC_t RC_SUCCESS on success,
+     *  RC_ERROR_BUFFER_EMPTY if all samples have been decoded,
+     *  RC_ERROR_BAD_DATA if the block ends before the announced number of samples
+     */
+    RC_t next(uint32_t& timestamp, float_t& value);
+
+    /**
+     * @brief Restarts decoding from the first sample
+     */
+    void rewind();
+
+    /**
+     * @brief Returns the number of samples in the block
+     *
+     * @return uint32_t
+     */
+    inline uint32_t getCount() const { return m_count; }
+
+    /**
+     * @brief Returns the timestamp of the first sample without decoding the block
+     *
+     * @param block [IN] Block with at least GORILLA_BLOCK_HEADER_SIZE bytes
+     * @return uint32_t
+     */
+    static uint32_t getFirstTimestamp(const uint8_t* block);
+
+   private:
+    RC_t readBits(uint32_t nBits, uint32_t& value);
+
+    const uint8_t* const m_block;
+    const uint32_t m_sizeBits;
+    const uint32_t m_count;
+    uint32_t m_bitPos = 0;
+    uint32_t m_decoded = 0;
+    uint32_t m_prevTimestamp = 0;
+    int32_t m_prevDelta = 0;
+    uint32_t m_prevValue = 0;
+    uint32_t m_prevLeading = 0;
+    uint32_t m_prevTrailing = 0;
+};
+
+#endif  // GORILLA_CODEC_H
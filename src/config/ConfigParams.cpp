@@ -0,0 +1,77 @@
+#include "ConfigParams.h"
+
+#include <string.h>
+
+RC_t ConfigParams::parse(const ConfigSection& section, const ConfigParam_t schema[], uint32_t count) {
+    m_schema = schema;
+    m_count = 0;
+    m_errorKey = "";
+    if(count > CONFIG_MAX_PARAMS) return RC_ERROR_OVERRUN;
+    m_count = count;
+
+    for(uint32_t i = 0; i < count; i++) {
+        Value_t& v = m_values[i];
+        v = {false, 0, 0, StringView()};
+        const StringView* given = section.find(schema[i].key);
+        if(given != nullptr) {
+            v.str = *given;
+        } else if(schema[i].defaultValue != nullptr) {
+            v.str = StringView(schema[i].defaultValue, strlen(schema[i].defaultValue));
+        } else if(schema[i].required) {
+            m_errorKey = schema[i].key;
+            return RC_ERROR_ZERO;
+        } else {
+            continue;
+        }
+
+        RC_t err = v.str.empty() ? RC_ERROR_BAD_DATA : RC_SUCCESS;
+        if(schema[i].type == CONFIG_PARAM_INT)
+            err = v.str.toInt(v.i);
+        else if(schema[i].type == CONFIG_PARAM_FLOAT)
+            err = v.str.toFloat(v.f);
+        if(RC_SUCCESS != err) {
+            m_errorKey = schema[i].key;
+            return err;
+        }
+        v.set = true;
+    }
+    return RC_SUCCESS;
+}
+
+bool ConfigParams::contains(const StringView& key) const {
+    for(uint32_t i = 0; i < m_count; i++) {
+        if(key.equals(m_schema[i].key)) return true;
+    }
+    return false;
+}
+
+int32_t ConfigParams::indexOf(const char key[]) const {
+    for(uint32_t i = 0; i < m_count; i++) {
+        if(strcmp(m_schema[i].key, key) == 0) return i;
+    }
+    return -1;
+}
+
+bool ConfigParams::isSet(const char key[]) const {
+    const int32_t i = indexOf(key);
+    return i >= 0 && m_values[i].set;
+}
+
+int32_t ConfigParams::getInt(const char key[]) const {
+    const int32_t i = indexOf(key);
+    return (i >= 0 && m_values[i].set) ? m_values[i].i : 0;
+}
+
+float_t ConfigParams::getFloat(const char key[]) const {
+    const int32_t i = indexOf(key);
+    return (i >= 0 && m_values[i].set) ? m_values[i].f : 0;
+}
+
+RC_t ConfigParams::getString(const char key[], char value[], uint32_t size) const {
+    const int32_t i = indexOf(key);
+    if(i < 0 || !m_values[i].set) {
+        if(size > 0) value[0] = '\0';
+        return RC_SUCCESS;
+    }
+    return m_values[i].str.copyTo(value, size);
+}
@@ -0,0 +1,118 @@
+#ifndef CONFIG_PARAMS_H
+#define CONFIG_PARAMS_H
+#include "SensorConfigParser.h"
+#include "global.h"
+
+/**
+ * @brief Maximum number of parameters in a schema
+ */
+#define CONFIG_MAX_PARAMS (16)
+
+typedef enum { CONFIG_PARAM_INT, CONFIG_PARAM_FLOAT, CONFIG_PARAM_STRING } ConfigParamType_t;
+
+/**
+ * @brief Description of a single parameter of a sensor or transformer type
+ */
+typedef struct {
+    const char* key;
+    ConfigParamType_t type;
+    bool required;
+    /**
+     * @brief Value used if an optional key is missing, written like in the config file.
+     * nullptr if the parameter has no default
+     */
+    const char* defaultValue;
+} ConfigParam_t;
+
+/**
+ * @brief Parameter values of a config section, checked and converted according to a schema
+ */
+class ConfigParams {
+   public:
+    ConfigParams() = default;
+
+    /**
+     * @brief Reads and converts all parameters of the schema from the section
+     *
+     * @param section [IN] Parsed sensor or transformer definition. Has to outlive this object
+     * @param schema [IN] Parameters to read. Has to outlive this object
+     * @param count [IN] Number of entries in schema, at most CONFIG_MAX_PARAMS
+     * @return RC_t RC_SUCCESS on success, see getErrorKey for the parameter which failed
+     *  RC_ERROR_ZERO if a required key is missing
+     *  RC_ERROR_BAD_DATA if a key has no value
+     *  RC_ERROR_INVALID if a value does not match the parameter type
+     *  RC_ERROR_OVERRUN if the schema has too many entries
+     */
+    RC_t parse(const ConfigSection& section, const ConfigParam_t schema[], uint32_t count);
+
+    /**
+     * @brief Checks whether the key is part of the schema
+     *
+     * @param key [IN]
+     * @return true if the schema has a parameter with this key
+     */
+    bool contains(const StringView& key) const;
+
+    /**
+     * @brief Checks whether the parameter was given in the config or has a default value
+     *
+     * @param key [IN]
+     * @return true if a value is available
+     */
+    bool isSet(const char key[]) const;
+
+    /**
+     * @brief Returns the value of an integer parameter
+     *
+     * @param key [IN]
+     * @return int32_t Value, 0 if the parameter is not set
+     */
+    int32_t getInt(const char key[]) const;
+
+    /**
+     * @brief Returns the value of a float parameter
+     *
+     * @param key [IN]
+     * @return float_t Value, 0 if the parameter is not set
+     */
+    float_t getFloat(const char key[]) const;
+
+    /**
+     * @brief Copies the value of a string parameter
+     *
+     * @param key [IN]
+     * @param value [OUT] Null-terminated value, an empty string if the parameter is not set
+     * @param size [IN] Size of value
+     * @return RC_t RC_SUCCESS on success, RC_ERROR_BUFFER_FULL if the value does not fit
+     */
+    RC_t getString(const char key[], char value[], uint32_t size) const;
+
+    /**
+     * @brief Returns the key of the parameter which failed to parse
+     *
+     * @return const char* Key or an empty string
+     */
+    inline const char* getErrorKey() const { return m_errorKey; }
+
+   private:
+    /**
+     * @brief Returns the index of the key in the schema
+     *
+     * @return int32_t Index or -1 if the schema does not contain the key
+     */
+    int32_t indexOf(const char key[]) const;
+
+    typedef struct {
+        bool set;
+        int32_t i;
+        float_t f;
+        StringView str;
+    } Value_t;
+
+    const ConfigParam_t* m_schema = nullptr;
+    uint32_t m_count = 0;
+    Value_t m_values[CONFIG_MAX_PARAMS];
+    const char* m_errorKey = "";
+};
+
+#endif  // CONFIG_PARAMS_H
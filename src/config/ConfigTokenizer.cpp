@@ -0,0 +1,314 @@
+#include "ConfigTokenizer.h"
+
+#include <errno.h>
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define KEY_VALUE_SEPARATOR ':'
+// Longest number representation accepted by toInt and toFloat
+#define CONFIG_NUMBER_MAX_LENGTH (32)
+
+bool StringView::equals(const char str[]) const {
+    return strncmp(m_data, str, m_length) == 0 && str[m_length] == '\0';
+}
+
+RC_t StringView::copyTo(char str[], uint32_t size) const {
+    if(m_length >= size) return RC_ERROR_BUFFER_FULL;
+    memcpy(str, m_data, m_length);
+    str[m_length] = '\0';
+    return RC_SUCCESS;
+}
+
+static inline bool isDecimalDigit(char c) { return c >= '0' && c <= '9'; }
+
+RC_t StringView::toInt(int32_t& value) const {
+    if(empty()) return RC_ERROR_BAD_DATA;
+    const char* c = m_data;
+    const char* const end = m_data + m_length;
+    const bool negative = (*c == '-');
+    if(*c == '-' || *c == '+') c++;
+    if(c == end) return RC_ERROR_INVALID;
+    // Converted in place since the view is not null-terminated
+    int64_t result = 0;
+    for(; c < end; c++) {
+        if(!isDecimalDigit(*c)) return RC_ERROR_INVALID;
+        result = result * 10 + (*c - '0');
+        if(result > static_cast<int64_t>(INT32_MAX) + 1) return RC_ERROR_INVALID;
+    }
+    if(negative) result = -result;
+    if(result > INT32_MAX) return RC_ERROR_INVALID;
+    value = static_cast<int32_t>(result);
+    return RC_SUCCESS;
+}
+
+/**
+ * @brief Converts a view with strtof, which needs a null-terminated copy of it
+ */
+static RC_t toFloatCopy(const StringView& view, float_t& value) {
+    char buf[CONFIG_NUMBER_MAX_LENGTH];
+    if(RC_SUCCESS != view.copyTo(buf, sizeof(buf))) return RC_ERROR_INVALID;
+    char* end;
+    errno = 0;
+    const float_t result = strtof(buf, &end);
+    if(*end != '\0' || errno != 0) return RC_ERROR_INVALID;
+    value = result;
+    return RC_SUCCESS;
+}
+
+RC_t StringView::toFloat(float_t& value) const {
+    // Powers of ten which a double holds exactly
+    static const double powersOfTen[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                         1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    if(empty()) return RC_ERROR_BAD_DATA;
+    if(m_length >= CONFIG_NUMBER_MAX_LENGTH) return RC_ERROR_INVALID;
+
+    // Plain decimal numbers are converted in place. Everything else, like exponents beyond the
+    // exactly representable powers of ten or "inf", is left to strtof
+    const char* c = m_data;
+    const char* const end = m_data + m_length;
+    const bool negative = (*c == '-');
+    if(*c == '-' || *c == '+') c++;
+    uint64_t mantissa = 0;
+    int32_t exponent = 0;
+    uint32_t digits = 0;
+    bool hasDigits = false;
+    for(; c < end && isDecimalDigit(*c); c++) {
+        hasDigits = true;
+        // Digits beyond the precision of the mantissa only scale it
+        if(digits < 19) {
+            mantissa = mantissa * 10 + (*c - '0');
+            if(mantissa != 0) digits++;
+        } else
+            exponent++;
+    }
+    if(c < end && *c == '.') {
+        for(c++; c < end && isDecimalDigit(*c); c++) {
+            hasDigits = true;
+            if(digits < 19) {
+                mantissa = mantissa * 10 + (*c - '0');
+                if(mantissa != 0) digits++;
+                exponent--;
+            }
+        }
+    }
+    if(hasDigits && c < end && (*c == 'e' || *c == 'E')) {
+        c++;
+        const bool negativeExponent = (c < end && *c == '-');
+        if(c < end && (*c == '-' || *c == '+')) c++;
+        int32_t e = 0;
+        bool hasExponentDigits = false;
+        for(; c < end && isDecimalDigit(*c); c++) {
+            hasExponentDigits = true;
+            if(e < 1000) e = e * 10 + (*c - '0');
+        }
+        if(!hasExponentDigits) return RC_ERROR_INVALID;
+        exponent += negativeExponent ? -e : e;
+    }
+    if(!hasDigits || c != end) return toFloatCopy(*this, value);
+    if(exponent < -22 || exponent > 22) return toFloatCopy(*this, value);
+
+    double result = static_cast<double>(mantissa);
+    if(exponent < 0)
+        result /= powersOfTen[-exponent];
+    else
+        result *= powersOfTen[exponent];
+    if(result > FLT_MAX) return RC_ERROR_INVALID;
+    value = static_cast<float_t>(negative ? -result : result);
+    return RC_SUCCESS;
+}
+
+/**
+ * @brief Checks whether a comment delimiter starts at pos
+ */
+static inline bool isComment(const char* data, uint32_t pos, uint32_t length) {
+    const uint32_t delimiterLen = sizeof(CONFIG_FILE_COMMENT_DELIMITER) - 1;
+    // Checking the first character alone is enough for almost all positions
+    return data[pos] == CONFIG_FILE_COMMENT_DELIMITER[0] && length - pos >= delimiterLen &&
+           memcmp(&data[pos], CONFIG_FILE_COMMENT_DELIMITER, delimiterLen) == 0;
+}
+
+static inline bool isBlank(char c) { return c == ' ' || c == '\t'; }
+
+static inline bool isStructureChar(char c) {
+    return c == SENSOR_CFG_OPEN_CHAR[0] || c == SENSOR_CFG_CLOSE_CHAR[0] || c == TRANSFORMER_CFG_OPEN_CHAR[0] ||
+           c == TRANSFORMER_CFG_CLOSE_CHAR[0];
+}
+
+/**
+ * @brief Characters at which a name or key may end. The start of a comment delimiter is checked further
+ */
+static inline bool mayEndName(char c) {
+    switch(c) {
+        case KEY_VALUE_SEPARATOR:
+        case SENSOR_CFG_OPEN_CHAR[0]:
+        case SENSOR_CFG_CLOSE_CHAR[0]:
+        case TRANSFORMER_CFG_OPEN_CHAR[0]:
+        case TRANSFORMER_CFG_CLOSE_CHAR[0]:
+        case CONFIG_FILE_COMMENT_DELIMITER[0]:
+        case '\r':
+        case '\n':
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Characters at which a value may end. The start of a comment delimiter is checked further
+ */
+static inline bool mayEndValue(char c) {
+    switch(c) {
+        case SENSOR_CFG_CLOSE_CHAR[0]:
+        case TRANSFORMER_CFG_CLOSE_CHAR[0]:
+        case CONFIG_FILE_COMMENT_DELIMITER[0]:
+        case '\r':
+        case '\n':
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Returns the offset of the first character from pos on which ends a name or key, or length
+ */
+static inline uint32_t findNameEnd(const char* data, uint32_t pos, uint32_t length) {
+    for(; pos < length; pos++) {
+        const char c = data[pos];
+        if(mayEndName(c) && (c != CONFIG_FILE_COMMENT_DELIMITER[0] || isComment(data, pos, length))) break;
+    }
+    return pos;
+}
+
+/**
+ * @brief Returns the offset of the first character from pos on which ends a value, or length
+ */
+static inline uint32_t findValueEnd(const char* data, uint32_t pos, uint32_t length) {
+    for(; pos < length; pos++) {
+        const char c = data[pos];
+        if(mayEndValue(c) && (c != CONFIG_FILE_COMMENT_DELIMITER[0] || isComment(data, pos, length))) break;
+    }
+    return pos;
+}
+
+ConfigTokenizer::ConfigTokenizer(const char* data, uint32_t length, bool complete)
+    : m_data(data), m_length(length), m_complete(complete) {}
+
+void ConfigTokenizer::setData(const char* data, uint32_t length, bool complete, const Position_t& position) {
+    m_data = data;
+    m_length = length;
+    m_complete = complete;
+    setPosition(position);
+}
+
+RC_t ConfigTokenizer::fail(const char message[], uint32_t line, uint32_t column) {
+    m_errorMessage = message;
+    m_errorLine = line;
+    m_errorColumn = column;
+    return RC_ERROR_BAD_DATA;
+}
+
+RC_t ConfigTokenizer::skipWhitespaceAndComments() {
+    const uint32_t delimiterLen = sizeof(CONFIG_FILE_COMMENT_DELIMITER) - 1;
+    while(m_pos < m_length) {
+        // Blanks are skipped in a local loop, the members would be stored for every character otherwise
+        uint32_t pos = m_pos;
+        while(pos < m_length && (isBlank(m_data[pos]) || m_data[pos] == '\r')) pos++;
+        m_pos = pos;
+        if(m_pos >= m_length) break;
+        const char c = m_data[m_pos];
+        if(c == '\n') {
+            m_line++;
+            m_lineStart = m_pos + 1;
+            m_pos++;
+        } else if(isComment(m_data, m_pos, m_length)) {
+            const Position_t start = getPosition();
+            const uint32_t line = m_line;
+            const uint32_t col = column();
+            uint32_t pos = m_pos + delimiterLen;
+            for(; pos < m_length && !isComment(m_data, pos, m_length); pos++) {
+                if(m_data[pos] == '\n') {
+                    m_line++;
+                    m_lineStart = pos + 1;
+                }
+            }
+            m_pos = pos;
+            if(m_pos >= m_length) {
+                if(!m_complete) {
+                    setPosition(start);
+                    return RC_ERROR_UNDERRUN;
+                }
+                return fail("Comment is not closed", line, col);
+            }
+            m_pos += delimiterLen;
+        } else {
+            break;
+        }
+    }
+    return RC_SUCCESS;
+}
+
+RC_t ConfigTokenizer::next(Token_t& token) {
+    const Position_t start = getPosition();
+    const RC_t err = nextToken(token);
+    // Continues at the start of the token once the data was refilled
+    if(RC_ERROR_UNDERRUN == err) setPosition(start);
+    return err;
+}
+
+RC_t ConfigTokenizer::nextToken(Token_t& token) {
+    const RC_t err = skipWhitespaceAndComments();
+    if(RC_SUCCESS != err) return err;
+    token.line = m_line;
+    token.column = column();
+    token.text = StringView();
+    token.value = StringView();
+    if(m_pos >= m_length) {
+        if(!m_complete) return RC_ERROR_UNDERRUN;
+        token.type = TOKEN_END;
+        return RC_SUCCESS;
+    }
+
+    const char c = m_data[m_pos];
+    if(isStructureChar(c)) {
+        if(c == SENSOR_CFG_OPEN_CHAR[0])
+            token.type = TOKEN_SENSOR_OPEN;
+        else if(c == SENSOR_CFG_CLOSE_CHAR[0])
+            token.type = TOKEN_SENSOR_CLOSE;
+        else if(c == TRANSFORMER_CFG_OPEN_CHAR[0])
+            token.type = TOKEN_TRANSFORMER_OPEN;
+        else
+            token.type = TOKEN_TRANSFORMER_CLOSE;
+        token.text = StringView(&m_data[m_pos], 1);
+        m_pos++;
+        return RC_SUCCESS;
+    }
+    if(c == KEY_VALUE_SEPARATOR) return fail("Missing key in front of ':'", token.line, token.column);
+
+    // Name or key, ends in front of the separator, a structure character, the line end or a comment
+    const uint32_t start = m_pos;
+    m_pos = findNameEnd(m_data, m_pos, m_length);
+    // The token may continue in the next data
+    if(m_pos >= m_length && !m_complete) return RC_ERROR_UNDERRUN;
+    uint32_t end = m_pos;
+    while(end > start && isBlank(m_data[end - 1])) end--;
+    token.text = StringView(&m_data[start], end - start);
+
+    if(m_pos >= m_length || m_data[m_pos] != KEY_VALUE_SEPARATOR) {
+        token.type = TOKEN_NAME;
+        return RC_SUCCESS;
+    }
+
+    // Value, may contain spaces but ends at the line end, a closing character or a comment
+    m_pos++;
+    while(m_pos < m_length && isBlank(m_data[m_pos])) m_pos++;
+    const uint32_t valueStart = m_pos;
+    m_pos = findValueEnd(m_data, m_pos, m_length);
+    if(m_pos >= m_length && !m_complete) return RC_ERROR_UNDERRUN;
+    end = m_pos;
+    while(end > valueStart && isBlank(m_data[end - 1])) end--;
+    token.value = StringView(&m_data[valueStart], end - valueStart);
+    token.type = TOKEN_KEY_VALUE;
+    return RC_SUCCESS;
+}
@@ -0,0 +1,219 @@
+#ifndef CONFIG_TOKENIZER_H
+#define CONFIG_TOKENIZER_H
+#include "global.h"
+
+/**
+ * @brief Non-owning reference to a part of a string. Not null-terminated.
+ */
+class StringView {
+   public:
+    StringView() = default;
+
+    StringView(const char* data, uint32_t length) : m_data(data), m_length(length) {}
+
+    inline const char* data() const { return m_data; }
+
+    inline uint32_t length() const { return m_length; }
+
+    inline bool empty() const { return m_length == 0; }
+
+    /**
+     * @brief Compares the view to a null-terminated string
+     *
+     * @param str [IN]
+     * @return true if both contain the same characters
+     */
+    bool equals(const char str[]) const;
+
+    /**
+     * @brief Copies the view into a null-terminated string
+     *
+     * @param str [OUT] Destination
+     * @param size [IN] Size of str
+     * @return RC_t RC_SUCCESS on success, RC_ERROR_BUFFER_FULL if the view does not fit
+     */
+    RC_t copyTo(char str[], uint32_t size) const;
+
+    /**
+     * @brief Converts the view into a decimal integer
+     *
+     * @param value [OUT]
+     * @return RC_t RC_SUCCESS on success, RC_ERROR_BAD_DATA if the view is empty,
+     *  RC_ERROR_INVALID if it is not an integer
+     */
+    RC_t toInt(int32_t& value) const;
+
+    /**
+     * @brief Converts the view into a float
+     *
+     * @param value [OUT]
+     * @return RC_t RC_SUCCESS on success, RC_ERROR_BAD_DATA if the view is empty,
+     *  RC_ERROR_INVALID if it is not a number
+     */
+    RC_t toFloat(float_t& value) const;
+
+   private:
+    const char* m_data = "";
+    uint32_t m_length = 0;
+};
+
+/**
+ * @brief Splits a sensor config file into tokens in a single pass without copying.
+ *
+ * Grammar:
+ *  file        := { sensor }
+ *  sensor      := name SENSOR_CFG_OPEN_CHAR { keyValue | transformer } SENSOR_CFG_CLOSE_CHAR
+ *  transformer := name TRANSFORMER_CFG_OPEN_CHAR { keyValue } TRANSFORMER_CFG_CLOSE_CHAR
+ *  keyValue    := key ':' value
+ *
+ * A value runs until the end of the line, a closing character or a comment. Comments are
+ * enclosed in CONFIG_FILE_COMMENT_DELIMITER and may appear anywhere between tokens.
+ * The tokenizer only checks the syntax of single tokens, the order is checked by the caller.
+ * Tokens refer to the buffer given to the constructor, which has to outlive them.
+ *
+ * The data may also be a window of a longer text which is refilled by the caller. A token
+ * which reaches the end of an incomplete window is not returned, see next and setData.
+ */
+class ConfigTokenizer {
+   public:
+    typedef enum {
+        TOKEN_END = 0,
+        /**
+         * @brief Sensor or transformer type in front of an opening character
+         */
+        TOKEN_NAME,
+        TOKEN_SENSOR_OPEN,
+        TOKEN_SENSOR_CLOSE,
+        TOKEN_TRANSFORMER_OPEN,
+        TOKEN_TRANSFORMER_CLOSE,
+        TOKEN_KEY_VALUE
+    } TokenType_t;
+
+    typedef struct {
+        TokenType_t type;
+        /**
+         * @brief Name or key of the token
+         */
+        StringView text;
+        /**
+         * @brief Value of a TOKEN_KEY_VALUE, without surrounding whitespace
+         */
+        StringView value;
+        /**
+         * @brief Position of the first character of the token, both starting at 1
+         */
+        uint32_t line;
+        uint32_t column;
+    } Token_t;
+
+    /**
+     * @brief Position in the data and the line it is in
+     */
+    typedef struct {
+        uint32_t pos;
+        uint32_t line;
+        /**
+         * @brief Offset of the first character of the line. Negative if the line started
+         * in front of the data
+         */
+        int32_t lineStart;
+    } Position_t;
+
+    /**
+     * @brief Constructor
+     *
+     * @param data [IN] Config text. Does not have to be null-terminated
+     * @param length [IN] Length of data in bytes
+     * @param complete [IN] Whether data ends with the end of the text
+     */
+    ConfigTokenizer(const char* data, uint32_t length, bool complete = true);
+
+    /**
+     * @brief Reads the next token
+     *
+     * @param token [OUT]
+     * @return RC_t RC_SUCCESS on success, also for TOKEN_END at the end of complete data
+     *  RC_ERROR_BAD_DATA on a syntax error, see getErrorMessage
+     *  RC_ERROR_UNDERRUN if the data is not complete and the token may continue behind it.
+     *  The position does not change then
+     */
+    RC_t next(Token_t& token);
+
+    /**
+     * @brief Skips whitespace and comments in front of the next token
+     *
+     * @return RC_t RC_SUCCESS on success, RC_ERROR_BAD_DATA for a comment which is not closed,
+     *  RC_ERROR_UNDERRUN if the data is not complete and ends within a comment.
+     *  The position is at the start of that comment then
+     */
+    RC_t skipWhitespaceAndComments();
+
+    /**
+     * @brief Returns the current position, e.g. to continue from it after the data was refilled
+     *
+     * @return Position_t
+     */
+    inline Position_t getPosition() const { return {m_pos, m_line, m_lineStart}; }
+
+    /**
+     * @brief Continues tokenizing in new data
+     *
+     * @param data [IN] Config text. Does not have to be null-terminated
+     * @param length [IN] Length of data in bytes
+     * @param complete [IN] Whether data ends with the end of the text
+     * @param position [IN] Position in data at which the next token is read
+     */
+    void setData(const char* data, uint32_t length, bool complete, const Position_t& position);
+
+    /**
+     * @brief Returns a description of the latest syntax error
+     *
+     * @return const char* Static string, empty if there was no error
+     */
+    inline const char* getErrorMessage() const { return m_errorMessage; }
+
+    /**
+     * @brief Position of the latest syntax error, both starting at 1
+     */
+    inline uint32_t getErrorLine() const { return m_errorLine; }
+
+    inline uint32_t getErrorColumn() const { return m_errorColumn; }
+
+   private:
+    /**
+     * @brief Same as next, but leaves the position behind the consumed data on RC_ERROR_UNDERRUN
+     */
+    RC_t nextToken(Token_t& token);
+
+    inline void setPosition(const Position_t& position) {
+        m_pos = position.pos;
+        m_line = position.line;
+        m_lineStart = position.lineStart;
+    }
+
+
+    /**
+     * @brief Records a syntax error at the given position
+     *
+     * @return RC_t Always RC_ERROR_BAD_DATA
+     */
+    RC_t fail(const char message[], uint32_t line, uint32_t column);
+
+    inline uint32_t column() const { return static_cast<uint32_t>(static_cast<int32_t>(m_pos) - m_lineStart) + 1; }
+
+    const char* m_data;
+    uint32_t m_length;
+    bool m_complete;
+    uint32_t m_pos = 0;
+    uint32_t m_line = 1;
+    /**
+     * @brief Offset of the first character of the current line
+     */
+    int32_t m_lineStart = 0;
+
+    const char* m_errorMessage = "";
+    uint32_t m_errorLine = 0;
+    uint32_t m_errorColumn = 0;
+};
+
+#endif  // CONFIG_TOKENIZER_H
@@ -0,0 +1,170 @@
+#include "SensorConfigParser.h"
+
+#include <string.h>
+
+#include "helper_functions.h"
+
+const StringView* ConfigSection::find(const char key[]) const {
+    // Comparing the lengths first rules out almost all other keys without looking at their characters
+    const uint32_t length = strlen(key);
+    for(const KeyValue_t& kv : values) {
+        if(kv.key.length() == length && memcmp(kv.key.data(), key, length) == 0) return &kv.value;
+    }
+    return nullptr;
+}
+
+RC_t ConfigSection::getString(const char key[], char value[], uint32_t valueLen) const {
+    const StringView* v = find(key);
+    if(v == nullptr) return RC_ERROR_ZERO;
+    if(v->empty()) return RC_ERROR_BAD_DATA;
+    return v->copyTo(value, valueLen);
+}
+
+RC_t ConfigSection::getInt(const char key[], int32_t& value) const {
+    const StringView* v = find(key);
+    if(v == nullptr) return RC_ERROR_ZERO;
+    return v->toInt(value);
+}
+
+RC_t ConfigSection::getFloat(const char key[], float_t& value) const {
+    const StringView* v = find(key);
+    if(v == nullptr) return RC_ERROR_ZERO;
+    return v->toFloat(value);
+}
+
+uint32_t ConfigSection::hash(uint32_t hash) const {
+    // Separators keep e.g. "ab: c" and "a: bc" apart
+    const uint8_t separator = 0;
+    hash = hashBytes(reinterpret_cast<const uint8_t*>(type.data()), type.length(), hash);
+    for(const KeyValue_t& kv : values) {
+        hash = hashBytes(&separator, 1, hash);
+        hash = hashBytes(reinterpret_cast<const uint8_t*>(kv.key.data()), kv.key.length(), hash);
+        hash = hashBytes(&separator, 1, hash);
+        hash = hashBytes(reinterpret_cast<const uint8_t*>(kv.value.data()), kv.value.length(), hash);
+    }
+    return hash;
+}
+
+SensorConfigParser::SensorConfigParser(const char* data, uint32_t length) : m_tokenizer(data, length) {}
+
+SensorConfigParser::SensorConfigParser(Filesystem& fs, char buffer[], uint32_t size)
+    : m_tokenizer(buffer, 0, fs.size() == 0), m_fs(&fs), m_buffer(buffer), m_size(size) {
+    m_remaining = fs.size();
+}
+
+RC_t SensorConfigParser::fill(ConfigTokenizer::Position_t position) {
+    memmove(m_buffer, m_buffer + position.pos, m_length - position.pos);
+    m_length -= position.pos;
+    position.lineStart -= position.pos;
+    position.pos = 0;
+
+    uint32_t n = m_size - m_length;
+    if(n > m_remaining) n = m_remaining;
+    const RC_t err = m_fs->read(reinterpret_cast<uint8_t*>(m_buffer + m_length), n);
+    if(RC_SUCCESS != err) return err;
+    m_length += n;
+    m_remaining -= n;
+    m_tokenizer.setData(m_buffer, m_length, m_remaining == 0, position);
+    return RC_SUCCESS;
+}
+
+RC_t SensorConfigParser::nextToken(ConfigTokenizer::Token_t& token) {
+    const RC_t err = m_tokenizer.next(token);
+    if(RC_SUCCESS != err && RC_ERROR_UNDERRUN != err) {
+        m_errorMessage = m_tokenizer.getErrorMessage();
+        m_errorLine = m_tokenizer.getErrorLine();
+        m_errorColumn = m_tokenizer.getErrorColumn();
+    }
+    return err;
+}
+
+RC_t SensorConfigParser::fail(const char message[], const ConfigTokenizer::Token_t& token) {
+    m_errorMessage = message;
+    m_errorLine = token.line;
+    m_errorColumn = token.column;
+    return RC_ERROR_BAD_DATA;
+}
+
+RC_t SensorConfigParser::next(SensorConfig_t& config) {
+    while(true) {
+        // Only the definition itself has to fit in the buffer, not the comments in front of it
+        RC_t err = m_tokenizer.skipWhitespaceAndComments();
+        const ConfigTokenizer::Position_t start = m_tokenizer.getPosition();
+        if(RC_SUCCESS == err) {
+            config.sensor.values.clear();
+            // Transformer sections of the previous sensor are overwritten instead of being freed
+            uint32_t transformerCount = 0;
+            err = parseSensor(config, transformerCount);
+            config.transformers.resize(transformerCount);
+        } else if(RC_ERROR_BAD_DATA == err) {
+            m_errorMessage = m_tokenizer.getErrorMessage();
+            m_errorLine = m_tokenizer.getErrorLine();
+            m_errorColumn = m_tokenizer.getErrorColumn();
+        }
+        // Only happens when reading from a file. The definition is parsed again once more of it was read
+        if(RC_ERROR_UNDERRUN != err) return err;
+        if(start.pos == 0 && m_length == m_size) {
+            m_errorMessage = "Sensor definition or comment does not fit in the read buffer";
+            m_errorLine = start.line;
+            m_errorColumn = static_cast<uint32_t>(static_cast<int32_t>(start.pos) - start.lineStart) + 1;
+            return RC_ERROR_OVERRUN;
+        }
+        err = fill(start);
+        if(RC_SUCCESS != err) return err;
+    }
+}
+
+RC_t SensorConfigParser::parseSensor(SensorConfig_t& config, uint32_t& transformerCount) {
+    ConfigTokenizer::Token_t token;
+    RC_t err = nextToken(token);
+    if(RC_SUCCESS != err) return err;
+    if(token.type == ConfigTokenizer::TOKEN_END) return RC_ERROR_BUFFER_EMPTY;
+    if(token.type != ConfigTokenizer::TOKEN_NAME) return fail("Expected a sensor type", token);
+    config.sensor.type = token.text;
+    config.sensor.line = token.line;
+    const ConfigTokenizer::Token_t sensorStart = token;
+
+    err = nextToken(token);
+    if(RC_SUCCESS != err) return err;
+    if(token.type != ConfigTokenizer::TOKEN_SENSOR_OPEN)
+        return fail("Expected '" SENSOR_CFG_OPEN_CHAR "' after the sensor type", token);
+
+    while(true) {
+        err = nextToken(token);
+        if(RC_SUCCESS != err) return err;
+        switch(token.type) {
+            case ConfigTokenizer::TOKEN_KEY_VALUE:
+                config.sensor.values.push_back({token.text, token.value});
+                break;
+            case ConfigTokenizer::TOKEN_SENSOR_CLOSE:
+                return RC_SUCCESS;
+            case ConfigTokenizer::TOKEN_END:
+                return fail("Sensor definition is not closed", sensorStart);
+            case ConfigTokenizer::TOKEN_NAME: {
+                if(transformerCount == config.transformers.size()) config.transformers.push_back(ConfigSection());
+                ConfigSection& transformer = config.transformers[transformerCount++];
+                transformer.values.clear();
+                transformer.type = token.text;
+                transformer.line = token.line;
+                const ConfigTokenizer::Token_t transformerStart = token;
+                err = nextToken(token);
+                if(RC_SUCCESS != err) return err;
+                if(token.type != ConfigTokenizer::TOKEN_TRANSFORMER_OPEN)
+                    return fail("Expected '" TRANSFORMER_CFG_OPEN_CHAR "' after the transformer type", token);
+                while(true) {
+                    err = nextToken(token);
+                    if(RC_SUCCESS != err) return err;
+                    if(token.type == ConfigTokenizer::TOKEN_TRANSFORMER_CLOSE) break;
+                    if(token.type == ConfigTokenizer::TOKEN_END)
+                        return fail("Transformer definition is not closed", transformerStart);
+                    if(token.type != ConfigTokenizer::TOKEN_KEY_VALUE)
+                        return fail("Expected a key-value pair or '" TRANSFORMER_CFG_CLOSE_CHAR "'", token);
+                    transformer.values.push_back({token.text, token.value});
+                }
+                break;
+            }
+            default:
+                return fail("Expected a key-value pair, a transformer or '" SENSOR_CFG_CLOSE_CHAR "'", token);
+        }
+    }
+}
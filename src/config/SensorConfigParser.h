@@ -0,0 +1,184 @@
+#ifndef SENSOR_CONFIG_PARSER_H
+#define SENSOR_CONFIG_PARSER_H
+#include <vector>
+
+#include "ConfigTokenizer.h"
+#include "filesystem/Filesystem.h"
+#include "global.h"
+
+/**
+ * @brief Type and key-value pairs of a sensor or transformer definition.
+ * Keys and values refer to the parsed config text.
+ */
+class ConfigSection {
+   public:
+    typedef struct {
+        StringView key;
+        StringView value;
+    } KeyValue_t;
+
+    /**
+     * @brief Returns the value of the given key
+     *
+     * @param key [IN]
+     * @return const StringView* Value or nullptr if the key does not exist
+     */
+    const StringView* find(const char key[]) const;
+
+    /**
+     * @brief Copies the value of the given key into a string
+     *
+     * @param key [IN] Key to look for
+     * @param value [OUT] Null-terminated value
+     * @param valueLen [IN] Size of value
+     * @return RC_t RC_SUCCESS on success
+     *  RC_ERROR_ZERO if the key does not exist
+     *  RC_ERROR_BAD_DATA if the key has no value
+     *  RC_ERROR_BUFFER_FULL if the value does not fit in the provided buffer
+     */
+    RC_t getString(const char key[], char value[], uint32_t valueLen) const;
+
+    /**
+     * @brief Same as getString but converts the value into an integer
+     *
+     * @return RC_t Same as getString and RC_ERROR_INVALID if the value is not an integer
+     */
+    RC_t getInt(const char key[], int32_t& value) const;
+
+    /**
+     * @brief Same as getString but converts the value into a float
+     *
+     * @return RC_t Same as getString and RC_ERROR_INVALID if the value is not a number
+     */
+    RC_t getFloat(const char key[], float_t& value) const;
+
+    /**
+     * @brief Continues a 32 bit FNV-1a hash with the type, keys and values.
+     * Formatting and comments do not change the hash.
+     *
+     * @param hash [IN] Hash of preceding data when hashing in several steps.
+     *  Defaults to the FNV offset basis.
+     * @return uint32_t
+     */
+    uint32_t hash(uint32_t hash = 2166136261u) const;
+
+    /**
+     * @brief Type name in front of the opening character
+     */
+    StringView type;
+    /**
+     * @brief Line of the type name, starting at 1
+     */
+    uint32_t line = 0;
+    std::vector<KeyValue_t> values;
+};
+
+/**
+ * @brief Definition of a sensor and its transformers
+ */
+typedef struct {
+    ConfigSection sensor;
+    /**
+     * @brief Transformers in the order of the config file. The topmost transformer is the last
+     * stage of the pipeline
+     */
+    std::vector<ConfigSection> transformers;
+} SensorConfig_t;
+
+/**
+ * @brief Reads the sensor definitions of a sensor config file one by one.
+ * Makes a single pass over the text and does not copy it, the text has to outlive the results.
+ * Syntax errors are reported with their line and column.
+ *
+ * The text is either given completely or read from an open file through a fixed buffer.
+ * The buffer is refilled like in LineReader and only limits the length of a single definition.
+ */
+class SensorConfigParser {
+   public:
+    /**
+     * @brief Constructor
+     *
+     * @param data [IN] Config text. Does not have to be null-terminated
+     * @param length [IN] Length of data in bytes
+     */
+    SensorConfigParser(const char* data, uint32_t length);
+
+    /**
+     * @brief Constructor for reading the open file of a Filesystem. The file has to be opened for
+     * reading beforehand and must stay open while sensors are parsed. It is read from its current
+     * position to its end.
+     *
+     * @param fs [IN] Filesystem with an open file
+     * @param buffer [IN] Buffer for the file contents, also limits the length of a sensor definition
+     * @param size [IN] Size of buffer in bytes
+     */
+    SensorConfigParser(Filesystem& fs, char buffer[], uint32_t size);
+
+    /**
+     * @brief Parses the next sensor definition
+     *
+     * @param config [OUT] Sensor definition. Passing the same object for every sensor reuses its memory.
+     *  When reading from a file, it refers to the buffer and is valid until the next call
+     * @return RC_t RC_SUCCESS on success,
+     *  RC_ERROR_BUFFER_EMPTY if there are no further sensors,
+     *  RC_ERROR_BAD_DATA on a syntax error, see getErrorMessage
+     *  RC_ERROR_OVERRUN if a definition does not fit in the buffer, see getErrorMessage
+     *  errors of Filesystem::read
+     */
+    RC_t next(SensorConfig_t& config);
+
+    inline const char* getErrorMessage() const { return m_errorMessage; }
+
+    inline uint32_t getErrorLine() const { return m_errorLine; }
+
+    inline uint32_t getErrorColumn() const { return m_errorColumn; }
+
+   private:
+    /**
+     * @brief Parses a sensor definition into config
+     *
+     * @param config [OUT]
+     * @param transformerCount [OUT] Number of entries of config.transformers which were written
+     * @return RC_t Same as next
+     */
+    RC_t parseSensor(SensorConfig_t& config, uint32_t& transformerCount);
+
+    /**
+     * @brief Reads the next token and takes over the error of the tokenizer
+     */
+    RC_t nextToken(ConfigTokenizer::Token_t& token);
+
+    /**
+     * @brief Records a syntax error at the position of the given token
+     *
+     * @return RC_t Always RC_ERROR_BAD_DATA
+     */
+    RC_t fail(const char message[], const ConfigTokenizer::Token_t& token);
+
+    /**
+     * @brief Moves the data from the given position on to the front of the buffer and fills up
+     * the rest from the file. The tokenizer continues at the given position.
+     *
+     * @param position [IN] Start of the definition which is parsed
+     * @return RC_t RC_SUCCESS on success, errors of Filesystem::read
+     */
+    RC_t fill(ConfigTokenizer::Position_t position);
+
+    ConfigTokenizer m_tokenizer;
+    /**
+     * @brief Only set when reading from a file
+     */
+    Filesystem* const m_fs = nullptr;
+    char* const m_buffer = nullptr;
+    const uint32_t m_size = 0;
+    uint32_t m_length = 0;
+    /**
+     * @brief Bytes of the file which were not read into the buffer yet
+     */
+    uint32_t m_remaining = 0;
+    const char* m_errorMessage = "";
+    uint32_t m_errorLine = 0;
+    uint32_t m_errorColumn = 0;
+};
+
+#endif  // SENSOR_CONFIG_PARSER_H
@@ -0,0 +1,82 @@
+#ifndef TYPE_TABLE_H
+#define TYPE_TABLE_H
+#include <string.h>
+
+#include "ConfigTokenizer.h"
+#include "global.h"
+#include "helper_functions.h"
+
+/**
+ * @brief Hash table of the types which can be created from the config file, filled by the types
+ * themselves during static initialization.
+ *
+ * Type_t has to provide the members name (null-terminated) and nameHash, which is calculated
+ * at compile time with constHash. Collisions are resolved by linear probing. The table is
+ * kept at most half full, so a lookup usually needs a single comparison.
+ * The table is zero-initialized before any constructor runs, which makes registration from
+ * static objects in any translation unit safe.
+ *
+ * @tparam Type_t Type descriptor
+ * @tparam SIZE Number of slots, has to be a power of two
+ */
+template <typename Type_t, uint32_t SIZE>
+class TypeTable {
+    static_assert(SIZE > 0 && (SIZE & (SIZE - 1)) == 0, "SIZE has to be a power of two");
+
+   public:
+    /**
+     * @brief Adds a type. Called through the registration macros of the type descriptors
+     *
+     * @param type [IN] Descriptor with static storage duration
+     * @return RC_t RC_SUCCESS on success, RC_ERROR_BUSY if the name is already taken,
+     *  RC_ERROR_BUFFER_FULL if the table is half full
+     */
+    static RC_t add(const Type_t& type) {
+        if(2 * (s_count + 1) > SIZE) return RC_ERROR_BUFFER_FULL;
+        for(uint32_t i = 0; i < SIZE; i++) {
+            const Type_t*& slot = s_slots[(type.nameHash + i) & (SIZE - 1)];
+            if(slot == nullptr) {
+                slot = &type;
+                s_count++;
+                return RC_SUCCESS;
+            }
+            if(strcmp(slot->name, type.name) == 0) return RC_ERROR_BUSY;
+        }
+        return RC_ERROR_BUFFER_FULL;
+    }
+
+    /**
+     * @brief Looks up a type by name
+     *
+     * @param name [IN]
+     * @return const Type_t* Descriptor or nullptr if no type has this name
+     */
+    static const Type_t* find(const StringView& name) {
+        const uint32_t hash = hashBytes(reinterpret_cast<const uint8_t*>(name.data()), name.length());
+        for(uint32_t i = 0; i < SIZE; i++) {
+            const Type_t* slot = s_slots[(hash + i) & (SIZE - 1)];
+            if(slot == nullptr) return nullptr;
+            if(slot->nameHash == hash && name.equals(slot->name)) return slot;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Returns the number of registered types
+     *
+     * @return uint32_t
+     */
+    static uint32_t size() { return s_count; }
+
+   private:
+    static const Type_t* s_slots[SIZE];
+    static uint32_t s_count;
+};
+
+template <typename Type_t, uint32_t SIZE>
+const Type_t* TypeTable<Type_t, SIZE>::s_slots[SIZE] = {};
+
+template <typename Type_t, uint32_t SIZE>
+uint32_t TypeTable<Type_t, SIZE>::s_count = 0;
+
+#endif  // TYPE_TABLE_H
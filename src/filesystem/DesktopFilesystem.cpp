@@ -20,31 +20,44 @@ RC_t DesktopFilesystem::openFile(const char filename[], OpenMode_t openMode) {
             mode = std::ios::in | std::ios::out | std::ios::app;
             break;
     }
-    // if a file was previously opened, close it first
-    if(hasOpenFile()) return RC_ERROR_BUSY;
+    // Waits for other tasks to close their file. Held until closeFile if the file is opened
+    m_fileMutex.lock();
+    if(hasOpenFile()) {
+        m_fileMutex.unlock();
+        return RC_ERROR_BUSY;
+    }
 
     fileMode = openMode;
     file.open(filename, mode);
-    if(hasOpenFile())
-        return RC_SUCCESS;
-    else
-        return RC_ERROR_OPEN;
+    if(hasOpenFile()) return RC_SUCCESS;
+    m_fileMutex.unlock();
+    return RC_ERROR_OPEN;
 }
 
-bool DesktopFilesystem::hasOpenFile() { return file.is_open(); }
+bool DesktopFilesystem::hasOpenFile() {
+    std::lock_guard<std::recursive_mutex> lock(m_fileMutex);
+    return file.is_open();
+}
 
 RC_t DesktopFilesystem::closeFile() {
-    if(hasOpenFile()) file.close();
+    std::lock_guard<std::recursive_mutex> lock(m_fileMutex);
+    if(hasOpenFile()) {
+        file.close();
+        // Taken by openFile
+        m_fileMutex.unlock();
+    }
     return RC_SUCCESS;
 }
 
 RC_t DesktopFilesystem::write(const uint8_t* data, uint32_t n) {
+    std::lock_guard<std::recursive_mutex> lock(m_fileMutex);
     if(!hasOpenFile()) return RC_ERROR_OPEN;
     file.write((const char*)data, n);
     return RC_SUCCESS;
 }
 
 RC_t DesktopFilesystem::flush() {
+    std::lock_guard<std::recursive_mutex> lock(m_fileMutex);
     if(!hasOpenFile()) return RC_ERROR_OPEN;
     file.flush();
     if(file.fail()) return RC_ERROR;
@@ -52,6 +65,7 @@ RC_t DesktopFilesystem::flush() {
 }
 
 RC_t DesktopFilesystem::read(uint8_t* data, uint32_t n) {
+    std::lock_guard<std::recursive_mutex> lock(m_fileMutex);
     if(!hasOpenFile()) return RC_ERROR_OPEN;
     file.read((char*)data, n);
     if(file.fail() && !file.eof()) return RC_ERROR_READ_FAILS;
@@ -59,26 +73,63 @@ RC_t DesktopFilesystem::read(uint8_t* data, uint32_t n) {
 }
 
 RC_t DesktopFilesystem::readUntil(uint8_t* data, uint32_t n, uint8_t end) {
+    std::lock_guard<std::recursive_mutex> lock(m_fileMutex);
     if(!hasOpenFile()) return RC_ERROR_OPEN;
     file.getline((char*)data, n, (char)end);
     if(file.fail() && !file.eof()) return RC_ERROR_READ_FAILS;
     return RC_SUCCESS;
 }
 
-bool DesktopFilesystem::eof() { return !hasOpenFile() || file.eof(); }
+RC_t DesktopFilesystem::seek(uint32_t position) {
+    std::lock_guard<std::recursive_mutex> lock(m_fileMutex);
+    if(!hasOpenFile()) return RC_ERROR_OPEN;
+    if(position > size()) return RC_ERROR_RANGE;
+    // Reset eof flag from previous reads
+    file.clear();
+    file.seekg(position, std::ios::beg);
+    if(file.fail()) return RC_ERROR;
+    return RC_SUCCESS;
+}
+
+uint32_t DesktopFilesystem::size() {
+    std::lock_guard<std::recursive_mutex> lock(m_fileMutex);
+    if(!hasOpenFile()) return 0;
+    file.clear();
+    const std::streampos current = file.tellg();
+    file.seekg(0, std::ios::end);
+    const std::streampos end = file.tellg();
+    file.seekg(current);
+    return static_cast<uint32_t>(end);
+}
+
+bool DesktopFilesystem::eof() {
+    std::lock_guard<std::recursive_mutex> lock(m_fileMutex);
+    return !hasOpenFile() || file.eof();
+}
 
 bool DesktopFilesystem::fileExists(const char filename[]) {
+    std::lock_guard<std::recursive_mutex> lock(m_fileMutex);
     std::ifstream f;
     f.open(filename);
     if(f.fail()) return false;
 
-    file.close();
+    f.close();
     return true;
 }
 
 RC_t DesktopFilesystem::deleteFile(const char filename[]) {
+    std::lock_guard<std::recursive_mutex> lock(m_fileMutex);
     if(0 == remove(filename))
         return RC_SUCCESS;
     else
         return RC_ERROR;
-}
\ No newline at end of file
+}
+
+RC_t DesktopFilesystem::renameFile(const char from[], const char to[]) {
+    std::lock_guard<std::recursive_mutex> lock(m_fileMutex);
+    if(hasOpenFile()) return RC_ERROR_BUSY;
+    if(0 == rename(from, to))
+        return RC_SUCCESS;
+    else
+        return RC_ERROR;
+}
@@ -1,5 +1,7 @@
 #ifndef FILESYSTEM_H
 #define FILESYSTEM_H
+#include <mutex>
+
 #include "global.h"
 #ifdef ARDUINO
     #include <Arduino.h>
@@ -9,6 +11,13 @@
 
 void filesystemSetup();
 
+/**
+ * @brief File access shared by all tasks. Only one file can be open at a time.
+ *
+ * A task which opens a file owns the file handle until it calls closeFile. Other tasks block in
+ * openFile and in all other functions until then, so that they can neither write into nor close
+ * the file of another task. The webserver task for example waits in openFile while the sample log is flushed.
+ */
 class Filesystem {
    public:
     typedef enum { READ_ONLY, WRITE_TRUNCATE, WRITE_APPEND } OpenMode_t;
@@ -18,18 +27,20 @@ class Filesystem {
     Filesystem() = default;
 
     /**
-     * @brief Opens a file with the given filename
+     * @brief Opens a file with the given filename. Waits while another task has a file open.
+     * On success the file has to be closed with closeFile by the same task
      *
      * @param filename [IN] Name of the file to open
      * @param openMode [IN] Mode in which to open file. Defaults to READ_ONLY.
      * @return RC_t RC_SUCCESS on success,
      *          RC_ERROR_OPEN if the file couldn't be opened
-     *          RC_ERROR_BUSY if a file is already open
+     *          RC_ERROR_BUSY if the calling task already has a file open
      */
     virtual RC_t openFile(const char filename[], OpenMode_t openMode = READ_ONLY) = 0;
 
     /**
-     * @brief Returns whether the filesystem currently has a file that is open
+     * @brief Returns whether the calling task has a file open.
+     * Waits while another task has a file open, after which it is closed again
      *
      * @return true
      * @return false
@@ -88,6 +99,23 @@ class Filesystem {
      */
     virtual RC_t readUntil(uint8_t* data, uint32_t n, uint8_t end) = 0;
 
+    /**
+     * @brief Moves the read position of the open file
+     *
+     * @param position [IN] New read position in bytes from the start of the file
+     * @return RC_t RC_SUCCESS on success,
+     *          RC_ERROR_OPEN if no file is open,
+     *          RC_ERROR_RANGE if the position is behind the end of the file
+     */
+    virtual RC_t seek(uint32_t position) = 0;
+
+    /**
+     * @brief Returns the size of the open file in bytes
+     *
+     * @return uint32_t Size or 0 if no file is open
+     */
+    virtual uint32_t size() = 0;
+
     /**
      * @brief Returns true if the end of file has been reached
      * or no file is open
@@ -114,6 +142,18 @@ class Filesystem {
      */
     virtual RC_t deleteFile(const char filename[]) = 0;
 
+    /**
+     * @brief Renames a file. An existing file with the new name is replaced in the same step.
+     * The file must not be open.
+     *
+     * @param from [IN] Current name of the file
+     * @param to [IN] New name of the file
+     * @return RC_t RC_SUCCESS on success,
+     *          RC_ERROR_BUSY if a file is open,
+     *          RC_ERROR if the file could not be renamed
+     */
+    virtual RC_t renameFile(const char from[], const char to[]) = 0;
+
     /**
      * @brief Returns whether the filesystem was successfully initialized
      *
@@ -128,6 +168,12 @@ class Filesystem {
      * filesystem was successfully initialized.
      */
     bool successfullyMounted = false;
+
+    /**
+     * @brief Locked by every function. Additionally held from a successful openFile until closeFile.
+     * Recursive, so that the task owning the open file can still call all other functions
+     */
+    std::recursive_mutex m_fileMutex;
 };
 
 #endif  // FILESYSTEM_H
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include "LineReader.h"
+
+#include <string.h>
+
+LineReader::LineReader(Filesystem& fs, char buffer[], uint32_t size) : m_fs(fs), m_buffer(buffer), m_size(size) {
+    m_remaining = fs.size();
+}
+
+RC_t LineReader::fill() {
+    memmove(m_buffer, m_buffer + m_pos, m_length - m_pos);
+    m_length -= m_pos;
+    m_pos = 0;
+
+    uint32_t n = m_size - m_length;
+    if(n > m_remaining) n = m_remaining;
+    const RC_t err = m_fs.read(reinterpret_cast<uint8_t*>(m_buffer + m_length), n);
+    if(RC_SUCCESS != err) return err;
+    m_length += n;
+    m_remaining -= n;
+    return RC_SUCCESS;
+}
+
+RC_t LineReader::next(StringView& line) {
+    while(true) {
+        char* start = m_buffer + m_pos;
+        const uint32_t available = m_length - m_pos;
+        char* end = static_cast<char*>(memchr(start, '\n', available));
+        if(end == nullptr && m_remaining == 0) {
+            // Unterminated last line
+            if(available == 0) return RC_ERROR_BUFFER_EMPTY;
+            end = start + available;
+        }
+
+        if(end != nullptr) {
+            m_pos += (end - start) + ((end < start + available) ? 1 : 0);
+            if(m_skipping) {
+                m_skipping = false;
+                continue;
+            }
+            uint32_t length = end - start;
+            if(length > 0 && start[length - 1] == '\r') length--;
+            line = StringView(start, length);
+            return RC_SUCCESS;
+        }
+
+        if(m_pos == 0 && m_length == m_size) {
+            // The line can never be completed in the buffer. Drop it up to its end
+            m_pos = m_length;
+            if(!m_skipping) {
+                m_skipping = true;
+                return RC_ERROR_OVERRUN;
+            }
+        }
+        const RC_t err = fill();
+        if(RC_SUCCESS != err) return err;
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef LINE_READER_H
+#define LINE_READER_H
+#include "Filesystem.h"
+#include "config/ConfigTokenizer.h"
+#include "global.h"
+
+/**
+ * @brief Reads the open file of a Filesystem line by line through a fixed buffer.
+ *
+ * The buffer is refilled in as large chunks as possible. Unconsumed bytes are kept at its front,
+ * so lines which straddle two chunks are returned in one piece. Every byte of the file is
+ * read and looked at once.
+ */
+class LineReader {
+   public:
+    /**
+     * @brief Constructor. The file has to be opened for reading beforehand and must stay open
+     * while lines are read. It is read from its current position to its end.
+     *
+     * @param fs [IN] Filesystem with an open file
+     * @param buffer [IN] Buffer for the file contents, also limits the line length
+     * @param size [IN] Size of buffer in bytes
+     */
+    LineReader(Filesystem& fs, char buffer[], uint32_t size);
+
+    /**
+     * @brief Returns the next line without line ending. Both \n and \r\n are accepted.
+     * The line refers to the buffer and is valid until the next call.
+     *
+     * @param line [OUT]
+     * @return RC_t RC_SUCCESS on success,
+     *  RC_ERROR_BUFFER_EMPTY if the end of the file was reached,
+     *  RC_ERROR_OVERRUN if the line does not fit in the buffer. It is skipped and the next call
+     *  continues with the following line,
+     *  errors of Filesystem::read
+     */
+    RC_t next(StringView& line);
+
+   private:
+    /**
+     * @brief Moves the unconsumed bytes to the front of the buffer and fills up the rest from the file
+     *
+     * @return RC_t RC_SUCCESS on success, errors of Filesystem::read
+     */
+    RC_t fill();
+
+    Filesystem& m_fs;
+    char* const m_buffer;
+    const uint32_t m_size;
+    uint32_t m_length = 0;
+    uint32_t m_pos = 0;
+    /**
+     * @brief Bytes of the file which were not read into the buffer yet
+     */
+    uint32_t m_remaining = 0;
+    /**
+     * @brief Set while the rest of an overlong line is dropped
+     */
+    bool m_skipping = false;
+};
+
+#endif  // LINE_READER_H
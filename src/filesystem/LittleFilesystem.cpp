@@ -24,19 +24,22 @@ RC_t LittleFilesystem::openFile(const char filename[], OpenMode_t openMode) {
             strcpy(mode, "a+");
             break;
     }
-    // if a file was previously opened, close it first
-    if(hasOpenFile()) return RC_ERROR_BUSY;
+    // Waits for other tasks to close their file. Held until closeFile if the file is opened
+    m_fileMutex.lock();
+    if(hasOpenFile()) {
+        m_fileMutex.unlock();
+        return RC_ERROR_BUSY;
+    }
 
     fileMode = openMode;
-    if(openMode == READ_ONLY && !LittleFS.exists(filename)) return RC_ERROR_OPEN;
-    file = LittleFS.open(filename, mode);
-    if(hasOpenFile())
-        return RC_SUCCESS;
-    else
-        return RC_ERROR_OPEN;
+    if(openMode != READ_ONLY || LittleFS.exists(filename)) file = LittleFS.open(filename, mode);
+    if(hasOpenFile()) return RC_SUCCESS;
+    m_fileMutex.unlock();
+    return RC_ERROR_OPEN;
 }
 
 bool LittleFilesystem::hasOpenFile() {
+    std::lock_guard<std::recursive_mutex> lock(m_fileMutex);
     if(!file || file.isDirectory())
         return false;
     else
@@ -44,42 +47,81 @@ bool LittleFilesystem::hasOpenFile() {
 }
 
 RC_t LittleFilesystem::closeFile() {
-    if(hasOpenFile()) file.close();
+    std::lock_guard<std::recursive_mutex> lock(m_fileMutex);
+    if(hasOpenFile()) {
+        file.close();
+        // Taken by openFile
+        m_fileMutex.unlock();
+    }
     return RC_SUCCESS;
 }
 
 RC_t LittleFilesystem::write(const uint8_t* data, uint32_t n) {
+    std::lock_guard<std::recursive_mutex> lock(m_fileMutex);
     if(!hasOpenFile()) return RC_ERROR_OPEN;
     file.write(data, n);
     return RC_SUCCESS;
 }
 
 RC_t LittleFilesystem::flush() {
+    std::lock_guard<std::recursive_mutex> lock(m_fileMutex);
     if(!hasOpenFile()) return RC_ERROR_OPEN;
     file.flush();
     return RC_SUCCESS;
 }
 
 RC_t LittleFilesystem::read(uint8_t* data, uint32_t n) {
+    std::lock_guard<std::recursive_mutex> lock(m_fileMutex);
     if(!hasOpenFile()) return RC_ERROR_OPEN;
     file.read(data, n);
     return RC_SUCCESS;
 }
 
 RC_t LittleFilesystem::readUntil(uint8_t* data, uint32_t n, uint8_t end) {
+    std::lock_guard<std::recursive_mutex> lock(m_fileMutex);
     if(!hasOpenFile()) return RC_ERROR_OPEN;
     file.readBytesUntil((char)end, data, n);
     return RC_SUCCESS;
 }
 
-bool LittleFilesystem::eof() { return !file.available(); }
+RC_t LittleFilesystem::seek(uint32_t position) {
+    std::lock_guard<std::recursive_mutex> lock(m_fileMutex);
+    if(!hasOpenFile()) return RC_ERROR_OPEN;
+    if(position > file.size()) return RC_ERROR_RANGE;
+    if(!file.seek(position)) return RC_ERROR;
+    return RC_SUCCESS;
+}
+
+uint32_t LittleFilesystem::size() {
+    std::lock_guard<std::recursive_mutex> lock(m_fileMutex);
+    if(!hasOpenFile()) return 0;
+    return file.size();
+}
+
+bool LittleFilesystem::eof() {
+    std::lock_guard<std::recursive_mutex> lock(m_fileMutex);
+    return !file.available();
+}
 
-bool LittleFilesystem::fileExists(const char filename[]) { return LittleFS.exists(filename); }
+bool LittleFilesystem::fileExists(const char filename[]) {
+    std::lock_guard<std::recursive_mutex> lock(m_fileMutex);
+    return LittleFS.exists(filename);
+}
 
 RC_t LittleFilesystem::deleteFile(const char filename[]) {
+    std::lock_guard<std::recursive_mutex> lock(m_fileMutex);
     if(hasOpenFile()) closeFile();
     if(1 == LittleFS.remove(filename))
         return RC_SUCCESS;
     else
         return RC_ERROR;
-}
\ No newline at end of file
+}
+
+RC_t LittleFilesystem::renameFile(const char from[], const char to[]) {
+    std::lock_guard<std::recursive_mutex> lock(m_fileMutex);
+    if(hasOpenFile()) return RC_ERROR_BUSY;
+    if(LittleFS.rename(from, to))
+        return RC_SUCCESS;
+    else
+        return RC_ERROR;
+}
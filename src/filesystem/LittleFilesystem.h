@@ -81,6 +81,23 @@ class LittleFilesystem : public Filesystem {
      */
     RC_t readUntil(uint8_t* data, uint32_t n, uint8_t end);
 
+    /**
+     * @brief Moves the read position of the open file
+     *
+     * @param position [IN] New read position in bytes from the start of the file
+     * @return RC_t RC_SUCCESS on success,
+     *          RC_ERROR_OPEN if no file is open,
+     *          RC_ERROR_RANGE if the position is behind the end of the file
+     */
+    RC_t seek(uint32_t position);
+
+    /**
+     * @brief Returns the size of the open file in bytes
+     *
+     * @return uint32_t Size or 0 if no file is open
+     */
+    uint32_t size();
+
     /**
      * @brief Returns true if the end of file has been reached
      * or no file is open
@@ -107,6 +124,18 @@ class LittleFilesystem : public Filesystem {
      */
     RC_t deleteFile(const char filename[]);
 
+    /**
+     * @brief Renames a file. An existing file with the new name is replaced in the same step.
+     * The file must not be open.
+     *
+     * @param from [IN] Current name of the file
+     * @param to [IN] New name of the file
+     * @return RC_t RC_SUCCESS on success,
+     *          RC_ERROR_BUSY if a file is open,
+     *          RC_ERROR if the file could not be renamed
+     */
+    RC_t renameFile(const char from[], const char to[]);
+
    private:
     /**
      * @brief Keeps track of in which mode the file was opened
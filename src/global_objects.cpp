@@ -2,9 +2,17 @@
 
 #include "cfg.h"
 #ifdef ARDUINO
+    #include "adc/ContinuousAdcSource.h"
     #include "filesystem/LittleFilesystem.h"
+    #include "gpio/ArduinoGpio.h"
+    #include "i2c/ArduinoI2cBus.h"
+    #include "storage/PreferencesKeyValueStore.h"
 #else
+    #include "adc/FakeSampleSource.h"
     #include "filesystem/DesktopFilesystem.h"
+    #include "gpio/SimulatedGpio.h"
+    #include "i2c/SimulatedI2cBus.h"
+    #include "storage/SimulatedKeyValueStore.h"
 #endif  // ARDUINO
 
 // global RamLogger object
@@ -20,12 +28,57 @@ DesktopFilesystem dfs;
 Filesystem* const filesystem = &dfs;
 #endif  // ARDUINO
 
-// Vector containing pointers to sensors
-std::vector<Sensor*> sensors;
+#ifdef ARDUINO
+ArduinoGpio agpio;
+// Pointer to gpio object
+Gpio* const gpio = &agpio;
+#else
+SimulatedGpio sgpio;
+// Pointer to gpio object
+Gpio* const gpio = &sgpio;
+#endif  // ARDUINO
+
+#ifdef ARDUINO
+ContinuousAdcSource adcSource;
+#else
+FakeSampleSource adcSource;
+#endif  // ARDUINO
+// Distributes continuous ADC conversions to the ADCSensors in continuous mode
+AdcAcquisition adcAcquisition(adcSource);
+
+#ifdef ARDUINO
+ArduinoI2cBus i2cBus(Wire);
+#else
+SimulatedI2cBus i2cBus;
+#endif  // ARDUINO
+// Arbitrates the access to the I2C bus and measures the I2C sensors
+I2cBusManager i2cBusManager(i2cBus);
+
+// Values which the MQTT task publishes ahead of the routine telemetry
+UrgentEventQueue urgentEvents;
+
+// Currently active sensor set. Only accessed through std::atomic_load and std::atomic_store
+static std::shared_ptr<const SensorRegistry> activeSensors = std::make_shared<SensorRegistry>();
+// Set by the webserver after a new sensor config file was written
+std::atomic<bool> sensorConfigReloadRequested(false);
+// Set by the webserver when a restart is requested
+std::atomic<bool> restartRequested(false);
 
 // Global settings object
 settings_t settings;
 // Preferences object is used to store information
 // that should not get exposed directly in a file
 // like passwords
-Preferences preferences;
\ No newline at end of file
+Preferences preferences;
+
+#ifdef ARDUINO
+PreferencesKeyValueStore nvs(preferences);
+#else
+SimulatedKeyValueStore nvs;
+#endif  // ARDUINO
+// Writes changed settings to the settings file and the passwords to the preferences
+SettingsStore settingsStore(*filesystem, nvs, CONFIG_FILENAME, settings);
+
+std::shared_ptr<const SensorRegistry> getSensors() { return std::atomic_load(&activeSensors); }
+
+void setSensors(std::shared_ptr<const SensorRegistry> registry) { std::atomic_store(&activeSensors, registry); }
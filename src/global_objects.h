@@ -2,18 +2,48 @@
 #define GLOBAL_OBJECTS_H
 #include <Preferences.h>
 
+#include <atomic>
+#include <memory>
 #include <vector>
 
 #include "RamLogger.h"
+#include "adc/AdcAcquisition.h"
 #include "filesystem/Filesystem.h"
 #include "global.h"
-#include "sensors/Sensor.h"
+#include "gpio/Gpio.h"
+#include "i2c/I2cBusManager.h"
+#include "sensors/SensorRegistry.h"
+#include "sensors/UrgentEventQueue.h"
 #include "settings.h"
+#include "storage/SettingsStore.h"
 
 extern RamLogger<RAMLOGGER_MAX_MESSAGE_COUNT, RAMLOGGER_MAX_STRING_LENGTH, RAMLOGGER_MAX_TIMESTAMP_STR_LEN> ramLogger;
 extern Filesystem* const filesystem;
-extern std::vector<Sensor*> sensors;
+extern Gpio* const gpio;
+extern AdcAcquisition adcAcquisition;
+extern I2cBusManager i2cBusManager;
+extern UrgentEventQueue urgentEvents;
+extern std::atomic<bool> sensorConfigReloadRequested;
+extern std::atomic<bool> restartRequested;
 extern settings_t settings;
 extern Preferences preferences;
+extern SettingsStore settingsStore;
+
+/**
+ * @brief Returns the currently active set of sensors. The returned pointer keeps the set
+ * and its sensors alive, so it has to be stored in a local variable while iterating.
+ * Safe to call from any task.
+ *
+ * @return std::shared_ptr<const SensorRegistry> Never a nullptr
+ */
+std::shared_ptr<const SensorRegistry> getSensors();
+
+/**
+ * @brief Replaces the active set of sensors in a single atomic step. Readers which are still
+ * holding the previous set keep using it until they release it.
+ *
+ * @param registry [IN] Fully built registry, must not be modified afterwards
+ */
+void setSensors(std::shared_ptr<const SensorRegistry> registry);
 
 #endif  // GLOBAL_OBJECTS_H
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include "ArduinoGpio.h"
+
+RC_t ArduinoGpio::configureInput(uint32_t pin, Pull_t pull) {
+    if(pin >= GPIO_MAX_PINS) return RC_ERROR_RANGE;
+    switch(pull) {
+        case PULL_UP:
+            pinMode(pin, INPUT_PULLUP);
+            break;
+        case PULL_DOWN:
+            pinMode(pin, INPUT_PULLDOWN);
+            break;
+        default:
+            pinMode(pin, INPUT);
+            break;
+    }
+    return RC_SUCCESS;
+}
+
+bool ArduinoGpio::read(uint32_t pin) {
+    if(pin >= GPIO_MAX_PINS) return false;
+    return digitalRead(pin) == HIGH;
+}
+
+RC_t ArduinoGpio::attachEdgeCallback(uint32_t pin, EdgeCallback_t callback, void* arg) {
+    if(pin >= GPIO_MAX_PINS) return RC_ERROR_RANGE;
+    if(callback == nullptr) return RC_ERROR_NULL;
+    if(m_handlers[pin].callback != nullptr) return RC_ERROR_BUSY;
+    m_handlers[pin].callback = callback;
+    m_handlers[pin].arg = arg;
+    m_handlers[pin].pin = pin;
+    attachInterruptArg(digitalPinToInterrupt(pin), onInterrupt, &m_handlers[pin], CHANGE);
+    return RC_SUCCESS;
+}
+
+RC_t ArduinoGpio::detachEdgeCallback(uint32_t pin) {
+    if(pin >= GPIO_MAX_PINS) return RC_ERROR_RANGE;
+    if(m_handlers[pin].callback == nullptr) return RC_SUCCESS;
+    detachInterrupt(digitalPinToInterrupt(pin));
+    m_handlers[pin].callback = nullptr;
+    m_handlers[pin].arg = nullptr;
+    return RC_SUCCESS;
+}
+
+uint32_t ArduinoGpio::getTimeUs() { return micros(); }
+
+void IRAM_ATTR ArduinoGpio::onInterrupt(void* handler) {
+    const Handler_t* h = static_cast<const Handler_t*>(handler);
+    // Read as early as possible so that the timestamp is close to the edge
+    const uint32_t timestampUs = micros();
+    const bool level = digitalRead(h->pin) == HIGH;
+    h->callback(h->arg, level, timestampUs);
+}
@@ -0,0 +1,40 @@
+#ifndef ARDUINO_GPIO_H
+#define ARDUINO_GPIO_H
+#include "Gpio.h"
+
+/**
+ * @brief Gpio implementation using the Arduino pin and interrupt functions
+ */
+class ArduinoGpio : public Gpio {
+   public:
+    ArduinoGpio() = default;
+
+    RC_t configureInput(uint32_t pin, Pull_t pull) override;
+
+    bool read(uint32_t pin) override;
+
+    RC_t attachEdgeCallback(uint32_t pin, EdgeCallback_t callback, void* arg) override;
+
+    RC_t detachEdgeCallback(uint32_t pin) override;
+
+    uint32_t getTimeUs() override;
+
+   private:
+    typedef struct {
+        EdgeCallback_t callback;
+        void* arg;
+        uint32_t pin;
+    } Handler_t;
+
+    /**
+     * @brief Interrupt service routine attached to every pin with a callback.
+     * Reads the level and time and forwards them to the callback.
+     *
+     * @param handler [IN] Pointer to the Handler_t of the pin
+     */
+    static void onInterrupt(void* handler);
+
+    Handler_t m_handlers[GPIO_MAX_PINS] = {};
+};
+
+#endif  // ARDUINO_GPIO_H
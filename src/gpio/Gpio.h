@@ -0,0 +1,87 @@
+#ifndef GPIO_H
+#define GPIO_H
+#include "global.h"
+#ifdef ARDUINO
+    #include <Arduino.h>
+#else
+    #include <cstdint>
+    // Only needed to place interrupt handlers in RAM on the controller
+    #define IRAM_ATTR
+#endif  // ARDUINO
+
+/**
+ * @brief Highest GPIO pin number plus one which can be used with a Gpio implementation
+ */
+#define GPIO_MAX_PINS (48)
+
+/**
+ * @brief Hardware abstraction for digital inputs with edge interrupts.
+ * Allows sensors which react to edges to be tested on native by injecting
+ * edge sequences instead of toggling real pins.
+ */
+class Gpio {
+   public:
+    typedef enum { PULL_NONE, PULL_UP, PULL_DOWN } Pull_t;
+
+    /**
+     * @brief Function called on every edge of a pin. Runs in interrupt context on the
+     * controller, so it must be short and must not block or allocate.
+     *
+     * @param arg [IN] Argument given when attaching the callback
+     * @param level [IN] Level of the pin right after the edge
+     * @param timestampUs [IN] Time of the edge in microseconds. Wraps around after about 71 minutes
+     */
+    typedef void (*EdgeCallback_t)(void* arg, bool level, uint32_t timestampUs);
+
+    Gpio() = default;
+    virtual ~Gpio() = default;
+
+    /**
+     * @brief Configures a pin as digital input
+     *
+     * @param pin [IN] GPIO pin number
+     * @param pull [IN] Internal pull resistor to enable
+     * @return RC_t RC_SUCCESS on success, RC_ERROR_RANGE if the pin number is invalid
+     */
+    virtual RC_t configureInput(uint32_t pin, Pull_t pull) = 0;
+
+    /**
+     * @brief Returns the current level of a pin
+     *
+     * @param pin [IN] GPIO pin number
+     * @return true if the pin is high
+     * @return false if the pin is low or invalid
+     */
+    virtual bool read(uint32_t pin) = 0;
+
+    /**
+     * @brief Attaches a callback which is called on every rising and falling edge of a pin.
+     * Only one callback can be attached per pin.
+     *
+     * @param pin [IN] GPIO pin number
+     * @param callback [IN] Function to call on an edge
+     * @param arg [IN] Argument passed to the callback
+     * @return RC_t RC_SUCCESS on success,
+     *  RC_ERROR_RANGE if the pin number is invalid,
+     *  RC_ERROR_NULL if callback is a nullptr,
+     *  RC_ERROR_BUSY if another callback is attached to the pin
+     */
+    virtual RC_t attachEdgeCallback(uint32_t pin, EdgeCallback_t callback, void* arg) = 0;
+
+    /**
+     * @brief Detaches the callback of a pin
+     *
+     * @param pin [IN] GPIO pin number
+     * @return RC_t RC_SUCCESS on success, RC_ERROR_RANGE if the pin number is invalid
+     */
+    virtual RC_t detachEdgeCallback(uint32_t pin) = 0;
+
+    /**
+     * @brief Returns the time base used for edge timestamps
+     *
+     * @return uint32_t Time in microseconds
+     */
+    virtual uint32_t getTimeUs() = 0;
+};
+
+#endif  // GPIO_H
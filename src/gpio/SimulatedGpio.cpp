@@ -0,0 +1,42 @@
+#include "SimulatedGpio.h"
+
+RC_t SimulatedGpio::configureInput(uint32_t pin, Pull_t pull) {
+    if(pin >= GPIO_MAX_PINS) return RC_ERROR_RANGE;
+    // An input without external driver floats to the level of its pull resistor
+    m_levels[pin] = (pull == PULL_UP);
+    return RC_SUCCESS;
+}
+
+bool SimulatedGpio::read(uint32_t pin) {
+    if(pin >= GPIO_MAX_PINS) return false;
+    return m_levels[pin];
+}
+
+RC_t SimulatedGpio::attachEdgeCallback(uint32_t pin, EdgeCallback_t callback, void* arg) {
+    if(pin >= GPIO_MAX_PINS) return RC_ERROR_RANGE;
+    if(callback == nullptr) return RC_ERROR_NULL;
+    if(m_handlers[pin].callback != nullptr) return RC_ERROR_BUSY;
+    m_handlers[pin].callback = callback;
+    m_handlers[pin].arg = arg;
+    return RC_SUCCESS;
+}
+
+RC_t SimulatedGpio::detachEdgeCallback(uint32_t pin) {
+    if(pin >= GPIO_MAX_PINS) return RC_ERROR_RANGE;
+    m_handlers[pin].callback = nullptr;
+    m_handlers[pin].arg = nullptr;
+    return RC_SUCCESS;
+}
+
+RC_t SimulatedGpio::setLevel(uint32_t pin, bool level) {
+    if(pin >= GPIO_MAX_PINS) return RC_ERROR_RANGE;
+    if(m_levels[pin] == level) return RC_SUCCESS;
+    m_levels[pin] = level;
+    if(m_handlers[pin].callback != nullptr) m_handlers[pin].callback(m_handlers[pin].arg, level, m_timeUs);
+    return RC_SUCCESS;
+}
+
+RC_t SimulatedGpio::injectEdge(uint32_t pin, bool level, uint32_t timestampUs) {
+    m_timeUs = timestampUs;
+    return setLevel(pin, level);
+}
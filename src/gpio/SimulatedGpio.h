@@ -0,0 +1,69 @@
+#ifndef SIMULATED_GPIO_H
+#define SIMULATED_GPIO_H
+#include "Gpio.h"
+
+/**
+ * @brief Gpio implementation without hardware. Pin levels and time are set by the
+ * caller and edge callbacks are called synchronously, which makes edge sequences
+ * reproducible in tests.
+ */
+class SimulatedGpio : public Gpio {
+   public:
+    SimulatedGpio() = default;
+
+    RC_t configureInput(uint32_t pin, Pull_t pull) override;
+
+    bool read(uint32_t pin) override;
+
+    RC_t attachEdgeCallback(uint32_t pin, EdgeCallback_t callback, void* arg) override;
+
+    RC_t detachEdgeCallback(uint32_t pin) override;
+
+    inline uint32_t getTimeUs() override { return m_timeUs; }
+
+    /**
+     * @brief Sets the simulated time
+     *
+     * @param timeUs [IN] Time in microseconds
+     */
+    inline void setTimeUs(uint32_t timeUs) { m_timeUs = timeUs; }
+
+    /**
+     * @brief Advances the simulated time
+     *
+     * @param us [IN] Microseconds to advance
+     */
+    inline void advanceTimeUs(uint32_t us) { m_timeUs += us; }
+
+    /**
+     * @brief Sets the level of a pin at the current time. Calls the attached callback
+     * if the level changed.
+     *
+     * @param pin [IN] GPIO pin number
+     * @param level [IN] New level
+     * @return RC_t RC_SUCCESS on success, RC_ERROR_RANGE if the pin number is invalid
+     */
+    RC_t setLevel(uint32_t pin, bool level);
+
+    /**
+     * @brief Advances the time to the given timestamp and then sets the level of a pin
+     *
+     * @param pin [IN] GPIO pin number
+     * @param level [IN] New level
+     * @param timestampUs [IN] Time of the edge in microseconds
+     * @return RC_t RC_SUCCESS on success, RC_ERROR_RANGE if the pin number is invalid
+     */
+    RC_t injectEdge(uint32_t pin, bool level, uint32_t timestampUs);
+
+   private:
+    typedef struct {
+        EdgeCallback_t callback;
+        void* arg;
+    } Handler_t;
+
+    bool m_levels[GPIO_MAX_PINS] = {};
+    Handler_t m_handlers[GPIO_MAX_PINS] = {};
+    uint32_t m_timeUs = 0;
+};
+
+#endif  // SIMULATED_GPIO_H
@@ -3,10 +3,116 @@
 #include <math.h>
 
 #include <algorithm>
+#include <cctype>
+#include <cstdio>
 #include <cstring>
+#ifndef ARDUINO
+    #include <chrono>
+#endif  // ARDUINO
 
 bool areEqualRel(float a, float b, float epsilon) { return (fabs(a - b) <= epsilon * std::max(fabs(a), fabs(b))); }
 
+uint32_t getUptimeMs() {
+#ifdef ARDUINO
+    return millis();
+#else
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+#endif  // ARDUINO
+}
+
+uint32_t getUptimeUs() {
+#ifdef ARDUINO
+    return micros();
+#else
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+#endif  // ARDUINO
+}
+
+RC_t formatFloat(char str[], uint32_t size, float_t value, uint8_t decimals, uint32_t* length) {
+    static const uint32_t powersOf10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+    if(decimals > FLOAT_FORMAT_MAX_DECIMALS) return RC_ERROR_BAD_PARAM;
+    if(size > 0) str[0] = '\0';
+
+    // Sign, up to 20 integer digits, decimal point and decimals
+    char text[32];
+    char* end = text + sizeof(text);
+    char* p = end;
+    const bool negative = signbit(value);
+    // The float converted to double times a power of 10 up to 10^9 is exact, as the 24 bit mantissa
+    // times 5^9 needs at most 45 bits. Rounding the product therefore rounds the exact value
+    const double scaled = fabs(static_cast<double>(value)) * powersOf10[decimals];
+    if(isnan(value)) {
+        p -= 3;
+        memcpy(p, "nan", 3);
+    } else if(isinf(value)) {
+        p -= 3;
+        memcpy(p, "inf", 3);
+    } else if(scaled >= 18446744073709551616.0) {
+        // Outside of uint64_t. Rare enough for the slow path
+        const int32_t n = snprintf(str, size, "%.*f", decimals, static_cast<double>(value));
+        if(n < 0 || static_cast<uint32_t>(n) >= size) {
+            if(size > 0) str[0] = '\0';
+            return RC_ERROR_BUFFER_FULL;
+        }
+        if(length != nullptr) *length = n;
+        return RC_SUCCESS;
+    } else {
+        const double floored = floor(scaled);
+        uint64_t digits = static_cast<uint64_t>(floored);
+        const double remainder = scaled - floored;
+        if(remainder > 0.5 || (remainder == 0.5 && (digits & 1) != 0)) digits++;
+
+        // The fraction fits into 32 bits, so only the integer part needs 64 bit divisions
+        uint32_t fraction = digits % powersOf10[decimals];
+        uint64_t integer = digits / powersOf10[decimals];
+        for(uint8_t i = 0; i < decimals; i++) {
+            *--p = '0' + fraction % 10;
+            fraction /= 10;
+        }
+        if(decimals > 0) *--p = '.';
+        while(integer > UINT32_MAX) {
+            *--p = '0' + integer % 10;
+            integer /= 10;
+        }
+        uint32_t integer32 = static_cast<uint32_t>(integer);
+        do {
+            *--p = '0' + integer32 % 10;
+            integer32 /= 10;
+        } while(integer32 > 0);
+    }
+    if(negative) *--p = '-';
+
+    const uint32_t n = end - p;
+    if(n >= size) return RC_ERROR_BUFFER_FULL;
+    memcpy(str, p, n);
+    str[n] = '\0';
+    if(length != nullptr) *length = n;
+    return RC_SUCCESS;
+}
+
+uint32_t hashString(const char str[]) { return hashBytes(reinterpret_cast<const uint8_t*>(str), strlen(str)); }
+
+uint32_t hashBytes(const uint8_t* data, uint32_t n, uint32_t hash) {
+    for(uint32_t i = 0; i < n; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+uint32_t hashIgnoringWhitespace(const char str[], uint32_t hash) {
+    for(uint32_t i = 0; str[i] != '\0'; i++) {
+        if(isspace(static_cast<unsigned char>(str[i]))) continue;
+        hash ^= static_cast<uint8_t>(str[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
 RC_t trimLeadingWhitespace(char str[]) {
     // Count leading spaces, tabs and linebreak characters
     uint32_t leadingWhitespaceChars = 0;
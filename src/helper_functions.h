@@ -14,6 +14,81 @@
  */
 bool areEqualRel(float a, float b, float epsilon);
 
+/**
+ * @brief Returns the time since startup in milliseconds.
+ * Uses millis() on the microcontroller and a monotonic clock on the desktop.
+ *
+ * @return uint32_t
+ */
+uint32_t getUptimeMs();
+
+/**
+ * @brief Returns the time since startup in microseconds. Wraps after about 71 minutes,
+ * so it is only suited for measuring short durations.
+ *
+ * @return uint32_t
+ */
+uint32_t getUptimeUs();
+
+/**
+ * @brief Calculates the 32 bit FNV-1a hash of a null-terminated string
+ *
+ * @param str [IN] String to hash
+ * @return uint32_t
+ */
+uint32_t hashString(const char str[]);
+
+/**
+ * @brief Calculates the 32 bit FNV-1a hash of a null-terminated string at compile time.
+ * Gives the same result as hashString.
+ *
+ * @param str [IN] String to hash
+ * @param hash [IN] Hash of the preceding characters
+ * @return constexpr uint32_t
+ */
+constexpr uint32_t constHash(const char* str, uint32_t hash = 2166136261u) {
+    return (*str == '\0') ? hash : constHash(str + 1, (hash ^ static_cast<uint8_t>(*str)) * 16777619u);
+}
+
+/**
+ * @brief Calculates the 32 bit FNV-1a hash of n bytes
+ *
+ * @param data [IN] Data to hash
+ * @param n [IN] Number of bytes
+ * @param hash [IN] Hash of preceding data when hashing in several steps.
+ *  Defaults to the FNV offset basis.
+ * @return uint32_t
+ */
+uint32_t hashBytes(const uint8_t* data, uint32_t n, uint32_t hash = 2166136261u);
+
+/**
+ * @brief Calculates the 32 bit FNV-1a hash of a null-terminated string, skipping
+ * all whitespace characters. Strings which only differ in formatting get the same hash.
+ *
+ * @param str [IN] String to hash
+ * @param hash [IN] Hash of preceding data when hashing in several steps.
+ *  Defaults to the FNV offset basis.
+ * @return uint32_t
+ */
+uint32_t hashIgnoringWhitespace(const char str[], uint32_t hash = 2166136261u);
+
+/**
+ * @brief Formats a float with a fixed number of decimals like snprintf with "%.<decimals>f",
+ * but without going through printf. Rounds half to even on the exact value of the float,
+ * like glibc. Values too large for the fast path fall back to snprintf.
+ *
+ * @param str [OUT] Buffer for the null-terminated text
+ * @param size [IN] Size of str in bytes
+ * @param value [IN] Value to format. NaN and infinity are written as "nan", "inf" and "-inf"
+ * @param decimals [IN] Number of decimals, at most FLOAT_FORMAT_MAX_DECIMALS
+ * @param length [OUT] Optional number of characters written without null terminator
+ * @return RC_t RC_SUCCESS on success,
+ *  RC_ERROR_BAD_PARAM if decimals is too large,
+ *  RC_ERROR_BUFFER_FULL if the text does not fit. str is left empty if size allows it
+ */
+RC_t formatFloat(char str[], uint32_t size, float_t value, uint8_t decimals = FLOAT_FORMAT_MAX_DECIMALS,
+                 uint32_t* length = nullptr);
+
 /**
  * Removes all comment strings from given str.
  * Comments are marked at the beginning AND end
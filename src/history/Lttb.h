@@ -0,0 +1,82 @@
+#ifndef LTTB_H
+#define LTTB_H
+#include "global.h"
+
+/**
+ * @brief Downsamples a series of points with the Largest-Triangle-Three-Buckets algorithm.
+ *
+ * The first and last point are always kept. The points in between are split into
+ * threshold - 2 buckets and from each bucket the point is chosen which forms the
+ * largest triangle with the previously chosen point and the average of the next bucket.
+ * This preserves the visual shape of the series much better than picking every nth point.
+ *
+ * Points are accessed and emitted through functors so that the input does not have to be
+ * contiguous in memory and no output buffer is required.
+ *
+ * @tparam Getter Callable with the signature Point get(uint32_t idx).
+ *  Point must provide the members timestamp and value.
+ * @tparam Emitter Callable with the signature void emit(const Point&)
+ * @param n [IN] Number of input points
+ * @param threshold [IN] Maximum number of output points. If it is smaller than 3
+ *  or at least n, all points are emitted unchanged
+ * @param get [IN] Accessor for the input points, ordered by timestamp
+ * @param emit [IN] Called for every selected point in order
+ * @return uint32_t Number of emitted points
+ */
+template <typename Getter, typename Emitter>
+uint32_t downsampleLttb(uint32_t n, uint32_t threshold, Getter get, Emitter emit) {
+    if(threshold >= n || threshold < 3) {
+        for(uint32_t i = 0; i < n; i++) emit(get(i));
+        return n;
+    }
+
+    // Bucket size of the points between the first and last one
+    const float every = static_cast<float>(n - 2) / static_cast<float>(threshold - 2);
+    uint32_t a = 0;
+    emit(get(a));
+
+    for(uint32_t i = 0; i < threshold - 2; i++) {
+        // x coordinates are taken relative to the previously chosen point
+        // to not lose precision on large uptime values
+        const auto pa = get(a);
+        const float ay = pa.value;
+
+        // Average of the next bucket, which is the third corner of the triangle
+        uint32_t avgStart = static_cast<uint32_t>((i + 1) * every) + 1;
+        uint32_t avgEnd = static_cast<uint32_t>((i + 2) * every) + 1;
+        if(avgEnd > n) avgEnd = n;
+        if(avgStart >= avgEnd) avgStart = avgEnd - 1;
+        float avgX = 0, avgY = 0;
+        for(uint32_t j = avgStart; j < avgEnd; j++) {
+            const auto p = get(j);
+            avgX += static_cast<float>(p.timestamp - pa.timestamp);
+            avgY += p.value;
+        }
+        avgX /= static_cast<float>(avgEnd - avgStart);
+        avgY /= static_cast<float>(avgEnd - avgStart);
+
+        // Pick the point of the current bucket with the largest triangle area
+        const uint32_t rangeStart = static_cast<uint32_t>(i * every) + 1;
+        const uint32_t rangeEnd = static_cast<uint32_t>((i + 1) * every) + 1;
+        float maxArea = -1;
+        uint32_t next = rangeStart;
+        for(uint32_t j = rangeStart; j < rangeEnd; j++) {
+            const auto p = get(j);
+            const float px = static_cast<float>(p.timestamp - pa.timestamp);
+            // Twice the triangle area. The factor does not matter for the comparison
+            float area = avgX * (p.value - ay) - px * (avgY - ay);
+            if(area < 0) area = -area;
+            if(area > maxArea) {
+                maxArea = area;
+                next = j;
+            }
+        }
+        emit(get(next));
+        a = next;
+    }
+
+    emit(get(n - 1));
+    return threshold;
+}
+
+#endif  // LTTB_H
@@ -0,0 +1,150 @@
+#include "SensorHistory.h"
+
+#include "Lttb.h"
+
+#define MS_PER_MINUTE (60UL * 1000UL)
+#define MS_PER_HOUR (60UL * MS_PER_MINUTE)
+
+SensorHistory::SensorHistory(uint32_t rawCapacity, uint32_t minuteCapacity, uint32_t hourCapacity)
+    : m_raw(rawCapacity),
+      m_minutes(minuteCapacity),
+      m_hours(hourCapacity),
+      m_minuteAccumulator(MS_PER_MINUTE),
+      m_hourAccumulator(MS_PER_HOUR) {}
+
+std::shared_ptr<SensorHistory> SensorHistory::createWithBudget(uint32_t budgetBytes) {
+    uint32_t hourCapacity = HISTORY_HOUR_TIER_CAPACITY;
+    if(hourCapacity * sizeof(AggregateEntry_t) > budgetBytes) hourCapacity = budgetBytes / sizeof(AggregateEntry_t);
+    const uint32_t remaining = budgetBytes - hourCapacity * sizeof(AggregateEntry_t);
+    const uint32_t rawCapacity = (remaining / 2) / sizeof(RawEntry_t);
+    const uint32_t minuteCapacity = (remaining / 2) / sizeof(AggregateEntry_t);
+    return std::make_shared<SensorHistory>(rawCapacity, minuteCapacity, hourCapacity);
+}
+
+bool SensorHistory::Accumulator::add(uint32_t timestamp, float_t value, AggregateEntry_t& finished) {
+    const uint32_t newBucket = timestamp / bucketLengthMs;
+    bool bucketFinished = false;
+    if(count > 0 && newBucket != bucket) {
+        finished.timestamp = bucket * bucketLengthMs;
+        finished.min = min;
+        finished.max = max;
+        finished.mean = sum / count;
+        bucketFinished = true;
+        count = 0;
+    }
+    if(count == 0) {
+        bucket = newBucket;
+        min = value;
+        max = value;
+        sum = 0;
+    }
+    if(value < min) min = value;
+    if(value > max) max = value;
+    sum += value;
+    count++;
+    return bucketFinished;
+}
+
+void SensorHistory::add(const SensorSample_t& sample) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_raw.push({sample.timestamp, sample.value});
+
+    AggregateEntry_t finished;
+    if(m_minuteAccumulator.add(sample.timestamp, sample.value, finished)) m_minutes.push(finished);
+    if(m_hourAccumulator.add(sample.timestamp, sample.value, finished)) m_hours.push(finished);
+}
+
+uint32_t SensorHistory::countInRange(Tier_t tier, uint32_t from, uint32_t to, uint32_t& first) const {
+    uint32_t last;
+    switch(tier) {
+        default:
+        case TIER_RAW:
+            first = m_raw.lowerBound(from);
+            last = (to == UINT32_MAX) ? m_raw.size() : m_raw.lowerBound(to + 1);
+            break;
+        case TIER_MINUTE:
+            first = m_minutes.lowerBound(from);
+            last = (to == UINT32_MAX) ? m_minutes.size() : m_minutes.lowerBound(to + 1);
+            break;
+        case TIER_HOUR:
+            first = m_hours.lowerBound(from);
+            last = (to == UINT32_MAX) ? m_hours.size() : m_hours.lowerBound(to + 1);
+            break;
+    }
+    return (last > first) ? last - first : 0;
+}
+
+HistoryPoint_t SensorHistory::getPoint(Tier_t tier, uint32_t idx) const {
+    if(tier == TIER_RAW) {
+        const RawEntry_t& e = m_raw[idx];
+        return {e.timestamp, e.value, e.value, e.value};
+    }
+    const AggregateEntry_t& e = (tier == TIER_MINUTE) ? m_minutes[idx] : m_hours[idx];
+    return {e.timestamp, e.mean, e.min, e.max};
+}
+
+uint32_t SensorHistory::query(uint32_t from, uint32_t to, uint32_t maxPoints,
+                              const std::function<void(const HistoryPoint_t&)>& callback, Tier_t& tier) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(from > to) return 0;
+
+    // Tiers which still hold data from the beginning of the range
+    bool covers[TIER_COUNT];
+    covers[TIER_RAW] = m_raw.size() > 0 && (m_raw[0].timestamp <= from || m_raw.size() < m_raw.capacity());
+    covers[TIER_MINUTE] =
+        m_minutes.size() > 0 && (m_minutes[0].timestamp <= from || m_minutes.size() < m_minutes.capacity());
+    covers[TIER_HOUR] = true;
+
+    // Start with the finest covering tier and move to coarser ones
+    // as long as they still provide enough points
+    uint32_t first = 0;
+    tier = TIER_HOUR;
+    uint32_t count = 0;
+    for(uint32_t t = TIER_RAW; t < TIER_COUNT; t++) {
+        if(!covers[t]) continue;
+        uint32_t tierFirst;
+        const uint32_t tierCount = countInRange(static_cast<Tier_t>(t), from, to, tierFirst);
+        if(count == 0 || tierCount >= maxPoints) {
+            tier = static_cast<Tier_t>(t);
+            first = tierFirst;
+            count = tierCount;
+        }
+        if(tierCount < maxPoints) break;
+    }
+
+    const Tier_t selectedTier = tier;
+    return downsampleLttb(
+        count, maxPoints, [this, selectedTier, first](uint32_t i) { return getPoint(selectedTier, first + i); },
+        callback);
+}
+
+uint32_t SensorHistory::size(Tier_t tier) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    switch(tier) {
+        case TIER_RAW:
+            return m_raw.size();
+        case TIER_MINUTE:
+            return m_minutes.size();
+        case TIER_HOUR:
+            return m_hours.size();
+        default:
+            return 0;
+    }
+}
+
+uint32_t SensorHistory::getMemoryUsage() const {
+    return m_raw.capacity() * sizeof(RawEntry_t) + (m_minutes.capacity() + m_hours.capacity()) * sizeof(AggregateEntry_t);
+}
+
+const char* SensorHistory::tierToString(Tier_t tier) {
+    switch(tier) {
+        case TIER_RAW:
+            return "raw";
+        case TIER_MINUTE:
+            return "minute";
+        case TIER_HOUR:
+            return "hour";
+        default:
+            return "unknown";
+    }
+}
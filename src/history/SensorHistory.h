@@ -0,0 +1,215 @@
+#ifndef SENSOR_HISTORY_H
+#define SENSOR_HISTORY_H
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "global.h"
+#include "sensors/SampleCache.h"
+
+/**
+ * @brief Point returned by history queries. For the full resolution tier
+ * min and max are equal to value, for aggregate tiers value is the mean.
+ */
+typedef struct {
+    uint32_t timestamp;
+    float_t value;
+    float_t min;
+    float_t max;
+} HistoryPoint_t;
+
+/**
+ * @brief Fixed capacity ring buffer which overwrites its oldest entry when full.
+ * Index 0 is the oldest entry.
+ *
+ * @tparam T Type of the stored entries
+ */
+template <typename T>
+class HistoryRing {
+   public:
+    explicit HistoryRing(uint32_t capacity) : m_buffer(capacity > 0 ? new T[capacity] : nullptr), m_capacity(capacity) {}
+    ~HistoryRing() { delete[] m_buffer; }
+    HistoryRing(const HistoryRing&) = delete;
+    HistoryRing& operator=(const HistoryRing&) = delete;
+
+    void push(const T& item) {
+        if(m_capacity == 0) return;
+        m_buffer[m_head] = item;
+        m_head = (m_head + 1) % m_capacity;
+        if(m_count < m_capacity) m_count++;
+    }
+
+    inline const T& operator[](uint32_t idx) const {
+        return m_buffer[(m_head + m_capacity - m_count + idx) % m_capacity];
+    }
+
+    inline uint32_t size() const { return m_count; }
+    inline uint32_t capacity() const { return m_capacity; }
+
+    /**
+     * @brief Returns the index of the first entry with a timestamp not lower than the given one.
+     * Requires entries to be pushed in timestamp order.
+     *
+     * @param timestamp [IN]
+     * @return uint32_t Index or size() if all entries are older
+     */
+    uint32_t lowerBound(uint32_t timestamp) const {
+        uint32_t lo = 0, hi = m_count;
+        while(lo < hi) {
+            const uint32_t mid = lo + (hi - lo) / 2;
+            if((*this)[mid].timestamp < timestamp)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+   private:
+    T* m_buffer;
+    const uint32_t m_capacity;
+    // Position at which the next entry is written
+    uint32_t m_head = 0;
+    // Number of stored entries
+    uint32_t m_count = 0;
+};
+
+/**
+ * @brief In-RAM history of a single sensor, organized in tiers of decreasing resolution.
+ *
+ * Every sample is stored at full resolution in the raw tier. In parallel, samples
+ * are aggregated into 1-minute and 1-hour buckets holding min, max and mean, which
+ * are stored in their own rings once a bucket is complete. Older data therefore
+ * survives at a lower resolution after it has been overwritten in the finer tiers.
+ *
+ * All functions are thread safe so that the polling loop can add samples while
+ * the webserver queries them.
+ */
+class SensorHistory {
+   public:
+    typedef enum { TIER_RAW = 0, TIER_MINUTE, TIER_HOUR, TIER_COUNT } Tier_t;
+
+    /**
+     * @brief Creates a history with the given number of entries per tier
+     *
+     * @param rawCapacity [IN] Number of samples stored at full resolution
+     * @param minuteCapacity [IN] Number of stored 1-minute aggregates
+     * @param hourCapacity [IN] Number of stored 1-hour aggregates
+     */
+    SensorHistory(uint32_t rawCapacity, uint32_t minuteCapacity, uint32_t hourCapacity);
+
+    /**
+     * @brief Creates a history whose buffers use at most the given number of bytes.
+     * The hour tier gets HISTORY_HOUR_TIER_CAPACITY entries, the rest of the budget is
+     * split evenly between the raw and minute tiers.
+     *
+     * @param budgetBytes [IN] Memory budget for the buffers
+     * @return std::shared_ptr<SensorHistory>
+     */
+    static std::shared_ptr<SensorHistory> createWithBudget(uint32_t budgetBytes);
+
+    /**
+     * @brief Adds a sample. Samples must be added in timestamp order.
+     *
+     * @param sample [IN]
+     */
+    void add(const SensorSample_t& sample);
+
+    /**
+     * @brief Queries the points within the given time range and downsamples them
+     * with LTTB if there are more than maxPoints.
+     *
+     * The tier is chosen as follows: Of all tiers which still hold data from the
+     * beginning of the range (or the coarsest tier if none does), the coarsest one
+     * which has at least maxPoints points in the range is used, since it has the
+     * least points to downsample. If none has enough points, the finest one is used.
+     *
+     * @param from [IN] Start of the range as uptime in ms, inclusive
+     * @param to [IN] End of the range as uptime in ms, inclusive
+     * @param maxPoints [IN] Maximum number of points to return
+     * @param callback [IN] Called for every returned point in timestamp order
+     * @param tier [OUT] Tier the points were taken from
+     * @return uint32_t Number of returned points
+     */
+    uint32_t query(uint32_t from, uint32_t to, uint32_t maxPoints,
+                   const std::function<void(const HistoryPoint_t&)>& callback, Tier_t& tier) const;
+
+    /**
+     * @brief Returns the number of entries currently stored in a tier
+     *
+     * @param tier [IN]
+     * @return uint32_t
+     */
+    uint32_t size(Tier_t tier) const;
+
+    /**
+     * @brief Returns the number of bytes used by the buffers of this history
+     *
+     * @return uint32_t
+     */
+    uint32_t getMemoryUsage() const;
+
+    /**
+     * @brief Returns the name of a tier for display purposes
+     *
+     * @param tier [IN]
+     * @return const char*
+     */
+    static const char* tierToString(Tier_t tier);
+
+   private:
+    typedef struct {
+        uint32_t timestamp;
+        float_t value;
+    } RawEntry_t;
+
+    typedef struct {
+        /**
+         * @brief Start of the bucket
+         */
+        uint32_t timestamp;
+        float_t min;
+        float_t max;
+        float_t mean;
+    } AggregateEntry_t;
+
+    /**
+     * @brief Collects the samples of the currently open bucket of an aggregate tier
+     */
+    struct Accumulator {
+        const uint32_t bucketLengthMs;
+        uint32_t bucket = 0;
+        uint32_t count = 0;
+        float_t min = 0;
+        float_t max = 0;
+        float_t sum = 0;
+
+        explicit Accumulator(uint32_t lengthMs) : bucketLengthMs(lengthMs) {}
+
+        /**
+         * @brief Adds a value. If the value belongs to a new bucket, the previous one
+         * is written to finished and true is returned.
+         */
+        bool add(uint32_t timestamp, float_t value, AggregateEntry_t& finished);
+    };
+
+    /**
+     * @brief Returns the number of entries of a tier in the given range
+     * and the index of the first one
+     */
+    uint32_t countInRange(Tier_t tier, uint32_t from, uint32_t to, uint32_t& first) const;
+
+    /**
+     * @brief Returns the entry of an tier as HistoryPoint_t
+     */
+    HistoryPoint_t getPoint(Tier_t tier, uint32_t idx) const;
+
+    HistoryRing<RawEntry_t> m_raw;
+    HistoryRing<AggregateEntry_t> m_minutes;
+    HistoryRing<AggregateEntry_t> m_hours;
+    Accumulator m_minuteAccumulator;
+    Accumulator m_hourAccumulator;
+    mutable std::mutex m_mutex;
+};
+
+#endif  // SENSOR_HISTORY_H
@@ -0,0 +1,34 @@
+#include "ArduinoI2cBus.h"
+
+#include <esp_timer.h>
+
+uint64_t ArduinoI2cBus::getTimeUs() const { return esp_timer_get_time(); }
+
+void ArduinoI2cBus::waitUs(uint32_t us) {
+    // Round up so that conversions are complete when the wait is over
+    vTaskDelay(pdMS_TO_TICKS((us + 999) / 1000) + 1);
+}
+
+RC_t ArduinoI2cBus::doWrite(uint8_t address, const uint8_t data[], uint32_t length) {
+    begin();
+    m_wire.beginTransmission(address);
+    for(uint32_t i = 0; i < length; i++) m_wire.write(data[i]);
+    return (0 == m_wire.endTransmission()) ? RC_SUCCESS : RC_ERROR_WRITE_FAILS;
+}
+
+RC_t ArduinoI2cBus::doRead(uint8_t address, uint8_t data[], uint32_t length) {
+    begin();
+    if(length > UINT8_MAX) return RC_ERROR_RANGE;
+    if(m_wire.requestFrom(address, static_cast<uint8_t>(length)) != length) return RC_ERROR_READ_FAILS;
+    for(uint32_t i = 0; i < length; i++) data[i] = m_wire.read();
+    return RC_SUCCESS;
+}
+
+void ArduinoI2cBus::begin() {
+    if(m_begun) return;
+    m_wire.begin();
+    m_wire.setClock(m_clockHz);
+    // Abort hung transactions instead of blocking the bus
+    m_wire.setTimeOut(I2C_TIMEOUT_MS);
+    m_begun = true;
+}
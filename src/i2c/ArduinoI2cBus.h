@@ -0,0 +1,41 @@
+#ifndef ARDUINO_I2C_BUS_H
+#define ARDUINO_I2C_BUS_H
+#include <Wire.h>
+
+#include "I2cBus.h"
+
+/**
+ * @brief I2cBus on a TwoWire controller of the Arduino framework.
+ * The controller is started on the first transaction.
+ */
+class ArduinoI2cBus : public I2cBus {
+   public:
+    /**
+     * @brief Constructor
+     *
+     * @param wire [IN] Controller, e.g. Wire
+     * @param clockHz [IN] Bus clock
+     */
+    explicit ArduinoI2cBus(TwoWire& wire, uint32_t clockHz = I2C_CLOCK_HZ) : m_wire(wire), m_clockHz(clockHz) {}
+
+    uint64_t getTimeUs() const override;
+
+    void waitUs(uint32_t us) override;
+
+   protected:
+    RC_t doWrite(uint8_t address, const uint8_t data[], uint32_t length) override;
+
+    RC_t doRead(uint8_t address, uint8_t data[], uint32_t length) override;
+
+   private:
+    /**
+     * @brief Starts the controller if that did not happen yet
+     */
+    void begin();
+
+    TwoWire& m_wire;
+    const uint32_t m_clockHz;
+    bool m_begun = false;
+};
+
+#endif  // ARDUINO_I2C_BUS_H
@@ -0,0 +1,22 @@
+#include "BH1750Device.h"
+
+RC_t BH1750Device::trigger(I2cBus& bus) {
+    const uint8_t cmd = BH1750_CMD_ONE_TIME_HIGH_RES;
+    const RC_t err = bus.write(getAddress(), &cmd, 1);
+    if(RC_SUCCESS != err) m_count = -1;
+    return err;
+}
+
+RC_t BH1750Device::collect(I2cBus& bus) {
+    uint8_t data[2];
+    const RC_t err = bus.read(getAddress(), data, sizeof(data));
+    m_count = (RC_SUCCESS == err) ? static_cast<int32_t>((data[0] << 8) | data[1]) : -1;
+    return err;
+}
+
+bool BH1750Device::getLux(float_t& lux) const {
+    const int32_t count = m_count;
+    if(count < 0) return false;
+    lux = static_cast<float_t>(count) / BH1750_COUNTS_PER_LUX;
+    return true;
+}
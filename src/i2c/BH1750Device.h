@@ -0,0 +1,48 @@
+#ifndef BH1750_DEVICE_H
+#define BH1750_DEVICE_H
+#include <atomic>
+
+#include "I2cDevice.h"
+
+// Commands of the BH1750 ambient light sensor
+#define BH1750_CMD_ONE_TIME_HIGH_RES (0x20)
+// Longest duration of a high resolution measurement according to the datasheet
+#define BH1750_CONVERSION_TIME_US (180000)
+// Conversion from the measured count to lux with the default measurement time
+#define BH1750_COUNTS_PER_LUX (1.2f)
+
+/**
+ * @brief BH1750 ambient light sensor measured in one time high resolution mode.
+ * Each cycle of the I2cBusManager starts one measurement, after which the device powers down.
+ */
+class BH1750Device : public I2cDevice {
+   public:
+    /**
+     * @brief Constructor
+     *
+     * @param address [IN] 0x23 if the address pin is low, 0x5c if it is high
+     */
+    explicit BH1750Device(uint8_t address) : I2cDevice(address) {}
+
+    RC_t trigger(I2cBus& bus) override;
+
+    inline uint32_t getConversionTimeUs() const override { return BH1750_CONVERSION_TIME_US; }
+
+    RC_t collect(I2cBus& bus) override;
+
+    /**
+     * @brief Returns the latest light level. Safe to call from any task.
+     *
+     * @param lux [OUT] Light level in lux
+     * @return true if the latest measurement succeeded
+     */
+    bool getLux(float_t& lux) const;
+
+   private:
+    /**
+     * @brief Raw count of the latest measurement or -1 if it failed
+     */
+    std::atomic<int32_t> m_count{-1};
+};
+
+#endif  // BH1750_DEVICE_H
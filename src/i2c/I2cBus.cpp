@@ -0,0 +1,41 @@
+#include "I2cBus.h"
+
+RC_t I2cBus::write(uint8_t address, const uint8_t data[], uint32_t length) {
+    const uint64_t start = getTimeUs();
+    const RC_t err = doWrite(address, data, length);
+    account(start, length, err);
+    return err;
+}
+
+RC_t I2cBus::read(uint8_t address, uint8_t data[], uint32_t length) {
+    const uint64_t start = getTimeUs();
+    const RC_t err = doRead(address, data, length);
+    account(start, length, err);
+    return err;
+}
+
+I2cBusMetrics_t I2cBus::getMetrics() const {
+    I2cBusMetrics_t metrics = m_metrics;
+    metrics.elapsedUs = m_metricsStarted ? getTimeUs() - m_metricsStartUs : 0;
+    return metrics;
+}
+
+void I2cBus::resetMetrics() {
+    m_metrics = {0, 0, 0, 0, 0};
+    m_metricsStartUs = getTimeUs();
+    m_metricsStarted = true;
+}
+
+void I2cBus::account(uint64_t startUs, uint32_t length, RC_t result) {
+    if(!m_metricsStarted) {
+        // Count from the first transaction on if the counters were never reset
+        m_metricsStartUs = startUs;
+        m_metricsStarted = true;
+    }
+    m_metrics.transactions++;
+    m_metrics.busyUs += getTimeUs() - startUs;
+    if(RC_SUCCESS == result)
+        m_metrics.bytes += length;
+    else
+        m_metrics.errors++;
+}
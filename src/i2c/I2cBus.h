@@ -0,0 +1,111 @@
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+#include "global.h"
+
+/**
+ * @brief Usage counters of an I2C bus
+ */
+typedef struct {
+    /**
+     * @brief Number of read and write transactions
+     */
+    uint32_t transactions;
+    /**
+     * @brief Number of failed transactions, e.g. because a device did not acknowledge
+     */
+    uint32_t errors;
+    /**
+     * @brief Number of payload bytes transferred
+     */
+    uint32_t bytes;
+    /**
+     * @brief Time in us the bus was busy with transactions
+     */
+    uint64_t busyUs;
+    /**
+     * @brief Time in us since the counters were reset
+     */
+    uint64_t elapsedUs;
+} I2cBusMetrics_t;
+
+/**
+ * @brief Hardware abstraction of an I2C bus controller. Allows I2C devices to be tested
+ * on native against simulated devices.
+ *
+ * Every transaction is timed and counted. The bus itself is not thread safe,
+ * access from several tasks has to go through an I2cBusManager.
+ */
+class I2cBus {
+   public:
+    I2cBus() = default;
+    virtual ~I2cBus() = default;
+
+    /**
+     * @brief Writes bytes to a device in a single transaction
+     *
+     * @param address [IN] 7 bit device address
+     * @param data [IN] Bytes to write
+     * @param length [IN] Number of bytes
+     * @return RC_t RC_SUCCESS on success, RC_ERROR_WRITE_FAILS if the device did not acknowledge
+     */
+    RC_t write(uint8_t address, const uint8_t data[], uint32_t length);
+
+    /**
+     * @brief Reads bytes from a device in a single transaction
+     *
+     * @param address [IN] 7 bit device address
+     * @param data [OUT] Read bytes
+     * @param length [IN] Number of bytes to read
+     * @return RC_t RC_SUCCESS on success, RC_ERROR_READ_FAILS if fewer bytes were received
+     */
+    RC_t read(uint8_t address, uint8_t data[], uint32_t length);
+
+    /**
+     * @brief Returns a monotonic time in us which is used to measure the bus usage
+     *
+     * @return uint64_t
+     */
+    virtual uint64_t getTimeUs() const = 0;
+
+    /**
+     * @brief Waits without occupying the bus, e.g. while devices convert
+     *
+     * @param us [IN] Time to wait in us
+     */
+    virtual void waitUs(uint32_t us) = 0;
+
+    /**
+     * @brief Returns the usage counters since the last reset
+     *
+     * @return I2cBusMetrics_t
+     */
+    I2cBusMetrics_t getMetrics() const;
+
+    /**
+     * @brief Resets the usage counters to zero
+     */
+    void resetMetrics();
+
+   protected:
+    /**
+     * @brief Performs a write transaction, see write
+     */
+    virtual RC_t doWrite(uint8_t address, const uint8_t data[], uint32_t length) = 0;
+
+    /**
+     * @brief Performs a read transaction, see read
+     */
+    virtual RC_t doRead(uint8_t address, uint8_t data[], uint32_t length) = 0;
+
+   private:
+    /**
+     * @brief Adds a finished transaction to the counters
+     */
+    void account(uint64_t startUs, uint32_t length, RC_t result);
+
+    I2cBusMetrics_t m_metrics = {0, 0, 0, 0, 0};
+    uint64_t m_metricsStartUs = 0;
+    bool m_metricsStarted = false;
+};
+
+#endif  // I2C_BUS_H
@@ -0,0 +1,81 @@
+#include "I2cBusManager.h"
+
+I2cBusManager::I2cBusManager(I2cBus& bus) : m_bus(bus) {}
+
+RC_t I2cBusManager::addDevice(const std::shared_ptr<I2cDevice>& device) {
+    if(device == nullptr) return RC_ERROR_NULL;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    pruneDevices();
+    for(const std::weak_ptr<I2cDevice>& d : m_devices) {
+        const std::shared_ptr<I2cDevice> other = d.lock();
+        if(other != nullptr && other->getAddress() == device->getAddress()) return RC_ERROR_BUSY;
+    }
+    m_devices.push_back(device);
+    return RC_SUCCESS;
+}
+
+RC_t I2cBusManager::transfer(uint8_t address, const uint8_t tx[], uint32_t txLength, uint8_t rx[],
+                             uint32_t rxLength) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(txLength > 0) {
+        const RC_t err = m_bus.write(address, tx, txLength);
+        if(RC_SUCCESS != err) return err;
+    }
+    if(rxLength > 0) return m_bus.read(address, rx, rxLength);
+    return RC_SUCCESS;
+}
+
+RC_t I2cBusManager::runCycle() {
+    // Holding the devices keeps them alive for the whole cycle
+    std::vector<std::shared_ptr<I2cDevice>> devices;
+    uint32_t conversionTimeUs = 0;
+    RC_t result = RC_SUCCESS;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        pruneDevices();
+        devices.reserve(m_devices.size());
+        for(const std::weak_ptr<I2cDevice>& d : m_devices) {
+            std::shared_ptr<I2cDevice> device = d.lock();
+            if(device == nullptr) continue;
+            if(RC_SUCCESS != device->trigger(m_bus)) {
+                result = RC_ERROR;
+                continue;
+            }
+            if(device->getConversionTimeUs() > conversionTimeUs) conversionTimeUs = device->getConversionTimeUs();
+            devices.push_back(std::move(device));
+        }
+    }
+    if(devices.empty()) return (RC_SUCCESS == result) ? RC_ERROR_BUFFER_EMPTY : result;
+
+    // All devices convert at the same time. The bus is free for other transfers meanwhile
+    m_bus.waitUs(conversionTimeUs);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for(const std::shared_ptr<I2cDevice>& device : devices) {
+        if(RC_SUCCESS != device->collect(m_bus)) result = RC_ERROR;
+    }
+    return result;
+}
+
+uint32_t I2cBusManager::getDeviceCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint32_t count = 0;
+    for(const std::weak_ptr<I2cDevice>& d : m_devices) {
+        if(!d.expired()) count++;
+    }
+    return count;
+}
+
+I2cBusMetrics_t I2cBusManager::getMetrics() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_bus.getMetrics();
+}
+
+void I2cBusManager::pruneDevices() {
+    for(auto it = m_devices.begin(); it != m_devices.end();) {
+        if(it->expired())
+            it = m_devices.erase(it);
+        else
+            ++it;
+    }
+}
@@ -0,0 +1,86 @@
+#ifndef I2C_BUS_MANAGER_H
+#define I2C_BUS_MANAGER_H
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "I2cDevice.h"
+
+/**
+ * @brief Owns an I2C bus and arbitrates the access of all tasks to it.
+ *
+ * Registered devices are measured in cycles by runCycle(), which is meant to be called
+ * periodically by a dedicated task: the conversions of all devices are started back to back,
+ * then the bus is released for the longest conversion time and finally all results are
+ * collected back to back. Tasks which need single transactions use transfer(), which waits
+ * for the bus and can run while the devices convert.
+ */
+class I2cBusManager {
+   public:
+    /**
+     * @brief Constructor
+     *
+     * @param bus [IN] Bus which is only accessed through this manager from now on
+     */
+    explicit I2cBusManager(I2cBus& bus);
+
+    /**
+     * @brief Adds a device to the measurement cycle. The manager does not keep the device alive,
+     * it is removed once the last shared_ptr to it is released.
+     *
+     * @param device [IN]
+     * @return RC_t RC_SUCCESS on success, RC_ERROR_NULL if device is a nullptr,
+     *  RC_ERROR_BUSY if another device with the same address is registered
+     */
+    RC_t addDevice(const std::shared_ptr<I2cDevice>& device);
+
+    /**
+     * @brief Performs a write followed by a read as one bus access. Waits until the bus is free.
+     *
+     * @param address [IN] 7 bit device address
+     * @param tx [IN] Bytes to write. Can be a nullptr if txLength is 0
+     * @param txLength [IN] Number of bytes to write. 0 skips the write
+     * @param rx [OUT] Read bytes. Can be a nullptr if rxLength is 0
+     * @param rxLength [IN] Number of bytes to read. 0 skips the read
+     * @return RC_t RC_SUCCESS on success, errors of the bus otherwise
+     */
+    RC_t transfer(uint8_t address, const uint8_t tx[], uint32_t txLength, uint8_t rx[], uint32_t rxLength);
+
+    /**
+     * @brief Runs one measurement cycle of all registered devices. Blocks for the longest conversion time.
+     *
+     * @return RC_t RC_SUCCESS if all devices were measured,
+     *  RC_ERROR_BUFFER_EMPTY if no device is registered,
+     *  RC_ERROR if the measurement of at least one device failed
+     */
+    RC_t runCycle();
+
+    /**
+     * @brief Returns the number of registered devices
+     *
+     * @return uint32_t
+     */
+    uint32_t getDeviceCount() const;
+
+    /**
+     * @brief Returns the usage counters of the bus
+     *
+     * @return I2cBusMetrics_t
+     */
+    I2cBusMetrics_t getMetrics() const;
+
+   private:
+    /**
+     * @brief Removes devices which were destroyed. m_mutex has to be held
+     */
+    void pruneDevices();
+
+    I2cBus& m_bus;
+    /**
+     * @brief Guards the bus and the device list
+     */
+    mutable std::mutex m_mutex;
+    std::vector<std::weak_ptr<I2cDevice>> m_devices;
+};
+
+#endif  // I2C_BUS_MANAGER_H
@@ -0,0 +1,53 @@
+#ifndef I2C_DEVICE_H
+#define I2C_DEVICE_H
+#include "I2cBus.h"
+
+/**
+ * @brief Device on an I2C bus whose measurement is split into starting a conversion and
+ * collecting its result. This allows an I2cBusManager to start the conversions of all devices
+ * on a bus first and to collect all results after the longest conversion time, instead of
+ * waiting for each device on its own.
+ *
+ * trigger and collect are only called by the I2cBusManager while it owns the bus.
+ * Results are handed to other tasks by the implementations.
+ */
+class I2cDevice {
+   public:
+    /**
+     * @brief Constructor
+     *
+     * @param address [IN] 7 bit device address
+     */
+    explicit I2cDevice(uint8_t address) : m_address(address) {}
+    virtual ~I2cDevice() = default;
+
+    inline uint8_t getAddress() const { return m_address; }
+
+    /**
+     * @brief Starts a conversion
+     *
+     * @param bus [IN] Bus on which the device is connected
+     * @return RC_t RC_SUCCESS if the conversion was started
+     */
+    virtual RC_t trigger(I2cBus& bus) = 0;
+
+    /**
+     * @brief Returns the longest time a conversion can take
+     *
+     * @return uint32_t Time in us
+     */
+    virtual uint32_t getConversionTimeUs() const = 0;
+
+    /**
+     * @brief Reads the result of the conversion started by trigger
+     *
+     * @param bus [IN] Bus on which the device is connected
+     * @return RC_t RC_SUCCESS if a result was read
+     */
+    virtual RC_t collect(I2cBus& bus) = 0;
+
+   private:
+    const uint8_t m_address;
+};
+
+#endif  // I2C_DEVICE_H
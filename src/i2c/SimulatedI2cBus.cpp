@@ -0,0 +1,34 @@
+#include "SimulatedI2cBus.h"
+
+RC_t SimulatedI2cBus::attach(uint8_t address, SimulatedI2cDevice* device) {
+    if(address >= I2C_MAX_ADDRESSES) return RC_ERROR_RANGE;
+    m_devices[address] = device;
+    return RC_SUCCESS;
+}
+
+RC_t SimulatedI2cBus::doWrite(uint8_t address, const uint8_t data[], uint32_t length) {
+    SimulatedI2cDevice* device = (address < I2C_MAX_ADDRESSES) ? m_devices[address] : nullptr;
+    if(device == nullptr) {
+        // Only the address byte is sent before the missing acknowledge
+        advanceTransaction(0);
+        return RC_ERROR_WRITE_FAILS;
+    }
+    advanceTransaction(length);
+    return (RC_SUCCESS == device->onWrite(m_timeUs, data, length)) ? RC_SUCCESS : RC_ERROR_WRITE_FAILS;
+}
+
+RC_t SimulatedI2cBus::doRead(uint8_t address, uint8_t data[], uint32_t length) {
+    SimulatedI2cDevice* device = (address < I2C_MAX_ADDRESSES) ? m_devices[address] : nullptr;
+    if(device == nullptr) {
+        advanceTransaction(0);
+        return RC_ERROR_READ_FAILS;
+    }
+    advanceTransaction(length);
+    return (RC_SUCCESS == device->onRead(m_timeUs, data, length)) ? RC_SUCCESS : RC_ERROR_READ_FAILS;
+}
+
+void SimulatedI2cBus::advanceTransaction(uint32_t length) {
+    // Start condition, address byte and payload bytes with 9 clocks each, stop condition
+    const uint64_t bits = 1 + 9 * (1 + static_cast<uint64_t>(length)) + 1;
+    m_timeUs += (bits * 1000000 + m_clockHz - 1) / m_clockHz;
+}
@@ -0,0 +1,85 @@
+#ifndef SIMULATED_I2C_BUS_H
+#define SIMULATED_I2C_BUS_H
+#include <atomic>
+
+#include "I2cBus.h"
+
+/**
+ * @brief Highest 7 bit I2C address plus one
+ */
+#define I2C_MAX_ADDRESSES (128)
+
+/**
+ * @brief Device model which answers the transactions of a SimulatedI2cBus
+ */
+class SimulatedI2cDevice {
+   public:
+    virtual ~SimulatedI2cDevice() = default;
+
+    /**
+     * @brief Called for a write transaction to the device
+     *
+     * @param timeUs [IN] Simulated time of the transaction
+     * @param data [IN] Written bytes
+     * @param length [IN] Number of bytes
+     * @return RC_t RC_SUCCESS to acknowledge
+     */
+    virtual RC_t onWrite(uint64_t timeUs, const uint8_t data[], uint32_t length) = 0;
+
+    /**
+     * @brief Called for a read transaction from the device
+     *
+     * @param timeUs [IN] Simulated time of the transaction
+     * @param data [OUT] Bytes to return
+     * @param length [IN] Number of requested bytes
+     * @return RC_t RC_SUCCESS to acknowledge
+     */
+    virtual RC_t onRead(uint64_t timeUs, uint8_t data[], uint32_t length) = 0;
+};
+
+/**
+ * @brief I2cBus without hardware. Transactions are answered by attached device models and
+ * advance a simulated clock by the time they would take on a real bus. Waiting advances
+ * the clock without sleeping.
+ */
+class SimulatedI2cBus : public I2cBus {
+   public:
+    /**
+     * @brief Constructor
+     *
+     * @param clockHz [IN] Simulated bus clock, determines the duration of transactions
+     */
+    explicit SimulatedI2cBus(uint32_t clockHz = I2C_CLOCK_HZ) : m_clockHz(clockHz) {}
+
+    /**
+     * @brief Connects a device model to the bus
+     *
+     * @param address [IN] 7 bit address of the device
+     * @param device [IN] Device model. Must outlive the bus or be detached. nullptr detaches the address
+     * @return RC_t RC_SUCCESS on success, RC_ERROR_RANGE if the address is invalid
+     */
+    RC_t attach(uint8_t address, SimulatedI2cDevice* device);
+
+    inline uint64_t getTimeUs() const override { return m_timeUs.load(); }
+
+    inline void waitUs(uint32_t us) override { m_timeUs += us; }
+
+    inline void setTimeUs(uint64_t timeUs) { m_timeUs = timeUs; }
+
+   protected:
+    RC_t doWrite(uint8_t address, const uint8_t data[], uint32_t length) override;
+
+    RC_t doRead(uint8_t address, uint8_t data[], uint32_t length) override;
+
+   private:
+    /**
+     * @brief Advances the clock by the duration of a transaction with the given number of payload bytes
+     */
+    void advanceTransaction(uint32_t length);
+
+    const uint32_t m_clockHz;
+    std::atomic<uint64_t> m_timeUs{0};
+    SimulatedI2cDevice* m_devices[I2C_MAX_ADDRESSES] = {};
+};
+
+#endif  // SIMULATED_I2C_BUS_H
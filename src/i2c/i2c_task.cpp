@@ -0,0 +1,15 @@
+#include "i2c_task.h"
+
+#include "global.h"
+#include "global_objects.h"
+
+TaskHandle_t i2cTaskHandle;
+
+void i2cTask(void* pvParameters) {
+    TickType_t lastWakeTime = xTaskGetTickCount();
+    while(1) {
+        // Blocks for the conversion time of the devices
+        i2cBusManager.runCycle();
+        xTaskDelayUntil(&lastWakeTime, pdMS_TO_TICKS(I2C_CYCLE_INTERVAL_MS));
+    }
+}
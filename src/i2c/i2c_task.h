@@ -0,0 +1,20 @@
+#ifndef I2C_TASK_H
+#define I2C_TASK_H
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#define I2C_TASK_NAME ("I2C_Task")
+#define I2C_TASK_STACK_SIZE (2048)
+// Above the loop task so that measurements are ready when the sensors are polled
+#define I2C_TASK_PRIORITY (LOOP_TASK_PRIORITY + 1)
+
+extern TaskHandle_t i2cTaskHandle;
+
+/**
+ * @brief I2C Task function. Should never return.
+ * Runs the measurement cycles of the devices on the global I2cBusManager, see there.
+ *
+ * @param pvParameters
+ */
+void i2cTask(void* pvParameters);
+#endif  // I2C_TASK_H
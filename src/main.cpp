@@ -4,12 +4,25 @@
 #include <WiFi.h>
 #include <freertos/task.h>
 
+#include <math.h>
+#include <string.h>
+
+#include <algorithm>
+#include <memory>
+#include <new>
 #include <vector>
 
+#include "adc/adc_task.h"
+#include "i2c/i2c_task.h"
 #include "global_objects.h"
 #include "helper_functions.h"
 #include "mqtt.h"
 #include "sensors/SensorFactory.h"
+#include "storage/SampleLog.h"
+#include "telemetry/CborPayloadEncoder.h"
+#include "telemetry/InfluxPayloadEncoder.h"
+#include "telemetry/JsonPayloadEncoder.h"
+#include "telemetry/MessagePackPayloadEncoder.h"
 #include "webserver/webserver.h"
 
 // Timer 0 used for automatic periodic reboot
@@ -25,6 +38,19 @@ NTPClient timeClient(ntpUDP);
 hw_timer_t* timer0_Cfg = NULL;
 bool rebootFlag = false;
 static TaskHandle_t loopTaskHandle = NULL;
+// Keeps samples which could not be published while the broker was unreachable
+SampleLog sampleLog(*filesystem, SAMPLE_LOG_FILENAME_PREFIX);
+// MQTT_BASE_TOPIC/<deviceTopic>, set up once the settings are read
+static char deviceTopic[sizeof(MQTT_BASE_TOPIC) + sizeof(settings.mqtt.deviceTopic)] = "";
+// Document in which all sensors of a cycle are published if settings.mqtt.publishMode is MQTT_PUBLISH_PER_DEVICE
+static uint8_t devicePayloadBuffer[MQTT_DEVICE_PAYLOAD_SIZE];
+// Encoders of the document in the order of MqttPayloadFormat_t. They share the buffer, only one is used at a time
+static JsonPayloadEncoder jsonEncoder(devicePayloadBuffer, sizeof(devicePayloadBuffer));
+static CborPayloadEncoder cborEncoder(devicePayloadBuffer, sizeof(devicePayloadBuffer));
+static MessagePackPayloadEncoder messagePackEncoder(devicePayloadBuffer, sizeof(devicePayloadBuffer));
+static InfluxPayloadEncoder influxEncoder(devicePayloadBuffer, sizeof(devicePayloadBuffer), MQTT_INFLUX_MEASUREMENT,
+                                          settings.mqtt.deviceTopic);
+static PayloadEncoder* const payloadEncoders[] = {&jsonEncoder, &cborEncoder, &messagePackEncoder, &influxEncoder};
 
 const char* encryptionTypeToString(wifi_auth_mode_t encryptionType) {
     switch(encryptionType) {
@@ -123,75 +149,171 @@ void wifiSetup() {
  * contained sensors and their pipeline stages
  *
  * @param filename [IN]
+ * @param registry [OUT] Registry to add the sensors to
+ * @param previous [IN] Optional currently active sensors. Sensors whose definition in the
+ *  config file did not change are taken over from it instead of being recreated,
+ *  which keeps their filter state, history and latest sample.
  * @return RC_t RC_SUCCESS on success
  */
-RC_t parseSensorFile(const char filename[]) {
+RC_t parseSensorFile(const char filename[], SensorRegistry& registry, const SensorRegistry* previous = nullptr) {
+    // The file is read through a buffer which only has to hold one sensor definition at a time
+    std::unique_ptr<char[]> buffer(new(std::nothrow) char[SENSOR_CFG_READ_BUFFER_SIZE]);
+    if(buffer == nullptr) return RC_ERROR_MEMORY;
     // Try to open the given file
     RC_t err = filesystem->openFile(filename, Filesystem::READ_ONLY);
     if(err != RC_SUCCESS) {
-        ramLogger.logLnf("Failed to open %s", SENSOR_CFG_FILENAME);
+        ramLogger.logLnf("Failed to open %s", filename);
         return err;
     }
 
+    SensorConfigParser parser(*filesystem, buffer.get(), SENSOR_CFG_READ_BUFFER_SIZE);
+    SensorConfig_t config;
+    const SensorContext_t context = {*filesystem, *gpio, adcAcquisition, i2cBusManager, &urgentEvents};
     while(true) {
-        uint8_t data[1024] = "\0";
-        // Read until [
-        err = filesystem->readUntil(data, sizeof(data), SENSOR_CFG_OPEN_CHAR[0]);
-        if(err != RC_SUCCESS) break;
-
-        // Trim all comments and leading whitespace from the input
-        trimComments(reinterpret_cast<char*>(data), CONFIG_FILE_COMMENT_DELIMITER);
-        trimLeadingWhitespace(reinterpret_cast<char*>(data));
-
-        // if the string is now empty, stop parsing
-        uint32_t dataStrLen = strlen(reinterpret_cast<char*>(data));
-        if(dataStrLen == 0) break;
-
-        char* commentStart = strstr(reinterpret_cast<char*>(data), CONFIG_FILE_COMMENT_DELIMITER);
-        // if a comment delimiter was found, the data read is part of an open ended comment.
-        if(commentStart != nullptr) {
-            uint32_t matchedCharsInRow = 0;
-            while(matchedCharsInRow != strlen(CONFIG_FILE_COMMENT_DELIMITER)) {
-                char tmp[2] = "\0";
-                filesystem->read(reinterpret_cast<uint8_t*>(tmp), 1);
-                // count up when the char order matches that of the comment delimiter.
-                if(tmp[0] == CONFIG_FILE_COMMENT_DELIMITER[matchedCharsInRow])
-                    matchedCharsInRow++;
-                else  // reset counter to 0 when a mismatched char is found
-                    matchedCharsInRow = 0;
-            }
-            // after rest of open comment was removed, skip to next read operation
-            continue;
+        err = parser.next(config);
+        if(err == RC_ERROR_BUFFER_EMPTY) {
+            err = RC_SUCCESS;
+            break;
+        } else if(err != RC_SUCCESS) {
+            ramLogger.logLnf("%s:%u:%u: %s", filename, parser.getErrorLine(), parser.getErrorColumn(),
+                             parser.getErrorMessage());
+            break;
         }
 
-        // Now only the type of the sensor should remain.
-        // Copy it to a separate string and parse the config string for that sensor
-        char sensorTypeStr[128];
-        strcpy(sensorTypeStr, reinterpret_cast<const char*>(data));
+        char sensorTypeStr[128] = "";
+        config.sensor.type.copyTo(sensorTypeStr, sizeof(sensorTypeStr));
         ramLogger.logLnf("Found %s", sensorTypeStr);
 
-        // Read configuration of the found sensor and its pipeline stages
-        err = filesystem->readUntil(data, sizeof(data), SENSOR_CFG_CLOSE_CHAR[0]);
-        if(err != RC_SUCCESS) break;
-        trimComments(reinterpret_cast<char*>(data), CONFIG_FILE_COMMENT_DELIMITER);
-        trimLeadingWhitespace(reinterpret_cast<char*>(data));
-
-        // Create sensor
-        Sensor* ptr = SensorFactory::sensorFromConfigString(sensorTypeStr, reinterpret_cast<char*>(data));
-        if(ptr == nullptr) {
-            ramLogger.logLnf("Failed to create %s", sensorTypeStr);
+        // Reuse the sensor if its definition did not change
+        uint32_t configHash = config.sensor.hash();
+        for(const ConfigSection& t : config.transformers) configHash = t.hash(configHash);
+        std::shared_ptr<Sensor> sensor = (previous != nullptr) ? previous->findByConfigHash(configHash) : nullptr;
+        if(sensor == nullptr) {
+            // Create sensor
+            StringView errorKey;
+            Sensor* ptr = SensorFactory::sensorFromConfig(config, context, &errorKey);
+            if(ptr == nullptr) {
+                char errorKeyStr[64] = "";
+                errorKey.copyTo(errorKeyStr, sizeof(errorKeyStr));
+                ramLogger.logLnf("%s:%u: Failed to create %s (%s)", filename, config.sensor.line, sensorTypeStr,
+                                 errorKeyStr);
+                err = RC_ERROR_BAD_DATA;
+                break;
+            }
+            sensor.reset(ptr);
+            sensor->setConfigHash(configHash);
+            if(RC_SUCCESS != sensor->setDeviceTopic(deviceTopic)) {
+                err = RC_ERROR_MEMORY;
+                break;
+            }
+        }
+        // Hand ownership to the registry. Sensor names have to be unique
+        err = registry.add(sensor);
+        if(err == RC_ERROR_INVALID) {
+            ramLogger.logLnf("Sensor name %s is used more than once", sensor->getName());
+            break;
+        } else if(err != RC_SUCCESS) {
+            ramLogger.logLnf("Failed to register sensor %s, Error Code=%i", sensor->getName(), err);
             break;
-        } else {
-            ramLogger.logLnf("Created sensor %s with %u pipeline stages", ptr->getName(), ptr->getNumPipelineStages());
-            sensors.push_back(ptr);
         }
+        ramLogger.logLnf("Created sensor %s with %u pipeline stages", sensor->getName(),
+                         sensor->getNumPipelineStages());
     }
-    // Whatever happened, close the file
     filesystem->closeFile();
     // Return error code if one occurred
     return err;
 }
 
+/**
+ * @brief Gives every sensor without one a history buffer. The part of the memory budget
+ * HISTORY_MEMORY_BUDGET_BYTES which is not used by existing histories is split evenly
+ * between these sensors.
+ *
+ * @param registry [IN]
+ */
+void attachSensorHistories(const SensorRegistry& registry) {
+    uint32_t budget = HISTORY_MEMORY_BUDGET_BYTES;
+    uint32_t sensorsWithoutHistory = 0;
+    for(const std::shared_ptr<Sensor>& s : registry) {
+        if(s->getHistory() == nullptr)
+            sensorsWithoutHistory++;
+        else
+            budget -= std::min(budget, s->getHistory()->getMemoryUsage());
+    }
+    if(sensorsWithoutHistory == 0) return;
+
+    const uint32_t budgetPerSensor = budget / sensorsWithoutHistory;
+    for(const std::shared_ptr<Sensor>& s : registry) {
+        if(s->getHistory() == nullptr) s->setHistory(SensorHistory::createWithBudget(budgetPerSensor));
+    }
+    ramLogger.logLnf("Allocated %u bytes of history per sensor", budgetPerSensor);
+}
+
+/**
+ * @brief Builds a new sensor set from the sensor config file next to the active one and
+ * swaps it in. Unchanged sensors keep their state. On failure the active set stays in use.
+ * Has to be called from the task which polls the sensors.
+ */
+void reloadSensorConfig() {
+    const std::shared_ptr<const SensorRegistry> active = getSensors();
+    std::shared_ptr<SensorRegistry> registry = std::make_shared<SensorRegistry>();
+    const RC_t err = parseSensorFile(SENSOR_CFG_FILENAME, *registry, active.get());
+    if(err != RC_SUCCESS) {
+        ramLogger.logLnf("Failed to reload sensor config, keeping active sensors. Error Code=%i", err);
+        return;
+    }
+
+    uint32_t unchanged = 0;
+    for(const std::shared_ptr<Sensor>& s : *registry) {
+        if(active->findByConfigHash(s->getConfigHash()) == s) unchanged++;
+    }
+    attachSensorHistories(*registry);
+    setSensors(registry);
+    ramLogger.logLnf("Reloaded sensor config: %u sensors, %u unchanged", registry->size(), unchanged);
+}
+
+/**
+ * @brief Publishes up to SAMPLE_LOG_REPLAY_RECORDS_PER_CYCLE logged records
+ * to the backlog subtopic of each sensor. Stops while the MQTT outbox is more than half full,
+ * so that the backlog does not push out live samples
+ */
+void replaySampleLog() {
+    const std::shared_ptr<const SensorRegistry> registry = getSensors();
+    SampleLog::Entry_t entries[SAMPLE_LOG_MAX_ENTRIES_PER_RECORD];
+    for(uint32_t i = 0; i < SAMPLE_LOG_REPLAY_RECORDS_PER_CYCLE && sampleLog.hasUnreadRecords(); i++) {
+        if(mqttOutbox.getFreeBytes() < MQTT_OUTBOX_SIZE / 2) break;
+        uint32_t timestamp = 0;
+        uint32_t count = 0;
+        const RC_t err = sampleLog.read(timestamp, entries, SAMPLE_LOG_MAX_ENTRIES_PER_RECORD, count);
+        if(err != RC_SUCCESS && err != RC_ERROR_MEMORY) break;
+
+        for(uint32_t j = 0; j < count; j++) {
+            char topic[256] = "";
+            char payload[2 * FLOAT_FORMAT_BUFFER_SIZE + 32] = "";
+            char valueStr[FLOAT_FORMAT_BUFFER_SIZE] = "";
+            char rawStr[FLOAT_FORMAT_BUFFER_SIZE] = "";
+            const Sensor* s = registry->find(entries[j].sensorId);
+            const uint8_t decimals = (s != nullptr) ? s->getDecimals() : FLOAT_FORMAT_MAX_DECIMALS;
+            // Sensors which were removed from the config since are published by their ID
+            if(s != nullptr)
+                snprintf(topic, sizeof(topic), "%s/backlog/%s", deviceTopic, s->getName());
+            else
+                snprintf(topic, sizeof(topic), "%s/backlog/%08X", deviceTopic, entries[j].sensorId);
+            // JSON has no representation for NaN and infinity
+            if(isfinite(entries[j].value))
+                formatFloat(valueStr, sizeof(valueStr), entries[j].value, decimals);
+            else
+                strcpy(valueStr, "null");
+            if(isfinite(entries[j].rawValue))
+                formatFloat(rawStr, sizeof(rawStr), entries[j].rawValue, decimals);
+            else
+                strcpy(rawStr, "null");
+            snprintf(payload, sizeof(payload), "{\"t\":%u,\"v\":%s,\"raw\":%s}", timestamp, valueStr, rawStr);
+            mqttPublish(topic, payload);
+        }
+    }
+}
+
 /**
  * @brief Used to trigger periodic automatic reboot using timer 0
  */
@@ -218,55 +340,30 @@ void setup() {
         while(1);
     }
 
-    // Read settings
-    if(RC_SUCCESS != parseSettingsFile(CONFIG_FILENAME, settings))
-        ramLogger.logLn("Failed to parse config file");
-    else
-        ramLogger.logLn("Successfully parsed config file");
-
-    // Preferences initialization
-    // Passwords are not stored in the settings file.
-    // If any are found during the first startup, they are moved to the
-    // less easily readable Preference storage.
-    preferences.begin("MultiSensor", false);
-
-    // These initializations are only run once.
+    // Passwords are not stored in the settings file but in the less easily readable Preference storage.
     // Unless the flash is fully erased, data stored in preferences can persist
     // through flashing of programs and filesystem images
-    if(!preferences.isKey("WIFI_Password")) preferences.putString("WIFI_Password", "");
-    if(!preferences.isKey("MQTT_Password")) preferences.putString("MQTT_Password", "");
-
-    // Read passwords from preferences
-    // If no password was found in the settings file, the password strings
-    // should be empty at this point (meaning they have length 1 due to \0 byte)
-    char tmp[sizeof(settings.wifi.password)] = "";
-    preferences.getString("WIFI_Password", tmp, sizeof(tmp));
-    if(strcmp(tmp, settings.wifi.password) != 0 && strlen(settings.wifi.password) > 1) {
-        // string stored in preference storage does not match password found in config file
-        // => Update value stored in flash
-        preferences.putString("WIFI_Password", settings.wifi.password);
-    } else {
-        // No password initialization through config file.
-        // => Copy password from preferences to wifi password variable
-        strcpy(settings.wifi.password, tmp);
-    }
+    preferences.begin("MultiSensor", false);
 
-    preferences.getString("MQTT_Password", tmp, sizeof(tmp));
-    if(strcmp(tmp, settings.mqtt.password) != 0 && strlen(settings.mqtt.password) > 1) {
-        // string stored in preference storage does not match password found in config file
-        // => Update value stored in flash
-        preferences.putString("MQTT_Password", settings.mqtt.password);
-    } else {
-        // No password initialization through config file.
-        // => Copy password from preferences to mqtt password variable
-        strcpy(settings.mqtt.password, tmp);
-    }
+    // Read settings. Passwords found in the settings file during the first startup are moved to the preferences
+    uint32_t foundSettings = 0, invalidSettings = 0;
+    if(RC_SUCCESS != settingsStore.load(&foundSettings, &invalidSettings))
+        ramLogger.logLn("Failed to parse config file");
+    else
+        ramLogger.logLn("Successfully parsed config file");
+    if(foundSettings & SETTING_BIT(SETTING_WIFI_PASSWORD))
+        ramLogger.logLn("Found WiFi password in config file. Removing it...");
+    if(foundSettings & SETTING_BIT(SETTING_MQTT_PASSWORD))
+        ramLogger.logLn("Found MQTT password in config file. Removing it...");
+    if(invalidSettings & SETTING_BIT(SETTING_MQTT_BROKER_PORT))
+        ramLogger.logLn("Config: Could not parse MQTT broker port");
 
     // if there was no clientID specified, generate one
     if(strlen(settings.mqtt.clientID) == 0)
         snprintf(settings.mqtt.clientID, 64, "MultiSensor-MQTT-%llX", ESP.getEfuseMac());
     // Same for the device topic
     if(strlen(settings.mqtt.deviceTopic) == 0) snprintf(settings.mqtt.deviceTopic, 64, "%llX", ESP.getEfuseMac());
+    snprintf(deviceTopic, sizeof(deviceTopic), "%s/%s", MQTT_BASE_TOPIC, settings.mqtt.deviceTopic);
     // And Hostname
     if(strlen(settings.wifi.hostname) == 0)
         snprintf(settings.wifi.hostname, 64, "MultiSensor-MQTT-%llX", ESP.getEfuseMac());
@@ -287,12 +384,27 @@ void setup() {
         }
     }
 
+    // Runs while no pin is in continuous mode as well, so that sensors added by a config reload work
+    if(pdPASS != xTaskCreate(adcTask, ADC_TASK_NAME, ADC_TASK_STACK_SIZE, NULL, ADC_TASK_PRIORITY, &adcTaskHandle)) {
+        ramLogger.logLn("Failed to create ADC task");
+    }
+    // Idles through its cycles while no I2C sensor is configured
+    if(pdPASS != xTaskCreate(i2cTask, I2C_TASK_NAME, I2C_TASK_STACK_SIZE, NULL, I2C_TASK_PRIORITY, &i2cTaskHandle)) {
+        ramLogger.logLn("Failed to create I2C task");
+    }
+
     // Sensor setup
-    if(RC_SUCCESS != parseSensorFile(SENSOR_CFG_FILENAME)) {
+    std::shared_ptr<SensorRegistry> registry = std::make_shared<SensorRegistry>();
+    if(RC_SUCCESS != parseSensorFile(SENSOR_CFG_FILENAME, *registry)) {
         ramLogger.logLn("Failed to parse sensor file");
     } else {
         ramLogger.logLn("Successfully parsed sensor config file");
     }
+    attachSensorHistories(*registry);
+    setSensors(registry);
+
+    if(RC_SUCCESS != sampleLog.begin()) ramLogger.logLn("Failed to initialize sample log");
+    if(sampleLog.hasUnreadRecords()) ramLogger.logLn("Found unpublished samples from before the last reboot");
 
     // Auto reboot
     // ESP32C3 has 2 54-bit hardware timers with 16-bit pre-scalers
@@ -308,45 +420,133 @@ void loop() {
         loopTaskHandle = xTaskGetCurrentTaskHandle();
     }
 
-    // stores the last waketime of the loop task
-    static TickType_t lastWakeTime;
-    lastWakeTime = xTaskGetTickCount();
-
     if(rebootFlag) {
         ramLogger.logLn("Automatic reboot triggered");
+        if(settingsStore.isDirty()) settingsStore.commit();
         delay(1000);
         ESP.restart();
     }
 
-    // publish value
-    for(Sensor* s : sensors) {
-        if(s == nullptr) continue;
-        float_t val = s->readSensor();
-        float_t rawVal = s->readSensorRaw();
+    if(restartRequested) {
+        // Don't lose settings which are still waiting for their write delay
+        if(settingsStore.isDirty()) settingsStore.commit();
+        ramLogger.logLn("Restarting system in 5 seconds");
+        delay(5000);
+        ESP.restart();
+    }
+
+    // Settings changed through the webserver are written together once no further changes are expected.
+    // They take effect after a restart
+    if(settingsStore.isDirty()) {
+        const RC_t err = settingsStore.update(getUptimeMs());
+        if(RC_SUCCESS != err)
+            ramLogger.logLnf("Failed to write settings, Error Code=%i", err);
+        else if(!settingsStore.isDirty()) {
+            ramLogger.logLnf("Settings saved (%u file writes, %u NVS writes). Restarting system",
+                             settingsStore.getFileWriteCount(), settingsStore.getNvsWriteCount());
+            // Short delay to finish printing potential debug messages
+            delay(1000);
+            ESP.restart();
+        }
+    }
+
+    // Apply a new sensor config before the sensors are polled
+    if(sensorConfigReloadRequested.exchange(false)) reloadSensorConfig();
+    const std::shared_ptr<const SensorRegistry> registry = getSensors();
+
+    // Samples published in this cycle in case they have to be logged
+    SampleLog::Entry_t entries[SAMPLE_LOG_MAX_ENTRIES_PER_RECORD];
+    uint32_t entryCount = 0;
+    bool published = false;
+    const bool connected = mqttConnected();
+    // All sensors of the cycle are published in one document if configured
+    const bool batched = (MQTT_PUBLISH_PER_DEVICE == settings.mqtt.publishMode);
+    PayloadEncoder& payload = *payloadEncoders[(settings.mqtt.payloadFormat < ARRAY_SIZE(payloadEncoders))
+                                                   ? settings.mqtt.payloadFormat
+                                                   : MQTT_PAYLOAD_JSON];
+    // The samples are sent without a timestamp until the time has been synchronized
+    const uint32_t timestamp = timeClient.isTimeSet() ? timeClient.getEpochTime() : 0;
+    payload.clear(timestamp);
+
+    // Each sensor is sampled at its own interval and the collected samples are published at its publish interval
+    for(const std::shared_ptr<Sensor>& s : *registry) {
+        // Reading the sensor also updates the cached sample which is served to the webserver
+        // Sensors which overrun their time budget or fail repeatedly are skipped for a while
+        const bool wasDegraded = s->getHealth().isDegraded();
+        s->sampleIfDue(getUptimeMs());
+        if(wasDegraded != s->getHealth().isDegraded()) {
+            if(wasDegraded)
+                ramLogger.logLnf("%s recovered", s->getName());
+            else
+                ramLogger.logLnf("%s degraded, retrying in %ums", s->getName(), s->getHealth().getBackoffMs());
+        }
+        SampleAggregator aggregate;
+        if(!s->takeAggregateIfDue(getUptimeMs(), aggregate)) continue;
+        SensorSample_t sample;
+        if(aggregate.getCount() == 0 || !s->getLatestSample(sample)) continue;
+        published = true;
+        char valueStr[FLOAT_FORMAT_BUFFER_SIZE] = "";
+        char rawStr[FLOAT_FORMAT_BUFFER_SIZE] = "";
+        formatFloat(valueStr, sizeof(valueStr), sample.value, s->getDecimals());
+        formatFloat(rawStr, sizeof(rawStr), sample.rawValue, s->getDecimals());
         Serial.print(s->getName());
         Serial.print(": ");
-        Serial.print(val);
+        Serial.print(valueStr);
         Serial.print(", raw: ");
-        Serial.println(rawVal);
+        Serial.println(rawStr);
+        // Failed reads carry no information worth keeping, like in the history of the sensor
+        const bool readFailed = isnan(sample.rawValue);
+        if(!connected && !readFailed && entryCount < SAMPLE_LOG_MAX_ENTRIES_PER_RECORD) {
+            entries[entryCount++] = {s->getId(), sample.value, sample.rawValue};
+        }
         // If the mqtt client is connected, publish the sensor data
-        if(mqttClient.connected()) {
-            char topic[256] = "";
-            char valStr[32] = "";
-
-            // publish processed value
-            snprintf(topic, sizeof(topic), "%s/%s/%s", MQTT_BASE_TOPIC, settings.mqtt.deviceTopic, s->getName());
-            snprintf(valStr, sizeof(valStr), "%f", val);
-            mqttClient.publish(topic, valStr);
+        if(connected && batched) {
+            const SampleAggregator* aggregated = (s->getAggregateFields() != 0) ? &aggregate : nullptr;
+            const uint8_t fields = s->getAggregateFields();
+            RC_t err = payload.add(s->getName(), sample, aggregated, fields, s->getDecimals());
+            if(RC_ERROR_BUFFER_FULL == err && payload.getSensorCount() > 0) {
+                // Continue in another document
+                mqttPublish(deviceTopic, payload.data(), payload.length());
+                payload.clear(timestamp);
+                err = payload.add(s->getName(), sample, aggregated, fields, s->getDecimals());
+            }
+            if(RC_SUCCESS != err) ramLogger.logLnf("%s could not be added to the device payload", s->getName());
+        } else if(connected) {
+            // publish processed value, or the aggregates of all samples since the last publish if configured
+            if(s->getAggregateFields() == 0) {
+                mqttPublish(s->getTopic(), valueStr);
+            } else {
+                char aggregateStr[SENSOR_AGGREGATE_PAYLOAD_SIZE] = "";
+                if(RC_SUCCESS ==
+                   aggregate.toJson(aggregateStr, sizeof(aggregateStr), s->getAggregateFields(), s->getDecimals()))
+                    mqttPublish(s->getTopic(), aggregateStr);
+            }
 
             // publish raw value under subtopic
-            snprintf(topic, sizeof(topic), "%s/%s/raw/%s", MQTT_BASE_TOPIC, settings.mqtt.deviceTopic, s->getName());
-            snprintf(valStr, sizeof(valStr), "%f", rawVal);
-            mqttClient.publish(topic, valStr);
+            mqttPublish(s->getRawTopic(), rawStr);
         }
     }
+    if(payload.getSensorCount() > 0) mqttPublish(deviceTopic, payload.data(), payload.length());
 
-    // Sleep task until the next sensor polling time
-    xTaskDelayUntil(&lastWakeTime, pdMS_TO_TICKS(SENSOR_POLLING_INTERVAL_S * 1000));
+    // Keep the samples while the broker is unreachable and publish them once it is back
+    static uint32_t lastLogFlush = 0;
+    if(!connected && entryCount > 0 && strcmp(settings.mqtt.brokerAddress, "0.0.0.0") != 0) {
+        const RC_t err = sampleLog.append(timeClient.getEpochTime(), entries, entryCount);
+        if(err != RC_SUCCESS) ramLogger.logLnf("Failed to log samples, Error Code=%i", err);
+    }
+    const bool flushDue = getUptimeMs() - lastLogFlush >= SAMPLE_LOG_FLUSH_INTERVAL_S * 1000;
+    if(sampleLog.getBufferedBytes() > 0 && (connected || flushDue)) {
+        if(RC_SUCCESS == sampleLog.flush()) lastLogFlush = getUptimeMs();
+    }
+    if(connected && published) replaySampleLog();
+
+    // Sleep until the next sensor is due
+    uint32_t sleepMs = SENSOR_LOOP_MAX_SLEEP_MS;
+    for(const std::shared_ptr<Sensor>& s : *registry) {
+        const uint32_t untilDue = s->getTimeUntilDueMs(getUptimeMs());
+        if(untilDue < sleepMs) sleepMs = untilDue;
+    }
+    if(sleepMs > 0) vTaskDelay(pdMS_TO_TICKS(sleepMs));
 }
 
 #endif  // PIO_UNIT_TESTING
\ No newline at end of file
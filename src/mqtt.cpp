@@ -5,87 +5,184 @@
 
 #include "global.h"
 #include "global_objects.h"
+#include "helper_functions.h"
 
 TaskHandle_t mqttTaskHandle;
 WiFiClient espWiFiClient;
-PubSubClient mqttClient(espWiFiClient);
+// PubSubClient is not thread safe. Only used by the MQTT task
+static PubSubClient mqttClient(espWiFiClient);
+MqttOutbox mqttOutbox;
+MqttConnection mqttConnection(MQTT_RECONNECT_MIN_BACKOFF_MS, MQTT_RECONNECT_MAX_BACKOFF_MS, esp_random());
+// Message which is being published. Too large for the stack of the MQTT task
+static MqttOutboxMessage_t outboxMessage;
 
-void reconnect() {
-    // Loop until we're reconnected
-    while(!mqttClient.connected()) {
-        ramLogger.logLnf("Attempting MQTT connection, ID: %s, User: %s", settings.mqtt.clientID,
-                         settings.mqtt.username);
-        // Attempt to connect
-        if(mqttClient.connect(settings.mqtt.clientID, settings.mqtt.username, settings.mqtt.password)) {
-            Serial.println("connected");
-        } else {
-            Serial.println(" try again in 5 seconds");
-            // Wait 5 seconds before retrying
-            delay(5000);
+/**
+ * @brief Wakes up the MQTT task when a message or urgent event was queued
+ */
+static void wakeMqttTask() {
+    if(mqttTaskHandle != NULL) xTaskNotifyGive(mqttTaskHandle);
+}
+
+/**
+ * @brief Publishes all queued urgent events
+ */
+static void publishUrgentEvents() {
+    if(!mqttClient.connected()) return;
+    std::shared_ptr<const SensorRegistry> registry;
+    UrgentEvent_t event;
+    while(urgentEvents.pop(event)) {
+        if(registry == nullptr) registry = getSensors();
+        const Sensor* s = registry->find(event.sensorId);
+        // Events of sensors which were removed by a config reload are obsolete
+        if(s == nullptr) continue;
+        char payload[FLOAT_FORMAT_BUFFER_SIZE] = "";
+        formatFloat(payload, sizeof(payload), event.value, s->getDecimals());
+        mqttClient.publish(s->getEventTopic(), payload);
+    }
+}
+
+/**
+ * @brief Publishes up to MQTT_OUTBOX_BATCH_SIZE messages of the outbox, each after the pending urgent events.
+ * Messages stay in the outbox if the connection is lost
+ *
+ * @return true if messages are left in the outbox while connected
+ */
+static bool publishOutbox() {
+    if(mqttConnection.getState() != MqttConnection::STATE_CONNECTED) return false;
+    for(uint32_t i = 0; i < MQTT_OUTBOX_BATCH_SIZE; i++) {
+        publishUrgentEvents();
+        if(RC_SUCCESS != mqttOutbox.front(outboxMessage)) return false;
+        if(!mqttClient.publish(outboxMessage.topic, outboxMessage.payload, outboxMessage.payloadLength)) {
+            if(!mqttClient.connected()) {
+                mqttConnection.connectionLost(getUptimeMs());
+                return false;
+            }
+            // Rejected by the client, e.g. larger than its buffer. Retrying would block the outbox
+            ramLogger.logLnf("Failed to publish to %s", outboxMessage.topic);
         }
+        mqttOutbox.pop(outboxMessage.sequence);
     }
+    return mqttOutbox.getMetrics().depth > 0;
 }
 
-void mqttTask(void* pvParameters) {
-    TickType_t lastWakeTime;
+bool mqttPublish(const char topic[], const char payload[]) { return RC_SUCCESS == mqttOutbox.push(topic, payload); }
+
+bool mqttPublish(const char topic[], const uint8_t payload[], uint32_t length) {
+    return RC_SUCCESS == mqttOutbox.push(topic, payload, length);
+}
+
+bool mqttConnected() { return mqttConnection.getState() == MqttConnection::STATE_CONNECTED; }
+
+/**
+ * @brief Returns the description of a PubSubClient state for logging
+ *
+ * @param state [IN] Return value of PubSubClient::state
+ * @param permanent [OUT] Set if retrying cannot fix the error
+ * @return const char*
+ */
+static const char* clientStateToString(int state, bool& permanent) {
+    permanent = false;
+    switch(state) {
+        case MQTT_CONNECTION_TIMEOUT:
+            return "connection timeout";
+        case MQTT_CONNECTION_LOST:
+            return "connection lost";
+        case MQTT_CONNECT_FAILED:
+            return "connection failed";
+        case MQTT_DISCONNECTED:
+            return "disconnected";
+        case MQTT_CONNECT_BAD_PROTOCOL:
+            return "version not supported by server";
+        case MQTT_CONNECT_BAD_CLIENT_ID:
+            return "client ID rejected by server";
+        case MQTT_CONNECT_UNAVAILABLE:
+            return "server unavailable";
+        case MQTT_CONNECT_BAD_CREDENTIALS:
+            permanent = true;
+            return "credentials rejected";
+        case MQTT_CONNECT_UNAUTHORIZED:
+            permanent = true;
+            return "client not authorized";
+        default:
+            return "unknown error";
+    }
+}
 
+/**
+ * @brief Connects to the broker if an attempt is due and services the connection otherwise
+ */
+static void maintainConnection() {
+    bool permanent = false;
+    switch(mqttConnection.getState()) {
+        case MqttConnection::STATE_CONNECTED:
+            // Processes incoming messages and keeps the connection alive
+            if(!mqttClient.loop()) {
+                ramLogger.logLnf("MQTT %s", clientStateToString(mqttClient.state(), permanent));
+                mqttConnection.connectionLost(getUptimeMs());
+            }
+            break;
+        case MqttConnection::STATE_HALTED:
+            break;
+        default:
+            if(mqttConnection.getTimeUntilConnectMs(getUptimeMs()) > 0 || WL_CONNECTED != WiFi.status()) break;
+            mqttConnection.connecting(getUptimeMs());
+            // Blocks at most for the TCP connect and MQTT_SOCKET_TIMEOUT_S
+            if(mqttClient.connect(settings.mqtt.clientID, settings.mqtt.username, settings.mqtt.password)) {
+                mqttConnection.connected(getUptimeMs());
+            } else {
+                const char* error = clientStateToString(mqttClient.state(), permanent);
+                mqttConnection.connectFailed(getUptimeMs(), permanent);
+                ramLogger.logLnf("MQTT %s, retrying in %ums", error, mqttConnection.getMetrics().backoffMs);
+            }
+            break;
+    }
+}
+
+void mqttTask(void* pvParameters) {
     // setup
     mqttClient.setKeepAlive(MQTT_CONNECTION_KEEPALIVE_S);
+    mqttClient.setSocketTimeout(MQTT_SOCKET_TIMEOUT_S);
     IPAddress serverIP;
     serverIP.fromString(settings.mqtt.brokerAddress);
     ramLogger.logLnf("MQTT broker address: %s", serverIP.toString().c_str());
     mqttClient.setServer(serverIP, settings.mqtt.brokerPort);
+    // Large enough for the largest message of the outbox and the MQTT header
+    mqttClient.setBufferSize(MQTT_OUTBOX_MAX_TOPIC_LENGTH + MQTT_OUTBOX_MAX_PAYLOAD_LENGTH + 16);
+    // Send small urgent messages right away instead of waiting for more data to fill a segment
+    espWiFiClient.setNoDelay(true);
+    mqttOutbox.setDropPolicy((settings.mqtt.outboxDrop == MQTT_OUTBOX_DROP_NEWEST) ? MqttOutbox::DROP_NEWEST
+                                                                                     : MqttOutbox::DROP_OLDEST);
+    mqttOutbox.setWakeFunction(wakeMqttTask);
+    urgentEvents.setWakeFunction(wakeMqttTask);
 
+    MqttConnection::State_t state = mqttConnection.getState();
     while(1) {
-        // Get current tick count for more precise cycle time calculation
-        lastWakeTime = xTaskGetTickCount();
+        maintainConnection();
+        const bool pending = publishOutbox();
 
-        // Process messages and maintain connection
-        if(!mqttClient.connected()) {
-            // lost connection. Try to reconnect...
-            int8_t err = mqttClient.connect(settings.mqtt.clientID, settings.mqtt.username, settings.mqtt.password);
-            bool stopFlag = false;
-            switch(err) {
-                default:
-                    break;
-                case MQTT_CONNECTION_TIMEOUT:
-                    ramLogger.logLn("MQTT connection timeout");
-                    break;
-                case MQTT_CONNECTION_LOST:
-                    ramLogger.logLn("MQTT connection lost");
-                    break;
-                case MQTT_CONNECT_FAILED:
-                    ramLogger.logLn("MQTT connection failed");
-                    break;
-                case MQTT_CONNECT_BAD_PROTOCOL:
-                    ramLogger.logLn("MQTT version not supported by server");
-                    break;
-                case MQTT_CONNECT_BAD_CLIENT_ID:
-                    ramLogger.logLn("MQTT client ID rejected by server");
-                    break;
-                case MQTT_CONNECT_UNAVAILABLE:
-                    ramLogger.logLn("MQTT server unavailable");
-                    break;
-                case MQTT_CONNECT_BAD_CREDENTIALS:
-                    ramLogger.logLn("MQTT credentials rejected");
-                    stopFlag = true;
-                    break;
-                case MQTT_CONNECT_UNAUTHORIZED:
-                    ramLogger.logLn("MQTT client not authorized");
-                    stopFlag = true;
-                    break;
-            }
-            if(stopFlag) {
-                ramLogger.logLn("Critical MQTT error. Halting MQTT task");
-                vTaskSuspend(NULL);
-            }
+        // Log state changes
+        const MqttConnection::State_t newState = mqttConnection.getState();
+        if(newState != state) {
+            if(newState == MqttConnection::STATE_CONNECTED)
+                ramLogger.logLnf("MQTT connected after %ums", mqttConnection.getMetrics().lastReconnectMs);
+            else
+                ramLogger.logLnf("MQTT %s -> %s", MqttConnection::stateToString(state),
+                                 MqttConnection::stateToString(newState));
+            state = newState;
         }
-        mqttClient.loop();
+        if(pending) continue;
 
-        // Sleep until next connection check is due
-        if(pdFALSE == xTaskDelayUntil(&lastWakeTime, pdMS_TO_TICKS(MQTT_TASK_CYCLE_TIME_MS))) {
-            ramLogger.logLn("MQTT task cycle time too low");
+        // Sleep until new messages or urgent events arrive, incoming data has to be processed
+        // or the next connection attempt is due
+        uint32_t sleepMs = MQTT_POLL_INTERVAL_MS;
+        if(state == MqttConnection::STATE_HALTED) {
+            sleepMs = UINT32_MAX;
+        } else if(state != MqttConnection::STATE_CONNECTED) {
+            // Without WiFi the next attempt is delayed until it may be back
+            sleepMs = (WL_CONNECTED == WiFi.status()) ? mqttConnection.getTimeUntilConnectMs(getUptimeMs())
+                                                      : MQTT_RECONNECT_MIN_BACKOFF_MS;
         }
+        if(sleepMs > 0) ulTaskNotifyTake(pdTRUE, (sleepMs == UINT32_MAX) ? portMAX_DELAY : pdMS_TO_TICKS(sleepMs));
     }
     // Task should never return
-}
\ No newline at end of file
+}
@@ -4,21 +4,66 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 
+#include "telemetry/MqttConnection.h"
+#include "telemetry/MqttOutbox.h"
+
 #define MQTT_TASK_NAME ("MQTT_Task")
 #define MQTT_TASK_STACK_SIZE (2048)
 #define MQTT_TASK_PRIORITY (LOOP_TASK_PRIORITY + 1)
 
 extern TaskHandle_t mqttTaskHandle;
-extern PubSubClient mqttClient;
+/**
+ * @brief Messages waiting for the MQTT task. Only the MQTT task uses the client,
+ * all other tasks publish through the outbox.
+ */
+extern MqttOutbox mqttOutbox;
+/**
+ * @brief State of the connection to the broker, maintained by the MQTT task
+ */
+extern MqttConnection mqttConnection;
+
+/**
+ * @brief Queues a message in mqttOutbox and wakes up the MQTT task to publish it.
+ * Urgent events are published before queued messages, so that they are never held up
+ * by routine telemetry. Safe to call from any task.
+ *
+ * @param topic [IN]
+ * @param payload [IN]
+ * @return true if the message was queued
+ */
+bool mqttPublish(const char topic[], const char payload[]);
+
+/**
+ * @brief Queues a message with a binary payload, see mqttPublish
+ *
+ * @param topic [IN]
+ * @param payload [IN]
+ * @param length [IN] Length of payload in bytes
+ * @return true if the message was queued
+ */
+bool mqttPublish(const char topic[], const uint8_t payload[], uint32_t length);
+
+/**
+ * @brief Checks whether the client was connected to the broker when the MQTT task last checked.
+ * Safe to call from any task.
+ *
+ * @return true if connected
+ */
+bool mqttConnected();
 
 /**
  * @brief MQTT Task function. Should never return.
- * The job of this function is to set up the mqtt client and periodically check
- * its connection to the server. If it got disconnected, reconnect.
+ * The job of this function is to set up the mqtt client and maintain its connection
+ * to the server through mqttConnection. Failed connection attempts are retried with a jittered
+ * exponential backoff between MQTT_RECONNECT_MIN_BACKOFF_MS and MQTT_RECONNECT_MAX_BACKOFF_MS.
  *
- * Cycle time: MQTT_TASK_CYCLE_TIME_MS
+ * The task sleeps on its task notification. New messages in mqttOutbox and urgent events wake
+ * it up immediately, otherwise it wakes up every MQTT_POLL_INTERVAL_MS while connected to process
+ * incoming data, or when the next connection attempt is due. It publishes the outbox in batches
+ * of MQTT_OUTBOX_BATCH_SIZE messages and keeps them while disconnected.
+ * Urgent events are published to MQTT_BASE_TOPIC/<deviceTopic>/event/<sensorName>.
  *
  * @param pvParameters
  */
 void mqttTask(void* pvParameters);
-#endif  // MQTT_H
\ No newline at end of file
+#endif  // MQTT_H
@@ -1,8 +1,48 @@
 #include "ADCSensor.h"
 
+#include "SensorType.h"
 #include "global.h"
 
 ADCSensor::ADCSensor(char name[], uint32_t pin, std::shared_ptr<Transformer> transformer)
     : Sensor(name, transformer), m_adcPin(pin) {}
 
-float_t ADCSensor::readSensorRaw() { return analogRead(m_adcPin); }
\ No newline at end of file
+ADCSensor::ADCSensor(char name[], uint32_t pin, AdcAcquisition& acquisition, uint32_t oversampling,
+                     std::shared_ptr<Transformer> transformer)
+    : Sensor(name, transformer),
+      m_adcPin(pin),
+      m_acquisition(&acquisition),
+      m_oversampling(oversampling),
+      m_channel(acquisition.openChannel(pin, oversampling)) {}
+
+float_t ADCSensor::readSensorRaw() {
+    // In continuous mode only reached if no new value was decimated since the last reading
+    if(m_acquisition != nullptr) return m_lastValue;
+    return analogRead(m_adcPin);
+}
+
+uint32_t ADCSensor::readSensorBlock(float_t values[], uint32_t maxCount) {
+    if(m_acquisition == nullptr) return Sensor::readSensorBlock(values, maxCount);
+    if(m_channel == nullptr) m_channel = m_acquisition->openChannel(m_adcPin, m_oversampling);
+    if(m_channel == nullptr) return 0;
+    const uint32_t count = m_channel->read(values, maxCount);
+    if(count > 0) m_lastValue = values[count - 1];
+    return count;
+}
+
+static const ConfigParam_t adcSensorParams[] = {
+    {"pin", CONFIG_PARAM_INT, true, nullptr},
+    // If given, the pin is converted continuously in the background
+    {"oversampling", CONFIG_PARAM_INT, false, nullptr},
+};
+
+static Sensor* createADCSensor(char name[], const ConfigParams& params, const SensorContext_t& context,
+                               std::shared_ptr<Transformer> transformer) {
+    const int32_t pin = params.getInt("pin");
+    const int32_t oversampling = params.getInt("oversampling");
+    if(oversampling < 0 || oversampling > ADC_MAX_OVERSAMPLING) return nullptr;
+
+    if(oversampling > 0) return new ADCSensor(name, pin, context.adcAcquisition, oversampling, transformer);
+    return new ADCSensor(name, pin, transformer);
+}
+
+REGISTER_SENSOR_TYPE(ADCSensor, adcSensorParams, createADCSensor);
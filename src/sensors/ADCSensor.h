@@ -1,11 +1,18 @@
 #ifndef ADCSENSOR_H
 #define ADCSENSOR_H
 #include "Sensor.h"
+#include "adc/AdcAcquisition.h"
 
 /**
  * @brief Class for reading a sensor connected directly to an ADC input pin
  * on the microcontroller
  *
+ * In single mode, every reading is one blocking conversion.
+ * In continuous mode, the pin is converted in the background by an AdcAcquisition and
+ * every reading hands all values decimated since the previous reading to the transformer pipeline.
+ *
+ * @note Single and continuous mode can not be mixed, since analogRead is not available
+ * while the ADC runs in continuous mode.
  */
 class ADCSensor : public Sensor {
    public:
@@ -19,15 +26,41 @@ class ADCSensor : public Sensor {
      */
     ADCSensor(char name[], uint32_t pin, std::shared_ptr<Transformer> transformer = nullptr);
 
+    /**
+     * @brief Constructs a new ADCSensor in continuous mode
+     *
+     * @param name [IN] Name of the sensor
+     * @param pin [IN] GPIO pin number
+     * @param acquisition [IN] Acquisition which converts the pin. Has to outlive the sensor
+     * @param oversampling [IN] Number of conversions which are averaged into one value
+     * @param transformer [IN] Pointer to optional data transformation pipeline
+     */
+    ADCSensor(char name[], uint32_t pin, AdcAcquisition& acquisition, uint32_t oversampling,
+              std::shared_ptr<Transformer> transformer = nullptr);
+
    protected:
     float_t readSensorRaw() override;
 
+    uint32_t readSensorBlock(float_t values[], uint32_t maxCount) override;
+
    private:
     /**
      * @brief ADC pin to which the sensor is connected
      *
      */
     const uint32_t m_adcPin;
+
+    /**
+     * @brief Nullptr in single mode
+     */
+    AdcAcquisition* const m_acquisition = nullptr;
+    const uint32_t m_oversampling = 1;
+    /**
+     * @brief Open channel in continuous mode. If the channel was still in use on creation,
+     * for example by the sensor this one replaces on a config reload, opening is retried on every reading.
+     */
+    std::shared_ptr<AdcAcquisition::Channel> m_channel;
+    float_t m_lastValue = 0;
 };
 
-#endif  // ADCSENSOR_H
\ No newline at end of file
+#endif  // ADCSENSOR_H
@@ -0,0 +1,41 @@
+#include "AdaptiveInterval.h"
+
+AdaptiveInterval::AdaptiveInterval(uint32_t minIntervalMs, uint32_t maxIntervalMs, float_t rateThreshold,
+                                   float_t varianceThreshold)
+    : m_minIntervalMs(minIntervalMs),
+      m_maxIntervalMs(maxIntervalMs),
+      m_rateThreshold(rateThreshold),
+      m_varianceThreshold(varianceThreshold),
+      m_intervalMs(minIntervalMs) {}
+
+uint32_t AdaptiveInterval::update(float_t value, uint32_t timestampMs) {
+    if(!m_initialized) {
+        // Start fast until there is enough history to judge the signal
+        m_initialized = true;
+        m_lastValue = value;
+        m_lastTimestampMs = timestampMs;
+        m_mean = value;
+        m_intervalMs = m_minIntervalMs;
+        return m_intervalMs;
+    }
+
+    const uint32_t elapsedMs = timestampMs - m_lastTimestampMs;
+    if(elapsedMs > 0) m_rate = fabsf(value - m_lastValue) * 1000.0f / static_cast<float_t>(elapsedMs);
+    m_lastValue = value;
+    m_lastTimestampMs = timestampMs;
+
+    // Exponentially weighted mean and variance
+    const float_t diff = value - m_mean;
+    m_mean += SENSOR_ADAPTIVE_EWMA_ALPHA * diff;
+    m_variance = (1.0f - SENSOR_ADAPTIVE_EWMA_ALPHA) * (m_variance + SENSOR_ADAPTIVE_EWMA_ALPHA * diff * diff);
+
+    const bool changing = (m_rateThreshold > 0 && m_rate > m_rateThreshold) ||
+                          (m_varianceThreshold > 0 && m_variance > m_varianceThreshold);
+    if(changing) {
+        m_intervalMs = m_minIntervalMs;
+    } else if(m_intervalMs < m_maxIntervalMs) {
+        const float_t next = static_cast<float_t>(m_intervalMs) * SENSOR_ADAPTIVE_GROWTH_FACTOR;
+        m_intervalMs = (next >= static_cast<float_t>(m_maxIntervalMs)) ? m_maxIntervalMs : static_cast<uint32_t>(next);
+    }
+    return m_intervalMs;
+}
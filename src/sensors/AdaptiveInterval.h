@@ -0,0 +1,73 @@
+#ifndef ADAPTIVE_INTERVAL_H
+#define ADAPTIVE_INTERVAL_H
+#include "global.h"
+
+/**
+ * @brief Chooses the sample interval of a sensor based on how much its signal changes.
+ *
+ * Each processed sample updates the rate of change against the previous sample and an
+ * exponentially weighted variance. If either crosses its threshold, the interval drops to the
+ * minimum right away so that transients are captured. While both stay below their thresholds,
+ * the interval grows by SENSOR_ADAPTIVE_GROWTH_FACTOR per sample up to the maximum.
+ * Uses constant memory.
+ */
+class AdaptiveInterval {
+   public:
+    /**
+     * @brief Constructor
+     *
+     * @param minIntervalMs [IN] Interval while the signal changes
+     * @param maxIntervalMs [IN] Interval while the signal is quiet
+     * @param rateThreshold [IN] Absolute change per second above which the signal counts as changing.
+     *  0 disables this criterion
+     * @param varianceThreshold [IN] Variance above which the signal counts as changing.
+     *  0 disables this criterion
+     */
+    AdaptiveInterval(uint32_t minIntervalMs, uint32_t maxIntervalMs, float_t rateThreshold,
+                     float_t varianceThreshold);
+
+    /**
+     * @brief Adds a sample and calculates the interval until the next one
+     *
+     * @param value [IN] Sample value after the transformer pipeline
+     * @param timestampMs [IN] Time at which the sample was taken
+     * @return uint32_t New sample interval in ms
+     */
+    uint32_t update(float_t value, uint32_t timestampMs);
+
+    inline uint32_t getIntervalMs() const { return m_intervalMs; }
+
+    inline uint32_t getMinIntervalMs() const { return m_minIntervalMs; }
+
+    inline uint32_t getMaxIntervalMs() const { return m_maxIntervalMs; }
+
+    /**
+     * @brief Returns the absolute rate of change between the latest two samples
+     *
+     * @return float_t Change per second
+     */
+    inline float_t getRate() const { return m_rate; }
+
+    /**
+     * @brief Returns the exponentially weighted variance of the samples
+     *
+     * @return float_t
+     */
+    inline float_t getVariance() const { return m_variance; }
+
+   private:
+    const uint32_t m_minIntervalMs;
+    const uint32_t m_maxIntervalMs;
+    const float_t m_rateThreshold;
+    const float_t m_varianceThreshold;
+
+    uint32_t m_intervalMs;
+    bool m_initialized = false;
+    float_t m_lastValue = 0;
+    uint32_t m_lastTimestampMs = 0;
+    float_t m_rate = 0;
+    float_t m_mean = 0;
+    float_t m_variance = 0;
+};
+
+#endif  // ADAPTIVE_INTERVAL_H
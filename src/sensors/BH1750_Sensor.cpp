@@ -1,11 +1,33 @@
 #include "BH1750_Sensor.h"
 
-#include <Wire.h>
+#include "SensorType.h"
 
-BH1750_Sensor::BH1750_Sensor(char name[], uint8_t addr, std::shared_ptr<Transformer> transformer)
-    : Sensor(name, transformer), m_sensor{addr} {
-    Wire.begin();
-    m_sensor.begin(BH1750::CONTINUOUS_HIGH_RES_MODE, addr, &Wire);
+BH1750_Sensor::BH1750_Sensor(char name[], uint8_t addr, I2cBusManager& bus, std::shared_ptr<Transformer> transformer)
+    : Sensor(name, transformer), m_bus(bus), m_device(std::make_shared<BH1750Device>(addr)) {
+    attach();
 }
 
-float_t BH1750_Sensor::readSensorRaw() { return static_cast<float_t>(m_sensor.readLightLevel()); }
\ No newline at end of file
+void BH1750_Sensor::attach() { m_attached = (RC_SUCCESS == m_bus.addDevice(m_device)); }
+
+float_t BH1750_Sensor::readSensorRaw() {
+    if(!m_attached) attach();
+    float_t lux;
+    if(!m_attached || !m_device->getLux(lux)) {
+        reportReadFailure();
+        return NAN;
+    }
+    return lux;
+}
+
+static const ConfigParam_t bh1750SensorParams[] = {
+    // Defaults to BH1750_I2C_ADDRESS_LOW
+    {"addr", CONFIG_PARAM_INT, false, nullptr},
+};
+
+static Sensor* createBH1750_Sensor(char name[], const ConfigParams& params, const SensorContext_t& context,
+                                   std::shared_ptr<Transformer> transformer) {
+    const uint8_t addr = params.isSet("addr") ? params.getInt("addr") : BH1750_I2C_ADDRESS_LOW;
+    return new BH1750_Sensor(name, addr, context.i2cBusManager, transformer);
+}
+
+REGISTER_SENSOR_TYPE(BH1750_Sensor, bh1750SensorParams, createBH1750_Sensor);
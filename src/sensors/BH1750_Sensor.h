@@ -4,27 +4,37 @@
 #define BH1750_I2C_ADDRESS_LOW (0x23)
 #define BH1750_I2C_ADDRESS_HIGH (0x5C)
 
-#include <BH1750.h>
-
 #include "Sensor.h"
+#include "i2c/BH1750Device.h"
+#include "i2c/I2cBusManager.h"
 
 class BH1750_Sensor : public Sensor {
    public:
     /**
-     * @brief Creates a BH1750 sensor which can read the current light level
+     * @brief Creates a BH1750 sensor which can read the current light level.
+     * The device is measured in the cycles of the bus manager, reading the sensor
+     * only returns the latest measurement and never accesses the bus.
      *
      * @param name [IN] Name of the sensor
      * @param addr [IN] I2C address. If the address pin is low, this should be 0x23 or 0x5c if it is high
+     * @param bus [IN] Manager of the bus on which the sensor is connected
      * @param transformer [IN] Pointer to optional data transformation pipeline
      */
-    BH1750_Sensor(char name[], uint8_t addr = BH1750_I2C_ADDRESS_LOW,
-                  std::shared_ptr<Transformer> transformer = nullptr);
+    BH1750_Sensor(char name[], uint8_t addr, I2cBusManager& bus, std::shared_ptr<Transformer> transformer = nullptr);
 
    protected:
     float_t readSensorRaw() override;
 
    private:
-    BH1750 m_sensor;
+    /**
+     * @brief Adds the device to the bus manager. Fails while another sensor, e.g. the one
+     * this sensor replaces during a config reload, still uses the address
+     */
+    void attach();
+
+    I2cBusManager& m_bus;
+    std::shared_ptr<BH1750Device> m_device;
+    bool m_attached = false;
 };
 
-#endif  // BH1750_SENSOR_H
\ No newline at end of file
+#endif  // BH1750_SENSOR_H
@@ -1,8 +1,33 @@
 #include "BooleanSensor.h"
 
+#include <cstring>
+
+#include "SensorType.h"
+
 BooleanSensor::BooleanSensor(char name[], uint32_t pin, PinMode pinmode, std::shared_ptr<Transformer> transformer)
     : Sensor(name, transformer), m_gpioPin(pin) {
     pinMode(m_gpioPin, pinmode);
 }
 
-float_t BooleanSensor::readSensorRaw() { return digitalRead(m_gpioPin); }
\ No newline at end of file
+float_t BooleanSensor::readSensorRaw() { return digitalRead(m_gpioPin); }
+
+static const ConfigParam_t booleanSensorParams[] = {
+    {"pin", CONFIG_PARAM_INT, true, nullptr},
+    {"pinMode", CONFIG_PARAM_STRING, false, "Input"},
+};
+
+static Sensor* createBooleanSensor(char name[], const ConfigParams& params, const SensorContext_t& context,
+                                   std::shared_ptr<Transformer> transformer) {
+    char pinMode[32] = "";
+    if(RC_SUCCESS != params.getString("pinMode", pinMode, sizeof(pinMode))) return nullptr;
+    BooleanSensor::PinMode mode = BooleanSensor::Input;
+    if(strcmp(pinMode, "InputPullUp") == 0) {
+        mode = BooleanSensor::InputPullUp;
+    } else if(strcmp(pinMode, "InputPullDown") == 0) {
+        mode = BooleanSensor::InputPullDown;
+    }
+
+    return new BooleanSensor(name, params.getInt("pin"), mode, transformer);
+}
+
+REGISTER_SENSOR_TYPE(BooleanSensor, booleanSensorParams, createBooleanSensor);
@@ -1,30 +1,50 @@
 #include "DHT22.h"
 
+#include <strings.h>
+
+#include "SensorType.h"
+
 DHT22::DHT22(char name[], uint32_t pin, Type type, std::shared_ptr<Transformer> transformer)
-    : Sensor(name, transformer), m_type(type), m_dht(DHT_Unified(pin, 22)) {
-    // the begin function also sets the pinMode
-    m_dht.begin();
-}
+    : Sensor(name, transformer), m_type(type), m_reader(DhtRmtReader::forPin(pin)) {}
 
 float_t DHT22::readSensorRaw() {
-    sensors_event_t event;
-    float_t val = 0;
+    DhtReading_t reading;
+    if(m_reader == nullptr || RC_SUCCESS != m_reader->read(reading)) {
+        reportReadFailure();
+        return m_lastValidValue;
+    }
     switch(m_type) {
         case TEMPERATURE:
-            m_dht.temperature().getEvent(&event);
-            val = event.temperature;
+            m_lastValidValue = reading.temperature;
             break;
         case HUMIDITY:
-            m_dht.humidity().getEvent(&event);
-            val = event.relative_humidity;
+            m_lastValidValue = reading.humidity;
             break;
         default:
             break;
     }
-    if(isnan(val)) {
-        return m_lastValidValue;
-    } else {
-        m_lastValidValue = val;
-        return val;
-    }
-}
\ No newline at end of file
+    return m_lastValidValue;
+}
+
+static const ConfigParam_t dht22Params[] = {
+    {"pin", CONFIG_PARAM_INT, true, nullptr},
+    // temperature or humidity, case insensitive
+    {"type", CONFIG_PARAM_STRING, true, nullptr},
+};
+
+static Sensor* createDHT22(char name[], const ConfigParams& params, const SensorContext_t& context,
+                           std::shared_ptr<Transformer> transformer) {
+    char type[32] = "";
+    if(RC_SUCCESS != params.getString("type", type, sizeof(type))) return nullptr;
+    DHT22::Type t;
+    if(strcasecmp("temperature", type) == 0)
+        t = DHT22::TEMPERATURE;
+    else if(strcasecmp("humidity", type) == 0)
+        t = DHT22::HUMIDITY;
+    else
+        return nullptr;
+
+    return new DHT22(name, params.getInt("pin"), t, transformer);
+}
+
+REGISTER_SENSOR_TYPE(DHT22, dht22Params, createDHT22);
@@ -1,9 +1,6 @@
 #ifndef DHT22_H
 #define DHT22_H
-#include <Adafruit_Sensor.h>
-#include <DHT.h>
-#include <DHT_U.h>
-
+#include "DhtRmtReader.h"
 #include "Sensor.h"
 
 class DHT22 : public Sensor {
@@ -15,7 +12,8 @@ class DHT22 : public Sensor {
      * a temperature or humidity reading based on the type parameter.
      *
      * To get both temperature and humidity, create two DHT22 objects
-     * on the same pin with a different type parameter.
+     * on the same pin with a different type parameter. Both share
+     * the same measurement.
      *
      * @param name [IN] Name of the sensor
      * @param pin [IN] GPIO pin number
@@ -29,8 +27,11 @@ class DHT22 : public Sensor {
 
    private:
     const Type m_type;
-    DHT_Unified m_dht;
+    /**
+     * @brief Nullptr if no RMT channel was available for the pin
+     */
+    std::shared_ptr<DhtRmtReader> m_reader;
     float_t m_lastValidValue = 0;
 };
 
-#endif  // DHT22_H
\ No newline at end of file
+#endif  // DHT22_H
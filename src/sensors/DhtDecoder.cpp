@@ -0,0 +1,51 @@
+#include "DhtDecoder.h"
+
+#include <cstring>
+
+RC_t dhtDecodePulses(const DhtPulse_t pulses[], uint32_t count, uint8_t data[DHT_FRAME_BYTES]) {
+    // Find the response: a long low pulse directly followed by a long high pulse
+    uint32_t i = 0;
+    while(i + 1 < count) {
+        if(pulses[i].level == 0 && pulses[i].durationUs >= DHT_RESPONSE_MIN_US && pulses[i + 1].level == 1 &&
+           pulses[i + 1].durationUs >= DHT_RESPONSE_MIN_US)
+            break;
+        i++;
+    }
+    if(i + 1 >= count) return RC_ERROR_BAD_DATA;
+    i += 2;
+
+    memset(data, 0, DHT_FRAME_BYTES);
+    for(uint32_t bit = 0; bit < DHT_FRAME_BYTES * 8; bit++, i += 2) {
+        if(i + 1 >= count) return RC_ERROR_BAD_DATA;
+        const DhtPulse_t& low = pulses[i];
+        const DhtPulse_t& high = pulses[i + 1];
+        if(low.level != 0 || high.level != 1) return RC_ERROR_BAD_DATA;
+        if(low.durationUs > DHT_BIT_MAX_US || high.durationUs > DHT_BIT_MAX_US) return RC_ERROR_BAD_DATA;
+        if(high.durationUs > DHT_BIT_THRESHOLD_US) data[bit / 8] |= 0x80 >> (bit % 8);
+    }
+
+    const uint8_t checksum = data[0] + data[1] + data[2] + data[3];
+    if(checksum != data[4]) return RC_ERROR_CHECKSUM;
+    return RC_SUCCESS;
+}
+
+RC_t dhtDecodeFrame(const uint8_t data[DHT_FRAME_BYTES], DhtReading_t& reading) {
+    const uint16_t rawHumidity = (data[0] << 8) | data[1];
+    // Temperature is in sign-magnitude format
+    const uint16_t rawTemperature = ((data[2] & 0x7F) << 8) | data[3];
+    const float_t humidity = rawHumidity / 10.0f;
+    float_t temperature = rawTemperature / 10.0f;
+    if(data[2] & 0x80) temperature = -temperature;
+    // Limits of the DHT22 measurement range
+    if(humidity > 100.0f || temperature < -40.0f || temperature > 80.0f) return RC_ERROR_RANGE;
+    reading.humidity = humidity;
+    reading.temperature = temperature;
+    return RC_SUCCESS;
+}
+
+RC_t dhtDecode(const DhtPulse_t pulses[], uint32_t count, DhtReading_t& reading) {
+    uint8_t data[DHT_FRAME_BYTES];
+    const RC_t err = dhtDecodePulses(pulses, count, data);
+    if(RC_SUCCESS != err) return err;
+    return dhtDecodeFrame(data, reading);
+}
@@ -0,0 +1,79 @@
+#ifndef DHT_DECODER_H
+#define DHT_DECODER_H
+#include "global.h"
+
+/**
+ * @brief Number of data bytes in a DHT22 frame: 2 bytes humidity, 2 bytes temperature, 1 byte checksum
+ */
+#define DHT_FRAME_BYTES (5)
+
+/**
+ * @brief Minimum duration in µs of the low and high pulse with which the sensor
+ * answers the start signal. Nominally 80 µs each.
+ */
+#define DHT_RESPONSE_MIN_US (60)
+
+/**
+ * @brief High pulses of a data bit longer than this in µs are a 1, shorter ones a 0.
+ * Nominally 26-28 µs for a 0 and 70 µs for a 1.
+ */
+#define DHT_BIT_THRESHOLD_US (48)
+
+/**
+ * @brief Longest low or high pulse in µs which is still accepted as part of a data bit.
+ * Longer pulses mean that the frame is corrupted.
+ */
+#define DHT_BIT_MAX_US (100)
+
+/**
+ * @brief Level and duration of a single pulse of the DHT data line
+ */
+typedef struct {
+    uint16_t durationUs;
+    uint8_t level;
+} DhtPulse_t;
+
+/**
+ * @brief Result of a DHT22 measurement
+ */
+typedef struct {
+    float_t temperature;
+    float_t humidity;
+} DhtReading_t;
+
+/**
+ * @brief Extracts the data bytes from the pulses of the DHT data line captured after the start signal.
+ *
+ * Pulses before the sensor response (low and high pulse of at least DHT_RESPONSE_MIN_US)
+ * are skipped, e.g. the remainder of the start signal. Every following pair of a low and a
+ * high pulse is one bit, MSB first. Pulses after the last bit are ignored.
+ *
+ * @param pulses [IN] Captured pulses in chronological order
+ * @param count [IN] Number of pulses
+ * @param data [OUT] The DHT_FRAME_BYTES data bytes
+ * @return RC_t RC_SUCCESS on success,
+ *  RC_ERROR_BAD_DATA if there is no response, a pulse is out of range or the frame is incomplete,
+ *  RC_ERROR_CHECKSUM if the checksum byte does not match
+ */
+RC_t dhtDecodePulses(const DhtPulse_t pulses[], uint32_t count, uint8_t data[DHT_FRAME_BYTES]);
+
+/**
+ * @brief Converts the data bytes of a DHT22 frame to temperature and humidity
+ *
+ * @param data [IN] The DHT_FRAME_BYTES data bytes, checksum already verified
+ * @param reading [OUT]
+ * @return RC_t RC_SUCCESS on success, RC_ERROR_RANGE if the values are outside of the sensor's range
+ */
+RC_t dhtDecodeFrame(const uint8_t data[DHT_FRAME_BYTES], DhtReading_t& reading);
+
+/**
+ * @brief Combination of dhtDecodePulses and dhtDecodeFrame
+ *
+ * @param pulses [IN] Captured pulses in chronological order
+ * @param count [IN] Number of pulses
+ * @param reading [OUT]
+ * @return RC_t see dhtDecodePulses and dhtDecodeFrame
+ */
+RC_t dhtDecode(const DhtPulse_t pulses[], uint32_t count, DhtReading_t& reading);
+
+#endif  // DHT_DECODER_H
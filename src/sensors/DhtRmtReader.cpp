@@ -0,0 +1,115 @@
+#include "DhtRmtReader.h"
+
+#include <driver/gpio.h>
+
+// Minimum time between two measurements required by the DHT22
+#define DHT_MIN_INTERVAL_MS (2000)
+// Duration of the start signal. The DHT22 requires at least 1 ms, a task delay of 2 ticks
+// guarantees that without busy waiting
+#define DHT_START_SIGNAL_MS (2)
+// Time to wait for the captured answer. A complete frame takes about 5 ms
+#define DHT_RMT_TIMEOUT_MS (20)
+// A line which stays high for this long after the last bit ends the capture
+#define DHT_RMT_IDLE_THRESHOLD_US (200)
+// Glitches shorter than this number of APB clock cycles (80 MHz) are filtered by the RMT
+#define DHT_RMT_FILTER_TICKS (100)
+// Size of the RMT driver's ring buffer for captured items
+#define DHT_RMT_RINGBUFFER_SIZE (512)
+// Response, 40 bits and a few spare pulses for the end of the start signal
+#define DHT_MAX_PULSES (2 * (DHT_FRAME_BYTES * 8 + 4))
+
+// Reader which uses the RMT receive channel with the same index
+typedef struct {
+    std::weak_ptr<DhtRmtReader> reader;
+    uint32_t pin;
+} ReaderSlot_t;
+
+static ReaderSlot_t readerSlots[SOC_RMT_RX_CANDIDATES_PER_GROUP];
+
+std::shared_ptr<DhtRmtReader> DhtRmtReader::forPin(uint32_t pin) {
+    int32_t freeSlot = -1;
+    for(int32_t i = 0; i < SOC_RMT_RX_CANDIDATES_PER_GROUP; i++) {
+        std::shared_ptr<DhtRmtReader> reader = readerSlots[i].reader.lock();
+        if(reader == nullptr) {
+            if(freeSlot < 0) freeSlot = i;
+        } else if(readerSlots[i].pin == pin) {
+            return reader;
+        }
+    }
+    if(freeSlot < 0) return nullptr;
+
+    std::shared_ptr<DhtRmtReader> reader(
+        new DhtRmtReader(pin, static_cast<rmt_channel_t>(RMT_ENCODE_RX_CHANNEL(freeSlot))));
+    if(!reader->m_installed) return nullptr;
+    readerSlots[freeSlot].reader = reader;
+    readerSlots[freeSlot].pin = pin;
+    return reader;
+}
+
+DhtRmtReader::DhtRmtReader(uint32_t pin, rmt_channel_t channel) : m_pin(pin), m_channel(channel) {
+    const gpio_num_t gpioNum = static_cast<gpio_num_t>(pin);
+    rmt_config_t config = RMT_DEFAULT_CONFIG_RX(gpioNum, channel);
+    // 1 µs per tick with the 80 MHz APB clock
+    config.clk_div = 80;
+    config.rx_config.filter_en = true;
+    config.rx_config.filter_ticks_thresh = DHT_RMT_FILTER_TICKS;
+    config.rx_config.idle_threshold = DHT_RMT_IDLE_THRESHOLD_US;
+    if(ESP_OK != rmt_config(&config)) return;
+    if(ESP_OK != rmt_driver_install(channel, DHT_RMT_RINGBUFFER_SIZE, 0)) return;
+    if(ESP_OK != rmt_get_ringbuf_handle(channel, &m_ringbuf)) {
+        rmt_driver_uninstall(channel);
+        return;
+    }
+    // Open drain with the input still enabled, so the start signal can be sent
+    // without detaching the pin from the RMT input
+    gpio_set_direction(gpioNum, GPIO_MODE_INPUT_OUTPUT_OD);
+    gpio_set_pull_mode(gpioNum, GPIO_PULLUP_ONLY);
+    gpio_set_level(gpioNum, 1);
+    m_installed = true;
+}
+
+DhtRmtReader::~DhtRmtReader() {
+    if(m_installed) rmt_driver_uninstall(m_channel);
+}
+
+RC_t DhtRmtReader::measure() {
+    const gpio_num_t gpioNum = static_cast<gpio_num_t>(m_pin);
+    gpio_set_level(gpioNum, 0);
+    delay(DHT_START_SIGNAL_MS);
+    gpio_set_level(gpioNum, 1);
+    rmt_rx_start(m_channel, true);
+
+    size_t length = 0;
+    rmt_item32_t* items =
+        static_cast<rmt_item32_t*>(xRingbufferReceive(m_ringbuf, &length, pdMS_TO_TICKS(DHT_RMT_TIMEOUT_MS)));
+    rmt_rx_stop(m_channel);
+    if(items == nullptr) return RC_ERROR_TIME_OUT;
+
+    // Every item holds two pulses. A duration of 0 marks the end of the capture
+    DhtPulse_t pulses[DHT_MAX_PULSES];
+    uint32_t count = 0;
+    const uint32_t itemCount = length / sizeof(rmt_item32_t);
+    for(uint32_t i = 0; i < itemCount && count + 2 <= DHT_MAX_PULSES; i++) {
+        if(items[i].duration0 == 0) break;
+        pulses[count++] = {static_cast<uint16_t>(items[i].duration0), static_cast<uint8_t>(items[i].level0)};
+        if(items[i].duration1 == 0) break;
+        pulses[count++] = {static_cast<uint16_t>(items[i].duration1), static_cast<uint8_t>(items[i].level1)};
+    }
+    vRingbufferReturnItem(m_ringbuf, items);
+
+    DhtReading_t reading;
+    const RC_t err = dhtDecode(pulses, count, reading);
+    if(RC_SUCCESS == err) m_lastReading = reading;
+    return err;
+}
+
+RC_t DhtRmtReader::read(DhtReading_t& reading) {
+    const uint32_t now = millis();
+    if(!m_measured || now - m_lastMeasurementMs >= DHT_MIN_INTERVAL_MS) {
+        m_lastResult = measure();
+        m_lastMeasurementMs = now;
+        m_measured = true;
+    }
+    reading = m_lastReading;
+    return m_lastResult;
+}
@@ -0,0 +1,67 @@
+#ifndef DHT_RMT_READER_H
+#define DHT_RMT_READER_H
+#include <driver/rmt.h>
+#include <freertos/ringbuf.h>
+
+#include <memory>
+
+#include "DhtDecoder.h"
+#include "global.h"
+
+/**
+ * @brief Reads a DHT22 on one pin by capturing its waveform with the RMT peripheral.
+ *
+ * The start signal is generated with a task delay and the answer is recorded by the RMT
+ * in the background, so interrupts stay enabled during the whole measurement, unlike
+ * bit-banging drivers which disable them for several milliseconds and disturb WiFi.
+ * The captured pulses are decoded with dhtDecode.
+ *
+ * Temperature and humidity sensors on the same pin share one reader via forPin, which
+ * also makes sure that the DHT22 is not read more often than its minimum measurement interval.
+ */
+class DhtRmtReader {
+   public:
+    /**
+     * @brief Returns the reader of the given pin, creating it if necessary
+     *
+     * @param pin [IN] GPIO pin number
+     * @return std::shared_ptr<DhtRmtReader> Reader or nullptr if no RMT receive channel is left
+     */
+    static std::shared_ptr<DhtRmtReader> forPin(uint32_t pin);
+
+    /**
+     * @brief Destructor. Releases the RMT channel.
+     */
+    ~DhtRmtReader();
+
+    /**
+     * @brief Returns the latest reading. Starts a new measurement if the previous one is older
+     * than DHT_MIN_INTERVAL_MS, otherwise returns the previous result.
+     *
+     * @param reading [OUT]
+     * @return RC_t RC_SUCCESS on success,
+     *  RC_ERROR_TIME_OUT if the sensor did not answer,
+     *  errors of dhtDecode
+     */
+    RC_t read(DhtReading_t& reading);
+
+   private:
+    DhtRmtReader(uint32_t pin, rmt_channel_t channel);
+
+    /**
+     * @brief Sends the start signal and decodes the captured answer
+     */
+    RC_t measure();
+
+    const uint32_t m_pin;
+    const rmt_channel_t m_channel;
+    RingbufHandle_t m_ringbuf = nullptr;
+    bool m_installed = false;
+
+    RC_t m_lastResult = RC_ERROR_INVALID_STATE;
+    DhtReading_t m_lastReading = {NAN, NAN};
+    uint32_t m_lastMeasurementMs = 0;
+    bool m_measured = false;
+};
+
+#endif  // DHT_RMT_READER_H
@@ -0,0 +1,165 @@
+#include "PulseCounterSensor.h"
+
+#include <strings.h>
+
+#include "SensorType.h"
+
+PulseCounterSensor::PulseCounterSensor(char name[], Gpio& gpio, uint32_t pin, Gpio::Pull_t pull, Edge_t edge,
+                                       uint32_t debounceUs, Output_t output, std::shared_ptr<Transformer> transformer)
+    : Sensor(name, transformer), m_gpio(gpio), m_pin(pin), m_edge(edge), m_debounceUs(debounceUs), m_output(output) {
+    m_gpio.configureInput(m_pin, pull);
+    m_lastReadUs = m_gpio.getTimeUs();
+    attach();
+}
+
+PulseCounterSensor::~PulseCounterSensor() {
+    if(m_attached) m_gpio.detachEdgeCallback(m_pin);
+}
+
+RC_t PulseCounterSensor::edgeFromString(const char str[], Edge_t& edge) {
+    if(strcasecmp(str, "rising") == 0)
+        edge = EDGE_RISING;
+    else if(strcasecmp(str, "falling") == 0)
+        edge = EDGE_FALLING;
+    else if(strcasecmp(str, "both") == 0)
+        edge = EDGE_BOTH;
+    else
+        return RC_ERROR_INVALID;
+    return RC_SUCCESS;
+}
+
+RC_t PulseCounterSensor::outputFromString(const char str[], Output_t& output) {
+    if(strcasecmp(str, "count") == 0)
+        output = OUTPUT_COUNT;
+    else if(strcasecmp(str, "delta") == 0)
+        output = OUTPUT_DELTA;
+    else if(strcasecmp(str, "rate") == 0)
+        output = OUTPUT_RATE;
+    else if(strcasecmp(str, "level") == 0)
+        output = OUTPUT_LEVEL;
+    else
+        return RC_ERROR_INVALID;
+    return RC_SUCCESS;
+}
+
+void IRAM_ATTR PulseCounterSensor::acceptLevel(Counter_t& counter, bool level, uint32_t timestampUs) const {
+    if(level == counter.level) return;
+    counter.level = level;
+    if(m_edge == EDGE_BOTH || (m_edge == EDGE_RISING) == level) {
+        counter.count++;
+        counter.lastEdgeUs = timestampUs;
+    }
+}
+
+void IRAM_ATTR PulseCounterSensor::onEdge(void* arg, bool level, uint32_t timestampUs) {
+    PulseCounterSensor* s = static_cast<PulseCounterSensor*>(arg);
+    // Only plain loads and stores, the interrupt is the only writer
+    const uint32_t generation = s->m_generation.load(std::memory_order_relaxed);
+    s->m_generation.store(generation + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // The pending level was stable until this edge
+    const uint32_t pendingUs = s->m_pendingUs.load(std::memory_order_relaxed);
+    if(s->m_hasPending.load(std::memory_order_relaxed) && timestampUs - pendingUs >= s->m_debounceUs) {
+        Counter_t counter = {s->m_level.load(std::memory_order_relaxed), s->m_count.load(std::memory_order_relaxed),
+                             s->m_lastEdgeUs.load(std::memory_order_relaxed)};
+        s->acceptLevel(counter, s->m_pendingLevel.load(std::memory_order_relaxed), pendingUs);
+        s->m_level.store(counter.level, std::memory_order_relaxed);
+        s->m_count.store(counter.count, std::memory_order_relaxed);
+        s->m_lastEdgeUs.store(counter.lastEdgeUs, std::memory_order_relaxed);
+    }
+    s->m_pendingLevel.store(level, std::memory_order_relaxed);
+    s->m_pendingUs.store(timestampUs, std::memory_order_relaxed);
+    s->m_hasPending.store(true, std::memory_order_relaxed);
+
+    s->m_generation.store(generation + 2, std::memory_order_release);
+}
+
+void PulseCounterSensor::attach() {
+    // Edges before attaching are not seen, start from the current level
+    m_level.store(m_gpio.read(m_pin), std::memory_order_relaxed);
+    if(RC_SUCCESS != m_gpio.attachEdgeCallback(m_pin, onEdge, this)) return;
+    m_attached = true;
+}
+
+PulseCounterSensor::Counter_t PulseCounterSensor::getCounter(uint32_t nowUs) const {
+    while(true) {
+        const uint32_t before = m_generation.load(std::memory_order_acquire);
+        // Odd while the interrupt updates the state on another core
+        if(before & 1) continue;
+        Counter_t counter = {m_level.load(std::memory_order_relaxed), m_count.load(std::memory_order_relaxed),
+                             m_lastEdgeUs.load(std::memory_order_relaxed)};
+        const bool hasPending = m_hasPending.load(std::memory_order_relaxed);
+        const bool pendingLevel = m_pendingLevel.load(std::memory_order_relaxed);
+        const uint32_t pendingUs = m_pendingUs.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // An edge arrived while copying
+        if(m_generation.load(std::memory_order_relaxed) != before) continue;
+
+        // The interrupt accepts the same level once the next edge arrives, so the count never goes back
+        if(hasPending && nowUs - pendingUs >= m_debounceUs) acceptLevel(counter, pendingLevel, pendingUs);
+        return counter;
+    }
+}
+
+float_t PulseCounterSensor::readSensorRaw() {
+    if(!m_attached) attach();
+    const uint32_t nowUs = m_gpio.getTimeUs();
+    const Counter_t counter = getCounter(nowUs);
+
+    const uint32_t delta = counter.count - m_countAtLastRead;
+    const uint32_t elapsedUs = nowUs - m_lastReadUs;
+    m_countAtLastRead = counter.count;
+    m_lastEdgeUsAtLastRead = counter.lastEdgeUs;
+    m_lastReadUs = nowUs;
+
+    switch(m_output) {
+        case OUTPUT_COUNT:
+            return static_cast<float_t>(counter.count);
+        case OUTPUT_DELTA:
+            return static_cast<float_t>(delta);
+        case OUTPUT_RATE:
+            if(elapsedUs == 0) return 0;
+            return static_cast<float_t>(delta) * 1000000.0f / static_cast<float_t>(elapsedUs);
+        case OUTPUT_LEVEL:
+        default:
+            return counter.level ? 1 : 0;
+    }
+}
+
+static const ConfigParam_t pulseCounterSensorParams[] = {
+    {"pin", CONFIG_PARAM_INT, true, nullptr},
+    {"pinMode", CONFIG_PARAM_STRING, false, "Input"},
+    {"edge", CONFIG_PARAM_STRING, false, "rising"},
+    {"output", CONFIG_PARAM_STRING, false, "count"},
+    {"debounceUs", CONFIG_PARAM_INT, false, "0"},
+};
+
+static Sensor* createPulseCounterSensor(char name[], const ConfigParams& params, const SensorContext_t& context,
+                                        std::shared_ptr<Transformer> transformer) {
+    const int32_t pin = params.getInt("pin");
+    const int32_t debounceUs = params.getInt("debounceUs");
+    if(pin < 0 || debounceUs < 0) return nullptr;
+
+    char str[16] = "";
+    Gpio::Pull_t pull = Gpio::PULL_NONE;
+    if(RC_SUCCESS != params.getString("pinMode", str, sizeof(str))) return nullptr;
+    if(strcmp(str, "InputPullUp") == 0)
+        pull = Gpio::PULL_UP;
+    else if(strcmp(str, "InputPullDown") == 0)
+        pull = Gpio::PULL_DOWN;
+    else if(strcmp(str, "Input") != 0)
+        return nullptr;
+
+    PulseCounterSensor::Edge_t edge;
+    if(RC_SUCCESS != params.getString("edge", str, sizeof(str))) return nullptr;
+    if(RC_SUCCESS != PulseCounterSensor::edgeFromString(str, edge)) return nullptr;
+
+    PulseCounterSensor::Output_t output;
+    if(RC_SUCCESS != params.getString("output", str, sizeof(str))) return nullptr;
+    if(RC_SUCCESS != PulseCounterSensor::outputFromString(str, output)) return nullptr;
+
+    return new PulseCounterSensor(name, context.gpio, pin, pull, edge, debounceUs, output, transformer);
+}
+
+REGISTER_SENSOR_TYPE(PulseCounterSensor, pulseCounterSensorParams, createPulseCounterSensor);
@@ -0,0 +1,159 @@
+#ifndef PULSE_COUNTER_SENSOR_H
+#define PULSE_COUNTER_SENSOR_H
+#include <atomic>
+
+#include "Sensor.h"
+#include "gpio/Gpio.h"
+
+/**
+ * @brief Sensor for digital signals which change faster than the polling interval,
+ * like flow meters, rain gauges or door contacts.
+ *
+ * Every edge of the pin is debounced and counted by the interrupt, so the number of edges
+ * between two readings is unlimited. Only the counter, the accepted level and the latest edge are kept:
+ *  - Debounce: a new level is only accepted once it stayed stable for the debounce time.
+ *    Bounces and glitches shorter than that are discarded.
+ *  - Hysteresis: only a change to the opposite of the last accepted level counts as a transition,
+ *    so repeated edges to the same level (e.g. from an interrupt missed during a bounce) are ignored.
+ *
+ * The level of the latest edge is accepted by the next edge or by a reading once it has been stable
+ * for the debounce time. A transition which is not stable yet at the time of a reading
+ * is counted in a later reading.
+ */
+class PulseCounterSensor : public Sensor {
+   public:
+    typedef enum { EDGE_RISING, EDGE_FALLING, EDGE_BOTH } Edge_t;
+
+    typedef enum {
+        /** Total number of counted edges since the sensor was created */
+        OUTPUT_COUNT,
+        /** Number of counted edges since the previous reading */
+        OUTPUT_DELTA,
+        /** Counted edges per second since the previous reading */
+        OUTPUT_RATE,
+        /** Debounced level of the pin, 0 or 1 */
+        OUTPUT_LEVEL
+    } Output_t;
+
+    /**
+     * @brief Constructor. Configures the pin and attaches the edge interrupt.
+     *
+     * @param name [IN] Name of the sensor
+     * @param gpio [IN] Gpio the pin belongs to. Has to outlive the sensor
+     * @param pin [IN] GPIO pin number
+     * @param pull [IN] Internal pull resistor to enable
+     * @param edge [IN] Which edges are counted
+     * @param debounceUs [IN] Time in microseconds a level has to be stable to be accepted. 0 disables debouncing
+     * @param output [IN] Value returned by a reading
+     * @param transformer [IN] Pointer to optional data transformation pipeline
+     */
+    PulseCounterSensor(char name[], Gpio& gpio, uint32_t pin, Gpio::Pull_t pull, Edge_t edge, uint32_t debounceUs,
+                       Output_t output, std::shared_ptr<Transformer> transformer = nullptr);
+
+    /**
+     * @brief Destructor. Detaches the edge interrupt.
+     */
+    ~PulseCounterSensor() override;
+
+    /**
+     * @brief Converts an edge name from the config file to its enum value
+     *
+     * @param str [IN] rising, falling or both. Case insensitive
+     * @param edge [OUT]
+     * @return RC_t RC_SUCCESS on success, RC_ERROR_INVALID if the name is unknown
+     */
+    static RC_t edgeFromString(const char str[], Edge_t& edge);
+
+    /**
+     * @brief Converts an output name from the config file to its enum value
+     *
+     * @param str [IN] count, delta, rate or level. Case insensitive
+     * @param output [OUT]
+     * @return RC_t RC_SUCCESS on success, RC_ERROR_INVALID if the name is unknown
+     */
+    static RC_t outputFromString(const char str[], Output_t& output);
+
+    /**
+     * @brief Returns the total number of counted edges up to the last reading
+     *
+     * @return uint32_t
+     */
+    inline uint32_t getCount() const { return m_countAtLastRead; }
+
+    /**
+     * @brief Returns the timestamp of the last counted edge up to the last reading
+     *
+     * @return uint32_t Time in microseconds of the Gpio time base, 0 if no edge was counted yet
+     */
+    inline uint32_t getLastEdgeTimestampUs() const { return m_lastEdgeUsAtLastRead; }
+
+    /**
+     * @brief Returns whether the edge interrupt is attached. If the pin was still in use by another
+     * sensor on creation, for example the one this sensor replaces on a config reload,
+     * attaching is retried on every reading.
+     *
+     * @return true
+     * @return false
+     */
+    inline bool isAttached() const { return m_attached; }
+
+   protected:
+    float_t readSensorRaw() override;
+
+   private:
+    /**
+     * @brief Debounced state of the pin
+     */
+    typedef struct {
+        bool level;
+        uint32_t count;
+        uint32_t lastEdgeUs;
+    } Counter_t;
+
+    /**
+     * @brief Edge callback, runs in interrupt context. Debounces the edge and counts the accepted transitions
+     */
+    static void onEdge(void* arg, bool level, uint32_t timestampUs);
+
+    /**
+     * @brief Tries to attach the edge interrupt and synchronizes the level with the pin
+     */
+    void attach();
+
+    /**
+     * @brief Copies the state written by the interrupt and applies the latest edge
+     * if it has been stable for the debounce time. Retries if an edge arrives while copying
+     *
+     * @param nowUs [IN] Current time
+     * @return Counter_t
+     */
+    Counter_t getCounter(uint32_t nowUs) const;
+
+    /**
+     * @brief Applies a debounced level to counter
+     */
+    void acceptLevel(Counter_t& counter, bool level, uint32_t timestampUs) const;
+
+    Gpio& m_gpio;
+    const uint32_t m_pin;
+    const Edge_t m_edge;
+    const uint32_t m_debounceUs;
+    const Output_t m_output;
+    bool m_attached = false;
+
+    // State written only by the edge interrupt. m_generation is odd while the interrupt updates it
+    std::atomic<uint32_t> m_generation{0};
+    std::atomic<bool> m_level{false};
+    std::atomic<uint32_t> m_count{0};
+    std::atomic<uint32_t> m_lastEdgeUs{0};
+    // Most recent edge which has not been stable for the debounce time yet
+    std::atomic<bool> m_hasPending{false};
+    std::atomic<bool> m_pendingLevel{false};
+    std::atomic<uint32_t> m_pendingUs{0};
+
+    uint32_t m_countAtLastRead = 0;
+    uint32_t m_lastEdgeUsAtLastRead = 0;
+    uint32_t m_lastReadUs = 0;
+};
+
+#endif  // PULSE_COUNTER_SENSOR_H
@@ -1,12 +1,24 @@
 #include "RandomSensor.h"
 
-#include <random>
+#include "SensorType.h"
 
 RandomSensor::RandomSensor(char name[], float_t lowerBound, float_t upperBound,
                            std::shared_ptr<Transformer> transformer)
-    : Sensor(name, transformer), m_lowerBound(lowerBound), m_upperBound(upperBound) {};
+    : Sensor(name, transformer), m_lowerBound(lowerBound), m_upperBound(upperBound), m_rng(m_sensorId) {};
 
 float_t RandomSensor::readSensorRaw() {
     // Generate random number between given lower and upper bound
-    return m_lowerBound + static_cast<float_t>(rand()) / (static_cast<float>(RAND_MAX / (m_upperBound - m_lowerBound)));
-}
\ No newline at end of file
+    return m_lowerBound + (m_upperBound - m_lowerBound) * m_rng.nextFloat();
+}
+
+static const ConfigParam_t randomSensorParams[] = {
+    {"lowerBound", CONFIG_PARAM_FLOAT, true, nullptr},
+    {"upperBound", CONFIG_PARAM_FLOAT, true, nullptr},
+};
+
+static Sensor* createRandomSensor(char name[], const ConfigParams& params, const SensorContext_t& context,
+                                  std::shared_ptr<Transformer> transformer) {
+    return new RandomSensor(name, params.getFloat("lowerBound"), params.getFloat("upperBound"), transformer);
+}
+
+REGISTER_SENSOR_TYPE(RandomSensor, randomSensorParams, createRandomSensor);
@@ -1,10 +1,13 @@
 #ifndef RANDOM_SENSOR_H
 #define RANDOM_SENSOR_H
 #include "Sensor.h"
+#include "XorShift32.h"
 
 /**
  * @brief Sensor for test purposes.
- * Generates random numbers within given range
+ * Generates uniformly distributed random numbers within given range.
+ * The generator is seeded with the sensor ID, so every sensor produces its own
+ * sequence which is the same after every reboot.
  */
 class RandomSensor : public Sensor {
    public:
@@ -24,6 +27,7 @@ class RandomSensor : public Sensor {
 
    private:
     float_t m_lowerBound, m_upperBound;
+    XorShift32 m_rng;
 };
 
 #endif  // RANDOM_SENSOR_H
\ No newline at end of file
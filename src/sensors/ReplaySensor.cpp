@@ -0,0 +1,143 @@
+#include "ReplaySensor.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#include "SensorType.h"
+
+ReplaySensor::ReplaySensor(char name[], Filesystem& fs, const char filename[], Format_t format, bool loop,
+                           std::shared_ptr<Transformer> transformer)
+    : Sensor(name, transformer), m_fs(fs), m_format(format), m_loop(loop) {
+    strncpy(m_filename, filename, REPLAY_SENSOR_MAX_FILENAME_LENGTH - 1);
+    m_filename[REPLAY_SENSOR_MAX_FILENAME_LENGTH - 1] = '\0';
+}
+
+ReplaySensor::Format_t ReplaySensor::formatFromFilename(const char filename[]) {
+    const uint32_t len = strlen(filename);
+    if(len >= 4 && strcmp(filename + len - 4, ".bin") == 0) return BINARY;
+    return CSV;
+}
+
+RC_t ReplaySensor::fillBuffer() {
+    memmove(m_buffer, m_buffer + m_bufferPos, m_bufferLen - m_bufferPos);
+    m_bufferLen -= m_bufferPos;
+    m_bufferPos = 0;
+
+    RC_t err = m_fs.openFile(m_filename, Filesystem::READ_ONLY);
+    if(err != RC_SUCCESS) return err;
+    const uint32_t fileSize = m_fs.size();
+    if(m_fileOffset >= fileSize) {
+        m_fs.closeFile();
+        return RC_ERROR_BUFFER_EMPTY;
+    }
+
+    uint32_t n = fileSize - m_fileOffset;
+    if(n > sizeof(m_buffer) - m_bufferLen) n = sizeof(m_buffer) - m_bufferLen;
+    err = m_fs.seek(m_fileOffset);
+    if(err == RC_SUCCESS) err = m_fs.read(m_buffer + m_bufferLen, n);
+    m_fs.closeFile();
+    if(err != RC_SUCCESS) return err;
+    m_bufferLen += n;
+    m_fileOffset += n;
+    return RC_SUCCESS;
+}
+
+bool ReplaySensor::nextValue(float_t& value, bool endOfFile) {
+    if(m_format == BINARY) {
+        if(m_bufferLen - m_bufferPos < sizeof(value)) return false;
+        memcpy(&value, m_buffer + m_bufferPos, sizeof(value));
+        m_bufferPos += sizeof(value);
+        return true;
+    }
+
+    while(m_bufferPos < m_bufferLen) {
+        char* line = reinterpret_cast<char*>(m_buffer + m_bufferPos);
+        const uint32_t available = m_bufferLen - m_bufferPos;
+        char* lineEnd = static_cast<char*>(memchr(line, '\n', available));
+        if(lineEnd == nullptr) {
+            if(!endOfFile) {
+                // A line longer than the buffer can never be completed, drop it
+                if(m_bufferPos == 0 && m_bufferLen == sizeof(m_buffer)) m_bufferPos = m_bufferLen;
+                return false;
+            }
+            lineEnd = line + available;
+        }
+        m_bufferPos += (lineEnd - line) + ((lineEnd < line + available) ? 1 : 0);
+
+        // Parse the last column of the line
+        char str[32];
+        char* column = line;
+        for(char* c = line; c < lineEnd; c++) {
+            if(*c == ',' || *c == ';') column = c + 1;
+        }
+        uint32_t len = lineEnd - column;
+        if(len >= sizeof(str)) continue;
+        memcpy(str, column, len);
+        str[len] = '\0';
+        char* end;
+        const float_t v = strtof(str, &end);
+        // Allow trailing whitespace like \r, but nothing else
+        while(*end == ' ' || *end == '\t' || *end == '\r') end++;
+        if(end == str || *end != '\0') continue;
+        value = v;
+        return true;
+    }
+    return false;
+}
+
+float_t ReplaySensor::readSensorRaw() {
+    bool endOfFile = false;
+    while(true) {
+        float_t value;
+        if(nextValue(value, endOfFile)) {
+            m_valuesSinceRewind++;
+            return value;
+        }
+
+        const RC_t err = fillBuffer();
+        if(err == RC_SUCCESS) continue;
+        if(err != RC_ERROR_BUFFER_EMPTY) return NAN;
+        if(!endOfFile) {
+            // Give an unterminated last line the chance to be parsed
+            endOfFile = true;
+            continue;
+        }
+
+        // End of the file reached. Start over if there were any values in it
+        if(!m_loop || m_valuesSinceRewind == 0) return NAN;
+        m_fileOffset = 0;
+        m_bufferLen = 0;
+        m_bufferPos = 0;
+        m_valuesSinceRewind = 0;
+        endOfFile = false;
+    }
+}
+
+static const ConfigParam_t replaySensorParams[] = {
+    {"file", CONFIG_PARAM_STRING, true, nullptr},
+    // csv or binary, defaults to the one matching the file extension
+    {"format", CONFIG_PARAM_STRING, false, nullptr},
+    {"loop", CONFIG_PARAM_INT, false, "1"},
+};
+
+static Sensor* createReplaySensor(char name[], const ConfigParams& params, const SensorContext_t& context,
+                                  std::shared_ptr<Transformer> transformer) {
+    char filename[REPLAY_SENSOR_MAX_FILENAME_LENGTH] = "";
+    if(RC_SUCCESS != params.getString("file", filename, sizeof(filename))) return nullptr;
+
+    ReplaySensor::Format_t format = ReplaySensor::formatFromFilename(filename);
+    if(params.isSet("format")) {
+        char formatStr[16] = "";
+        if(RC_SUCCESS != params.getString("format", formatStr, sizeof(formatStr))) return nullptr;
+        if(strcmp(formatStr, "csv") == 0)
+            format = ReplaySensor::CSV;
+        else if(strcmp(formatStr, "binary") == 0)
+            format = ReplaySensor::BINARY;
+        else
+            return nullptr;
+    }
+
+    return new ReplaySensor(name, context.filesystem, filename, format, params.getInt("loop") != 0, transformer);
+}
+
+REGISTER_SENSOR_TYPE(ReplaySensor, replaySensorParams, createReplaySensor);
@@ -0,0 +1,94 @@
+#ifndef REPLAY_SENSOR_H
+#define REPLAY_SENSOR_H
+#include "Sensor.h"
+#include "filesystem/Filesystem.h"
+
+/**
+ * @brief Maximum length of the replayed file's name, including null terminator
+ */
+#define REPLAY_SENSOR_MAX_FILENAME_LENGTH (64)
+
+/**
+ * @brief Hardware-free sensor which returns previously recorded values from a file,
+ * one value per reading.
+ *
+ * Supported formats:
+ *  - CSV: One value per line. If a line has several comma or semicolon separated
+ *    columns, the last one is used, so "timestamp,value" recordings can be replayed
+ *    directly. Lines which don't end in a number, like headers, are skipped.
+ *  - Binary: Consecutive 32 bit little endian floats
+ *
+ * The file is read in chunks of REPLAY_SENSOR_BUFFER_SIZE bytes. Since the Filesystem only
+ * allows one open file at a time, the file is only open while a chunk is read.
+ */
+class ReplaySensor : public Sensor {
+   public:
+    typedef enum { CSV, BINARY } Format_t;
+
+    /**
+     * @brief Constructor
+     *
+     * @param name [IN] Name of the sensor
+     * @param fs [IN] Filesystem on which the file is stored
+     * @param filename [IN] File with the recorded values
+     * @param format [IN] Format of the file
+     * @param loop [IN] If true, the replay restarts at the beginning of the file once its end is reached.
+     *  Otherwise NAN is returned after the last value
+     * @param transformer [IN] Pointer to optional data transformation pipeline
+     */
+    ReplaySensor(char name[], Filesystem& fs, const char filename[], Format_t format, bool loop = true,
+                 std::shared_ptr<Transformer> transformer = nullptr);
+
+    /**
+     * @brief Returns the format matching the extension of a filename.
+     * Files ending in .bin are binary, all others CSV.
+     *
+     * @param filename [IN]
+     * @return Format_t
+     */
+    static Format_t formatFromFilename(const char filename[]);
+
+   protected:
+    float_t readSensorRaw() override;
+
+   private:
+    /**
+     * @brief Takes the next value from the buffer
+     *
+     * @param value [OUT]
+     * @param endOfFile [IN] Whether the buffer holds the rest of the file. An unterminated
+     *  CSV line is only complete at the end of the file
+     * @return true A value was found
+     * @return false The buffer needs to be refilled
+     */
+    bool nextValue(float_t& value, bool endOfFile);
+
+    /**
+     * @brief Moves the unconsumed bytes to the front of the buffer and fills up the rest from the file
+     *
+     * @return RC_t RC_SUCCESS if bytes were added,
+     *  RC_ERROR_BUFFER_EMPTY if the end of the file is reached,
+     *  errors of the Filesystem
+     */
+    RC_t fillBuffer();
+
+    Filesystem& m_fs;
+    char m_filename[REPLAY_SENSOR_MAX_FILENAME_LENGTH] = "";
+    const Format_t m_format;
+    const bool m_loop;
+
+    uint8_t m_buffer[REPLAY_SENSOR_BUFFER_SIZE];
+    uint32_t m_bufferLen = 0;
+    uint32_t m_bufferPos = 0;
+    /**
+     * @brief File offset of the next byte to be read into the buffer
+     */
+    uint32_t m_fileOffset = 0;
+    /**
+     * @brief Number of values returned since the replay (re)started.
+     * Used to detect files without any values
+     */
+    uint32_t m_valuesSinceRewind = 0;
+};
+
+#endif  // REPLAY_SENSOR_H
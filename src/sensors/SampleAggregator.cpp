@@ -0,0 +1,89 @@
+#include "SampleAggregator.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "helper_functions.h"
+
+void SampleAggregator::add(float_t value) {
+    m_count++;
+    if(m_count == 1) {
+        m_min = value;
+        m_max = value;
+        m_mean = value;
+    } else {
+        if(value < m_min) m_min = value;
+        if(value > m_max) m_max = value;
+        m_mean += (value - m_mean) / static_cast<float_t>(m_count);
+    }
+    m_last = value;
+}
+
+void SampleAggregator::reset() { m_count = 0; }
+
+RC_t SampleAggregator::toJson(char str[], uint32_t size, uint8_t fields, uint8_t decimals) const {
+    if(m_count == 0) return RC_ERROR_BUFFER_EMPTY;
+    if(size < 3) return RC_ERROR_BUFFER_FULL;
+
+    const struct {
+        uint8_t field;
+        const char* name;
+        float_t value;
+    } values[] = {{FIELD_MIN, "min", m_min}, {FIELD_MAX, "max", m_max}, {FIELD_MEAN, "mean", m_mean},
+                  {FIELD_LAST, "last", m_last}};
+
+    uint32_t len = 0;
+    str[len++] = '{';
+    for(const auto& v : values) {
+        if((fields & v.field) == 0) continue;
+        const int32_t n = snprintf(&str[len], size - len, "%s\"%s\":", (len > 1) ? "," : "", v.name);
+        if(n < 0 || static_cast<uint32_t>(n) >= size - len) return RC_ERROR_BUFFER_FULL;
+        len += n;
+        uint32_t valueLength = 0;
+        const RC_t err = formatFloat(&str[len], size - len, v.value, decimals, &valueLength);
+        if(RC_SUCCESS != err) return err;
+        len += valueLength;
+    }
+    if(fields & FIELD_COUNT) {
+        const int32_t n = snprintf(&str[len], size - len, "%s\"count\":%u", (len > 1) ? "," : "", m_count);
+        if(n < 0 || static_cast<uint32_t>(n) >= size - len) return RC_ERROR_BUFFER_FULL;
+        len += n;
+    }
+    if(len + 2 > size) return RC_ERROR_BUFFER_FULL;
+    str[len++] = '}';
+    str[len] = '\0';
+    return RC_SUCCESS;
+}
+
+RC_t SampleAggregator::fieldsFromString(const char str[], uint8_t& fields) {
+    static const struct {
+        const char* name;
+        uint8_t field;
+    } names[] = {{"min", FIELD_MIN},   {"max", FIELD_MAX},     {"mean", FIELD_MEAN},
+                 {"last", FIELD_LAST}, {"count", FIELD_COUNT}, {"all", FIELD_ALL}};
+
+    uint8_t result = 0;
+    const char* start = str;
+    while(true) {
+        // Trim whitespace around the name
+        while(*start == ' ' || *start == '\t') start++;
+        const char* end = strchr(start, ',');
+        if(end == nullptr) end = start + strlen(start);
+        uint32_t len = end - start;
+        while(len > 0 && (start[len - 1] == ' ' || start[len - 1] == '\t' || start[len - 1] == '\r')) len--;
+
+        bool found = false;
+        for(const auto& n : names) {
+            if(strlen(n.name) == len && strncmp(n.name, start, len) == 0) {
+                result |= n.field;
+                found = true;
+                break;
+            }
+        }
+        if(!found) return RC_ERROR_INVALID;
+        if(*end == '\0') break;
+        start = end + 1;
+    }
+    fields = result;
+    return RC_SUCCESS;
+}
@@ -0,0 +1,81 @@
+#ifndef SAMPLE_AGGREGATOR_H
+#define SAMPLE_AGGREGATOR_H
+#include "global.h"
+
+/**
+ * @brief Collects the samples of a sensor between two publishes and summarizes them
+ * as min, max, mean, last value and count. Uses constant memory regardless of
+ * how many samples are added.
+ */
+class SampleAggregator {
+   public:
+    /**
+     * @brief Aggregates which can be selected for publishing. Can be combined as bit mask
+     */
+    typedef enum {
+        FIELD_MIN = 1 << 0,
+        FIELD_MAX = 1 << 1,
+        FIELD_MEAN = 1 << 2,
+        FIELD_LAST = 1 << 3,
+        FIELD_COUNT = 1 << 4,
+        FIELD_ALL = 0x1F
+    } Field_t;
+
+    SampleAggregator() = default;
+
+    /**
+     * @brief Adds a sample to the current window
+     *
+     * @param value [IN]
+     */
+    void add(float_t value);
+
+    /**
+     * @brief Starts a new, empty window
+     */
+    void reset();
+
+    inline uint32_t getCount() const { return m_count; }
+
+    inline float_t getMin() const { return m_min; }
+
+    inline float_t getMax() const { return m_max; }
+
+    inline float_t getMean() const { return m_mean; }
+
+    inline float_t getLast() const { return m_last; }
+
+    /**
+     * @brief Writes the selected aggregates as JSON object, e.g. {"min":1.000000,"count":3}
+     *
+     * @param str [OUT] Output buffer
+     * @param size [IN] Size of str
+     * @param fields [IN] Bit mask of Field_t values
+     * @param decimals [IN] Number of decimals of min, max, mean and last
+     * @return RC_t RC_SUCCESS on success
+     *  RC_ERROR_BUFFER_EMPTY if no sample was added since the last reset
+     *  RC_ERROR_BUFFER_FULL if the output does not fit into str
+     */
+    RC_t toJson(char str[], uint32_t size, uint8_t fields, uint8_t decimals = FLOAT_FORMAT_MAX_DECIMALS) const;
+
+    /**
+     * @brief Converts a comma separated list like "min,max,mean" into a bit mask of Field_t values
+     *
+     * @param str [IN] List of field names. Whitespace around the names is ignored
+     * @param fields [OUT] Bit mask
+     * @return RC_t RC_SUCCESS on success, RC_ERROR_INVALID if a name is unknown or the list is empty
+     */
+    static RC_t fieldsFromString(const char str[], uint8_t& fields);
+
+   private:
+    uint32_t m_count = 0;
+    float_t m_min = 0;
+    float_t m_max = 0;
+    /**
+     * @brief Running mean. Unlike a sum it does not lose precision in long windows
+     */
+    float_t m_mean = 0;
+    float_t m_last = 0;
+};
+
+#endif  // SAMPLE_AGGREGATOR_H
@@ -0,0 +1,119 @@
+#ifndef SAMPLE_CACHE_H
+#define SAMPLE_CACHE_H
+#include <atomic>
+#include <cstring>
+
+#include "global.h"
+
+/**
+ * @brief A single acquired sensor reading
+ */
+typedef struct {
+    /**
+     * @brief Reading after it has passed through the transformer pipeline
+     */
+    float_t value;
+    /**
+     * @brief Unprocessed reading as returned by the sensor
+     */
+    float_t rawValue;
+    /**
+     * @brief Uptime in ms at which the reading was taken
+     */
+    uint32_t timestamp;
+} SensorSample_t;
+
+/**
+ * @brief Holds the latest sample of a sensor so that consumers
+ * like the webserver or the MQTT client never have to access the sensor hardware.
+ *
+ * Implemented as a double buffer with a generation counter. The single writer
+ * always fills the slot which is currently not published and then publishes it
+ * by incrementing the generation. Readers copy the published slot and retry
+ * if any sample was published in the meantime, as the slot may then already be
+ * rewritten by the store after that. Neither side ever blocks,
+ * which matters on a single core where a reader task with a higher priority
+ * may preempt the writer in the middle of an update.
+ *
+ * @note Only one task may call store at a time. Any number of tasks may call load.
+ */
+class SampleCache {
+   public:
+    SampleCache() = default;
+
+    /**
+     * @brief Publishes a new sample. Must only be called from the acquisition path.
+     *
+     * @param sample [IN] Sample to publish
+     */
+    void store(const SensorSample_t& sample) {
+        const uint32_t generation = m_generation.load(std::memory_order_relaxed) + 1;
+        Slot& slot = m_slots[generation & 1];
+        // A reader which sees any of the values below also sees all previously published generations
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.value.store(floatToBits(sample.value), std::memory_order_relaxed);
+        slot.rawValue.store(floatToBits(sample.rawValue), std::memory_order_relaxed);
+        slot.timestamp.store(sample.timestamp, std::memory_order_relaxed);
+        m_generation.store(generation, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copies the latest published sample
+     *
+     * @param sample [OUT] Latest sample
+     * @return true A sample was available
+     * @return false Nothing has been stored yet
+     */
+    bool load(SensorSample_t& sample) const {
+        while(true) {
+            const uint32_t before = m_generation.load(std::memory_order_acquire);
+            if(before == 0) return false;
+            const Slot& slot = m_slots[before & 1];
+            sample.value = bitsToFloat(slot.value.load(std::memory_order_relaxed));
+            sample.rawValue = bitsToFloat(slot.rawValue.load(std::memory_order_relaxed));
+            sample.timestamp = slot.timestamp.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            // The slot read above is rewritten by the second store after it was published. Even if the
+            // generation only advanced by one, that store may already be running, so any change means retry
+            const uint32_t after = m_generation.load(std::memory_order_relaxed);
+            if(after == before) return true;
+        }
+    }
+
+    /**
+     * @brief Returns how many samples have been stored so far
+     *
+     * @return uint32_t
+     */
+    inline uint32_t getGeneration() const { return m_generation.load(std::memory_order_relaxed); }
+
+   private:
+    struct Slot {
+        std::atomic<uint32_t> value{0};
+        std::atomic<uint32_t> rawValue{0};
+        std::atomic<uint32_t> timestamp{0};
+    };
+
+    static inline uint32_t floatToBits(float_t f) {
+        uint32_t bits;
+        memcpy(&bits, &f, sizeof(bits));
+        return bits;
+    }
+
+    static inline float_t bitsToFloat(uint32_t bits) {
+        float_t f;
+        memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+
+    /**
+     * @brief Both buffers. The published one is selected by the lowest bit of m_generation
+     */
+    Slot m_slots[2];
+    /**
+     * @brief Number of the latest published sample. 0 means nothing was published yet
+     */
+    std::atomic<uint32_t> m_generation{0};
+};
+
+#endif  // SAMPLE_CACHE_H
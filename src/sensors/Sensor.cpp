@@ -1,15 +1,126 @@
 #include "Sensor.h"
 
+#include <stdio.h>
+
+#include <new>
+
+#include "helper_functions.h"
+
 Sensor::Sensor(char name[], std::shared_ptr<Transformer> transformer) : m_transformer(transformer) {
     strncpy(m_sensorName, name, SENSOR_NAME_MAX_LENGTH - 1);
-    m_sensorName[SENSOR_NAME_MAX_LENGTH] = '\0';
+    m_sensorName[SENSOR_NAME_MAX_LENGTH - 1] = '\0';
+    m_sensorId = hashString(m_sensorName);
 }
 
-float_t Sensor::readSensor() {
-    float_t rawReading = readSensorRaw();
+RC_t Sensor::setDeviceTopic(const char deviceTopic[]) {
+    const char* const formats[] = {"%s/%s", "%s/raw/%s", "%s/event/%s"};
+    uint32_t offsets[ARRAY_SIZE(formats)];
+    uint32_t size = 0;
+    for(uint32_t i = 0; i < ARRAY_SIZE(formats); i++) {
+        offsets[i] = size;
+        size += snprintf(nullptr, 0, formats[i], deviceTopic, m_sensorName) + 1;
+    }
+    m_topics.reset(new(std::nothrow) char[size]);
+    if(m_topics == nullptr) return RC_ERROR_MEMORY;
+    for(uint32_t i = 0; i < ARRAY_SIZE(formats); i++) {
+        snprintf(m_topics.get() + offsets[i], size - offsets[i], formats[i], deviceTopic, m_sensorName);
+    }
+    m_rawTopicOffset = offsets[1];
+    m_eventTopicOffset = offsets[2];
+    return RC_SUCCESS;
+}
+
+SensorSample_t Sensor::sample() {
+    SensorSample_t sample;
+    float_t block[SENSOR_MAX_BLOCK_SIZE];
+    m_readFailed = false;
+    m_urgentRaised = false;
+    const uint32_t start = getUptimeUs();
+    uint32_t count = readSensorBlock(block, SENSOR_MAX_BLOCK_SIZE);
+    if(count == 0) {
+        block[0] = readSensorRaw();
+        count = 1;
+    }
+    m_lastReadDurationUs = getUptimeUs() - start;
+    if(isnan(block[count - 1])) m_readFailed = true;
+    sample.rawValue = block[count - 1];
+    sample.timestamp = getUptimeMs();
     if(m_transformer != nullptr) {
-        float_t transformedReading = m_transformer->applyTransformations(rawReading);
-        return transformedReading;
-    } else
-        return rawReading;
-}
\ No newline at end of file
+        for(uint32_t i = 0; i < count; i++) {
+            const float_t value = m_transformer->applyTransformations(block[i]);
+            // Report each urgent value of a block, e.g. every edge of a threshold
+            if(m_transformer->takeUrgentEvent() && m_urgentEvents != nullptr)
+                m_urgentEvents->push({m_sensorId, value, sample.timestamp});
+            sample.value = value;
+        }
+    } else {
+        sample.value = sample.rawValue;
+    }
+    if(m_urgentRaised && m_urgentEvents != nullptr) m_urgentEvents->push({m_sensorId, sample.value, sample.timestamp});
+    m_latestSample.store(sample);
+    // Failed reads would show up as gaps of NaN in the history and its aggregates
+    if(m_history != nullptr && !m_readFailed) m_history->add(sample);
+    if(!m_readFailed) m_aggregator.add(sample.value);
+    return sample;
+}
+
+float_t Sensor::readSensor() { return sample().value; }
+
+void Sensor::setCadence(uint32_t sampleIntervalMs, uint32_t publishIntervalMs, uint8_t aggregateFields) {
+    m_sampleIntervalMs = sampleIntervalMs;
+    m_publishIntervalMs = publishIntervalMs;
+    m_aggregateFields = aggregateFields;
+}
+
+void Sensor::setAdaptiveInterval(std::unique_ptr<AdaptiveInterval> adaptive) {
+    m_adaptive = std::move(adaptive);
+    if(m_adaptive != nullptr) m_sampleIntervalMs = m_adaptive->getIntervalMs();
+}
+
+bool Sensor::isSampleDue(uint32_t nowMs) const {
+    if(m_health.getTimeUntilRetryMs(nowMs) > 0) return false;
+    return !m_sampled || static_cast<int32_t>(nowMs - m_nextSampleMs) >= 0;
+}
+
+bool Sensor::isPublishDue(uint32_t nowMs) const {
+    return !m_published || static_cast<int32_t>(nowMs - m_nextPublishMs) >= 0;
+}
+
+uint32_t Sensor::getTimeUntilDueMs(uint32_t nowMs) const {
+    if(isSampleDue(nowMs) || isPublishDue(nowMs)) return 0;
+    // A degraded sensor is due once both its backoff and its regular interval have passed
+    const int32_t untilRetry = m_health.getTimeUntilRetryMs(nowMs);
+    const int32_t untilInterval = static_cast<int32_t>(m_nextSampleMs - nowMs);
+    const uint32_t untilSample = (untilInterval > untilRetry) ? untilInterval : untilRetry;
+    const uint32_t untilPublish = m_nextPublishMs - nowMs;
+    return (untilSample < untilPublish) ? untilSample : untilPublish;
+}
+
+bool Sensor::sampleIfDue(uint32_t nowMs) {
+    if(!isSampleDue(nowMs)) return false;
+    const SensorSample_t s = sample();
+    m_health.record(nowMs, m_lastReadDurationUs, m_readFailed, m_sampleIntervalMs);
+    // The adaptive interval judges the signal after the transformer pipeline
+    if(m_adaptive != nullptr && !m_readFailed) m_sampleIntervalMs = m_adaptive->update(s.value, nowMs);
+    m_nextSampleMs = nextDueTime(m_nextSampleMs, m_sampleIntervalMs, nowMs, m_sampled);
+    m_sampled = true;
+    return true;
+}
+
+bool Sensor::takeAggregateIfDue(uint32_t nowMs, SampleAggregator& aggregate) {
+    if(!isPublishDue(nowMs)) return false;
+    aggregate = m_aggregator;
+    m_aggregator.reset();
+    m_nextPublishMs = nextDueTime(m_nextPublishMs, m_publishIntervalMs, nowMs, m_published);
+    m_published = true;
+    return true;
+}
+
+uint32_t Sensor::nextDueTime(uint32_t due, uint32_t interval, uint32_t nowMs, bool scheduled) {
+    // Keep a fixed cadence unless the deadline was missed by more than a whole interval
+    if(scheduled) {
+        due += interval;
+        if(static_cast<int32_t>(due - nowMs) > 0) return due;
+    }
+    return nowMs + interval;
+}
@@ -2,7 +2,13 @@
 #define SENSOR_H
 #include <memory>
 
+#include "../history/SensorHistory.h"
 #include "../transformers/Transformer.h"
+#include "AdaptiveInterval.h"
+#include "SampleAggregator.h"
+#include "SampleCache.h"
+#include "SensorHealth.h"
+#include "UrgentEventQueue.h"
 
 /**
  * @brief Maximum length of sensor name, including null terminator
@@ -26,16 +32,56 @@ class Sensor {
      */
     Sensor(char name[], std::shared_ptr<Transformer> transformer = nullptr);
 
+    /**
+     * @brief Destructor
+     */
+    virtual ~Sensor() = default;
+
+    /**
+     * @brief Acquisition function. Reads the sensor once, puts the reading through the
+     * transformer pipeline and publishes the result to the latest-sample cache.
+     * The result is also added to the aggregation window.
+     * Should only be called from the task which polls the sensors.
+     *
+     * @return SensorSample_t The new sample
+     */
+    SensorSample_t sample();
+
     /**
      * @brief Function to call for reading the sensor.
      * Will return a reading of the sensor that has been put through the filter function
      * of the sensor object. Digital values are mapped to either 0 or UINT16_MAX while
-     * analog values are not remapped
+     * analog values are not remapped.
+     * Same as sample() but only returns the processed value.
      *
-     * @return SensorResult_t
+     * @return float_t
      */
     float_t readSensor();
 
+    /**
+     * @brief Returns the latest sample taken by sample() without accessing the sensor.
+     * Safe to call from any task.
+     *
+     * @param sample [OUT] Latest sample
+     * @return true A sample was available
+     * @return false The sensor has not been sampled yet
+     */
+    inline bool getLatestSample(SensorSample_t& sample) const { return m_latestSample.load(sample); }
+
+    /**
+     * @brief Attaches a history to which every new sample is added
+     *
+     * @param history [IN] History object. Can be a nullptr to disable the history
+     */
+    inline void setHistory(std::shared_ptr<SensorHistory> history) { m_history = std::move(history); }
+
+    /**
+     * @brief Returns the history of this sensor
+     *
+     * @return SensorHistory* History or nullptr if none is attached
+     */
+    inline SensorHistory* getHistory() const { return m_history.get(); }
+
     /**
      * @brief Returns a raw reading of the given sensor without any filtering
      * or processing.
@@ -45,6 +91,21 @@ class Sensor {
      */
     virtual float_t readSensorRaw() = 0;
 
+    /**
+     * @brief Returns all raw readings acquired since the previous call, oldest first.
+     * Every value is put through the transformer pipeline, so that filters see the full
+     * acquisition rate, and the last one becomes the new sample.
+     * The default implementation returns a single reading of readSensorRaw.
+     *
+     * @param values [OUT] Raw readings
+     * @param maxCount [IN] Size of values, at least 1
+     * @return uint32_t Number of readings. If 0, readSensorRaw is used instead
+     */
+    virtual uint32_t readSensorBlock(float_t values[], uint32_t maxCount) {
+        values[0] = readSensorRaw();
+        return 1;
+    }
+
     /**
      * @brief Returns the name assigned to this sensor
      *
@@ -52,6 +113,174 @@ class Sensor {
      */
     inline const char* getName() const { return m_sensorName; };
 
+    /**
+     * @brief Returns the numeric ID of this sensor.
+     * The ID is derived from the name and therefore stays the same across reboots
+     *
+     * @return uint32_t
+     */
+    inline uint32_t getId() const { return m_sensorId; }
+
+    /**
+     * @brief Builds the MQTT topics of this sensor from the topic of its device:
+     * <deviceTopic>/<name>, <deviceTopic>/raw/<name> and <deviceTopic>/event/<name>.
+     * Called once when the sensor is created, so that the topics are not formatted for every publish.
+     * Must not be called while other tasks use the sensor.
+     *
+     * @param deviceTopic [IN] MQTT_BASE_TOPIC/<deviceTopic>
+     * @return RC_t RC_SUCCESS on success, RC_ERROR_MEMORY if the topics could not be allocated
+     */
+    RC_t setDeviceTopic(const char deviceTopic[]);
+
+    /**
+     * @brief Returns the topic of the processed values
+     *
+     * @return const char* Empty string if setDeviceTopic was not called
+     */
+    inline const char* getTopic() const { return m_topics ? m_topics.get() : ""; }
+
+    /**
+     * @brief Returns the topic of the raw values
+     *
+     * @return const char* Empty string if setDeviceTopic was not called
+     */
+    inline const char* getRawTopic() const { return m_topics ? m_topics.get() + m_rawTopicOffset : ""; }
+
+    /**
+     * @brief Returns the topic of urgent events
+     *
+     * @return const char* Empty string if setDeviceTopic was not called
+     */
+    inline const char* getEventTopic() const { return m_topics ? m_topics.get() + m_eventTopicOffset : ""; }
+
+    /**
+     * @brief Sets the hash of the config file definition this sensor was created from.
+     * Used to detect unchanged sensors when the config is reloaded.
+     *
+     * @param hash [IN]
+     */
+    inline void setConfigHash(uint32_t hash) { m_configHash = hash; }
+
+    /**
+     * @brief Returns the hash of the config file definition this sensor was created from
+     *
+     * @return uint32_t 0 if none was set
+     */
+    inline uint32_t getConfigHash() const { return m_configHash; }
+
+    /**
+     * @brief Sets how often the sensor is sampled and how often its aggregated samples are published
+     *
+     * @param sampleIntervalMs [IN] Time between two samples
+     * @param publishIntervalMs [IN] Time between two publishes. Should not be shorter than sampleIntervalMs
+     * @param aggregateFields [IN] Bit mask of SampleAggregator::Field_t values to publish.
+     *  0 publishes only the latest value
+     */
+    void setCadence(uint32_t sampleIntervalMs, uint32_t publishIntervalMs, uint8_t aggregateFields);
+
+    /**
+     * @brief Lets the sample interval follow the signal instead of using a fixed interval
+     *
+     * @param adaptive [IN] Controller which chooses the interval. nullptr restores the fixed interval
+     */
+    void setAdaptiveInterval(std::unique_ptr<AdaptiveInterval> adaptive);
+
+    /**
+     * @brief Returns the controller of the adaptive sample interval
+     *
+     * @return const AdaptiveInterval* nullptr if the interval is fixed
+     */
+    inline const AdaptiveInterval* getAdaptiveInterval() const { return m_adaptive.get(); }
+
+    /**
+     * @brief Returns the current sample interval. Changes over time for adaptive sensors
+     *
+     * @return uint32_t
+     */
+    inline uint32_t getSampleIntervalMs() const { return m_sampleIntervalMs; }
+
+    inline uint32_t getPublishIntervalMs() const { return m_publishIntervalMs; }
+
+    inline uint8_t getAggregateFields() const { return m_aggregateFields; }
+
+    /**
+     * @brief Sets the number of decimals with which the values of this sensor are published
+     *
+     * @param decimals [IN] At most FLOAT_FORMAT_MAX_DECIMALS
+     */
+    inline void setDecimals(uint8_t decimals) { m_decimals = decimals; }
+
+    inline uint8_t getDecimals() const { return m_decimals; }
+
+    /**
+     * @brief Sets the time a single read of this sensor may take
+     *
+     * @param budgetMs [IN] Budget in ms. 0 disables the budget
+     */
+    inline void setTimeBudget(uint32_t budgetMs) { m_health.setBudgetUs(budgetMs * 1000); }
+
+    /**
+     * @brief Returns the read timing and fault counters of this sensor
+     *
+     * @return const SensorHealth&
+     */
+    inline const SensorHealth& getHealth() const { return m_health; }
+
+    /**
+     * @brief Sets the queue which receives the urgent events raised by the transformer pipeline
+     * or the sensor itself
+     *
+     * @param queue [IN] Queue or nullptr to discard urgent events
+     */
+    inline void setUrgentEventQueue(UrgentEventQueue* queue) { m_urgentEvents = queue; }
+
+    /**
+     * @brief Checks whether the next sample is due. A sensor which was never sampled is always due.
+     * A degraded sensor is not due until its backoff has passed.
+     *
+     * @param nowMs [IN] Current uptime in ms
+     * @return true if sampleIfDue() would sample
+     */
+    bool isSampleDue(uint32_t nowMs) const;
+
+    /**
+     * @brief Checks whether the aggregated samples are due to be published.
+     * A sensor which was never published is always due.
+     *
+     * @param nowMs [IN] Current uptime in ms
+     * @return true if takeAggregateIfDue() would return an aggregate
+     */
+    bool isPublishDue(uint32_t nowMs) const;
+
+    /**
+     * @brief Calls sample() and schedules the next sample if the sample interval has passed.
+     * Also records the duration and result of the read in the sensor health.
+     * Should only be called from the task which polls the sensors.
+     *
+     * @param nowMs [IN] Current uptime in ms
+     * @return true if a sample was taken
+     */
+    bool sampleIfDue(uint32_t nowMs);
+
+    /**
+     * @brief If the publish interval has passed, returns the samples collected since the previous
+     * publish, starts a new window and schedules the next publish.
+     * Should only be called from the task which polls the sensors.
+     *
+     * @param nowMs [IN] Current uptime in ms
+     * @param aggregate [OUT] Aggregates of the finished window
+     * @return true if the publish was due and aggregate was written
+     */
+    bool takeAggregateIfDue(uint32_t nowMs, SampleAggregator& aggregate);
+
+    /**
+     * @brief Returns the time until the next sample or publish is due
+     *
+     * @param nowMs [IN] Current uptime in ms
+     * @return uint32_t Time in ms, 0 if already due
+     */
+    uint32_t getTimeUntilDueMs(uint32_t nowMs) const;
+
     /**
      * @brief Returns how many pipeline stages this sensor has
      *
@@ -65,6 +294,30 @@ class Sensor {
     }
 
    protected:
+    /**
+     * @brief Marks the current read as failed. Derived classes call this from readSensorRaw
+     * or readSensorBlock when the hardware did not deliver a valid reading.
+     * Failed readings are not aggregated and count as sensor fault.
+     */
+    inline void reportReadFailure() { m_readFailed = true; }
+
+    /**
+     * @brief Marks the current read as urgent. Derived classes call this from readSensorRaw
+     * or readSensorBlock, e.g. when the hardware signals an alarm.
+     */
+    inline void raiseUrgentEvent() { m_urgentRaised = true; }
+
+    /**
+     * @brief Calculates when a periodic action is due next
+     *
+     * @param due [IN] Previous due time
+     * @param interval [IN] Period of the action
+     * @param nowMs [IN] Time at which the action was performed
+     * @param scheduled [IN] False if the action was performed for the first time
+     * @return uint32_t Next due time
+     */
+    static uint32_t nextDueTime(uint32_t due, uint32_t interval, uint32_t nowMs, bool scheduled);
+
     /**
      * @brief Shared pointer to optional transformer pipeline
      * which is applied to any value read from the sensor.
@@ -77,6 +330,74 @@ class Sensor {
      *
      */
     char m_sensorName[SENSOR_NAME_MAX_LENGTH] = "";
+
+    /**
+     * @brief Hash of the sensor name
+     */
+    uint32_t m_sensorId = 0;
+    /**
+     * @brief The three topics of the sensor as consecutive null-terminated strings
+     */
+    std::unique_ptr<char[]> m_topics;
+    uint32_t m_rawTopicOffset = 0;
+    uint32_t m_eventTopicOffset = 0;
+
+    /**
+     * @brief Hash of the config file definition, see setConfigHash
+     */
+    uint32_t m_configHash = 0;
+
+    /**
+     * @brief Latest sample, written by sample() and read by consumers in other tasks
+     */
+    SampleCache m_latestSample;
+
+    /**
+     * @brief Optional history of past samples
+     */
+    std::shared_ptr<SensorHistory> m_history;
+
+    /**
+     * @brief Samples taken since the last publish
+     */
+    SampleAggregator m_aggregator;
+    uint32_t m_sampleIntervalMs = SENSOR_POLLING_INTERVAL_S * 1000;
+    uint32_t m_publishIntervalMs = SENSOR_POLLING_INTERVAL_S * 1000;
+    uint8_t m_aggregateFields = 0;
+    uint8_t m_decimals = FLOAT_FORMAT_MAX_DECIMALS;
+    /**
+     * @brief Optional controller of the sample interval
+     */
+    std::unique_ptr<AdaptiveInterval> m_adaptive;
+    /**
+     * @brief Uptime at which the next sample and publish are due. Only valid after the first one
+     */
+    uint32_t m_nextSampleMs = 0;
+    uint32_t m_nextPublishMs = 0;
+    bool m_sampled = false;
+    bool m_published = false;
+
+    /**
+     * @brief Read timing and fault counters
+     */
+    SensorHealth m_health;
+    /**
+     * @brief Set by reportReadFailure during the current read
+     */
+    bool m_readFailed = false;
+    /**
+     * @brief Duration of the latest read in us
+     */
+    uint32_t m_lastReadDurationUs = 0;
+
+    /**
+     * @brief Receiver of urgent events. Can be a nullptr
+     */
+    UrgentEventQueue* m_urgentEvents = nullptr;
+    /**
+     * @brief Set by raiseUrgentEvent during the current read
+     */
+    bool m_urgentRaised = false;
 };
 
 #endif  // SENSOR_H
\ No newline at end of file
@@ -0,0 +1,180 @@
+#include "SensorFactory.h"
+
+#include <string.h>
+
+#include "SampleAggregator.h"
+
+// Keys which every sensor type supports in addition to its own parameters
+static const ConfigParam_t commonSensorParams[] = {
+    {"name", CONFIG_PARAM_STRING, true, nullptr},
+    {"publishIntervalS", CONFIG_PARAM_INT, false, nullptr},
+    {"sampleIntervalMs", CONFIG_PARAM_INT, false, nullptr},
+    {"aggregate", CONFIG_PARAM_STRING, false, nullptr},
+    {"decimals", CONFIG_PARAM_INT, false, nullptr},
+    // Time a single read may take before the sensor is skipped, 0 disables the budget
+    {"timeBudgetMs", CONFIG_PARAM_INT, false, nullptr},
+    {"maxSampleIntervalMs", CONFIG_PARAM_INT, false, nullptr},
+    {"rateThreshold", CONFIG_PARAM_FLOAT, false, "0"},
+    {"varianceThreshold", CONFIG_PARAM_FLOAT, false, "0"},
+};
+
+/**
+ * @brief Sets the optional error output to a null-terminated key
+ */
+static inline void setErrorKey(StringView* errorKey, const char key[]) {
+    if(errorKey != nullptr) *errorKey = StringView(key, strlen(key));
+}
+
+Sensor* SensorFactory::sensorFromConfig(const SensorConfig_t& config, const SensorContext_t& context,
+                                        StringView* errorKey) {
+    setErrorKey(errorKey, "");
+    const SensorType_t* type = SensorTypes::find(config.sensor.type);
+    if(type == nullptr) {
+        if(errorKey != nullptr) *errorKey = config.sensor.type;
+        return nullptr;
+    }
+
+    ConfigParams common, params;
+    if(RC_SUCCESS != common.parse(config.sensor, commonSensorParams, ARRAY_SIZE(commonSensorParams))) {
+        setErrorKey(errorKey, common.getErrorKey());
+        return nullptr;
+    }
+    if(RC_SUCCESS != params.parse(config.sensor, type->params, type->paramCount)) {
+        setErrorKey(errorKey, params.getErrorKey());
+        return nullptr;
+    }
+    if(RC_SUCCESS != checkKeys(config.sensor, common, &params, errorKey)) return nullptr;
+
+    char name[SENSOR_NAME_MAX_LENGTH] = "";
+    if(RC_SUCCESS != common.getString("name", name, sizeof(name))) {
+        setErrorKey(errorKey, "name");
+        return nullptr;
+    }
+
+    uint32_t sampleIntervalMs{0}, publishIntervalMs{0};
+    uint8_t aggregateFields{0};
+    if(RC_SUCCESS != cadenceFromParams(common, sampleIntervalMs, publishIntervalMs, aggregateFields, errorKey))
+        return nullptr;
+
+    int32_t decimals = FLOAT_FORMAT_MAX_DECIMALS;
+    if(common.isSet("decimals")) decimals = common.getInt("decimals");
+    if(decimals < 0 || decimals > FLOAT_FORMAT_MAX_DECIMALS) {
+        setErrorKey(errorKey, "decimals");
+        return nullptr;
+    }
+
+    int32_t timeBudgetMs = SENSOR_DEFAULT_TIME_BUDGET_MS;
+    if(common.isSet("timeBudgetMs")) timeBudgetMs = common.getInt("timeBudgetMs");
+    if(timeBudgetMs < 0) {
+        setErrorKey(errorKey, "timeBudgetMs");
+        return nullptr;
+    }
+
+    std::unique_ptr<AdaptiveInterval> adaptive;
+    if(RC_SUCCESS != adaptiveIntervalFromParams(common, sampleIntervalMs, publishIntervalMs, adaptive, errorKey))
+        return nullptr;
+
+    std::shared_ptr<Transformer> transformer;
+    if(RC_SUCCESS != createTransformerChain(config, transformer, errorKey)) return nullptr;
+
+    Sensor* sensor = type->create(name, params, context, transformer);
+    if(sensor == nullptr) return nullptr;
+    sensor->setCadence(sampleIntervalMs, publishIntervalMs, aggregateFields);
+    sensor->setDecimals(decimals);
+    sensor->setTimeBudget(timeBudgetMs);
+    sensor->setAdaptiveInterval(std::move(adaptive));
+    sensor->setUrgentEventQueue(context.urgentEvents);
+    return sensor;
+}
+
+std::shared_ptr<Transformer> SensorFactory::transformerFromConfig(const ConfigSection& config, StringView* errorKey) {
+    setErrorKey(errorKey, "");
+    const TransformerType_t* type = TransformerTypes::find(config.type);
+    if(type == nullptr) {
+        if(errorKey != nullptr) *errorKey = config.type;
+        return nullptr;
+    }
+
+    ConfigParams params;
+    if(RC_SUCCESS != params.parse(config, type->params, type->paramCount)) {
+        setErrorKey(errorKey, params.getErrorKey());
+        return nullptr;
+    }
+    if(RC_SUCCESS != checkKeys(config, params, nullptr, errorKey)) return nullptr;
+    return type->create(params);
+}
+
+RC_t SensorFactory::createTransformerChain(const SensorConfig_t& config, std::shared_ptr<Transformer>& transformer,
+                                           StringView* errorKey) {
+    std::shared_ptr<Transformer> prevTransformer;
+    for(const ConfigSection& section : config.transformers) {
+        std::shared_ptr<Transformer> t = transformerFromConfig(section, errorKey);
+        if(t == nullptr) return RC_ERROR_BAD_DATA;
+        // Chain the created transformers together
+        t->setNextTransformer(prevTransformer);
+        prevTransformer = t;
+    }
+    transformer = prevTransformer;
+    return RC_SUCCESS;
+}
+
+RC_t SensorFactory::checkKeys(const ConfigSection& config, const ConfigParams& first, const ConfigParams* second,
+                              StringView* errorKey) {
+    for(const ConfigSection::KeyValue_t& kv : config.values) {
+        if(first.contains(kv.key) || (second != nullptr && second->contains(kv.key))) continue;
+        if(errorKey != nullptr) *errorKey = kv.key;
+        return RC_ERROR_INVALID;
+    }
+    return RC_SUCCESS;
+}
+
+RC_t SensorFactory::cadenceFromParams(const ConfigParams& params, uint32_t& sampleIntervalMs,
+                                      uint32_t& publishIntervalMs, uint8_t& aggregateFields, StringView* errorKey) {
+    int32_t publishIntervalS = SENSOR_POLLING_INTERVAL_S;
+    if(params.isSet("publishIntervalS")) publishIntervalS = params.getInt("publishIntervalS");
+    if(publishIntervalS <= 0) {
+        setErrorKey(errorKey, "publishIntervalS");
+        return RC_ERROR_INVALID;
+    }
+    publishIntervalMs = publishIntervalS * 1000;
+
+    int32_t sampleInterval = publishIntervalMs;
+    if(params.isSet("sampleIntervalMs")) sampleInterval = params.getInt("sampleIntervalMs");
+    if(sampleInterval < SENSOR_MIN_SAMPLE_INTERVAL_MS || sampleInterval > publishIntervalS * 1000) {
+        setErrorKey(errorKey, "sampleIntervalMs");
+        return RC_ERROR_INVALID;
+    }
+    sampleIntervalMs = sampleInterval;
+
+    aggregateFields = 0;
+    if(!params.isSet("aggregate")) return RC_SUCCESS;
+    char fieldsStr[64] = "";
+    if(RC_SUCCESS != params.getString("aggregate", fieldsStr, sizeof(fieldsStr)) ||
+       RC_SUCCESS != SampleAggregator::fieldsFromString(fieldsStr, aggregateFields)) {
+        setErrorKey(errorKey, "aggregate");
+        return RC_ERROR_INVALID;
+    }
+    return RC_SUCCESS;
+}
+
+RC_t SensorFactory::adaptiveIntervalFromParams(const ConfigParams& params, uint32_t sampleIntervalMs,
+                                               uint32_t publishIntervalMs, std::unique_ptr<AdaptiveInterval>& adaptive,
+                                               StringView* errorKey) {
+    if(!params.isSet("maxSampleIntervalMs")) return RC_SUCCESS;
+    const int32_t maxIntervalMs = params.getInt("maxSampleIntervalMs");
+    if(maxIntervalMs <= static_cast<int32_t>(sampleIntervalMs) ||
+       maxIntervalMs > static_cast<int32_t>(publishIntervalMs)) {
+        setErrorKey(errorKey, "maxSampleIntervalMs");
+        return RC_ERROR_INVALID;
+    }
+
+    const float_t rateThreshold = params.getFloat("rateThreshold");
+    const float_t varianceThreshold = params.getFloat("varianceThreshold");
+    if(rateThreshold < 0 || varianceThreshold < 0 || (rateThreshold == 0 && varianceThreshold == 0)) {
+        setErrorKey(errorKey, varianceThreshold < 0 ? "varianceThreshold" : "rateThreshold");
+        return RC_ERROR_INVALID;
+    }
+
+    adaptive.reset(new AdaptiveInterval(sampleIntervalMs, maxIntervalMs, rateThreshold, varianceThreshold));
+    return RC_SUCCESS;
+}
@@ -0,0 +1,41 @@
+#include "SensorHealth.h"
+
+bool SensorHealth::record(uint32_t nowMs, uint32_t durationUs, bool failed, uint32_t intervalMs) {
+    m_readCount.fetch_add(1, std::memory_order_relaxed);
+    m_lastDurationUs.store(durationUs, std::memory_order_relaxed);
+    if(durationUs > m_maxDurationUs.load(std::memory_order_relaxed))
+        m_maxDurationUs.store(durationUs, std::memory_order_relaxed);
+
+    const bool overrun = (m_budgetUs > 0) && (durationUs > m_budgetUs);
+    if(overrun) m_overrunCount.fetch_add(1, std::memory_order_relaxed);
+    if(failed) m_failureCount.fetch_add(1, std::memory_order_relaxed);
+
+    if(!overrun && !failed) {
+        m_consecutiveFaults.store(0, std::memory_order_relaxed);
+        m_backoffMs.store(0, std::memory_order_relaxed);
+        m_degraded.store(false, std::memory_order_relaxed);
+        return false;
+    }
+
+    const uint32_t faults = m_consecutiveFaults.load(std::memory_order_relaxed) + 1;
+    m_consecutiveFaults.store(faults, std::memory_order_relaxed);
+    if(!overrun && faults < SENSOR_FAULT_THRESHOLD) return true;
+
+    // Double the backoff with every fault, starting at twice the sample interval
+    uint32_t backoffMs = m_backoffMs.load(std::memory_order_relaxed);
+    if(backoffMs == 0)
+        backoffMs = (intervalMs > 0) ? intervalMs * 2 : 2;
+    else
+        backoffMs = (backoffMs > SENSOR_MAX_BACKOFF_MS / 2) ? SENSOR_MAX_BACKOFF_MS : backoffMs * 2;
+    if(backoffMs > SENSOR_MAX_BACKOFF_MS) backoffMs = SENSOR_MAX_BACKOFF_MS;
+    m_backoffMs.store(backoffMs, std::memory_order_relaxed);
+    m_retryAtMs = nowMs + backoffMs;
+    m_degraded.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+uint32_t SensorHealth::getTimeUntilRetryMs(uint32_t nowMs) const {
+    if(!isDegraded()) return 0;
+    const int32_t remaining = static_cast<int32_t>(m_retryAtMs - nowMs);
+    return (remaining > 0) ? remaining : 0;
+}
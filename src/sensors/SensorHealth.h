@@ -0,0 +1,91 @@
+#ifndef SENSOR_HEALTH_H
+#define SENSOR_HEALTH_H
+#include <atomic>
+
+#include "global.h"
+
+/**
+ * @brief Tracks read durations and faults of a sensor and decides when a faulty sensor is retried.
+ *
+ * A read is a fault if the sensor reported a failure or if it took longer than the time budget.
+ * A read over budget immediately puts the sensor into backoff, failed reads only after
+ * SENSOR_FAULT_THRESHOLD of them in a row. While in backoff the sensor is degraded and not read.
+ * Each further fault doubles the backoff up to SENSOR_MAX_BACKOFF_MS, the first good read ends it.
+ *
+ * @note record must only be called from the task which polls the sensors.
+ * The counters may be read from any task.
+ */
+class SensorHealth {
+   public:
+    SensorHealth() = default;
+
+    /**
+     * @brief Sets the time budget of a single read
+     *
+     * @param budgetUs [IN] Budget in us. 0 disables the budget
+     */
+    inline void setBudgetUs(uint32_t budgetUs) { m_budgetUs = budgetUs; }
+
+    inline uint32_t getBudgetUs() const { return m_budgetUs; }
+
+    /**
+     * @brief Records the result of a read and updates the backoff
+     *
+     * @param nowMs [IN] Uptime in ms at which the read finished
+     * @param durationUs [IN] Duration of the read
+     * @param failed [IN] True if the sensor reported a failure
+     * @param intervalMs [IN] Regular sample interval of the sensor. The backoff starts at twice this value
+     * @return true if the read was a fault
+     */
+    bool record(uint32_t nowMs, uint32_t durationUs, bool failed, uint32_t intervalMs);
+
+    /**
+     * @brief Returns the time until a degraded sensor may be read again
+     *
+     * @param nowMs [IN] Current uptime in ms
+     * @return uint32_t Time in ms, 0 if the sensor may be read now
+     */
+    uint32_t getTimeUntilRetryMs(uint32_t nowMs) const;
+
+    /**
+     * @brief Returns true while the sensor is skipped because of faults
+     */
+    inline bool isDegraded() const { return m_degraded.load(std::memory_order_relaxed); }
+
+    inline uint32_t getReadCount() const { return m_readCount.load(std::memory_order_relaxed); }
+
+    inline uint32_t getFailureCount() const { return m_failureCount.load(std::memory_order_relaxed); }
+
+    inline uint32_t getOverrunCount() const { return m_overrunCount.load(std::memory_order_relaxed); }
+
+    inline uint32_t getConsecutiveFaults() const { return m_consecutiveFaults.load(std::memory_order_relaxed); }
+
+    inline uint32_t getLastDurationUs() const { return m_lastDurationUs.load(std::memory_order_relaxed); }
+
+    inline uint32_t getMaxDurationUs() const { return m_maxDurationUs.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the length of the current backoff
+     *
+     * @return uint32_t Backoff in ms, 0 if the sensor is not degraded
+     */
+    inline uint32_t getBackoffMs() const { return m_backoffMs.load(std::memory_order_relaxed); }
+
+   private:
+    uint32_t m_budgetUs = SENSOR_DEFAULT_TIME_BUDGET_MS * 1000;
+    /**
+     * @brief Uptime at which the current backoff ends. Only valid while degraded
+     */
+    uint32_t m_retryAtMs = 0;
+
+    std::atomic<bool> m_degraded{false};
+    std::atomic<uint32_t> m_readCount{0};
+    std::atomic<uint32_t> m_failureCount{0};
+    std::atomic<uint32_t> m_overrunCount{0};
+    std::atomic<uint32_t> m_consecutiveFaults{0};
+    std::atomic<uint32_t> m_lastDurationUs{0};
+    std::atomic<uint32_t> m_maxDurationUs{0};
+    std::atomic<uint32_t> m_backoffMs{0};
+};
+
+#endif  // SENSOR_HEALTH_H
@@ -0,0 +1,73 @@
+#include "SensorRegistry.h"
+
+#include <cstring>
+
+#include "helper_functions.h"
+
+// Number of index entries allocated for the first sensor
+#define SENSOR_REGISTRY_INITIAL_INDEX_SIZE (16)
+
+RC_t SensorRegistry::add(std::shared_ptr<Sensor> sensor) {
+    if(sensor == nullptr) return RC_ERROR_NULL;
+    // Index entries store the position plus one in a uint16_t
+    if(m_sensors.size() >= UINT16_MAX - 1) return RC_ERROR_MEMORY;
+
+    // Keep the load factor at or below 0.5 so that probe sequences stay short
+    if((m_sensors.size() + 1) * 2 > m_index.size()) grow();
+
+    const uint32_t pos = probe(sensor->getId());
+    if(m_index[pos] != 0) {
+        const Sensor* existing = m_sensors[m_index[pos] - 1].get();
+        if(strcmp(existing->getName(), sensor->getName()) == 0)
+            return RC_ERROR_INVALID;
+        else
+            return RC_ERROR_BAD_DATA;
+    }
+
+    m_sensors.push_back(sensor);
+    m_index[pos] = static_cast<uint16_t>(m_sensors.size());
+    return RC_SUCCESS;
+}
+
+Sensor* SensorRegistry::find(const char name[]) const {
+    Sensor* s = find(hashString(name));
+    // Guard against hash collisions with names which are not registered
+    if(s != nullptr && strcmp(s->getName(), name) != 0) return nullptr;
+    return s;
+}
+
+Sensor* SensorRegistry::find(uint32_t id) const {
+    if(m_index.empty()) return nullptr;
+    const uint16_t entry = m_index[probe(id)];
+    if(entry == 0) return nullptr;
+    return m_sensors[entry - 1].get();
+}
+
+std::shared_ptr<Sensor> SensorRegistry::findByConfigHash(uint32_t configHash) const {
+    for(const std::shared_ptr<Sensor>& s : m_sensors) {
+        if(s->getConfigHash() == configHash) return s;
+    }
+    return nullptr;
+}
+
+void SensorRegistry::clear() {
+    m_sensors.clear();
+    m_index.clear();
+}
+
+uint32_t SensorRegistry::probe(uint32_t id) const {
+    const uint32_t mask = m_index.size() - 1;
+    uint32_t pos = id & mask;
+    while(m_index[pos] != 0 && m_sensors[m_index[pos] - 1]->getId() != id) {
+        pos = (pos + 1) & mask;
+    }
+    return pos;
+}
+
+void SensorRegistry::grow() {
+    const uint32_t newSize = m_index.empty() ? SENSOR_REGISTRY_INITIAL_INDEX_SIZE : m_index.size() * 2;
+    m_index.assign(newSize, 0);
+    for(uint32_t i = 0; i < m_sensors.size(); i++) {
+        m_index[probe(m_sensors[i]->getId())] = static_cast<uint16_t>(i + 1);
+    }
+}
@@ -0,0 +1,114 @@
+#ifndef SENSOR_REGISTRY_H
+#define SENSOR_REGISTRY_H
+#include <memory>
+#include <vector>
+
+#include "Sensor.h"
+#include "global.h"
+
+/**
+ * @brief Owns all configured sensors and allows looking them up by name or ID
+ * in constant time.
+ *
+ * Sensors are stored in insertion order for iteration. Lookups go through an
+ * open-addressing hash index with linear probing which is keyed by the sensor ID.
+ * Since the ID is the hash of the sensor name, the same index serves both
+ * name and ID lookups. An index entry is the position of the sensor plus one,
+ * 0 marks an empty entry.
+ *
+ * A registry is filled once and not modified while it is in use. To change the sensor
+ * set, a new registry is built and swapped in as a whole, see getSensors() and setSensors().
+ */
+class SensorRegistry {
+   public:
+    typedef std::vector<std::shared_ptr<Sensor>>::const_iterator const_iterator;
+
+    SensorRegistry() = default;
+
+    /**
+     * @brief Adds a sensor to the registry and takes ownership of it
+     *
+     * @param sensor [IN] Sensor to add
+     * @return RC_t RC_SUCCESS on success,
+     *  RC_ERROR_NULL if sensor is a nullptr,
+     *  RC_ERROR_INVALID if a sensor with the same name already exists,
+     *  RC_ERROR_BAD_DATA if the ID of the sensor collides with that of a different sensor,
+     *  RC_ERROR_MEMORY if the maximum number of sensors is reached
+     */
+    RC_t add(std::shared_ptr<Sensor> sensor);
+
+    /**
+     * @brief Looks up a sensor by its name
+     *
+     * @param name [IN] Name of the sensor
+     * @return Sensor* Sensor or nullptr if none with that name exists
+     */
+    Sensor* find(const char name[]) const;
+
+    /**
+     * @brief Looks up a sensor by its ID
+     *
+     * @param id [IN] ID of the sensor, see Sensor::getId
+     * @return Sensor* Sensor or nullptr if none with that ID exists
+     */
+    Sensor* find(uint32_t id) const;
+
+    /**
+     * @brief Looks up a sensor by the hash of its config file definition.
+     * Linear search, only meant for config reloads.
+     *
+     * @param configHash [IN] Hash of the definition, see Sensor::getConfigHash
+     * @return std::shared_ptr<Sensor> Sensor or nullptr if none matches
+     */
+    std::shared_ptr<Sensor> findByConfigHash(uint32_t configHash) const;
+
+    /**
+     * @brief Removes and releases all sensors
+     */
+    void clear();
+
+    /**
+     * @brief Returns the number of sensors in the registry
+     *
+     * @return uint32_t
+     */
+    inline uint32_t size() const { return m_sensors.size(); }
+
+    /**
+     * @brief Returns the sensor at the given position in insertion order
+     *
+     * @param idx [IN] Position, must be smaller than size()
+     * @return Sensor*
+     */
+    inline Sensor* at(uint32_t idx) const { return m_sensors[idx].get(); }
+
+    inline const_iterator begin() const { return m_sensors.begin(); }
+    inline const_iterator end() const { return m_sensors.end(); }
+
+   private:
+    /**
+     * @brief Returns the index entry position at which the given ID is stored
+     * or the first empty position in its probe sequence
+     *
+     * @param id [IN] Sensor ID
+     * @return uint32_t
+     */
+    uint32_t probe(uint32_t id) const;
+
+    /**
+     * @brief Doubles the index size and reinserts all sensors
+     */
+    void grow();
+
+    /**
+     * @brief Sensors in insertion order
+     */
+    std::vector<std::shared_ptr<Sensor>> m_sensors;
+    /**
+     * @brief Open-addressing hash index. Size is always a power of two
+     * and at least twice the number of sensors.
+     */
+    std::vector<uint16_t> m_index;
+};
+
+#endif  // SENSOR_REGISTRY_H
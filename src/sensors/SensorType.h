@@ -0,0 +1,88 @@
+#ifndef SENSOR_TYPE_H
+#define SENSOR_TYPE_H
+#include <memory>
+
+#include "Sensor.h"
+#include "UrgentEventQueue.h"
+#include "adc/AdcAcquisition.h"
+#include "config/ConfigParams.h"
+#include "config/TypeTable.h"
+#include "filesystem/Filesystem.h"
+#include "gpio/Gpio.h"
+#include "i2c/I2cBusManager.h"
+
+/**
+ * @brief Number of slots of the sensor type table. At most half of them can be used
+ */
+#define SENSOR_TYPE_TABLE_SIZE (32)
+
+/**
+ * @brief Shared resources which sensors may need for their construction
+ */
+typedef struct {
+    Filesystem& filesystem;
+    Gpio& gpio;
+    AdcAcquisition& adcAcquisition;
+    I2cBusManager& i2cBusManager;
+    /**
+     * @brief Receiver of urgent events. Can be a nullptr
+     */
+    UrgentEventQueue* urgentEvents;
+} SensorContext_t;
+
+/**
+ * @brief Creates a sensor from its checked parameters
+ *
+ * @param name [IN] Sensor name
+ * @param params [IN] Parameters according to the schema of the type
+ * @param context [IN] Shared resources
+ * @param transformer [IN] Transformer chain of the sensor, can be a nullptr
+ * @return Sensor* Dynamically allocated sensor or nullptr if a parameter value is invalid
+ */
+typedef Sensor* (*SensorConstructor_t)(char name[], const ConfigParams& params, const SensorContext_t& context,
+                                       std::shared_ptr<Transformer> transformer);
+
+/**
+ * @brief Describes a sensor type which can be created from the sensor config file
+ */
+typedef struct {
+    /**
+     * @brief Type name in the config file
+     */
+    const char* name;
+    /**
+     * @brief constHash of name
+     */
+    uint32_t nameHash;
+    const ConfigParam_t* params;
+    uint32_t paramCount;
+    SensorConstructor_t create;
+} SensorType_t;
+
+/**
+ * @brief All sensor types which registered themselves with REGISTER_SENSOR_TYPE
+ */
+typedef TypeTable<SensorType_t, SENSOR_TYPE_TABLE_SIZE> SensorTypes;
+
+/**
+ * @brief Adds a sensor type to SensorTypes during static initialization
+ */
+class SensorTypeRegistration {
+   public:
+    explicit SensorTypeRegistration(const SensorType_t& type) { SensorTypes::add(type); }
+};
+
+/**
+ * @brief Registers a sensor type under the name typeName. Has to be used once in the
+ * source file of the type, outside of any function.
+ *
+ * @param typeName Name of the type in the config file, without quotes
+ * @param params Array of ConfigParam_t with the type specific parameters
+ * @param constructor SensorConstructor_t which creates the sensor
+ */
+#define REGISTER_SENSOR_TYPE(typeName, params, constructor)                                                         \
+    static const SensorType_t typeName##_sensorType = {#typeName, constHash(#typeName), params, ARRAY_SIZE(params), \
+                                                       constructor};                                                \
+    static const SensorTypeRegistration typeName##_sensorTypeRegistration(typeName##_sensorType)
+
+#endif  // SENSOR_TYPE_H
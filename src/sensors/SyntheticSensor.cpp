@@ -0,0 +1,78 @@
+#include "SyntheticSensor.h"
+
+#include <cstring>
+#include <strings.h>
+
+#include "SensorType.h"
+
+SyntheticSensor::SyntheticSensor(char name[], Waveform_t waveform, float_t amplitude, float_t baseline, uint32_t period,
+                                 float_t noise, std::shared_ptr<Transformer> transformer)
+    : Sensor(name, transformer),
+      m_waveform(waveform),
+      m_amplitude(amplitude),
+      m_baseline(baseline),
+      m_period(period > 0 ? period : 1),
+      m_noise(noise),
+      m_rng(m_sensorId) {}
+
+RC_t SyntheticSensor::waveformFromString(const char str[], Waveform_t& waveform) {
+    if(strcasecmp(str, "sine") == 0)
+        waveform = SINE;
+    else if(strcasecmp(str, "step") == 0)
+        waveform = STEP;
+    else if(strcasecmp(str, "ramp") == 0)
+        waveform = RAMP;
+    else if(strcasecmp(str, "noise") == 0)
+        waveform = NOISE;
+    else
+        return RC_ERROR_INVALID;
+    return RC_SUCCESS;
+}
+
+float_t SyntheticSensor::readSensorRaw() {
+    float_t value;
+    switch(m_waveform) {
+        default:
+        case SINE:
+            value = m_baseline + m_amplitude * sinf(6.2831853f * m_step / m_period);
+            break;
+        case STEP:
+            value = (m_step < m_period / 2) ? m_baseline : m_baseline + m_amplitude;
+            break;
+        case RAMP:
+            value = m_baseline + m_amplitude * m_step / m_period;
+            break;
+        case NOISE:
+            value = m_baseline + m_amplitude * (2.0f * m_rng.nextFloat() - 1.0f);
+            break;
+    }
+    if(m_noise != 0) value += m_noise * (2.0f * m_rng.nextFloat() - 1.0f);
+
+    m_step++;
+    if(m_step >= m_period) m_step = 0;
+    return value;
+}
+
+static const ConfigParam_t syntheticSensorParams[] = {
+    {"waveform", CONFIG_PARAM_STRING, true, nullptr},
+    {"amplitude", CONFIG_PARAM_FLOAT, true, nullptr},
+    {"baseline", CONFIG_PARAM_FLOAT, false, "0"},
+    {"period", CONFIG_PARAM_INT, false, "100"},
+    {"noise", CONFIG_PARAM_FLOAT, false, "0"},
+};
+
+static Sensor* createSyntheticSensor(char name[], const ConfigParams& params, const SensorContext_t& context,
+                                     std::shared_ptr<Transformer> transformer) {
+    char waveformStr[16] = "";
+    SyntheticSensor::Waveform_t waveform;
+    if(RC_SUCCESS != params.getString("waveform", waveformStr, sizeof(waveformStr))) return nullptr;
+    if(RC_SUCCESS != SyntheticSensor::waveformFromString(waveformStr, waveform)) return nullptr;
+
+    const int32_t period = params.getInt("period");
+    if(period <= 0) return nullptr;
+
+    return new SyntheticSensor(name, waveform, params.getFloat("amplitude"), params.getFloat("baseline"), period,
+                               params.getFloat("noise"), transformer);
+}
+
+REGISTER_SENSOR_TYPE(SyntheticSensor, syntheticSensorParams, createSyntheticSensor);
@@ -0,0 +1,66 @@
+#ifndef SYNTHETIC_SENSOR_H
+#define SYNTHETIC_SENSOR_H
+#include "Sensor.h"
+#include "XorShift32.h"
+
+/**
+ * @brief Hardware-free sensor which generates a waveform for testing and benchmarking
+ * transformer pipelines.
+ *
+ * The waveform advances by one step per reading, so the output only depends on the
+ * number of readings and not on the time between them. Optional uniform noise
+ * is added to every value.
+ */
+class SyntheticSensor : public Sensor {
+   public:
+    typedef enum {
+        /** baseline + amplitude * sin(2 * pi * step / period) */
+        SINE,
+        /** Square wave: baseline for the first half of the period, baseline + amplitude for the second one */
+        STEP,
+        /** Sawtooth rising from baseline to baseline + amplitude during every period */
+        RAMP,
+        /** Uniform noise in [baseline - amplitude, baseline + amplitude) */
+        NOISE
+    } Waveform_t;
+
+    /**
+     * @brief Constructor
+     *
+     * @param name [IN] Name of the sensor
+     * @param waveform [IN] Waveform to generate
+     * @param amplitude [IN] Amplitude of the waveform
+     * @param baseline [IN] Value the waveform is centered around or starts from, see Waveform_t
+     * @param period [IN] Length of a period in readings. Must not be 0
+     * @param noise [IN] Amplitude of uniform noise added to every value. 0 disables noise
+     * @param transformer [IN] Pointer to optional data transformation pipeline
+     */
+    SyntheticSensor(char name[], Waveform_t waveform, float_t amplitude, float_t baseline, uint32_t period,
+                    float_t noise = 0, std::shared_ptr<Transformer> transformer = nullptr);
+
+    /**
+     * @brief Converts a waveform name from the config file to its enum value
+     *
+     * @param str [IN] sine, step, ramp or noise. Case insensitive
+     * @param waveform [OUT]
+     * @return RC_t RC_SUCCESS on success, RC_ERROR_INVALID if the name is unknown
+     */
+    static RC_t waveformFromString(const char str[], Waveform_t& waveform);
+
+   protected:
+    float_t readSensorRaw() override;
+
+   private:
+    const Waveform_t m_waveform;
+    const float_t m_amplitude;
+    const float_t m_baseline;
+    const uint32_t m_period;
+    const float_t m_noise;
+    /**
+     * @brief Position within the current period
+     */
+    uint32_t m_step = 0;
+    XorShift32 m_rng;
+};
+
+#endif  // SYNTHETIC_SENSOR_H
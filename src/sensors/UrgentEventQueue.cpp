@@ -0,0 +1,51 @@
+#include "UrgentEventQueue.h"
+
+#include <chrono>
+
+void UrgentEventQueue::setWakeFunction(void (*wakeFunction)()) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_wakeFunction = wakeFunction;
+}
+
+void UrgentEventQueue::push(const UrgentEvent_t& event) {
+    void (*wakeFunction)() = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        wakeFunction = m_wakeFunction;
+        if(m_count < URGENT_EVENT_QUEUE_SIZE) {
+            m_events[(m_start + m_count) % URGENT_EVENT_QUEUE_SIZE] = event;
+            m_count++;
+        } else {
+            // Overwrite the oldest event, the newest state matters most
+            m_events[m_start] = event;
+            m_start = (m_start + 1) % URGENT_EVENT_QUEUE_SIZE;
+            m_dropped++;
+        }
+    }
+    m_eventAvailable.notify_one();
+    if(wakeFunction != nullptr) wakeFunction();
+}
+
+bool UrgentEventQueue::pop(UrgentEvent_t& event) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(m_count == 0) return false;
+    event = m_events[m_start];
+    m_start = (m_start + 1) % URGENT_EVENT_QUEUE_SIZE;
+    m_count--;
+    return true;
+}
+
+bool UrgentEventQueue::waitForEvent(uint32_t timeoutMs) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_eventAvailable.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] { return m_count > 0; });
+}
+
+uint32_t UrgentEventQueue::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_count;
+}
+
+uint32_t UrgentEventQueue::getDroppedCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_dropped;
+}
@@ -0,0 +1,89 @@
+#ifndef URGENT_EVENT_QUEUE_H
+#define URGENT_EVENT_QUEUE_H
+#include <condition_variable>
+#include <mutex>
+
+#include "global.h"
+
+/**
+ * @brief Sample which has to be published as soon as possible, e.g. because an alarm threshold was crossed
+ */
+typedef struct {
+    /**
+     * @brief ID of the sensor which raised the event
+     */
+    uint32_t sensorId;
+    /**
+     * @brief Processed value which raised the event
+     */
+    float_t value;
+    /**
+     * @brief Uptime in ms at which the event was raised
+     */
+    uint32_t timestamp;
+} UrgentEvent_t;
+
+/**
+ * @brief Hands urgent events from the sensors to the publisher and wakes it up.
+ * Holds up to URGENT_EVENT_QUEUE_SIZE events, when full the oldest event is dropped.
+ * Safe to use from any task, but not from interrupts.
+ */
+class UrgentEventQueue {
+   public:
+    UrgentEventQueue() = default;
+
+    /**
+     * @brief Adds an event and wakes up a task waiting in waitForEvent
+     *
+     * @param event [IN]
+     */
+    void push(const UrgentEvent_t& event);
+
+    /**
+     * @brief Sets a function which is called after every push, e.g. to wake up the publisher
+     *
+     * @param wakeFunction [IN] nullptr to disable
+     */
+    void setWakeFunction(void (*wakeFunction)());
+
+    /**
+     * @brief Takes the oldest event without waiting
+     *
+     * @param event [OUT]
+     * @return true if an event was taken
+     */
+    bool pop(UrgentEvent_t& event);
+
+    /**
+     * @brief Waits until an event is available
+     *
+     * @param timeoutMs [IN] Longest time to wait
+     * @return true if an event is available, false on timeout
+     */
+    bool waitForEvent(uint32_t timeoutMs);
+
+    /**
+     * @brief Returns the number of queued events
+     *
+     * @return uint32_t
+     */
+    uint32_t size() const;
+
+    /**
+     * @brief Returns how many events were dropped because the queue was full
+     *
+     * @return uint32_t
+     */
+    uint32_t getDroppedCount() const;
+
+   private:
+    mutable std::mutex m_mutex;
+    std::condition_variable m_eventAvailable;
+    UrgentEvent_t m_events[URGENT_EVENT_QUEUE_SIZE];
+    uint32_t m_start = 0;
+    uint32_t m_count = 0;
+    uint32_t m_dropped = 0;
+    void (*m_wakeFunction)() = nullptr;
+};
+
+#endif  // URGENT_EVENT_QUEUE_H
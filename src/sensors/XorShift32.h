@@ -0,0 +1,45 @@
+#ifndef XORSHIFT32_H
+#define XORSHIFT32_H
+#include "global.h"
+
+/**
+ * @brief Marsaglia's xorshift32 pseudo random number generator.
+ * Much faster than rand() and deterministic across platforms for a given seed,
+ * but not suitable for anything security related.
+ */
+class XorShift32 {
+   public:
+    /**
+     * @brief Constructor
+     *
+     * @param seed [IN] Initial state. A seed of 0 is replaced, since the generator would only return 0
+     */
+    explicit XorShift32(uint32_t seed) : m_state(seed != 0 ? seed : 2463534242u) {}
+
+    /**
+     * @brief Returns the next 32 bit random number
+     *
+     * @return uint32_t
+     */
+    inline uint32_t next() {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 17;
+        m_state ^= m_state << 5;
+        return m_state;
+    }
+
+    /**
+     * @brief Returns a uniformly distributed number in [0, 1)
+     *
+     * @return float_t
+     */
+    inline float_t nextFloat() {
+        // The upper 24 bits fit exactly into the float mantissa
+        return static_cast<float_t>(next() >> 8) * (1.0f / 16777216.0f);
+    }
+
+   private:
+    uint32_t m_state;
+};
+
+#endif  // XORSHIFT32_H
@@ -1,93 +1,229 @@
 #include "settings.h"
 
-#include "global_objects.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "filesystem/LineReader.h"
 #include "helper_functions.h"
 
-RC_t parseSettingsFile(const char filename[], settings_t& settingsObject) {
-    // Try to open the given file
-    RC_t err = filesystem->openFile(filename, Filesystem::READ_ONLY);
-    if(err != RC_SUCCESS) return err;
+// Longest filename of the settings file including the temporary file suffix
+#define SETTINGS_MAX_FILENAME_LENGTH (64)
+
+typedef enum { SETTING_TYPE_STRING, SETTING_TYPE_PORT, SETTING_TYPE_CHOICE } SettingType_t;
+
+typedef struct {
+    const char* key;
+    uint32_t keyHash;
+    SettingType_t type;
+    /**
+     * @brief Position and size of the field in settings_t
+     */
+    uint32_t offset;
+    uint32_t size;
+    /**
+     * @brief Secrets are stored in the non-volatile storage instead of the settings file
+     */
+    bool secret;
+    /**
+     * @brief Values of a SETTING_TYPE_CHOICE setting. The field holds the index of the chosen one
+     */
+    const char* const* choices;
+    uint32_t choiceCount;
+} SettingsKey_t;
+
+#define SETTINGS_KEY(key, type, field, secret)                                                                 \
+    {key, constHash(key), type, offsetof(settings_t, field), sizeof(static_cast<settings_t*>(nullptr)->field), \
+     secret, nullptr, 0}
+
+#define CHOICE_SETTINGS_KEY(key, field, choices)                                                              \
+    {key, constHash(key), SETTING_TYPE_CHOICE, offsetof(settings_t, field), sizeof(uint32_t), false, choices, \
+     ARRAY_SIZE(choices)}
+
+// Values of MQTT_Publish_Mode in the order of MqttPublishMode_t
+static const char* const publishModes[] = {"sensor", "device"};
+// Values of MQTT_Outbox_Drop in the order of MqttOutboxDrop_t
+static const char* const outboxDrops[] = {"oldest", "newest"};
+// Values of MQTT_Payload_Format in the order of MqttPayloadFormat_t
+static const char* const payloadFormats[] = {"json", "cbor", "msgpack", "influx"};
+
+// Keys of the settings file in the order of Setting_t
+static const SettingsKey_t settingsKeys[SETTING_COUNT] = {
+    SETTINGS_KEY("WIFI_SSID", SETTING_TYPE_STRING, wifi.ssid, false),
+    SETTINGS_KEY("WIFI_Password", SETTING_TYPE_STRING, wifi.password, true),
+    SETTINGS_KEY("WIFI_Hostname", SETTING_TYPE_STRING, wifi.hostname, false),
+    SETTINGS_KEY("MQTT_Broker_Address", SETTING_TYPE_STRING, mqtt.brokerAddress, false),
+    SETTINGS_KEY("MQTT_Broker_Port", SETTING_TYPE_PORT, mqtt.brokerPort, false),
+    SETTINGS_KEY("MQTT_ClientID", SETTING_TYPE_STRING, mqtt.clientID, false),
+    SETTINGS_KEY("MQTT_Username", SETTING_TYPE_STRING, mqtt.username, false),
+    SETTINGS_KEY("MQTT_Password", SETTING_TYPE_STRING, mqtt.password, true),
+    SETTINGS_KEY("MQTT_Device_Topic", SETTING_TYPE_STRING, mqtt.deviceTopic, false),
+    CHOICE_SETTINGS_KEY("MQTT_Publish_Mode", mqtt.publishMode, publishModes),
+    CHOICE_SETTINGS_KEY("MQTT_Outbox_Drop", mqtt.outboxDrop, outboxDrops),
+    CHOICE_SETTINGS_KEY("MQTT_Payload_Format", mqtt.payloadFormat, payloadFormats),
+};
+
+const char* getSettingKey(Setting_t setting) { return (setting < SETTING_COUNT) ? settingsKeys[setting].key : ""; }
+
+bool isSecretSetting(Setting_t setting) { return setting < SETTING_COUNT && settingsKeys[setting].secret; }
+
+RC_t setSetting(settings_t& settingsObject, Setting_t setting, const StringView& value, bool* changed) {
+    if(setting >= SETTING_COUNT) return RC_ERROR_BAD_PARAM;
+    const SettingsKey_t& k = settingsKeys[setting];
+    uint8_t* field = reinterpret_cast<uint8_t*>(&settingsObject) + k.offset;
+    bool differs = false;
+    if(SETTING_TYPE_STRING == k.type) {
+        char* str = reinterpret_cast<char*>(field);
+        if(value.length() >= k.size) return RC_ERROR_BUFFER_FULL;
+        differs = !value.equals(str);
+        if(differs) value.copyTo(str, k.size);
+    } else if(SETTING_TYPE_CHOICE == k.type) {
+        uint32_t choice = 0;
+        while(choice < k.choiceCount && !value.equals(k.choices[choice])) choice++;
+        if(choice == k.choiceCount) return RC_ERROR_INVALID;
+        uint32_t* current = reinterpret_cast<uint32_t*>(field);
+        differs = *current != choice;
+        *current = choice;
+    } else {
+        int32_t port = 0;
+        const RC_t err = value.toInt(port);
+        if(RC_SUCCESS != err) return err;
+        if(port < 0 || port > UINT16_MAX) return RC_ERROR_RANGE;
+        uint32_t* current = reinterpret_cast<uint32_t*>(field);
+        differs = *current != static_cast<uint32_t>(port);
+        *current = port;
+    }
+    if(changed != nullptr) *changed = differs;
+    return RC_SUCCESS;
+}
 
-    // Flag to indicate whether the WiFi password
-    // was found in the settings file.
-    // If it was, rewrite the file without it
-    bool passwordFound = false;
-
-    while(!filesystem->eof()) {
-        uint8_t data[1024] = "\0";
-        // Read line
-        err = filesystem->read(data, sizeof(data));
-        if(err != RC_SUCCESS) break;
-
-        // Remove comments from input
-        trimComments(reinterpret_cast<char*>(data), CONFIG_FILE_COMMENT_DELIMITER);
-
-        // Parse the key-value pairs required for the settings
-        char value[128] = "";
-        RC_t parseErr = readKeyValue(reinterpret_cast<char*>(data), "WIFI_SSID", value, sizeof(value));
-        if(parseErr == RC_SUCCESS) strcpy(settingsObject.wifi.ssid, value);
-        memset(value, '\0', sizeof(value));
-
-        parseErr = readKeyValue(reinterpret_cast<char*>(data), "WIFI_Password", value, sizeof(value));
-        if(parseErr == RC_SUCCESS) {
-            ramLogger.logLn("Found WiFi password in config file. Removing it...");
-            strcpy(settingsObject.wifi.password, value);
-            passwordFound = true;
-        }
-        memset(value, '\0', sizeof(value));
+RC_t getSetting(const settings_t& settingsObject, Setting_t setting, char value[], uint32_t size) {
+    if(setting >= SETTING_COUNT) return RC_ERROR_BAD_PARAM;
+    const SettingsKey_t& k = settingsKeys[setting];
+    const uint8_t* field = reinterpret_cast<const uint8_t*>(&settingsObject) + k.offset;
+    int32_t length = 0;
+    if(SETTING_TYPE_STRING == k.type)
+        length = snprintf(value, size, "%s", reinterpret_cast<const char*>(field));
+    else if(SETTING_TYPE_CHOICE == k.type) {
+        const uint32_t choice = *reinterpret_cast<const uint32_t*>(field);
+        length = snprintf(value, size, "%s", (choice < k.choiceCount) ? k.choices[choice] : "");
+    } else
+        length = snprintf(value, size, "%u", *reinterpret_cast<const uint32_t*>(field));
+    if(length < 0 || length >= static_cast<int32_t>(size)) return RC_ERROR_BUFFER_FULL;
+    return RC_SUCCESS;
+}
 
-        parseErr = readKeyValue(reinterpret_cast<char*>(data), "WIFI_Hostname", value, sizeof(value));
-        if(parseErr == RC_SUCCESS) strcpy(settingsObject.wifi.hostname, value);
-        memset(value, '\0', sizeof(value));
+static inline bool isBlank(char c) { return c == ' ' || c == '\t'; }
 
-        parseErr = readKeyValue(reinterpret_cast<char*>(data), "MQTT_Broker_Address", value, sizeof(value));
-        if(parseErr == RC_SUCCESS) strcpy(settingsObject.mqtt.brokerAddress, value);
-        memset(value, '\0', sizeof(value));
+static StringView trim(const char* start, const char* end) {
+    while(start < end && isBlank(*start)) start++;
+    while(end > start && isBlank(end[-1])) end--;
+    return StringView(start, end - start);
+}
 
-        parseErr = readKeyValueInt(reinterpret_cast<char*>(data), "MQTT_Broker_Port",
-                                   reinterpret_cast<int32_t&>(settingsObject.mqtt.brokerPort));
-        if(RC_ERROR_INVALID == parseErr) ramLogger.logLn("Config: Could not parse MQTT broker port");
+/**
+ * @brief Copies a line without its comments
+ *
+ * @param line [IN]
+ * @param text [OUT] At least as large as line
+ * @param inComment [INOUT] Whether the line starts inside a comment. Set to whether it ends inside one
+ * @return uint32_t Length of text
+ */
+static uint32_t stripComments(const StringView& line, char text[], bool& inComment) {
+    const uint32_t delimiterLength = strlen(CONFIG_FILE_COMMENT_DELIMITER);
+    uint32_t length = 0;
+    for(uint32_t i = 0; i < line.length();) {
+        if(line.length() - i >= delimiterLength &&
+           memcmp(line.data() + i, CONFIG_FILE_COMMENT_DELIMITER, delimiterLength) == 0) {
+            inComment = !inComment;
+            i += delimiterLength;
+            continue;
+        }
+        if(!inComment) text[length++] = line.data()[i];
+        i++;
+    }
+    return length;
+}
 
-        parseErr = readKeyValue(reinterpret_cast<char*>(data), "MQTT_ClientID", value, sizeof(value));
-        if(parseErr == RC_SUCCESS) strcpy(settingsObject.mqtt.clientID, value);
-        memset(value, '\0', sizeof(value));
+/**
+ * @brief Stores the value of a "KEY: value" line in the setting of its key
+ *
+ * @param line [IN] Line without comments
+ * @param settingsObject [OUT]
+ * @param found [INOUT] SETTING_BIT of the key is set if its value was stored
+ * @param invalid [INOUT] SETTING_BIT of the key is set if its value was rejected
+ */
+static void parseSettingsLine(const StringView& line, settings_t& settingsObject, uint32_t& found, uint32_t& invalid) {
+    const char* colon = static_cast<const char*>(memchr(line.data(), ':', line.length()));
+    if(colon == nullptr) return;
+    const StringView key = trim(line.data(), colon);
+    const StringView value = trim(colon + 1, line.data() + line.length());
+    // Keys without value keep their default
+    if(key.empty() || value.empty()) return;
+
+    const uint32_t keyHash = hashBytes(reinterpret_cast<const uint8_t*>(key.data()), key.length());
+    for(uint32_t i = 0; i < SETTING_COUNT; i++) {
+        if(settingsKeys[i].keyHash != keyHash || !key.equals(settingsKeys[i].key)) continue;
+        if(RC_SUCCESS == setSetting(settingsObject, static_cast<Setting_t>(i), value))
+            found |= SETTING_BIT(i);
+        else
+            invalid |= SETTING_BIT(i);
+        return;
+    }
+}
 
-        parseErr = readKeyValue(reinterpret_cast<char*>(data), "MQTT_Username", value, sizeof(value));
-        if(parseErr == RC_SUCCESS) strcpy(settingsObject.mqtt.username, value);
-        memset(value, '\0', sizeof(value));
+RC_t parseSettingsFile(Filesystem& fs, const char filename[], settings_t& settingsObject, uint32_t* foundSettings,
+                       uint32_t* invalidSettings) {
+    // Try to open the given file
+    RC_t err = fs.openFile(filename, Filesystem::READ_ONLY);
+    if(err != RC_SUCCESS) return err;
 
-        parseErr = readKeyValue(reinterpret_cast<char*>(data), "MQTT_Device_Topic", value, sizeof(value));
-        if(parseErr == RC_SUCCESS) strcpy(settingsObject.mqtt.deviceTopic, value);
-        memset(value, '\0', sizeof(value));
+    char buffer[SETTINGS_FILE_MAX_LINE_LENGTH];
+    char text[SETTINGS_FILE_MAX_LINE_LENGTH];
+    LineReader reader(fs, buffer, sizeof(buffer));
+    uint32_t found = 0, invalid = 0;
+    bool inComment = false;
+    StringView line;
+    while(true) {
+        err = reader.next(line);
+        // Overlong lines are skipped, they can't hold a valid setting
+        if(RC_ERROR_OVERRUN == err) continue;
+        if(RC_SUCCESS != err) break;
+        const uint32_t length = stripComments(line, text, inComment);
+        parseSettingsLine(StringView(text, length), settingsObject, found, invalid);
     }
-    filesystem->closeFile();
+    fs.closeFile();
+    if(RC_ERROR_BUFFER_EMPTY != err) return err;
 
-    // Remove password from settings file
-    if(passwordFound) writeToSettingsFile(filename, settingsObject);
-    return err;
+    if(foundSettings != nullptr) *foundSettings = found;
+    if(invalidSettings != nullptr) *invalidSettings = invalid;
+    return RC_SUCCESS;
 }
 
-RC_t writeToSettingsFile(const char filename[], const settings_t& settingsObject) {
-    // Try to open the given file in Truncate mode to overwrite it
-    RC_t err = filesystem->openFile(filename, Filesystem::WRITE_TRUNCATE);
+RC_t writeToSettingsFile(Filesystem& fs, const char filename[], const settings_t& settingsObject) {
+    // The settings are written to a temporary file which then replaces the settings file.
+    // If writing is interrupted, the previous settings file stays intact
+    char tempFilename[SETTINGS_MAX_FILENAME_LENGTH];
+    const int32_t filenameLength =
+        snprintf(tempFilename, sizeof(tempFilename), "%s%s", filename, SETTINGS_TEMP_FILE_SUFFIX);
+    if(filenameLength < 0 || filenameLength >= static_cast<int32_t>(sizeof(tempFilename))) return RC_ERROR_BAD_PARAM;
+    RC_t err = fs.openFile(tempFilename, Filesystem::WRITE_TRUNCATE);
     if(err != RC_SUCCESS) return err;
 
-    char line[256] = "";
-    int32_t usedChars = snprintf(line, sizeof(line), "WIFI_SSID: %s\n", settingsObject.wifi.ssid);
-    if(RC_SUCCESS != filesystem->write((uint8_t*)line, usedChars)) return RC_ERROR_WRITE_FAILS;
-    usedChars = snprintf(line, sizeof(line), "WIFI_Hostname: %s\n", settingsObject.wifi.hostname);
-    if(RC_SUCCESS != filesystem->write((uint8_t*)line, usedChars)) return RC_ERROR_WRITE_FAILS;
-    usedChars = snprintf(line, sizeof(line), "MQTT_Broker_Address: %s\n", settingsObject.mqtt.brokerAddress);
-    if(RC_SUCCESS != filesystem->write((uint8_t*)line, usedChars)) return RC_ERROR_WRITE_FAILS;
-    usedChars = snprintf(line, sizeof(line), "MQTT_Broker_Port: %u\n", settingsObject.mqtt.brokerPort);
-    if(RC_SUCCESS != filesystem->write((uint8_t*)line, usedChars)) return RC_ERROR_WRITE_FAILS;
-    usedChars = snprintf(line, sizeof(line), "MQTT_ClientID: %s\n", settingsObject.mqtt.clientID);
-    if(RC_SUCCESS != filesystem->write((uint8_t*)line, usedChars)) return RC_ERROR_WRITE_FAILS;
-    usedChars = snprintf(line, sizeof(line), "MQTT_Username: %s\n", settingsObject.mqtt.username);
-    if(RC_SUCCESS != filesystem->write((uint8_t*)line, usedChars)) return RC_ERROR_WRITE_FAILS;
-    usedChars = snprintf(line, sizeof(line), "MQTT_Device_Topic: %s\n", settingsObject.mqtt.deviceTopic);
-    if(RC_SUCCESS != filesystem->write((uint8_t*)line, usedChars)) return RC_ERROR_WRITE_FAILS;
-
-    filesystem->closeFile();
-    return RC_SUCCESS;
-}
\ No newline at end of file
+    for(uint32_t i = 0; i < SETTING_COUNT && RC_SUCCESS == err; i++) {
+        const SettingsKey_t& k = settingsKeys[i];
+        if(k.secret) continue;
+        char value[SETTINGS_MAX_VALUE_LENGTH] = "";
+        getSetting(settingsObject, static_cast<Setting_t>(i), value, sizeof(value));
+        char line[SETTINGS_FILE_MAX_LINE_LENGTH] = "";
+        const int32_t usedChars = snprintf(line, sizeof(line), "%s: %s\n", k.key, value);
+        err = fs.write(reinterpret_cast<uint8_t*>(line), usedChars);
+    }
+    if(RC_SUCCESS == err) err = fs.flush();
+    fs.closeFile();
+    if(RC_SUCCESS != err) {
+        fs.deleteFile(tempFilename);
+        return RC_ERROR_WRITE_FAILS;
+    }
+    return fs.renameFile(tempFilename, filename);
+}
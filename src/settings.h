@@ -1,7 +1,29 @@
 #ifndef SETTINGS_H
 #define SETTINGS_H
+#include "config/ConfigTokenizer.h"
+#include "filesystem/Filesystem.h"
 #include "global.h"
 
+/**
+ * @brief How the samples of a polling cycle are published
+ */
+typedef enum {
+    // Every sensor to MQTT_BASE_TOPIC/<deviceTopic>/<sensorName> and MQTT_BASE_TOPIC/<deviceTopic>/raw/<sensorName>
+    MQTT_PUBLISH_PER_SENSOR,
+    // All sensors of a cycle in one document to MQTT_BASE_TOPIC/<deviceTopic>
+    MQTT_PUBLISH_PER_DEVICE
+} MqttPublishMode_t;
+
+/**
+ * @brief Which messages are dropped if the MQTT outbox is full
+ */
+typedef enum { MQTT_OUTBOX_DROP_OLDEST, MQTT_OUTBOX_DROP_NEWEST } MqttOutboxDrop_t;
+
+/**
+ * @brief Encoding of the document published if MQTT_Publish_Mode is device
+ */
+typedef enum { MQTT_PAYLOAD_JSON, MQTT_PAYLOAD_CBOR, MQTT_PAYLOAD_MSGPACK, MQTT_PAYLOAD_INFLUX } MqttPayloadFormat_t;
+
 typedef struct {
     struct {
         char ssid[64] = "";
@@ -32,31 +54,129 @@ typedef struct {
          * > MQTT_BASE_TOPIC/<deviceTopic>/<sensorName>
          */
         char deviceTopic[64] = "";
+        /**
+         * @brief One of MqttPublishMode_t
+         */
+        uint32_t publishMode = MQTT_PUBLISH_PER_SENSOR;
+        /**
+         * @brief One of MqttOutboxDrop_t
+         */
+        uint32_t outboxDrop = MQTT_OUTBOX_DROP_OLDEST;
+        /**
+         * @brief One of MqttPayloadFormat_t
+         */
+        uint32_t payloadFormat = MQTT_PAYLOAD_JSON;
     } mqtt;
 } settings_t;
 
+/**
+ * @brief Fields of settings_t and keys of the settings file.
+ * Used as bit positions in the masks reported by parseSettingsFile
+ */
+typedef enum {
+    SETTING_WIFI_SSID,
+    SETTING_WIFI_PASSWORD,
+    SETTING_WIFI_HOSTNAME,
+    SETTING_MQTT_BROKER_ADDRESS,
+    SETTING_MQTT_BROKER_PORT,
+    SETTING_MQTT_CLIENT_ID,
+    SETTING_MQTT_USERNAME,
+    SETTING_MQTT_PASSWORD,
+    SETTING_MQTT_DEVICE_TOPIC,
+    SETTING_MQTT_PUBLISH_MODE,
+    SETTING_MQTT_OUTBOX_DROP,
+    SETTING_MQTT_PAYLOAD_FORMAT,
+    SETTING_COUNT
+} Setting_t;
+
+#define SETTING_BIT(setting) (1u << (setting))
+
+/**
+ * @brief Size of the largest value of settings_t including null terminator
+ */
+#define SETTINGS_MAX_VALUE_LENGTH (64)
+
+/**
+ * @brief Returns the key of a setting in the settings file
+ *
+ * @param setting [IN]
+ * @return const char* Key or an empty string for invalid settings
+ */
+const char* getSettingKey(Setting_t setting);
+
+/**
+ * @brief Returns whether a setting is a secret. Secrets are not written to the settings file.
+ *
+ * @param setting [IN]
+ * @return true
+ * @return false
+ */
+bool isSecretSetting(Setting_t setting);
+
+/**
+ * @brief Parses a value and stores it in a field of the settings object
+ *
+ * @param settingsObject [INOUT]
+ * @param setting [IN] Field to set
+ * @param value [IN] Value in the format of the settings file
+ * @param changed [OUT] Optional, whether the field had another value before
+ * @return RC_t RC_SUCCESS on success,
+ *  RC_ERROR_BAD_PARAM if the setting does not exist,
+ *  RC_ERROR_BUFFER_FULL if the value is too long,
+ *  RC_ERROR_BAD_DATA if a number is empty,
+ *  RC_ERROR_INVALID if a number can not be parsed or the value is not one of the choices of the setting,
+ *  RC_ERROR_RANGE if a number is out of range
+ */
+RC_t setSetting(settings_t& settingsObject, Setting_t setting, const StringView& value, bool* changed = nullptr);
+
+/**
+ * @brief Formats a field of the settings object like in the settings file
+ *
+ * @param settingsObject [IN]
+ * @param setting [IN] Field to get
+ * @param value [OUT] Null-terminated value
+ * @param size [IN] Size of value
+ * @return RC_t RC_SUCCESS on success,
+ *  RC_ERROR_BAD_PARAM if the setting does not exist,
+ *  RC_ERROR_BUFFER_FULL if the value does not fit
+ */
+RC_t getSetting(const settings_t& settingsObject, Setting_t setting, char value[], uint32_t size);
+
 /**
  * @brief Parses the given file into the provided settings object
- * as far as possible
+ * as far as possible.
  *
+ * Every line of the form "KEY: value" sets the setting of its key. Comments, unknown keys and
+ * keys without a value are ignored.
+ *
+ * @param fs [IN] Filesystem on which the file is stored
  * @param filename [IN] Name of the configuration file
  * @param settingsObject [OUT] Settings object to which the file contents are parsed
+ * @param foundSettings [OUT] Optional, SETTING_BIT of every setting which was read from the file
+ * @param invalidSettings [OUT] Optional, SETTING_BIT of every setting whose value was rejected
  * @return RC_t RC_SUCCESS on success,
  *  RC_ERROR_OPEN if the file could not be opened,
  *  RC_ERROR_BUSY if another file is currently open and needs to be closed first,
  *  RC_ERROR_READ_FAILS if the read operation failed
  */
-RC_t parseSettingsFile(const char filename[], settings_t& settingsObject);
+RC_t parseSettingsFile(Filesystem& fs, const char filename[], settings_t& settingsObject,
+                       uint32_t* foundSettings = nullptr, uint32_t* invalidSettings = nullptr);
 
 /**
  * @brief Overwrites the config file with the settings currently stored
- * in the provided settings object
+ * in the provided settings object. Secrets are left out.
+ *
+ * The file is replaced in one step by renaming a temporary file, so that it is
+ * never left half written.
  *
+ * @param fs [IN] Filesystem on which the file is stored
  * @param filename [IN] Name of the configuration file to overwrite
  * @param settingsObject [IN] Settings to write
  * @return RC_t RC_SUCCESS on success,
  *  RC_ERROR_OPEN if the file could not be opened,
+ *  RC_ERROR_WRITE_FAILS if writing failed,
+ *  errors of Filesystem::renameFile
  */
-RC_t writeToSettingsFile(const char filename[], const settings_t& settingsObject);
+RC_t writeToSettingsFile(Filesystem& fs, const char filename[], const settings_t& settingsObject);
 
 #endif  // SETTINGS_H
\ No newline at end of file
@@ -0,0 +1,41 @@
+#ifndef KEY_VALUE_STORE_H
+#define KEY_VALUE_STORE_H
+#include "global.h"
+#ifdef ARDUINO
+    #include <Arduino.h>
+#else
+    #include <cstdint>
+#endif  // ARDUINO
+
+/**
+ * @brief Abstraction of the non-volatile key-value storage in which values are kept which
+ * should not be exposed in a file, like passwords. Allows the settings to be tested on native.
+ */
+class KeyValueStore {
+   public:
+    KeyValueStore() = default;
+    virtual ~KeyValueStore() = default;
+
+    /**
+     * @brief Reads the string stored under a key
+     *
+     * @param key [IN]
+     * @param value [OUT] Null-terminated value
+     * @param size [IN] Size of value
+     * @return RC_t RC_SUCCESS on success,
+     *  RC_ERROR_ZERO if nothing is stored under the key,
+     *  RC_ERROR_BUFFER_FULL if the value does not fit
+     */
+    virtual RC_t getString(const char key[], char value[], uint32_t size) = 0;
+
+    /**
+     * @brief Stores a string under a key. Every call writes to flash.
+     *
+     * @param key [IN]
+     * @param value [IN] Null-terminated value
+     * @return RC_t RC_SUCCESS on success, RC_ERROR_WRITE_FAILS if the value could not be stored
+     */
+    virtual RC_t putString(const char key[], const char value[]) = 0;
+};
+
+#endif  // KEY_VALUE_STORE_H
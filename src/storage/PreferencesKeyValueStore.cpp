@@ -0,0 +1,16 @@
+#include "PreferencesKeyValueStore.h"
+
+#include <string.h>
+
+RC_t PreferencesKeyValueStore::getString(const char key[], char value[], uint32_t size) {
+    if(!m_preferences.isKey(key)) return RC_ERROR_ZERO;
+    // getString returns the length including the null terminator and 0 if the value does not fit
+    if(0 == m_preferences.getString(key, value, size)) return RC_ERROR_BUFFER_FULL;
+    return RC_SUCCESS;
+}
+
+RC_t PreferencesKeyValueStore::putString(const char key[], const char value[]) {
+    // Returns the number of characters written, or 0 on failure
+    if(m_preferences.putString(key, value) != strlen(value)) return RC_ERROR_WRITE_FAILS;
+    return RC_SUCCESS;
+}
@@ -0,0 +1,27 @@
+#ifndef PREFERENCES_KEY_VALUE_STORE_H
+#define PREFERENCES_KEY_VALUE_STORE_H
+#include <Preferences.h>
+
+#include "KeyValueStore.h"
+
+/**
+ * @brief KeyValueStore in the NVS partition of the controller
+ */
+class PreferencesKeyValueStore : public KeyValueStore {
+   public:
+    /**
+     * @brief Constructor
+     *
+     * @param preferences [IN] Preferences on which begin was already called
+     */
+    PreferencesKeyValueStore(Preferences& preferences) : m_preferences(preferences) {}
+
+    RC_t getString(const char key[], char value[], uint32_t size) override;
+
+    RC_t putString(const char key[], const char value[]) override;
+
+   private:
+    Preferences& m_preferences;
+};
+
+#endif  // PREFERENCES_KEY_VALUE_STORE_H
@@ -0,0 +1,401 @@
+#include "SampleLog.h"
+
+#include <cstdio>
+#include <cstring>
+
+// Magic bytes at the start of every segment
+#define SEGMENT_MAGIC "SLG1"
+// Magic plus 32 bit sequence number
+#define SEGMENT_HEADER_SIZE (8)
+// Tag bit marking a sensor which is new to the segment
+#define ENTRY_TAG_NEW_SENSOR (0x80)
+// Worst case size of an encoded entry: tag, ID and two 5 byte varints
+#define MAX_ENTRY_SIZE (1 + 4 + 5 + 5)
+// Worst case size of a record body
+#define MAX_RECORD_BODY_SIZE (1 + 5 + SAMPLE_LOG_MAX_ENTRIES_PER_RECORD * MAX_ENTRY_SIZE)
+// Worst case size of a record including its length prefix
+#define MAX_RECORD_SIZE (2 + MAX_RECORD_BODY_SIZE)
+
+static_assert(SAMPLE_LOG_WRITE_BUFFER_SIZE >= SEGMENT_HEADER_SIZE + MAX_RECORD_SIZE,
+              "Sample log write buffer can't hold a full record");
+static_assert(SAMPLE_LOG_READ_BUFFER_SIZE >= MAX_RECORD_SIZE, "Sample log read buffer can't hold a full record");
+static_assert(SAMPLE_LOG_MAX_SENSORS <= 0x7F, "Sensor table position must fit in the entry tag");
+
+static inline uint32_t zigzagEncode(int32_t v) {
+    return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+
+static inline int32_t zigzagDecode(uint32_t v) { return static_cast<int32_t>((v >> 1) ^ (~(v & 1) + 1)); }
+
+/**
+ * @brief Writes v as LEB128 varint to buf and returns the number of bytes written
+ */
+static uint32_t putVarint(uint8_t* buf, uint32_t v) {
+    uint32_t n = 0;
+    while(v >= 0x80) {
+        buf[n++] = static_cast<uint8_t>(v | 0x80);
+        v >>= 7;
+    }
+    buf[n++] = static_cast<uint8_t>(v);
+    return n;
+}
+
+/**
+ * @brief Reads a LEB128 varint from buf.
+ * Returns the number of bytes consumed or 0 if the varint is incomplete or too long
+ */
+static uint32_t getVarint(const uint8_t* buf, uint32_t len, uint32_t& v) {
+    v = 0;
+    for(uint32_t i = 0; i < len && i < 5; i++) {
+        v |= static_cast<uint32_t>(buf[i] & 0x7F) << (7 * i);
+        if((buf[i] & 0x80) == 0) return i + 1;
+    }
+    return 0;
+}
+
+static inline uint32_t floatToBits(float_t f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+static inline float_t bitsToFloat(uint32_t bits) {
+    float_t f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+static inline void putUint32(uint8_t* buf, uint32_t v) {
+    for(uint32_t i = 0; i < 4; i++) buf[i] = static_cast<uint8_t>(v >> (8 * i));
+}
+
+static inline uint32_t getUint32(const uint8_t* buf) {
+    return buf[0] | (buf[1] << 8) | (buf[2] << 16) | (static_cast<uint32_t>(buf[3]) << 24);
+}
+
+SampleLog::SampleLog(Filesystem& fs, const char prefix[], uint32_t segmentSize, uint32_t maxSegments)
+    : m_fs(fs), m_segmentSize(segmentSize), m_maxSegments(maxSegments < 2 ? 2 : maxSegments) {
+    strncpy(m_prefix, prefix, sizeof(m_prefix) - 1);
+    m_prefix[sizeof(m_prefix) - 1] = '\0';
+    m_writeTable.reset();
+    m_readTable.reset();
+}
+
+void SampleLog::segmentFilename(uint32_t seq, char str[]) const {
+    snprintf(str, SAMPLE_LOG_MAX_PREFIX_LENGTH + 16, "%s%u.bin", m_prefix, seq % m_maxSegments);
+}
+
+RC_t SampleLog::begin() {
+    // Other tasks hold the filesystem lock while they have a file open, so this only finds a file of the calling
+    // task. The segments couldn't be opened below and would be missed
+    if(m_fs.hasOpenFile()) return RC_ERROR_BUSY;
+    m_hasSegments = false;
+    for(uint32_t slot = 0; slot < m_maxSegments; slot++) {
+        char filename[SAMPLE_LOG_MAX_PREFIX_LENGTH + 16];
+        segmentFilename(slot, filename);
+        if(!m_fs.fileExists(filename)) continue;
+
+        uint8_t header[SEGMENT_HEADER_SIZE] = {0};
+        if(RC_SUCCESS != m_fs.openFile(filename, Filesystem::READ_ONLY)) continue;
+        const uint32_t size = m_fs.size();
+        m_fs.read(header, sizeof(header));
+        m_fs.closeFile();
+
+        const uint32_t seq = getUint32(header + 4);
+        if(size < SEGMENT_HEADER_SIZE || memcmp(header, SEGMENT_MAGIC, 4) != 0 || seq % m_maxSegments != slot) {
+            // Not a valid segment, e.g. because the device lost power while creating it
+            m_fs.deleteFile(filename);
+            continue;
+        }
+        if(!m_hasSegments || seq < m_tailSeq) m_tailSeq = seq;
+        if(!m_hasSegments || seq > m_headSeq) {
+            m_headSeq = seq;
+            m_headSize = size;
+        }
+        m_hasSegments = true;
+    }
+    // The encoding state of the head segment was lost with the reboot
+    m_headWritable = false;
+    m_writeLen = 0;
+    m_readBufferOffset = m_readLen = m_readPos = 0;
+    m_readHeaderDone = false;
+    m_readTable.reset();
+    return RC_SUCCESS;
+}
+
+RC_t SampleLog::rotate() {
+    RC_t err = flush();
+    if(err != RC_SUCCESS) return err;
+
+    if(m_hasSegments) {
+        m_headSeq++;
+    } else {
+        m_headSeq++;
+        m_tailSeq = m_headSeq;
+        m_hasSegments = true;
+    }
+    // The new head reuses the filename of the oldest segment when the maximum is reached
+    if(m_headSeq - m_tailSeq >= m_maxSegments) {
+        dropTail();
+        m_stats.segmentsDropped++;
+    }
+
+    m_writeTable.reset();
+    m_headSize = 0;
+    m_headWritable = true;
+    memcpy(m_writeBuffer, SEGMENT_MAGIC, 4);
+    putUint32(m_writeBuffer + 4, m_headSeq);
+    m_writeLen = SEGMENT_HEADER_SIZE;
+    return RC_SUCCESS;
+}
+
+void SampleLog::dropTail() {
+    char filename[SAMPLE_LOG_MAX_PREFIX_LENGTH + 16];
+    segmentFilename(m_tailSeq, filename);
+    m_fs.deleteFile(filename);
+
+    if(m_tailSeq == m_headSeq) {
+        m_hasSegments = false;
+        m_headSize = 0;
+        m_headWritable = false;
+    } else {
+        m_tailSeq++;
+    }
+    m_readBufferOffset = m_readLen = m_readPos = 0;
+    m_readHeaderDone = false;
+    m_readTable.reset();
+}
+
+RC_t SampleLog::append(uint32_t timestamp, const Entry_t entries[], uint32_t count) {
+    if(count == 0 || count > SAMPLE_LOG_MAX_ENTRIES_PER_RECORD) return RC_ERROR_BAD_PARAM;
+
+    // Count the sensors which are not yet in the sensor table of the segment
+    uint32_t newSensors = 0;
+    for(uint32_t i = 0; i < count; i++) {
+        bool found = false;
+        for(uint32_t j = 0; j < m_writeTable.count && !found; j++) found = (m_writeTable.ids[j] == entries[i].sensorId);
+        if(!found) newSensors++;
+    }
+
+    // Start a new segment if this record might not fit in the current one anymore
+    const uint32_t worstCaseSize = 2 + 1 + 5 + count * MAX_ENTRY_SIZE;
+    const bool segmentFull = m_headSize + m_writeLen + worstCaseSize > m_segmentSize ||
+                             m_writeTable.count + newSensors > SAMPLE_LOG_MAX_SENSORS;
+    if(!m_hasSegments || !m_headWritable || segmentFull) {
+        RC_t err = rotate();
+        if(err != RC_SUCCESS) return err;
+    }
+    if(m_writeLen + worstCaseSize > SAMPLE_LOG_WRITE_BUFFER_SIZE) {
+        RC_t err = flush();
+        if(err != RC_SUCCESS) return err;
+    }
+
+    // Encode record body
+    uint8_t body[MAX_RECORD_BODY_SIZE];
+    uint32_t len = 0;
+    body[len++] = static_cast<uint8_t>(count);
+    len += putVarint(body + len, zigzagEncode(static_cast<int32_t>(timestamp - m_writeTable.prevTimestamp)));
+    m_writeTable.prevTimestamp = timestamp;
+    for(uint32_t i = 0; i < count; i++) {
+        uint32_t pos = 0;
+        while(pos < m_writeTable.count && m_writeTable.ids[pos] != entries[i].sensorId) pos++;
+        if(pos == m_writeTable.count) {
+            // First occurrence of this sensor in the segment
+            m_writeTable.ids[pos] = entries[i].sensorId;
+            m_writeTable.prevValue[pos] = 0;
+            m_writeTable.prevRaw[pos] = 0;
+            m_writeTable.count++;
+            body[len++] = static_cast<uint8_t>(pos | ENTRY_TAG_NEW_SENSOR);
+            putUint32(body + len, entries[i].sensorId);
+            len += 4;
+        } else {
+            body[len++] = static_cast<uint8_t>(pos);
+        }
+        const uint32_t valueBits = floatToBits(entries[i].value);
+        const uint32_t rawBits = floatToBits(entries[i].rawValue);
+        len += putVarint(body + len, zigzagEncode(static_cast<int32_t>(valueBits - m_writeTable.prevValue[pos])));
+        len += putVarint(body + len, zigzagEncode(static_cast<int32_t>(rawBits - m_writeTable.prevRaw[pos])));
+        m_writeTable.prevValue[pos] = valueBits;
+        m_writeTable.prevRaw[pos] = rawBits;
+    }
+
+    m_writeLen += putVarint(m_writeBuffer + m_writeLen, len);
+    memcpy(m_writeBuffer + m_writeLen, body, len);
+    m_writeLen += len;
+    m_stats.recordsWritten++;
+    return RC_SUCCESS;
+}
+
+RC_t SampleLog::flush() {
+    if(m_writeLen == 0) return RC_SUCCESS;
+    char filename[SAMPLE_LOG_MAX_PREFIX_LENGTH + 16];
+    segmentFilename(m_headSeq, filename);
+    RC_t err = m_fs.openFile(filename, m_headSize == 0 ? Filesystem::WRITE_TRUNCATE : Filesystem::WRITE_APPEND);
+    if(err != RC_SUCCESS) return err;
+    err = m_fs.write(m_writeBuffer, m_writeLen);
+    m_fs.closeFile();
+    if(err != RC_SUCCESS) return err;
+
+    m_headSize += m_writeLen;
+    m_stats.bytesWritten += m_writeLen;
+    m_stats.flushes++;
+    m_writeLen = 0;
+    return RC_SUCCESS;
+}
+
+bool SampleLog::hasUnreadRecords() const {
+    if(!m_hasSegments) return false;
+    if(m_tailSeq != m_headSeq) return true;
+    // Only the header is left
+    const uint32_t readOffset = m_readBufferOffset + m_readPos;
+    return m_headSize > SEGMENT_HEADER_SIZE && readOffset < m_headSize;
+}
+
+RC_t SampleLog::fillReadBuffer() {
+    char filename[SAMPLE_LOG_MAX_PREFIX_LENGTH + 16];
+    segmentFilename(m_tailSeq, filename);
+    RC_t err = m_fs.openFile(filename, Filesystem::READ_ONLY);
+    if(err != RC_SUCCESS) return err;
+
+    // Keep the unconsumed bytes and append new data behind them
+    const uint32_t remaining = m_readLen - m_readPos;
+    memmove(m_readBuffer, m_readBuffer + m_readPos, remaining);
+    m_readBufferOffset += m_readPos;
+    m_readPos = 0;
+    m_readLen = remaining;
+
+    uint32_t fileSize = m_fs.size();
+    // Unflushed bytes of the head segment are never read
+    if(m_tailSeq == m_headSeq && fileSize > m_headSize) fileSize = m_headSize;
+    const uint32_t fileOffset = m_readBufferOffset + m_readLen;
+    if(fileOffset < fileSize) {
+        uint32_t n = fileSize - fileOffset;
+        if(n > sizeof(m_readBuffer) - m_readLen) n = sizeof(m_readBuffer) - m_readLen;
+        err = m_fs.seek(fileOffset);
+        if(err == RC_SUCCESS) err = m_fs.read(m_readBuffer + m_readLen, n);
+        if(err == RC_SUCCESS) m_readLen += n;
+    }
+    m_fs.closeFile();
+    return err;
+}
+
+RC_t SampleLog::read(uint32_t& timestamp, Entry_t entries[], uint32_t maxEntries, uint32_t& count) {
+    // Whether the read buffer was refilled since the last record boundary
+    bool refilled = false;
+    while(true) {
+        if(!hasUnreadRecords()) {
+            // Remove the head segment once it was read completely
+            if(m_hasSegments && m_tailSeq == m_headSeq && m_writeLen == 0 &&
+               m_readBufferOffset + m_readPos >= m_headSize) {
+                dropTail();
+            }
+            return RC_ERROR_BUFFER_EMPTY;
+        }
+
+        const uint8_t* data = m_readBuffer + m_readPos;
+        const uint32_t available = m_readLen - m_readPos;
+        uint32_t bodyLen = 0;
+        uint32_t prefixLen = 0;
+        bool complete;
+        if(!m_readHeaderDone) {
+            complete = available >= SEGMENT_HEADER_SIZE;
+        } else {
+            prefixLen = getVarint(data, available, bodyLen);
+            complete = prefixLen > 0 && bodyLen <= MAX_RECORD_BODY_SIZE && prefixLen + bodyLen <= available;
+        }
+
+        if(!complete) {
+            if(!refilled) {
+                RC_t err = fillReadBuffer();
+                if(err == RC_ERROR_OPEN) {
+                    // Segment is missing
+                    dropTail();
+                } else if(err != RC_SUCCESS) {
+                    return err;
+                }
+                refilled = true;
+                continue;
+            }
+            // No complete record left although the buffer was just refilled.
+            // Either the end of the segment was reached or the rest of it is corrupt.
+            if(m_tailSeq != m_headSeq) {
+                dropTail();
+                refilled = false;
+                continue;
+            }
+            return RC_ERROR_BUFFER_EMPTY;
+        }
+        refilled = false;
+
+        if(!m_readHeaderDone) {
+            if(memcmp(data, SEGMENT_MAGIC, 4) != 0 || getUint32(data + 4) != m_tailSeq) {
+                // Not the segment that was expected, skip it
+                if(m_tailSeq == m_headSeq) return RC_ERROR_BUFFER_EMPTY;
+                dropTail();
+                continue;
+            }
+            m_readPos += SEGMENT_HEADER_SIZE;
+            m_readHeaderDone = true;
+            continue;
+        }
+
+        // Decode record body
+        const uint8_t* body = data + prefixLen;
+        m_readPos += prefixLen + bodyLen;
+        uint32_t pos = 0;
+        const uint32_t entryCount = body[pos++];
+        uint32_t tsDelta;
+        uint32_t n = getVarint(body + pos, bodyLen - pos, tsDelta);
+        if(n == 0) continue;
+        pos += n;
+        m_readTable.prevTimestamp += zigzagDecode(tsDelta);
+        timestamp = m_readTable.prevTimestamp;
+
+        bool valid = true;
+        for(uint32_t i = 0; i < entryCount && valid; i++) {
+            if(pos >= bodyLen) {
+                valid = false;
+                break;
+            }
+            const uint8_t tag = body[pos++];
+            uint32_t idx = tag & ~ENTRY_TAG_NEW_SENSOR;
+            if(tag & ENTRY_TAG_NEW_SENSOR) {
+                if(pos + 4 > bodyLen || idx != m_readTable.count || idx >= SAMPLE_LOG_MAX_SENSORS) {
+                    valid = false;
+                    break;
+                }
+                m_readTable.ids[idx] = getUint32(body + pos);
+                m_readTable.prevValue[idx] = 0;
+                m_readTable.prevRaw[idx] = 0;
+                m_readTable.count++;
+                pos += 4;
+            } else if(idx >= m_readTable.count) {
+                valid = false;
+                break;
+            }
+            uint32_t valueDelta, rawDelta;
+            n = getVarint(body + pos, bodyLen - pos, valueDelta);
+            pos += n;
+            const uint32_t m = getVarint(body + pos, bodyLen - pos, rawDelta);
+            pos += m;
+            if(n == 0 || m == 0) {
+                valid = false;
+                break;
+            }
+            m_readTable.prevValue[idx] += static_cast<uint32_t>(zigzagDecode(valueDelta));
+            m_readTable.prevRaw[idx] += static_cast<uint32_t>(zigzagDecode(rawDelta));
+            if(i < maxEntries) {
+                entries[i].sensorId = m_readTable.ids[idx];
+                entries[i].value = bitsToFloat(m_readTable.prevValue[idx]);
+                entries[i].rawValue = bitsToFloat(m_readTable.prevRaw[idx]);
+            }
+        }
+        // Skip corrupt records
+        if(!valid) continue;
+
+        m_stats.recordsRead++;
+        count = (entryCount < maxEntries) ? entryCount : maxEntries;
+        if(entryCount > maxEntries) return RC_ERROR_MEMORY;
+        return RC_SUCCESS;
+    }
+}
@@ -0,0 +1,214 @@
+#ifndef SAMPLE_LOG_H
+#define SAMPLE_LOG_H
+#include "filesystem/Filesystem.h"
+#include "global.h"
+
+/**
+ * @brief Maximum length of the segment filename prefix, including null terminator
+ */
+#define SAMPLE_LOG_MAX_PREFIX_LENGTH (32)
+
+/**
+ * @brief Append-only log of sensor samples on a Filesystem, used to keep samples
+ * which could not be published while the MQTT broker was unreachable.
+ *
+ * The log is split into segment files named <prefix><n>.bin with n being the segment
+ * sequence number modulo the maximum number of segments. When the maximum is reached,
+ * the oldest segment is dropped. Segments which have been read completely are deleted.
+ *
+ * Segment format:
+ *  - Header: magic "SLG1" followed by the 32 bit little endian sequence number
+ *  - Records: varint length of the record body followed by the body
+ *
+ * Record body:
+ *  - 1 byte number of entries
+ *  - zigzag varint of the timestamp delta to the previous record in the segment
+ *  - per entry: 1 byte tag, the lower 7 bits are the position of the sensor in the segment's
+ *    sensor table. If the highest bit is set, the sensor is new to the segment and its
+ *    32 bit ID follows. Then the value and raw value as zigzag varints of the difference
+ *    of their bit patterns to the previous value of the same sensor in the segment.
+ *
+ * Since every segment starts with empty tables, segments can be decoded independently.
+ * Records are collected in a RAM buffer and only written to flash when the buffer is full
+ * or flush is called, to reduce flash wear.
+ *
+ * Records are replayed at least once: the read position within a segment is not persisted,
+ * so a partially replayed segment is replayed again from its start after a reboot.
+ *
+ * @note Not thread safe. The Filesystem only allows one open file at a time, so every
+ * operation opens and closes the segment file it needs.
+ */
+class SampleLog {
+   public:
+    /**
+     * @brief Single sensor value in a record
+     */
+    typedef struct {
+        uint32_t sensorId;
+        float_t value;
+        float_t rawValue;
+    } Entry_t;
+
+    /**
+     * @brief Counters for evaluating the log
+     */
+    typedef struct {
+        uint32_t recordsWritten;
+        uint32_t recordsRead;
+        uint32_t bytesWritten;
+        uint32_t flushes;
+        uint32_t segmentsDropped;
+    } Statistics_t;
+
+    /**
+     * @brief Constructor. begin() has to be called before using the log.
+     *
+     * @param fs [IN] Filesystem to store the segments on
+     * @param prefix [IN] Path and name prefix of the segment files, e.g. "/samplelog_"
+     * @param segmentSize [IN] Size in bytes after which a new segment is started
+     * @param maxSegments [IN] Maximum number of segments
+     */
+    SampleLog(Filesystem& fs, const char prefix[], uint32_t segmentSize = SAMPLE_LOG_SEGMENT_SIZE,
+              uint32_t maxSegments = SAMPLE_LOG_MAX_SEGMENTS);
+
+    /**
+     * @brief Finds segments which were written before the last reboot.
+     * Waits while another task has a file of the filesystem open.
+     *
+     * @return RC_t RC_SUCCESS on success,
+     *  RC_ERROR_BUSY if the calling task has a file open
+     */
+    RC_t begin();
+
+    /**
+     * @brief Appends a record to the write buffer. Writes the buffer to flash first
+     * if the record does not fit in it anymore.
+     *
+     * @param timestamp [IN] Timestamp of all entries
+     * @param entries [IN] Sensor values
+     * @param count [IN] Number of entries, at most SAMPLE_LOG_MAX_ENTRIES_PER_RECORD
+     * @return RC_t RC_SUCCESS on success,
+     *  RC_ERROR_BAD_PARAM if count is 0 or too large,
+     *  errors of flush
+     */
+    RC_t append(uint32_t timestamp, const Entry_t entries[], uint32_t count);
+
+    /**
+     * @brief Writes the buffered records to flash. Waits while another task has a file of the filesystem open.
+     *
+     * @return RC_t RC_SUCCESS on success,
+     *  RC_ERROR_BUSY if the calling task has a file open,
+     *  RC_ERROR_OPEN if the segment couldn't be opened
+     */
+    RC_t flush();
+
+    /**
+     * @brief Reads the oldest unread record. Only records which have been flushed can be read.
+     * Waits while another task has a file of the filesystem open.
+     *
+     * @param timestamp [OUT] Timestamp of the record
+     * @param entries [OUT] Entries of the record
+     * @param maxEntries [IN] Size of entries. Should be SAMPLE_LOG_MAX_ENTRIES_PER_RECORD
+     * @param count [OUT] Number of entries in the record
+     * @return RC_t RC_SUCCESS on success,
+     *  RC_ERROR_BUFFER_EMPTY if there is no unread record,
+     *  RC_ERROR_MEMORY if the record has more than maxEntries entries,
+     *  RC_ERROR_BUSY if the calling task has a file open
+     */
+    RC_t read(uint32_t& timestamp, Entry_t entries[], uint32_t maxEntries, uint32_t& count);
+
+    /**
+     * @brief Returns whether there are flushed records which have not been read yet
+     *
+     * @return true
+     * @return false
+     */
+    bool hasUnreadRecords() const;
+
+    /**
+     * @brief Returns the number of bytes waiting in the write buffer
+     *
+     * @return uint32_t
+     */
+    inline uint32_t getBufferedBytes() const { return m_writeLen; }
+
+    inline const Statistics_t& getStatistics() const { return m_stats; }
+
+   private:
+    /**
+     * @brief Per segment state for the delta encoding
+     */
+    struct SensorTable {
+        uint32_t ids[SAMPLE_LOG_MAX_SENSORS];
+        uint32_t prevValue[SAMPLE_LOG_MAX_SENSORS];
+        uint32_t prevRaw[SAMPLE_LOG_MAX_SENSORS];
+        uint32_t count;
+        uint32_t prevTimestamp;
+        void reset() {
+            count = 0;
+            prevTimestamp = 0;
+        }
+    };
+
+    /**
+     * @brief Writes the filename of the segment with the given sequence number to str
+     */
+    void segmentFilename(uint32_t seq, char str[]) const;
+
+    /**
+     * @brief Flushes the buffer and starts a new head segment
+     */
+    RC_t rotate();
+
+    /**
+     * @brief Deletes the segment which is currently being read and moves on to the next one
+     */
+    void dropTail();
+
+    /**
+     * @brief Refills the read buffer from the tail segment, keeping unconsumed bytes
+     */
+    RC_t fillReadBuffer();
+
+    Filesystem& m_fs;
+    char m_prefix[SAMPLE_LOG_MAX_PREFIX_LENGTH];
+    const uint32_t m_segmentSize;
+    const uint32_t m_maxSegments;
+
+    /**
+     * @brief Set once any segment exists
+     */
+    bool m_hasSegments = false;
+    uint32_t m_tailSeq = 0;
+    uint32_t m_headSeq = 0;
+    /**
+     * @brief Number of bytes of the head segment which are on flash
+     */
+    uint32_t m_headSize = 0;
+    /**
+     * @brief False if the head segment was written before a reboot. Its encoding
+     * state is then unknown and the next record goes into a new segment.
+     */
+    bool m_headWritable = false;
+
+    uint8_t m_writeBuffer[SAMPLE_LOG_WRITE_BUFFER_SIZE];
+    uint32_t m_writeLen = 0;
+    SensorTable m_writeTable;
+
+    uint8_t m_readBuffer[SAMPLE_LOG_READ_BUFFER_SIZE];
+    /**
+     * @brief File offset of the first byte in the read buffer
+     */
+    uint32_t m_readBufferOffset = 0;
+    uint32_t m_readLen = 0;
+    uint32_t m_readPos = 0;
+    /**
+     * @brief Set once the header of the tail segment was validated
+     */
+    bool m_readHeaderDone = false;
+    SensorTable m_readTable;
+
+    Statistics_t m_stats = {0, 0, 0, 0, 0};
+};
+
+#endif  // SAMPLE_LOG_H
@@ -0,0 +1,101 @@
+#include "SettingsStore.h"
+
+#include <string.h>
+
+SettingsStore::SettingsStore(Filesystem& fs, KeyValueStore& nvs, const char filename[], settings_t& settingsObject,
+                             uint32_t writeDelayMs)
+    : m_fs(fs), m_nvs(nvs), m_filename(filename), m_settings(settingsObject), m_writeDelayMs(writeDelayMs) {}
+
+RC_t SettingsStore::load(uint32_t* foundSettings, uint32_t* invalidSettings) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint32_t found = 0;
+    const RC_t err = parseSettingsFile(m_fs, m_filename, m_settings, &found, invalidSettings);
+    if(foundSettings != nullptr) *foundSettings = found;
+
+    for(uint32_t i = 0; i < SETTING_COUNT; i++) {
+        const Setting_t setting = static_cast<Setting_t>(i);
+        if(!isSecretSetting(setting)) continue;
+        if(found & SETTING_BIT(setting)) {
+            // Provisioned through the settings file. Commit stores it only if it differs
+            m_dirty |= SETTING_BIT(setting);
+            m_rewriteFile = true;
+            continue;
+        }
+        char stored[SETTINGS_MAX_VALUE_LENGTH] = "";
+        if(RC_SUCCESS == m_nvs.getString(getSettingKey(setting), stored, sizeof(stored)))
+            setSetting(m_settings, setting, StringView(stored, strlen(stored)));
+    }
+
+    const RC_t commitErr = isDirtyLocked() ? commitLocked() : RC_SUCCESS;
+    return (RC_SUCCESS != err) ? err : commitErr;
+}
+
+RC_t SettingsStore::set(Setting_t setting, const char value[], uint32_t nowMs, bool* changed) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    bool differs = false;
+    const RC_t err = setSetting(m_settings, setting, StringView(value, strlen(value)), &differs);
+    if(RC_SUCCESS != err) return err;
+    if(differs) {
+        if(!isDirtyLocked()) m_dirtySinceMs = nowMs;
+        m_dirty |= SETTING_BIT(setting);
+    }
+    if(changed != nullptr) *changed = differs;
+    return RC_SUCCESS;
+}
+
+RC_t SettingsStore::update(uint32_t nowMs) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(!isDirtyLocked() || nowMs - m_dirtySinceMs < m_writeDelayMs) return RC_SUCCESS;
+    const RC_t err = commitLocked();
+    // Retry after another delay instead of in every call
+    if(RC_SUCCESS != err) m_dirtySinceMs = nowMs;
+    return err;
+}
+
+RC_t SettingsStore::commit() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return commitLocked();
+}
+
+RC_t SettingsStore::commitLocked() {
+    RC_t err = RC_SUCCESS;
+    bool fileChanged = m_rewriteFile;
+    for(uint32_t i = 0; i < SETTING_COUNT; i++) {
+        const Setting_t setting = static_cast<Setting_t>(i);
+        if(!(m_dirty & SETTING_BIT(setting))) continue;
+        if(!isSecretSetting(setting)) {
+            fileChanged = true;
+            continue;
+        }
+
+        // Secrets are only written if they differ from the stored value, since a setting
+        // may have been changed back before the commit
+        char value[SETTINGS_MAX_VALUE_LENGTH] = "";
+        char stored[SETTINGS_MAX_VALUE_LENGTH] = "";
+        getSetting(m_settings, setting, value, sizeof(value));
+        // A missing value counts as empty
+        const RC_t readErr = m_nvs.getString(getSettingKey(setting), stored, sizeof(stored));
+        const bool readable = RC_SUCCESS == readErr || RC_ERROR_ZERO == readErr;
+        if(!readable || strcmp(value, stored) != 0) {
+            const RC_t writeErr = m_nvs.putString(getSettingKey(setting), value);
+            if(RC_SUCCESS != writeErr) {
+                err = writeErr;
+                continue;
+            }
+            m_nvsWriteCount++;
+        }
+        m_dirty &= ~SETTING_BIT(setting);
+    }
+
+    if(fileChanged) {
+        const RC_t writeErr = writeToSettingsFile(m_fs, m_filename, m_settings);
+        if(RC_SUCCESS != writeErr) return writeErr;
+        m_fileWriteCount++;
+        m_rewriteFile = false;
+        // Everything left is stored in the file
+        for(uint32_t i = 0; i < SETTING_COUNT; i++) {
+            if(!isSecretSetting(static_cast<Setting_t>(i))) m_dirty &= ~SETTING_BIT(i);
+        }
+    }
+    return err;
+}
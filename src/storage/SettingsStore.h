@@ -0,0 +1,142 @@
+#ifndef SETTINGS_STORE_H
+#define SETTINGS_STORE_H
+#include <mutex>
+
+#include "KeyValueStore.h"
+#include "filesystem/Filesystem.h"
+#include "global.h"
+#include "settings.h"
+
+/**
+ * @brief Keeps a settings object in sync with the settings file and the non-volatile storage
+ * while wearing the flash as little as possible.
+ *
+ * Changes are only recorded at first. Once SETTINGS_WRITE_DELAY_MS passed since the first
+ * unsaved change, all changes are written together: the settings file is replaced once and only
+ * the secrets whose stored value differs are written to the non-volatile storage.
+ *
+ * All methods may be called from different tasks. A change which is made while a commit is
+ * running waits for it and is written with the next one.
+ */
+class SettingsStore {
+   public:
+    /**
+     * @brief Constructor
+     *
+     * @param fs [IN] Filesystem on which the settings file is stored
+     * @param nvs [IN] Non-volatile storage of the secrets
+     * @param filename [IN] Name of the settings file. Must stay valid for the lifetime of the store
+     * @param settingsObject [IN] Settings which are loaded into and changed through the store
+     * @param writeDelayMs [IN] Time after the first unsaved change until the changes are written
+     */
+    SettingsStore(Filesystem& fs, KeyValueStore& nvs, const char filename[], settings_t& settingsObject,
+                  uint32_t writeDelayMs = SETTINGS_WRITE_DELAY_MS);
+
+    /**
+     * @brief Reads the settings file and the secrets. Secrets found in the settings file
+     * are moved to the non-volatile storage and the file is rewritten without them.
+     *
+     * @param foundSettings [OUT] Optional, see parseSettingsFile
+     * @param invalidSettings [OUT] Optional, see parseSettingsFile
+     * @return RC_t RC_SUCCESS on success, errors of parseSettingsFile and commit
+     */
+    RC_t load(uint32_t* foundSettings = nullptr, uint32_t* invalidSettings = nullptr);
+
+    /**
+     * @brief Changes a setting. It is written with the next commit, unless it is set back
+     * to its stored value before.
+     *
+     * @param setting [IN]
+     * @param value [IN] Null-terminated value in the format of the settings file
+     * @param nowMs [IN] Current uptime in ms
+     * @param changed [OUT] Optional, whether the setting had another value before
+     * @return RC_t RC_SUCCESS on success, errors of setSetting
+     */
+    RC_t set(Setting_t setting, const char value[], uint32_t nowMs, bool* changed = nullptr);
+
+    /**
+     * @brief Commits the changes once the write delay has passed since the first unsaved change.
+     * Meant to be called periodically.
+     *
+     * @param nowMs [IN] Current uptime in ms
+     * @return RC_t RC_SUCCESS if nothing had to be written or the changes were written,
+     *  errors of commit. A failed commit is retried after another write delay
+     */
+    RC_t update(uint32_t nowMs);
+
+    /**
+     * @brief Writes all unsaved changes immediately
+     *
+     * @return RC_t RC_SUCCESS on success, errors of writeToSettingsFile and KeyValueStore::putString.
+     *  Settings which could not be written stay unsaved
+     */
+    RC_t commit();
+
+    /**
+     * @brief Returns whether there are changes which were not written yet
+     *
+     * @return true
+     * @return false
+     */
+    inline bool isDirty() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return isDirtyLocked();
+    }
+
+    /**
+     * @brief Returns the number of times the settings file was written
+     *
+     * @return uint32_t
+     */
+    inline uint32_t getFileWriteCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_fileWriteCount;
+    }
+
+    /**
+     * @brief Returns the number of values written to the non-volatile storage
+     *
+     * @return uint32_t
+     */
+    inline uint32_t getNvsWriteCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_nvsWriteCount;
+    }
+
+   private:
+    /**
+     * @brief commit for callers which already hold m_mutex
+     */
+    RC_t commitLocked();
+
+    /**
+     * @brief isDirty for callers which already hold m_mutex
+     */
+    inline bool isDirtyLocked() const { return m_dirty != 0 || m_rewriteFile; }
+
+    /**
+     * @brief Guards the settings object and the state of the store
+     */
+    mutable std::mutex m_mutex;
+    Filesystem& m_fs;
+    KeyValueStore& m_nvs;
+    const char* const m_filename;
+    settings_t& m_settings;
+    const uint32_t m_writeDelayMs;
+    /**
+     * @brief SETTING_BIT of every setting which was changed since the last commit
+     */
+    uint32_t m_dirty = 0;
+    /**
+     * @brief Set if the settings file contains secrets which have to be removed
+     */
+    bool m_rewriteFile = false;
+    /**
+     * @brief Uptime of the first unsaved change
+     */
+    uint32_t m_dirtySinceMs = 0;
+    uint32_t m_fileWriteCount = 0;
+    uint32_t m_nvsWriteCount = 0;
+};
+
+#endif  // SETTINGS_STORE_H
@@ -0,0 +1,17 @@
+#include "SimulatedKeyValueStore.h"
+
+#include <string.h>
+
+RC_t SimulatedKeyValueStore::getString(const char key[], char value[], uint32_t size) {
+    const auto it = m_values.find(key);
+    if(it == m_values.end()) return RC_ERROR_ZERO;
+    if(it->second.size() >= size) return RC_ERROR_BUFFER_FULL;
+    memcpy(value, it->second.c_str(), it->second.size() + 1);
+    return RC_SUCCESS;
+}
+
+RC_t SimulatedKeyValueStore::putString(const char key[], const char value[]) {
+    m_values[key] = value;
+    m_writeCount++;
+    return RC_SUCCESS;
+}
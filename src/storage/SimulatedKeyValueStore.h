@@ -0,0 +1,32 @@
+#ifndef SIMULATED_KEY_VALUE_STORE_H
+#define SIMULATED_KEY_VALUE_STORE_H
+#include <map>
+#include <string>
+
+#include "KeyValueStore.h"
+
+/**
+ * @brief KeyValueStore in RAM. Counts the writes, so that tests can check how often
+ * the flash would have been written.
+ */
+class SimulatedKeyValueStore : public KeyValueStore {
+   public:
+    SimulatedKeyValueStore() = default;
+
+    RC_t getString(const char key[], char value[], uint32_t size) override;
+
+    RC_t putString(const char key[], const char value[]) override;
+
+    /**
+     * @brief Returns the number of putString calls
+     *
+     * @return uint32_t
+     */
+    inline uint32_t getWriteCount() const { return m_writeCount; }
+
+   private:
+    std::map<std::string, std::string> m_values;
+    uint32_t m_writeCount = 0;
+};
+
+#endif  // SIMULATED_KEY_VALUE_STORE_H
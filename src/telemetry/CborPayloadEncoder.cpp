@@ -0,0 +1,56 @@
+#include "CborPayloadEncoder.h"
+
+#include <string.h>
+
+#define CBOR_UNSIGNED (0x00)
+#define CBOR_TEXT (0x60)
+#define CBOR_MAP (0xA0)
+#define CBOR_FLOAT32 (0xFA)
+// Additional information for a 1, 2 or 4 byte argument
+#define CBOR_ARGUMENT_8 (24)
+#define CBOR_ARGUMENT_16 (25)
+#define CBOR_ARGUMENT_32 (26)
+
+CborPayloadEncoder::CborPayloadEncoder(uint8_t buffer[], uint32_t size) : PayloadEncoder(buffer, size) { clear(); }
+
+void CborPayloadEncoder::clear(uint32_t timestamp) {
+    m_buffer[0] = CBOR_MAP | CBOR_ARGUMENT_16;
+    putBigEndian(1, 0, 2);
+    m_length = 3;
+    m_sensorCount = 0;
+}
+
+bool CborPayloadEncoder::appendHead(uint8_t majorType, uint32_t argument) {
+    if(argument < CBOR_ARGUMENT_8) return appendByte(majorType | argument);
+    if(argument <= UINT8_MAX) return appendByte(majorType | CBOR_ARGUMENT_8) && appendBigEndian(argument, 1);
+    if(argument <= UINT16_MAX) return appendByte(majorType | CBOR_ARGUMENT_16) && appendBigEndian(argument, 2);
+    return appendByte(majorType | CBOR_ARGUMENT_32) && appendBigEndian(argument, 4);
+}
+
+bool CborPayloadEncoder::appendText(const char str[]) {
+    return appendHead(CBOR_TEXT, strlen(str)) && appendString(str);
+}
+
+RC_t CborPayloadEncoder::add(const char name[], const SensorSample_t& sample, const SampleAggregator* aggregate,
+                             uint8_t fields, uint8_t decimals) {
+    if(m_sensorCount >= UINT16_MAX) return RC_ERROR_BUFFER_FULL;
+    PayloadField_t values[PAYLOAD_ENCODER_MAX_FIELDS];
+    const uint32_t count = getFields(sample, aggregate, fields, values);
+    const uint32_t previousLength = m_length;
+
+    bool fits = appendText(name) && appendHead(CBOR_MAP, count);
+    for(uint32_t i = 0; i < count && fits; i++) {
+        fits = appendText(values[i].name);
+        if(values[i].isCount)
+            fits = fits && appendHead(CBOR_UNSIGNED, values[i].count);
+        else
+            fits = fits && appendByte(CBOR_FLOAT32) && appendBigEndian(floatBits(values[i].value), 4);
+    }
+    if(!fits) {
+        m_length = previousLength;
+        return RC_ERROR_BUFFER_FULL;
+    }
+    m_sensorCount++;
+    putBigEndian(1, m_sensorCount, 2);
+    return RC_SUCCESS;
+}
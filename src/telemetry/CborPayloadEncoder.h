@@ -0,0 +1,39 @@
+#ifndef CBOR_PAYLOAD_ENCODER_H
+#define CBOR_PAYLOAD_ENCODER_H
+#include "PayloadEncoder.h"
+
+/**
+ * @brief Encodes the samples as CBOR (RFC 8949) map with one map per sensor. It has the same
+ * structure as the JSON payload, values are single precision floats and counts unsigned integers.
+ *
+ * The outer map always uses a 16 bit length, so that it can be updated in place after every add.
+ */
+class CborPayloadEncoder : public PayloadEncoder {
+   public:
+    /**
+     * @brief Constructor
+     *
+     * @param buffer [IN] Buffer for the payload
+     * @param size [IN] Size of buffer in bytes, at least 3
+     */
+    CborPayloadEncoder(uint8_t buffer[], uint32_t size);
+
+    void clear(uint32_t timestamp = 0) override;
+
+    RC_t add(const char name[], const SensorSample_t& sample, const SampleAggregator* aggregate = nullptr,
+             uint8_t fields = 0, uint8_t decimals = FLOAT_FORMAT_MAX_DECIMALS) override;
+
+   private:
+    /**
+     * @brief Appends the head of a data item with the smallest encoding of its argument
+     *
+     * @param majorType [IN] Major type in bits 5 to 7
+     * @param argument [IN] Value, length or number of entries
+     * @return true if it fit
+     */
+    bool appendHead(uint8_t majorType, uint32_t argument);
+
+    bool appendText(const char str[]);
+};
+
+#endif  // CBOR_PAYLOAD_ENCODER_H
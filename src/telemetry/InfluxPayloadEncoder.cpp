@@ -0,0 +1,72 @@
+#include "InfluxPayloadEncoder.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "helper_functions.h"
+
+InfluxPayloadEncoder::InfluxPayloadEncoder(uint8_t buffer[], uint32_t size, const char measurement[],
+                                           const char device[])
+    : PayloadEncoder(buffer, size), m_measurement(measurement), m_device(device) {
+    clear();
+}
+
+void InfluxPayloadEncoder::clear(uint32_t timestamp) {
+    if(timestamp == 0)
+        m_timestamp[0] = '\0';
+    else
+        // Line protocol timestamps are in nanoseconds by default
+        snprintf(m_timestamp, sizeof(m_timestamp), "%u000000000", timestamp);
+    m_length = 0;
+    m_sensorCount = 0;
+}
+
+// Special characters of the line protocol. Equal signs only separate tags, backslashes are escaped so that a
+// trailing one does not escape the following separator
+static const char MEASUREMENT_SPECIAL[] = ", \\";
+static const char TAG_SPECIAL[] = ",= \\";
+
+bool InfluxPayloadEncoder::appendEscaped(const char str[], const char special[]) {
+    for(const char* c = str; *c != '\0'; c++) {
+        if(strchr(special, *c) != nullptr && !appendByte('\\')) return false;
+        if(!appendByte(*c)) return false;
+    }
+    return true;
+}
+
+RC_t InfluxPayloadEncoder::add(const char name[], const SensorSample_t& sample, const SampleAggregator* aggregate,
+                               uint8_t fields, uint8_t decimals) {
+    PayloadField_t values[PAYLOAD_ENCODER_MAX_FIELDS];
+    const uint32_t count = getFields(sample, aggregate, fields, values);
+    const uint32_t previousLength = m_length;
+
+    bool fits = appendEscaped(m_measurement, MEASUREMENT_SPECIAL);
+    if(m_device[0] != '\0') fits = fits && appendString(",device=") && appendEscaped(m_device, TAG_SPECIAL);
+    fits = fits && appendString(",sensor=") && appendEscaped(name, TAG_SPECIAL);
+    uint32_t written = 0;
+    bool formatted = true;
+    for(uint32_t i = 0; i < count && fits; i++) {
+        char valueStr[FLOAT_FORMAT_BUFFER_SIZE];
+        if(values[i].isCount)
+            snprintf(valueStr, sizeof(valueStr), "%ui", values[i].count);
+        else if(!isfinite(values[i].value))
+            continue;
+        else if(RC_SUCCESS != formatFloat(valueStr, sizeof(valueStr), values[i].value, decimals)) {
+            formatted = false;
+            break;
+        }
+        fits = appendByte((written > 0) ? ',' : ' ') && appendString(values[i].name) && appendByte('=') &&
+               appendString(valueStr);
+        written++;
+    }
+    if(m_timestamp[0] != '\0') fits = fits && appendByte(' ') && appendString(m_timestamp);
+    fits = fits && appendByte('\n');
+    if(!formatted || !fits || written == 0) {
+        m_length = previousLength;
+        // A line needs at least one field
+        return (formatted && !fits) ? RC_ERROR_BUFFER_FULL : RC_ERROR_BAD_PARAM;
+    }
+    m_sensorCount++;
+    return RC_SUCCESS;
+}
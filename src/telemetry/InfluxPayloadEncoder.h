@@ -0,0 +1,52 @@
+#ifndef INFLUX_PAYLOAD_ENCODER_H
+#define INFLUX_PAYLOAD_ENCODER_H
+#include "PayloadEncoder.h"
+
+/**
+ * @brief Encodes the samples in InfluxDB line protocol with one line per sensor, e.g.
+ * multisensor,device=Livingroom,sensor=Temperature value=21.50,raw=2345.00 1700000000000000000
+ *
+ * Aggregates are written as fields of the same name, the sample count as integer field.
+ * Non-finite values are left out as line protocol cannot represent them.
+ */
+class InfluxPayloadEncoder : public PayloadEncoder {
+   public:
+    /**
+     * @brief Constructor
+     *
+     * @param buffer [IN] Buffer for the payload
+     * @param size [IN] Size of buffer in bytes
+     * @param measurement [IN] Name of the measurement of all lines. Has to outlive the encoder
+     * @param device [IN] Value of the device tag. Has to outlive the encoder.
+     *  The tag is left out if it is empty
+     */
+    InfluxPayloadEncoder(uint8_t buffer[], uint32_t size, const char measurement[], const char device[]);
+
+    /**
+     * @brief Starts a new payload without sensors
+     *
+     * @param timestamp [IN] Unix time in seconds appended to every line.
+     *  If 0, the lines have no timestamp and the server uses its own time
+     */
+    void clear(uint32_t timestamp = 0) override;
+
+    RC_t add(const char name[], const SensorSample_t& sample, const SampleAggregator* aggregate = nullptr,
+             uint8_t fields = 0, uint8_t decimals = FLOAT_FORMAT_MAX_DECIMALS) override;
+
+   private:
+    /**
+     * @brief Appends str with a backslash in front of each of the special characters
+     *
+     * @param str [IN] Measurement name or tag value
+     * @param special [IN] Characters which have to be escaped
+     * @return true if it fit
+     */
+    bool appendEscaped(const char str[], const char special[]);
+
+    const char* const m_measurement;
+    const char* const m_device;
+    // Nanoseconds since the epoch as string, empty if there is no timestamp
+    char m_timestamp[24] = "";
+};
+
+#endif  // INFLUX_PAYLOAD_ENCODER_H
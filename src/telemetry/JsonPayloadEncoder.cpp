@@ -0,0 +1,63 @@
+#include "JsonPayloadEncoder.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "helper_functions.h"
+
+JsonPayloadEncoder::JsonPayloadEncoder(uint8_t buffer[], uint32_t size) : PayloadEncoder(buffer, size) { clear(); }
+
+void JsonPayloadEncoder::clear(uint32_t timestamp) {
+    memcpy(m_buffer, "{}", 3);
+    m_length = 2;
+    m_sensorCount = 0;
+}
+
+bool JsonPayloadEncoder::appendText(const char str[], bool escape) {
+    for(const char* c = str; *c != '\0'; c++) {
+        const bool escaped = escape && (*c == '"' || *c == '\\');
+        // Keep space for the null terminator
+        if(m_length + (escaped ? 2 : 1) >= m_size) return false;
+        if(escaped) m_buffer[m_length++] = '\\';
+        m_buffer[m_length++] = *c;
+    }
+    return true;
+}
+
+RC_t JsonPayloadEncoder::add(const char name[], const SensorSample_t& sample, const SampleAggregator* aggregate,
+                             uint8_t fields, uint8_t decimals) {
+    PayloadField_t values[PAYLOAD_ENCODER_MAX_FIELDS];
+    const uint32_t count = getFields(sample, aggregate, fields, values);
+    const uint32_t previousLength = m_length;
+
+    // Overwrite the closing brace of the document
+    m_length--;
+    RC_t err = RC_SUCCESS;
+    bool fits = appendText((m_sensorCount > 0) ? ",\"" : "\"") && appendText(name, true) && appendText("\":{");
+    for(uint32_t i = 0; i < count && fits; i++) {
+        char valueStr[FLOAT_FORMAT_BUFFER_SIZE];
+        if(values[i].isCount)
+            snprintf(valueStr, sizeof(valueStr), "%u", values[i].count);
+        else if(!isfinite(values[i].value))
+            // JSON has no notation for NAN and infinity, e.g. of a failed read
+            strcpy(valueStr, "null");
+        else if(RC_SUCCESS != formatFloat(valueStr, sizeof(valueStr), values[i].value, decimals)) {
+            err = RC_ERROR_BAD_PARAM;
+            break;
+        }
+        fits = appendText((i > 0) ? ",\"" : "\"") && appendText(values[i].name) && appendText("\":") &&
+               appendText(valueStr);
+    }
+    if(RC_SUCCESS == err && !(fits && appendText("}}"))) err = RC_ERROR_BUFFER_FULL;
+    if(RC_SUCCESS != err) {
+        // Leave the document as it was before
+        m_length = previousLength;
+        m_buffer[m_length - 1] = '}';
+        m_buffer[m_length] = '\0';
+        return err;
+    }
+    m_buffer[m_length] = '\0';
+    m_sensorCount++;
+    return RC_SUCCESS;
+}
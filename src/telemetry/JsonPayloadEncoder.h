@@ -0,0 +1,43 @@
+#ifndef JSON_PAYLOAD_ENCODER_H
+#define JSON_PAYLOAD_ENCODER_H
+#include "PayloadEncoder.h"
+
+/**
+ * @brief Encodes the samples as JSON object with one object per sensor, e.g.
+ * {"Temperature":{"value":21.50,"raw":2345.00},"Humidity":{"mean":40.10,"count":6,"raw":1234.00}}
+ *
+ * The payload is null-terminated behind its length, so it can be used as string as well.
+ */
+class JsonPayloadEncoder : public PayloadEncoder {
+   public:
+    /**
+     * @brief Constructor
+     *
+     * @param buffer [IN] Buffer for the payload
+     * @param size [IN] Size of buffer in bytes, at least 3
+     */
+    JsonPayloadEncoder(uint8_t buffer[], uint32_t size);
+
+    void clear(uint32_t timestamp = 0) override;
+
+    RC_t add(const char name[], const SensorSample_t& sample, const SampleAggregator* aggregate = nullptr,
+             uint8_t fields = 0, uint8_t decimals = FLOAT_FORMAT_MAX_DECIMALS) override;
+
+    /**
+     * @brief Returns the null-terminated payload
+     *
+     * @return const char*
+     */
+    inline const char* c_str() const { return reinterpret_cast<const char*>(m_buffer); }
+
+   private:
+    /**
+     * @brief Appends a string at m_length. Quotes and backslashes are escaped if requested.
+     * Keeps a byte free for the null terminator
+     *
+     * @return true if it fit
+     */
+    bool appendText(const char str[], bool escape = false);
+};
+
+#endif  // JSON_PAYLOAD_ENCODER_H
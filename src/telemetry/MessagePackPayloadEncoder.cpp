@@ -0,0 +1,70 @@
+#include "MessagePackPayloadEncoder.h"
+
+#include <string.h>
+
+#define MSGPACK_POSITIVE_FIXINT_MAX (0x7F)
+#define MSGPACK_FIXMAP (0x80)
+#define MSGPACK_FIXSTR (0xA0)
+#define MSGPACK_FIXSTR_MAX_LENGTH (31)
+#define MSGPACK_FLOAT32 (0xCA)
+#define MSGPACK_UINT8 (0xCC)
+#define MSGPACK_UINT16 (0xCD)
+#define MSGPACK_UINT32 (0xCE)
+#define MSGPACK_STR8 (0xD9)
+#define MSGPACK_STR16 (0xDA)
+#define MSGPACK_MAP16 (0xDE)
+
+MessagePackPayloadEncoder::MessagePackPayloadEncoder(uint8_t buffer[], uint32_t size) : PayloadEncoder(buffer, size) {
+    clear();
+}
+
+void MessagePackPayloadEncoder::clear(uint32_t timestamp) {
+    m_buffer[0] = MSGPACK_MAP16;
+    putBigEndian(1, 0, 2);
+    m_length = 3;
+    m_sensorCount = 0;
+}
+
+bool MessagePackPayloadEncoder::appendText(const char str[]) {
+    const uint32_t length = strlen(str);
+    bool fits = false;
+    if(length <= MSGPACK_FIXSTR_MAX_LENGTH)
+        fits = appendByte(MSGPACK_FIXSTR | length);
+    else if(length <= UINT8_MAX)
+        fits = appendByte(MSGPACK_STR8) && appendBigEndian(length, 1);
+    else if(length <= UINT16_MAX)
+        fits = appendByte(MSGPACK_STR16) && appendBigEndian(length, 2);
+    return fits && appendString(str);
+}
+
+bool MessagePackPayloadEncoder::appendUnsigned(uint32_t value) {
+    if(value <= MSGPACK_POSITIVE_FIXINT_MAX) return appendByte(value);
+    if(value <= UINT8_MAX) return appendByte(MSGPACK_UINT8) && appendBigEndian(value, 1);
+    if(value <= UINT16_MAX) return appendByte(MSGPACK_UINT16) && appendBigEndian(value, 2);
+    return appendByte(MSGPACK_UINT32) && appendBigEndian(value, 4);
+}
+
+RC_t MessagePackPayloadEncoder::add(const char name[], const SensorSample_t& sample, const SampleAggregator* aggregate,
+                                    uint8_t fields, uint8_t decimals) {
+    if(m_sensorCount >= UINT16_MAX) return RC_ERROR_BUFFER_FULL;
+    PayloadField_t values[PAYLOAD_ENCODER_MAX_FIELDS];
+    const uint32_t count = getFields(sample, aggregate, fields, values);
+    const uint32_t previousLength = m_length;
+
+    // At most PAYLOAD_ENCODER_MAX_FIELDS entries, so the sensor map always is a fixmap
+    bool fits = appendText(name) && appendByte(MSGPACK_FIXMAP | count);
+    for(uint32_t i = 0; i < count && fits; i++) {
+        fits = appendText(values[i].name);
+        if(values[i].isCount)
+            fits = fits && appendUnsigned(values[i].count);
+        else
+            fits = fits && appendByte(MSGPACK_FLOAT32) && appendBigEndian(floatBits(values[i].value), 4);
+    }
+    if(!fits) {
+        m_length = previousLength;
+        return RC_ERROR_BUFFER_FULL;
+    }
+    m_sensorCount++;
+    putBigEndian(1, m_sensorCount, 2);
+    return RC_SUCCESS;
+}
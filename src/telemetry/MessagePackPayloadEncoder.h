@@ -0,0 +1,35 @@
+#ifndef MESSAGE_PACK_PAYLOAD_ENCODER_H
+#define MESSAGE_PACK_PAYLOAD_ENCODER_H
+#include "PayloadEncoder.h"
+
+/**
+ * @brief Encodes the samples as MessagePack map with one map per sensor. It has the same
+ * structure as the JSON payload, values are single precision floats and counts unsigned integers.
+ *
+ * The outer map always is a map 16, so that its length can be updated in place after every add.
+ */
+class MessagePackPayloadEncoder : public PayloadEncoder {
+   public:
+    /**
+     * @brief Constructor
+     *
+     * @param buffer [IN] Buffer for the payload
+     * @param size [IN] Size of buffer in bytes, at least 3
+     */
+    MessagePackPayloadEncoder(uint8_t buffer[], uint32_t size);
+
+    void clear(uint32_t timestamp = 0) override;
+
+    RC_t add(const char name[], const SensorSample_t& sample, const SampleAggregator* aggregate = nullptr,
+             uint8_t fields = 0, uint8_t decimals = FLOAT_FORMAT_MAX_DECIMALS) override;
+
+   private:
+    bool appendText(const char str[]);
+
+    /**
+     * @brief Appends an unsigned integer in its smallest encoding
+     */
+    bool appendUnsigned(uint32_t value);
+};
+
+#endif  // MESSAGE_PACK_PAYLOAD_ENCODER_H
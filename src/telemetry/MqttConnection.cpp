@@ -0,0 +1,100 @@
+#include "MqttConnection.h"
+
+MqttConnection::MqttConnection(uint32_t minBackoffMs, uint32_t maxBackoffMs, uint32_t seed)
+    : m_minBackoffMs(minBackoffMs), m_maxBackoffMs(maxBackoffMs), m_random(seed), m_nextBackoffMs(minBackoffMs) {}
+
+uint32_t MqttConnection::getTimeUntilConnectMs(uint32_t nowMs) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    switch(m_state) {
+        case STATE_DISCONNECTED:
+            return 0;
+        case STATE_BACKOFF: {
+            // Signed difference, so that the uptime may wrap
+            const int32_t remaining = static_cast<int32_t>(m_retryAtMs - nowMs);
+            return (remaining > 0) ? remaining : 0;
+        }
+        default:
+            return UINT32_MAX;
+    }
+}
+
+void MqttConnection::connecting(uint32_t nowMs) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(!m_disconnected) {
+        m_disconnected = true;
+        m_disconnectedAtMs = nowMs;
+    }
+    m_metrics.backoffMs = 0;
+    setState(STATE_CONNECTING);
+}
+
+void MqttConnection::connected(uint32_t nowMs) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_metrics.connects++;
+    if(m_disconnected) {
+        m_metrics.lastReconnectMs = nowMs - m_disconnectedAtMs;
+        if(m_metrics.lastReconnectMs > m_metrics.maxReconnectMs) m_metrics.maxReconnectMs = m_metrics.lastReconnectMs;
+        m_disconnected = false;
+    }
+    m_nextBackoffMs = m_minBackoffMs;
+    m_metrics.backoffMs = 0;
+    setState(STATE_CONNECTED);
+}
+
+void MqttConnection::connectFailed(uint32_t nowMs, bool permanent) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_metrics.failedAttempts++;
+    if(permanent) {
+        m_metrics.backoffMs = 0;
+        setState(STATE_HALTED);
+        return;
+    }
+    // Equal jitter: at least half of the backoff, so that it still grows
+    const uint32_t half = m_nextBackoffMs / 2;
+    m_metrics.backoffMs = half + m_random.next() % (m_nextBackoffMs - half + 1);
+    m_retryAtMs = nowMs + m_metrics.backoffMs;
+    m_nextBackoffMs = (m_nextBackoffMs > m_maxBackoffMs / 2) ? m_maxBackoffMs : 2 * m_nextBackoffMs;
+    setState(STATE_BACKOFF);
+}
+
+void MqttConnection::connectionLost(uint32_t nowMs) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(m_state != STATE_CONNECTED) return;
+    m_metrics.connectionLosses++;
+    m_disconnected = true;
+    m_disconnectedAtMs = nowMs;
+    setState(STATE_DISCONNECTED);
+}
+
+MqttConnection::State_t MqttConnection::getState() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_state;
+}
+
+MqttConnectionMetrics_t MqttConnection::getMetrics() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_metrics;
+}
+
+const char* MqttConnection::stateToString(State_t state) {
+    switch(state) {
+        case STATE_DISCONNECTED:
+            return "disconnected";
+        case STATE_CONNECTING:
+            return "connecting";
+        case STATE_CONNECTED:
+            return "connected";
+        case STATE_BACKOFF:
+            return "backoff";
+        case STATE_HALTED:
+            return "halted";
+        default:
+            return "unknown";
+    }
+}
+
+void MqttConnection::setState(State_t state) {
+    if(state == m_state) return;
+    m_state = state;
+    m_metrics.transitions++;
+}
@@ -0,0 +1,143 @@
+#ifndef MQTT_CONNECTION_H
+#define MQTT_CONNECTION_H
+#include <mutex>
+
+#include "global.h"
+#include "sensors/XorShift32.h"
+
+/**
+ * @brief Counters of the connection to the MQTT broker
+ */
+typedef struct {
+    /**
+     * @brief Number of state changes
+     */
+    uint32_t transitions;
+    /**
+     * @brief Successful connection attempts
+     */
+    uint32_t connects;
+    uint32_t failedAttempts;
+    /**
+     * @brief Number of times an established connection was lost
+     */
+    uint32_t connectionLosses;
+    /**
+     * @brief Time from losing the connection, or from the first attempt after startup,
+     * until the client was connected again
+     */
+    uint32_t lastReconnectMs;
+    uint32_t maxReconnectMs;
+    /**
+     * @brief Delay before the next attempt, 0 unless in STATE_BACKOFF
+     */
+    uint32_t backoffMs;
+} MqttConnectionMetrics_t;
+
+/**
+ * @brief State machine of the connection to the MQTT broker. Decides when the next connection
+ * attempt is due, but does not connect itself, so the MQTT task can sleep in between.
+ *
+ * Failed attempts are retried after a backoff which starts at minBackoffMs and doubles with every
+ * further failure up to maxBackoffMs. Each delay is jittered between half and all of the backoff,
+ * so that devices which lost the broker at the same time do not reconnect in lockstep.
+ * Errors which a retry cannot fix, like rejected credentials, halt the state machine.
+ *
+ * The events must only be reported from the MQTT task. The state and counters may be read from any task.
+ */
+class MqttConnection {
+   public:
+    typedef enum { STATE_DISCONNECTED, STATE_CONNECTING, STATE_CONNECTED, STATE_BACKOFF, STATE_HALTED } State_t;
+
+    /**
+     * @brief Constructor
+     *
+     * @param minBackoffMs [IN] Backoff after the first failed attempt
+     * @param maxBackoffMs [IN] Longest backoff
+     * @param seed [IN] Seed of the jitter, should differ between devices
+     */
+    MqttConnection(uint32_t minBackoffMs, uint32_t maxBackoffMs, uint32_t seed);
+
+    /**
+     * @brief Returns the time until the next connection attempt is due
+     *
+     * @param nowMs [IN] Current uptime in ms
+     * @return uint32_t Time in ms, 0 if an attempt is due now,
+     *  UINT32_MAX if no attempt is needed because the client is connected or halted
+     */
+    uint32_t getTimeUntilConnectMs(uint32_t nowMs) const;
+
+    /**
+     * @brief Reports that a connection attempt is started
+     *
+     * @param nowMs [IN] Current uptime in ms
+     */
+    void connecting(uint32_t nowMs);
+
+    /**
+     * @brief Reports that the client connected. Resets the backoff
+     *
+     * @param nowMs [IN] Current uptime in ms
+     */
+    void connected(uint32_t nowMs);
+
+    /**
+     * @brief Reports that a connection attempt failed
+     *
+     * @param nowMs [IN] Current uptime in ms
+     * @param permanent [IN] True if retrying cannot help. Halts the state machine
+     */
+    void connectFailed(uint32_t nowMs, bool permanent = false);
+
+    /**
+     * @brief Reports that an established connection was lost. The next attempt is due immediately
+     *
+     * @param nowMs [IN] Current uptime in ms
+     */
+    void connectionLost(uint32_t nowMs);
+
+    State_t getState() const;
+
+    /**
+     * @brief Returns the counters since startup
+     *
+     * @return MqttConnectionMetrics_t
+     */
+    MqttConnectionMetrics_t getMetrics() const;
+
+    /**
+     * @brief Returns the name of a state for logging
+     *
+     * @param state [IN]
+     * @return const char*
+     */
+    static const char* stateToString(State_t state);
+
+   private:
+    /**
+     * @brief Changes the state and counts the transition. m_mutex has to be held
+     */
+    void setState(State_t state);
+
+    mutable std::mutex m_mutex;
+    const uint32_t m_minBackoffMs;
+    const uint32_t m_maxBackoffMs;
+    XorShift32 m_random;
+    State_t m_state = STATE_DISCONNECTED;
+    /**
+     * @brief Backoff before jitter after the next failed attempt
+     */
+    uint32_t m_nextBackoffMs;
+    /**
+     * @brief Uptime at which the backoff ends. Only valid in STATE_BACKOFF
+     */
+    uint32_t m_retryAtMs = 0;
+    /**
+     * @brief Uptime since which the client is disconnected. Only valid while m_disconnected is set
+     */
+    uint32_t m_disconnectedAtMs = 0;
+    bool m_disconnected = false;
+    MqttConnectionMetrics_t m_metrics = {0, 0, 0, 0, 0, 0, 0};
+};
+
+#endif  // MQTT_CONNECTION_H
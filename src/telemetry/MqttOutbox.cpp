@@ -0,0 +1,116 @@
+#include "MqttOutbox.h"
+
+#include <string.h>
+
+// Topic and payload length in front of every message
+#define MQTT_OUTBOX_HEADER_SIZE (4)
+
+void MqttOutbox::setDropPolicy(DropPolicy_t policy) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_policy = policy;
+}
+
+void MqttOutbox::setWakeFunction(void (*wakeFunction)()) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_wakeFunction = wakeFunction;
+}
+
+RC_t MqttOutbox::push(const char topic[], const char payload[]) {
+    return push(topic, reinterpret_cast<const uint8_t*>(payload), strlen(payload));
+}
+
+RC_t MqttOutbox::push(const char topic[], const uint8_t payload[], uint32_t payloadLength) {
+    const uint32_t topicLength = strlen(topic);
+    const uint32_t size = MQTT_OUTBOX_HEADER_SIZE + topicLength + payloadLength;
+    void (*wakeFunction)() = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(topicLength >= MQTT_OUTBOX_MAX_TOPIC_LENGTH || payloadLength > MQTT_OUTBOX_MAX_PAYLOAD_LENGTH ||
+           size > MQTT_OUTBOX_SIZE) {
+            m_metrics.dropped++;
+            return RC_ERROR_BAD_PARAM;
+        }
+        if(MQTT_OUTBOX_SIZE - m_metrics.bytes < size) {
+            if(m_policy == DROP_NEWEST) {
+                m_metrics.dropped++;
+                return RC_ERROR_BUFFER_FULL;
+            }
+            while(MQTT_OUTBOX_SIZE - m_metrics.bytes < size) {
+                removeFront();
+                m_metrics.dropped++;
+            }
+        }
+        const uint8_t header[MQTT_OUTBOX_HEADER_SIZE] = {
+            static_cast<uint8_t>(topicLength), static_cast<uint8_t>(topicLength >> 8),
+            static_cast<uint8_t>(payloadLength), static_cast<uint8_t>(payloadLength >> 8)};
+        write(header, sizeof(header));
+        write(reinterpret_cast<const uint8_t*>(topic), topicLength);
+        write(payload, payloadLength);
+        m_metrics.bytes += size;
+        m_metrics.depth++;
+        if(m_metrics.depth > m_metrics.maxDepth) m_metrics.maxDepth = m_metrics.depth;
+        wakeFunction = m_wakeFunction;
+    }
+    if(wakeFunction != nullptr) wakeFunction();
+    return RC_SUCCESS;
+}
+
+RC_t MqttOutbox::front(MqttOutboxMessage_t& message) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(m_metrics.depth == 0) return RC_ERROR_BUFFER_EMPTY;
+    uint8_t header[MQTT_OUTBOX_HEADER_SIZE];
+    read(m_tail, header, sizeof(header));
+    const uint32_t topicLength = header[0] | (header[1] << 8);
+    message.payloadLength = header[2] | (header[3] << 8);
+    read((m_tail + MQTT_OUTBOX_HEADER_SIZE) % MQTT_OUTBOX_SIZE, reinterpret_cast<uint8_t*>(message.topic),
+         topicLength);
+    message.topic[topicLength] = '\0';
+    read((m_tail + MQTT_OUTBOX_HEADER_SIZE + topicLength) % MQTT_OUTBOX_SIZE, message.payload, message.payloadLength);
+    message.sequence = m_sequence;
+    return RC_SUCCESS;
+}
+
+void MqttOutbox::pop(uint32_t sequence) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(m_metrics.depth == 0 || sequence != m_sequence) return;
+    removeFront();
+    m_metrics.published++;
+}
+
+uint32_t MqttOutbox::getFreeBytes() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return MQTT_OUTBOX_SIZE - m_metrics.bytes;
+}
+
+MqttOutboxMetrics_t MqttOutbox::getMetrics() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_metrics;
+}
+
+void MqttOutbox::write(const uint8_t data[], uint32_t length) {
+    // Wraps around the end of the ring at most once
+    const uint32_t first = (length < MQTT_OUTBOX_SIZE - m_head) ? length : MQTT_OUTBOX_SIZE - m_head;
+    memcpy(&m_ring[m_head], data, first);
+    memcpy(m_ring, data + first, length - first);
+    m_head = (m_head + length) % MQTT_OUTBOX_SIZE;
+}
+
+void MqttOutbox::read(uint32_t pos, uint8_t data[], uint32_t length) const {
+    const uint32_t first = (length < MQTT_OUTBOX_SIZE - pos) ? length : MQTT_OUTBOX_SIZE - pos;
+    memcpy(data, &m_ring[pos], first);
+    memcpy(data + first, m_ring, length - first);
+}
+
+uint32_t MqttOutbox::frontSize() const {
+    uint8_t header[MQTT_OUTBOX_HEADER_SIZE];
+    read(m_tail, header, sizeof(header));
+    return MQTT_OUTBOX_HEADER_SIZE + (header[0] | (header[1] << 8)) + (header[2] | (header[3] << 8));
+}
+
+void MqttOutbox::removeFront() {
+    const uint32_t size = frontSize();
+    m_tail = (m_tail + size) % MQTT_OUTBOX_SIZE;
+    m_metrics.bytes -= size;
+    m_metrics.depth--;
+    m_sequence++;
+}
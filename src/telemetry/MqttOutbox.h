@@ -0,0 +1,171 @@
+#ifndef MQTT_OUTBOX_H
+#define MQTT_OUTBOX_H
+#include <mutex>
+
+#include "global.h"
+
+/**
+ * @brief Usage counters of an MqttOutbox
+ */
+typedef struct {
+    /**
+     * @brief Messages waiting to be published
+     */
+    uint32_t depth;
+    /**
+     * @brief Bytes of the ring used by the waiting messages
+     */
+    uint32_t bytes;
+    /**
+     * @brief Largest depth since startup
+     */
+    uint32_t maxDepth;
+    /**
+     * @brief Messages which were dropped because the ring was full or they were too large
+     */
+    uint32_t dropped;
+    /**
+     * @brief Messages which were taken out of the ring after being published
+     */
+    uint32_t published;
+} MqttOutboxMetrics_t;
+
+/**
+ * @brief Message taken from an MqttOutbox
+ */
+typedef struct {
+    char topic[MQTT_OUTBOX_MAX_TOPIC_LENGTH];
+    /**
+     * @brief Payload, not null-terminated
+     */
+    uint8_t payload[MQTT_OUTBOX_MAX_PAYLOAD_LENGTH];
+    uint32_t payloadLength;
+    /**
+     * @brief Identifies the message for pop
+     */
+    uint32_t sequence;
+} MqttOutboxMessage_t;
+
+/**
+ * @brief Bounded ring of MQTT messages between the tasks which produce them and the MQTT task,
+ * which owns the client. Messages are stored back to back in MQTT_OUTBOX_SIZE bytes, so many
+ * small messages fit as well as a few large ones.
+ *
+ * A message stays in the ring until the consumer pops it after a successful publish,
+ * so messages are held while the broker is unreachable. Once the ring is full, either the
+ * oldest messages are dropped to make space or the new message is rejected.
+ *
+ * Safe to use from any task, but not from interrupts. Only a single consumer is supported.
+ */
+class MqttOutbox {
+   public:
+    typedef enum { DROP_OLDEST, DROP_NEWEST } DropPolicy_t;
+
+    MqttOutbox() = default;
+
+    /**
+     * @brief Sets what happens to messages if the ring is full
+     *
+     * @param policy [IN]
+     */
+    void setDropPolicy(DropPolicy_t policy);
+
+    /**
+     * @brief Sets a function which is called after every push, e.g. to wake up the consumer
+     *
+     * @param wakeFunction [IN] nullptr to disable
+     */
+    void setWakeFunction(void (*wakeFunction)());
+
+    /**
+     * @brief Adds a message to the end of the ring
+     *
+     * @param topic [IN] Null-terminated topic, shorter than MQTT_OUTBOX_MAX_TOPIC_LENGTH
+     * @param payload [IN] Null-terminated payload, at most MQTT_OUTBOX_MAX_PAYLOAD_LENGTH characters
+     * @return RC_t RC_SUCCESS if the message was added, possibly by dropping the oldest messages,
+     *  RC_ERROR_BUFFER_FULL if the ring is full and the policy is DROP_NEWEST,
+     *  RC_ERROR_BAD_PARAM if the message can never fit. Counted as dropped as well
+     */
+    RC_t push(const char topic[], const char payload[]);
+
+    /**
+     * @brief Adds a message with a binary payload to the end of the ring
+     *
+     * @param topic [IN] Null-terminated topic, shorter than MQTT_OUTBOX_MAX_TOPIC_LENGTH
+     * @param payload [IN]
+     * @param length [IN] Length of payload in bytes, at most MQTT_OUTBOX_MAX_PAYLOAD_LENGTH
+     * @return RC_t see push
+     */
+    RC_t push(const char topic[], const uint8_t payload[], uint32_t length);
+
+    /**
+     * @brief Copies the oldest message without removing it
+     *
+     * @param message [OUT]
+     * @return RC_t RC_SUCCESS on success, RC_ERROR_BUFFER_EMPTY if there is no message
+     */
+    RC_t front(MqttOutboxMessage_t& message) const;
+
+    /**
+     * @brief Removes the oldest message after it was published. Does nothing if that message
+     * was dropped in the meantime, so that no newer message is lost
+     *
+     * @param sequence [IN] Sequence of the message returned by front
+     */
+    void pop(uint32_t sequence);
+
+    /**
+     * @brief Returns the number of bytes which are free for further messages
+     *
+     * @return uint32_t
+     */
+    uint32_t getFreeBytes() const;
+
+    /**
+     * @brief Returns the usage counters since startup
+     *
+     * @return MqttOutboxMetrics_t
+     */
+    MqttOutboxMetrics_t getMetrics() const;
+
+   private:
+    /**
+     * @brief Copies bytes into the ring at m_head. m_mutex has to be held
+     */
+    void write(const uint8_t data[], uint32_t length);
+
+    /**
+     * @brief Copies bytes out of the ring starting at pos. m_mutex has to be held
+     */
+    void read(uint32_t pos, uint8_t data[], uint32_t length) const;
+
+    /**
+     * @brief Returns the size in bytes of the oldest message. m_mutex has to be held
+     */
+    uint32_t frontSize() const;
+
+    /**
+     * @brief Removes the oldest message. m_mutex has to be held
+     */
+    void removeFront();
+
+    mutable std::mutex m_mutex;
+    uint8_t m_ring[MQTT_OUTBOX_SIZE];
+    /**
+     * @brief Offset of the oldest message
+     */
+    uint32_t m_tail = 0;
+    /**
+     * @brief Offset behind the newest message
+     */
+    uint32_t m_head = 0;
+    /**
+     * @brief Sequence of the oldest message
+     */
+    uint32_t m_sequence = 0;
+    DropPolicy_t m_policy = DROP_OLDEST;
+    void (*m_wakeFunction)() = nullptr;
+    MqttOutboxMetrics_t m_metrics = {0, 0, 0, 0, 0};
+};
+
+#endif  // MQTT_OUTBOX_H
@@ -0,0 +1,54 @@
+#include "PayloadEncoder.h"
+
+#include <string.h>
+
+uint32_t PayloadEncoder::getFields(const SensorSample_t& sample, const SampleAggregator* aggregate, uint8_t fields,
+                                   PayloadField_t values[PAYLOAD_ENCODER_MAX_FIELDS]) {
+    uint32_t n = 0;
+    if(aggregate == nullptr || fields == 0) {
+        values[n++] = {"value", sample.value, 0, false};
+    } else {
+        // Same order as SampleAggregator::toJson
+        if(fields & SampleAggregator::FIELD_MIN) values[n++] = {"min", aggregate->getMin(), 0, false};
+        if(fields & SampleAggregator::FIELD_MAX) values[n++] = {"max", aggregate->getMax(), 0, false};
+        if(fields & SampleAggregator::FIELD_MEAN) values[n++] = {"mean", aggregate->getMean(), 0, false};
+        if(fields & SampleAggregator::FIELD_LAST) values[n++] = {"last", aggregate->getLast(), 0, false};
+        if(fields & SampleAggregator::FIELD_COUNT) values[n++] = {"count", 0, aggregate->getCount(), true};
+    }
+    values[n++] = {"raw", sample.rawValue, 0, false};
+    return n;
+}
+
+bool PayloadEncoder::append(const uint8_t data[], uint32_t n) {
+    if(m_size - m_length < n) return false;
+    memcpy(&m_buffer[m_length], data, n);
+    m_length += n;
+    return true;
+}
+
+bool PayloadEncoder::appendByte(uint8_t b) {
+    if(m_length >= m_size) return false;
+    m_buffer[m_length++] = b;
+    return true;
+}
+
+bool PayloadEncoder::appendString(const char str[]) {
+    return append(reinterpret_cast<const uint8_t*>(str), strlen(str));
+}
+
+bool PayloadEncoder::appendBigEndian(uint32_t value, uint8_t bytes) {
+    if(m_size - m_length < bytes) return false;
+    putBigEndian(m_length, value, bytes);
+    m_length += bytes;
+    return true;
+}
+
+void PayloadEncoder::putBigEndian(uint32_t pos, uint32_t value, uint8_t bytes) {
+    for(uint8_t i = 0; i < bytes; i++) m_buffer[pos + i] = static_cast<uint8_t>(value >> (8 * (bytes - 1 - i)));
+}
+
+uint32_t PayloadEncoder::floatBits(float_t value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
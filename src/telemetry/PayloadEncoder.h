@@ -0,0 +1,144 @@
+#ifndef PAYLOAD_ENCODER_H
+#define PAYLOAD_ENCODER_H
+#include "global.h"
+#include "sensors/SampleAggregator.h"
+#include "sensors/SampleCache.h"
+
+// Largest number of values of one sensor: all aggregates and the raw value
+#define PAYLOAD_ENCODER_MAX_FIELDS (6)
+
+/**
+ * @brief Value of a sensor in a payload
+ */
+typedef struct {
+    /**
+     * @brief Key of the value, e.g. "value", "raw" or the name of an aggregate
+     */
+    const char* name;
+    float_t value;
+    /**
+     * @brief Number of samples. Only valid if isCount is set
+     */
+    uint32_t count;
+    bool isCount;
+} PayloadField_t;
+
+/**
+ * @brief Encodes the samples of several sensors into one MQTT payload in a caller-provided buffer.
+ * Encoders never allocate memory.
+ *
+ * The payload in the buffer is complete after every add, so it can be published at any time.
+ * If a sensor does not fit, the payload is left unchanged, so that it can be published and
+ * the sensor added to the next one.
+ */
+class PayloadEncoder {
+   public:
+    virtual ~PayloadEncoder() = default;
+
+    /**
+     * @brief Starts a new payload without sensors
+     *
+     * @param timestamp [IN] Unix time in seconds at which the samples were taken.
+     *  0 if unknown. Only used by formats which can carry a timestamp
+     */
+    virtual void clear(uint32_t timestamp = 0) = 0;
+
+    /**
+     * @brief Adds the sample of a sensor to the payload
+     *
+     * @param name [IN] Name of the sensor
+     * @param sample [IN] Latest sample, its raw value is always added
+     * @param aggregate [IN] Optional aggregated samples since the last publish. If given,
+     *  the selected aggregates are added instead of the processed value
+     * @param fields [IN] Bit mask of SampleAggregator::Field_t values
+     * @param decimals [IN] Number of decimals of the values in text formats
+     * @return RC_t RC_SUCCESS on success,
+     *  RC_ERROR_BUFFER_FULL if the sensor does not fit,
+     *  RC_ERROR_BAD_PARAM if the values can't be encoded, e.g. with too many decimals.
+     *  The payload stays unchanged on errors
+     */
+    virtual RC_t add(const char name[], const SensorSample_t& sample, const SampleAggregator* aggregate = nullptr,
+                     uint8_t fields = 0, uint8_t decimals = FLOAT_FORMAT_MAX_DECIMALS) = 0;
+
+    /**
+     * @brief Returns the payload
+     *
+     * @return const uint8_t*
+     */
+    inline const uint8_t* data() const { return m_buffer; }
+
+    /**
+     * @brief Returns the length of the payload in bytes
+     *
+     * @return uint32_t
+     */
+    inline uint32_t length() const { return m_length; }
+
+    /**
+     * @brief Returns the number of sensors in the payload
+     *
+     * @return uint32_t
+     */
+    inline uint32_t getSensorCount() const { return m_sensorCount; }
+
+   protected:
+    /**
+     * @brief Constructor
+     *
+     * @param buffer [IN] Buffer for the payload
+     * @param size [IN] Size of buffer in bytes
+     */
+    PayloadEncoder(uint8_t buffer[], uint32_t size) : m_buffer(buffer), m_size(size) {}
+
+    /**
+     * @brief Lists the values of a sensor in the order in which they are encoded:
+     * the processed value or the selected aggregates, then the raw value
+     *
+     * @param sample [IN]
+     * @param aggregate [IN] nullptr if the processed value is used
+     * @param fields [IN] Bit mask of SampleAggregator::Field_t values
+     * @param values [OUT]
+     * @return uint32_t Number of values
+     */
+    static uint32_t getFields(const SensorSample_t& sample, const SampleAggregator* aggregate, uint8_t fields,
+                              PayloadField_t values[PAYLOAD_ENCODER_MAX_FIELDS]);
+
+    /**
+     * @brief Appends bytes at m_length
+     *
+     * @return true if they fit
+     */
+    bool append(const uint8_t data[], uint32_t n);
+
+    bool appendByte(uint8_t b);
+
+    /**
+     * @brief Appends a null-terminated string without terminator
+     */
+    bool appendString(const char str[]);
+
+    /**
+     * @brief Appends an unsigned integer in big-endian byte order
+     *
+     * @param value [IN]
+     * @param bytes [IN] Number of bytes, 1, 2 or 4
+     */
+    bool appendBigEndian(uint32_t value, uint8_t bytes);
+
+    /**
+     * @brief Overwrites an unsigned integer in big-endian byte order at pos
+     */
+    void putBigEndian(uint32_t pos, uint32_t value, uint8_t bytes);
+
+    /**
+     * @brief Returns the bit pattern of an IEEE 754 single precision float
+     */
+    static uint32_t floatBits(float_t value);
+
+    uint8_t* const m_buffer;
+    const uint32_t m_size;
+    uint32_t m_length = 0;
+    uint32_t m_sensorCount = 0;
+};
+
+#endif  // PAYLOAD_ENCODER_H
@@ -1,6 +1,26 @@
 #include "DigitalThreshold.h"
 
-DigitalThreshold::DigitalThreshold(float_t thresh, std::shared_ptr<Transformer> next)
-    : Transformer(next), m_threshold(thresh) {}
+#include "TransformerType.h"
 
-float_t DigitalThreshold::transform(float_t input) { return (input >= m_threshold) ? 1 : 0; }
\ No newline at end of file
+DigitalThreshold::DigitalThreshold(float_t thresh, bool urgent, std::shared_ptr<Transformer> next)
+    : Transformer(next), m_threshold(thresh), m_urgent(urgent) {}
+
+float_t DigitalThreshold::transform(float_t input) {
+    const float_t output = (input >= m_threshold) ? 1 : 0;
+    // The first output is the initial state, not a change
+    if(m_urgent && m_lastOutput >= 0 && output != m_lastOutput) raiseUrgentEvent();
+    m_lastOutput = output;
+    return output;
+}
+
+static const ConfigParam_t digitalThresholdParams[] = {
+    {"thresh", CONFIG_PARAM_FLOAT, true, nullptr},
+    // Publishes every change of the output immediately
+    {"urgent", CONFIG_PARAM_INT, false, "0"},
+};
+
+static std::shared_ptr<Transformer> createDigitalThreshold(const ConfigParams& params) {
+    return std::make_shared<DigitalThreshold>(params.getFloat("thresh"), params.getInt("urgent") != 0);
+}
+
+REGISTER_TRANSFORMER_TYPE(DigitalThreshold, digitalThresholdParams, createDigitalThreshold);
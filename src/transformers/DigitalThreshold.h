@@ -9,10 +9,12 @@ class DigitalThreshold : public Transformer {
      * the given threshold to a 1 and values below to a 0
      *
      * @param thresh [IN] Threshold from which values are seen as a logic 1
+     * @param urgent [IN] If true, every change of the output raises an urgent event
      * @param next [IN] shared pointer to next step in transformation pipeline.
      *  Defaults to a nullptr.
      */
-    DigitalThreshold(float_t thresh, std::shared_ptr<Transformer> next = std::shared_ptr<Transformer>());
+    DigitalThreshold(float_t thresh, bool urgent = false,
+                     std::shared_ptr<Transformer> next = std::shared_ptr<Transformer>());
 
    protected:
     /**
@@ -25,6 +27,11 @@ class DigitalThreshold : public Transformer {
 
    private:
     const float_t m_threshold;
+    const bool m_urgent;
+    /**
+     * @brief Previous output, -1 before the first input
+     */
+    float_t m_lastOutput = -1;
 };
 
 #endif  // DIGITAL_THRESHOLD_H
\ No newline at end of file
@@ -1,5 +1,17 @@
 #include "Offset.h"
 
+#include "TransformerType.h"
+
 Offset::Offset(float_t offset, std::shared_ptr<Transformer> next) : Transformer(next), m_offset(offset) {}
 
-float_t Offset::transform(float_t input) { return input + m_offset; }
\ No newline at end of file
+float_t Offset::transform(float_t input) { return input + m_offset; }
+
+static const ConfigParam_t offsetParams[] = {
+    {"offset", CONFIG_PARAM_FLOAT, true, nullptr},
+};
+
+static std::shared_ptr<Transformer> createOffset(const ConfigParams& params) {
+    return std::make_shared<Offset>(params.getFloat("offset"));
+}
+
+REGISTER_TRANSFORMER_TYPE(Offset, offsetParams, createOffset);
@@ -1,5 +1,7 @@
 #include "Remapper.h"
 
+#include "TransformerType.h"
+
 Remapper::Remapper(float_t inMin, float_t inMax, float_t outMin, float_t outMax, std::shared_ptr<Transformer> next)
     : m_inMin(inMin), m_inMax(inMax), m_outMin(outMin), m_outMax(outMax) {}
 
@@ -8,3 +10,17 @@ float_t Remapper::transform(float_t input) {
     if(input < m_inMin) input = m_inMin;
     return (input - m_inMin) * (m_outMax - m_outMin) / (m_inMax - m_inMin) + m_outMin;
 }
+
+static const ConfigParam_t remapperParams[] = {
+    {"inMin", CONFIG_PARAM_FLOAT, true, nullptr},
+    {"inMax", CONFIG_PARAM_FLOAT, true, nullptr},
+    {"outMin", CONFIG_PARAM_FLOAT, true, nullptr},
+    {"outMax", CONFIG_PARAM_FLOAT, true, nullptr},
+};
+
+static std::shared_ptr<Transformer> createRemapper(const ConfigParams& params) {
+    return std::make_shared<Remapper>(params.getFloat("inMin"), params.getFloat("inMax"), params.getFloat("outMin"),
+                                      params.getFloat("outMax"));
+}
+
+REGISTER_TRANSFORMER_TYPE(Remapper, remapperParams, createRemapper);
@@ -1,5 +1,7 @@
 #include "SimpleMovingAverageFilter.h"
 
+#include "TransformerType.h"
+
 SimpleMovingAverageFilter::SimpleMovingAverageFilter(uint32_t n, std::shared_ptr<Transformer> next)
     : Transformer(next), m_bufferSize(n) {
     m_averageBuffer = new float_t[n];
@@ -36,4 +38,17 @@ float_t SimpleMovingAverageFilter::transform(float_t input) {
         return sum / m_bufferSize;
     else
         return 0;
-}
\ No newline at end of file
+}
+
+static const ConfigParam_t simpleMovingAverageFilterParams[] = {
+    {"n", CONFIG_PARAM_INT, true, nullptr},
+};
+
+static std::shared_ptr<Transformer> createSimpleMovingAverageFilter(const ConfigParams& params) {
+    const int32_t n = params.getInt("n");
+    if(n <= 0) return nullptr;
+    return std::make_shared<SimpleMovingAverageFilter>(n);
+}
+
+REGISTER_TRANSFORMER_TYPE(SimpleMovingAverageFilter, simpleMovingAverageFilterParams,
+                          createSimpleMovingAverageFilter);
@@ -20,4 +20,12 @@ uint32_t Transformer::countRemainingPipelineStages() const {
         current = current->m_next;
     }
     return counter;
-}
\ No newline at end of file
+}
+bool Transformer::takeUrgentEvent() {
+    bool urgent = false;
+    for(Transformer* current = this; current != nullptr; current = current->m_next.get()) {
+        urgent |= current->m_urgentEvent;
+        current->m_urgentEvent = false;
+    }
+    return urgent;
+}
@@ -40,6 +40,14 @@ class Transformer {
      */
     uint32_t countRemainingPipelineStages() const;
 
+    /**
+     * @brief Checks whether this or a following stage raised an urgent event during the
+     * previous call to applyTransformations and clears the events
+     *
+     * @return true if an urgent event was raised
+     */
+    bool takeUrgentEvent();
+
    protected:
     /**
      * Applies the implemented transformation to the given input
@@ -50,10 +58,19 @@ class Transformer {
      */
     virtual float_t transform(float_t input) = 0;
 
+    /**
+     * Marks the current output as urgent, e.g. because an alarm condition started or ended.
+     * Urgent outputs are published ahead of the routine telemetry.
+     */
+    inline void raiseUrgentEvent() { m_urgentEvent = true; }
+
     /**
      * Next step in transformation pipeline
      */
     std::shared_ptr<Transformer> m_next;
+
+   private:
+    bool m_urgentEvent = false;
 };
 
 #endif  // TRANSFORMER_H
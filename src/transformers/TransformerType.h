@@ -0,0 +1,65 @@
+#ifndef TRANSFORMER_TYPE_H
+#define TRANSFORMER_TYPE_H
+#include <memory>
+
+#include "Transformer.h"
+#include "config/ConfigParams.h"
+#include "config/TypeTable.h"
+
+/**
+ * @brief Number of slots of the transformer type table. At most half of them can be used
+ */
+#define TRANSFORMER_TYPE_TABLE_SIZE (32)
+
+/**
+ * @brief Creates a transformer from its checked parameters
+ *
+ * @param params [IN] Parameters according to the schema of the type
+ * @return std::shared_ptr<Transformer> Created transformer or nullptr if a parameter value is invalid
+ */
+typedef std::shared_ptr<Transformer> (*TransformerConstructor_t)(const ConfigParams& params);
+
+/**
+ * @brief Describes a transformer type which can be created from the sensor config file
+ */
+typedef struct {
+    /**
+     * @brief Type name in the config file
+     */
+    const char* name;
+    /**
+     * @brief constHash of name
+     */
+    uint32_t nameHash;
+    const ConfigParam_t* params;
+    uint32_t paramCount;
+    TransformerConstructor_t create;
+} TransformerType_t;
+
+/**
+ * @brief All transformer types which registered themselves with REGISTER_TRANSFORMER_TYPE
+ */
+typedef TypeTable<TransformerType_t, TRANSFORMER_TYPE_TABLE_SIZE> TransformerTypes;
+
+/**
+ * @brief Adds a transformer type to TransformerTypes during static initialization
+ */
+class TransformerTypeRegistration {
+   public:
+    explicit TransformerTypeRegistration(const TransformerType_t& type) { TransformerTypes::add(type); }
+};
+
+/**
+ * @brief Registers a transformer type under the name typeName. Has to be used once in the
+ * source file of the type, outside of any function.
+ *
+ * @param typeName Name of the type in the config file, without quotes
+ * @param params Array of ConfigParam_t with the parameters of the type
+ * @param constructor TransformerConstructor_t which creates the transformer
+ */
+#define REGISTER_TRANSFORMER_TYPE(typeName, params, constructor)                                          \
+    static const TransformerType_t typeName##_transformerType = {#typeName, constHash(#typeName), params, \
+                                                                 ARRAY_SIZE(params), constructor};        \
+    static const TransformerTypeRegistration typeName##_transformerTypeRegistration(typeName##_transformerType)
+
+#endif  // TRANSFORMER_TYPE_H
@@ -9,6 +9,7 @@
 #include "esp_task_wdt.h"
 #include "filesystem/Filesystem.h"
 #include "global_objects.h"
+#include "helper_functions.h"
 #include "webserver_helpers.h"
 
 AsyncWebServer server(80);
@@ -18,18 +19,63 @@ void notFound(AsyncWebServerRequest* request) { request->send(404, "text/plain",
 void sensorEndpointSetup() {
     /**
      * If no get parameters are passed, give last sensor value.
-     * If a from and to parameter are passed, return a range of values.
+     * If a name parameter is passed, only give the last value of that sensor.
+     * If a from and to parameter are passed, return a range of values of the sensor given by name.
+     * from and to are uptimes in ms, values of zero or below are relative to now.
+     * The optional points parameter limits the number of returned values.
      * If sampleCount is passed as a parameter, return the total number of available samples
      */
     server.on("/api/sensors", HTTP_GET, [](AsyncWebServerRequest* request) {
 #if ENABLE_WEBSERVER_REQUEST_LOGGING
         Serial.println("Webserver: Sensor data request received");
 #endif  // ENABLE_WEBSERVER_REQUEST_LOGGING
+        if(request->hasParam("from") || request->hasParam("to")) {
+            // range based data request
+            int32_t from, to;
+            const std::shared_ptr<const SensorRegistry> registry = getSensors();
+            const Sensor* s = request->hasParam("name") ? registry->find(request->getParam("name")->value().c_str())
+                                                        : nullptr;
+            if(s == nullptr || !getFromToIndices(request, from, to)) {
+                request->send(400);
+                return;
+            }
+            int32_t points = HISTORY_DEFAULT_QUERY_POINTS;
+            if(request->hasParam("points") && !paramToInt(request->getParam("points"), points)) {
+                request->send(400);
+                return;
+            }
+            if(points < 3) points = 3;
+            if(points > HISTORY_MAX_QUERY_POINTS) points = HISTORY_MAX_QUERY_POINTS;
+
+            if(s->getHistory() == nullptr) {
+                request->send(404, "text/plain", "No history available");
+                return;
+            }
+
+            AsyncResponseStream* response = request->beginResponseStream("application/json");
+            getSensorHistory(response, *s, from, to, points);
+            request->send(response);
+            return;
+        }
+
         DynamicJsonDocument doc(DYNAMIC_JSON_DOCUMENT_SIZE);
         JsonObject obj = doc.to<JsonObject>();
 
-        // Fill JSON object with sensor data
-        getCurrentSensorData(obj);
+        if(request->hasParam("sampleCount")) {
+            // number of stored samples per history tier
+            const std::shared_ptr<const SensorRegistry> registry = getSensors();
+            for(const std::shared_ptr<Sensor>& s : *registry) {
+                addSensorSampleCount(obj, *s);
+            }
+        } else if(request->hasParam("name")) {
+            AsyncWebParameter* nameParam = request->getParam("name");
+            if(!getCurrentSensorData(obj, nameParam->value().c_str())) {
+                request->send(404, "text/plain", "Unknown sensor");
+                return;
+            }
+        } else {
+            getCurrentSensorData(obj);
+        }
 
         // Serialize JSON response and send it
         AsyncResponseStream* response = request->beginResponseStream("application/json");
@@ -73,6 +119,27 @@ void logEndpointSetup() {
     });
 }
 
+typedef struct {
+    const char* name;
+    Setting_t setting;
+} SettingParam_t;
+
+// POST parameters of /api/system which change settings
+static const SettingParam_t settingParams[] = {
+    {"ssid", SETTING_WIFI_SSID},
+    {"wifiPassword", SETTING_WIFI_PASSWORD},
+    {"hostname", SETTING_WIFI_HOSTNAME},
+    {"brokerAddress", SETTING_MQTT_BROKER_ADDRESS},
+    {"brokerPort", SETTING_MQTT_BROKER_PORT},
+    {"username", SETTING_MQTT_USERNAME},
+    {"mqttPassword", SETTING_MQTT_PASSWORD},
+    {"clientID", SETTING_MQTT_CLIENT_ID},
+    {"deviceTopic", SETTING_MQTT_DEVICE_TOPIC},
+    {"publishMode", SETTING_MQTT_PUBLISH_MODE},
+    {"outboxDrop", SETTING_MQTT_OUTBOX_DROP},
+    {"payloadFormat", SETTING_MQTT_PAYLOAD_FORMAT},
+};
+
 void systemEndpointSetup() {
     // System setting changes
     server.on("/api/system", HTTP_POST, [](AsyncWebServerRequest* request) {
@@ -82,72 +149,28 @@ void systemEndpointSetup() {
         // check for post parameter time
 
         // Parameter handling
+        // Settings are only counted as changed if their value differs, since the
+        // web interface always submits all of them
+        uint32_t receivedSettingCount = 0;
         uint32_t changedSettingCount = 0;
-        if(request->hasParam("ssid", true)) {
-            AsyncWebParameter* p = request->getParam("ssid", true);
-            strcpy(settings.wifi.ssid, p->value().c_str());
-            ramLogger.logLnf("Updated SSID to %s", p->value().c_str());
-            changedSettingCount++;
-        }
-        if(request->hasParam("wifiPassword", true)) {
-            AsyncWebParameter* p = request->getParam("wifiPassword", true);
-            strcpy(settings.wifi.password, p->value().c_str());
-            // write to non-volatile storage
-            preferences.putString("WIFI_Password", p->value().c_str());
-            ramLogger.logLn("Updated WiFi password");
-            changedSettingCount++;
-        }
-        if(request->hasParam("hostname", true)) {
-            AsyncWebParameter* p = request->getParam("hostname", true);
-            strcpy(settings.wifi.hostname, p->value().c_str());
-            ramLogger.logLnf("Updated hostname to %s", p->value().c_str());
-            changedSettingCount++;
-        }
-        if(request->hasParam("brokerAddress", true)) {
-            AsyncWebParameter* p = request->getParam("brokerAddress", true);
-            strcpy(settings.mqtt.brokerAddress, p->value().c_str());
-            ramLogger.logLnf("Updated broker address to %s", p->value().c_str());
-            changedSettingCount++;
-        }
-        if(request->hasParam("brokerPort", true)) {
-            AsyncWebParameter* p = request->getParam("brokerPort", true);
-
-            int32_t port = 0;
-            // make sure that the port parameter is numeric
-            if(paramToInt(p, port)) {
-                settings.mqtt.brokerPort = port;
-                ramLogger.logLnf("Updated broker port to %u", port);
-                changedSettingCount++;
-            }
-        }
-        if(request->hasParam("username", true)) {
-            AsyncWebParameter* p = request->getParam("username", true);
-            strcpy(settings.mqtt.username, p->value().c_str());
-            ramLogger.logLnf("Updated username to %s", p->value().c_str());
-            changedSettingCount++;
-        }
-        if(request->hasParam("mqttPassword", true)) {
-            AsyncWebParameter* p = request->getParam("mqttPassword", true);
-            strcpy(settings.mqtt.password, p->value().c_str());
-            // write to non-volatile storage
-            preferences.putString("MQTT_Password", p->value().c_str());
-            ramLogger.logLn("Updated MQTT password");
-            changedSettingCount++;
-        }
-        if(request->hasParam("clientID", true)) {
-            AsyncWebParameter* p = request->getParam("clientID", true);
-            strcpy(settings.mqtt.clientID, p->value().c_str());
-            ramLogger.logLnf("Updated clientID to %s", p->value().c_str());
-            changedSettingCount++;
-        }
-        if(request->hasParam("deviceTopic", true)) {
-            AsyncWebParameter* p = request->getParam("deviceTopic", true);
-            strcpy(settings.mqtt.deviceTopic, p->value().c_str());
-            ramLogger.logLnf("Updated deviceTopic to %s", p->value().c_str());
+        // The sensor config is reloaded at runtime and doesn't require a restart
+        bool sensorConfigChanged = false;
+        for(const SettingParam_t& param : settingParams) {
+            if(!request->hasParam(param.name, true)) continue;
+            AsyncWebParameter* p = request->getParam(param.name, true);
+            bool changed = false;
+            if(RC_SUCCESS != settingsStore.set(param.setting, p->value().c_str(), getUptimeMs(), &changed)) continue;
+            receivedSettingCount++;
+            if(!changed) continue;
+            if(isSecretSetting(param.setting))
+                ramLogger.logLnf("Updated %s", getSettingKey(param.setting));
+            else
+                ramLogger.logLnf("Updated %s to %s", getSettingKey(param.setting), p->value().c_str());
             changedSettingCount++;
         }
         if(request->hasParam("sensorConfig", true)) {
             AsyncWebParameter* p = request->getParam("sensorConfig", true);
+            // Waits if the loop task is currently reading the config or flushing the sample log
             if(RC_SUCCESS == filesystem->openFile(SENSOR_CFG_FILENAME, Filesystem::WRITE_TRUNCATE)) {
                 const char* text = p->value().c_str();
                 // listAllParams(request);
@@ -159,38 +182,36 @@ void systemEndpointSetup() {
                 filesystem->write((uint8_t*)text, textLen);
                 filesystem->closeFile();
                 ramLogger.logLnf("Updated sensor settings file (%u characters written)", textLen);
-                changedSettingCount++;
+                sensorConfigChanged = true;
             } else
                 ramLogger.logLn("Failed to update sensor config file");
         }
 
-        // If any settings were changed, write them back and reboot
-        if(changedSettingCount > 0) {
-            RC_t err = writeToSettingsFile(CONFIG_FILENAME, settings);
-            if(RC_SUCCESS != err)
-                ramLogger.logLnf("Failed to write settings file, Error Code=%i", err);
-            else {
-                // Short delay to finish printing potential debug messages
-                ramLogger.logLnf("%u settings changed. Restarting system in 3 seconds", changedSettingCount);
-                delay(3000);
-                ESP.restart();
-            }
+        // Let the sensor polling task build the new sensors. Settings changes below
+        // restart the system anyway, in which case the new config is read on startup.
+        if(sensorConfigChanged) {
+            sensorConfigReloadRequested = true;
+            ramLogger.logLn("Sensor config will be reloaded with the next sensor polling cycle");
         }
 
-        // Check this parameter last as it will stop code execution after it
+        // Changed settings are written by the settings store together with changes of following
+        // requests. The system restarts once they are written
+        if(changedSettingCount > 0)
+            ramLogger.logLnf("%u settings changed. Restarting system once they are saved", changedSettingCount);
+
+        // Check this parameter last as it answers the request. The loop task restarts the system
+        // after it saved the settings which are still waiting for their write delay
         if(request->hasParam("restart", true)) {
-            // Restart system
             request->send(200);
-            ramLogger.logLn("Restarting system in 5 seconds");
-            vTaskDelay(5000 / portTICK_PERIOD_MS);
-            ESP.restart();
+            restartRequested = true;
+            return;
         }
 
         // Reply
         if(request->args() == 0) {  // no arguments were received
             ramLogger.logLn("Received /api/system POST request without parameters");
             request->send(400, "text/plain", "POST request without parameters");
-        } else if(changedSettingCount == 0) {
+        } else if(receivedSettingCount == 0 && !sensorConfigChanged) {
             // some arguments were received but no settings updated
             // due to wrong parameters
             ramLogger.logLn("Invalid POST request parameters");
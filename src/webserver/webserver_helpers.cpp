@@ -3,6 +3,8 @@
 #include "cfg.h"
 #include "filesystem/Filesystem.h"
 #include "global_objects.h"
+#include "helper_functions.h"
+#include "mqtt.h"
 
 void listAllParams(const AsyncWebServerRequest* request) {
     // List all parameters
@@ -101,7 +103,8 @@ bool getFromToIndices(const AsyncWebServerRequest* const request, int32_t& fromI
 }
 
 void getSystemInfo(AsyncResponseStream* response) {
-    DynamicJsonDocument doc(DYNAMIC_JSON_DOCUMENT_SIZE);
+    const std::shared_ptr<const SensorRegistry> registry = getSensors();
+    DynamicJsonDocument doc(DYNAMIC_JSON_DOCUMENT_SIZE + registry->size() * SYSTEM_INFO_JSON_SIZE_PER_SENSOR);
     JsonObject root = doc.to<JsonObject>();
 
     // WiFi
@@ -125,16 +128,86 @@ void getSystemInfo(AsyncResponseStream* response) {
     wifiObj["TX Power"] = WiFi.getTxPower();
     wifiObj["RSSI"] = WiFi.RSSI();
 
+    // I2C bus usage
+    const I2cBusMetrics_t i2c = i2cBusManager.getMetrics();
+    JsonObject i2cObj = root.createNestedObject("I2C");
+    i2cObj["Devices"] = i2cBusManager.getDeviceCount();
+    i2cObj["Transactions"] = i2c.transactions;
+    i2cObj["Errors"] = i2c.errors;
+    i2cObj["Bytes"] = i2c.bytes;
+    i2cObj["Utilization %"] = (i2c.elapsedUs > 0) ? 100.0 * i2c.busyUs / i2c.elapsedUs : 0.0;
+
+    // Connection to the broker and messages waiting for the MQTT task
+    const MqttConnectionMetrics_t connection = mqttConnection.getMetrics();
+    const MqttOutboxMetrics_t outbox = mqttOutbox.getMetrics();
+    JsonObject mqttObj = root.createNestedObject("MQTT");
+    mqttObj["State"] = MqttConnection::stateToString(mqttConnection.getState());
+    mqttObj["State Changes"] = connection.transitions;
+    mqttObj["Connects"] = connection.connects;
+    mqttObj["Failed Attempts"] = connection.failedAttempts;
+    mqttObj["Connection Losses"] = connection.connectionLosses;
+    mqttObj["Last Reconnect ms"] = connection.lastReconnectMs;
+    mqttObj["Max Reconnect ms"] = connection.maxReconnectMs;
+    mqttObj["Backoff ms"] = connection.backoffMs;
+    mqttObj["Outbox Depth"] = outbox.depth;
+    mqttObj["Outbox Bytes"] = outbox.bytes;
+    mqttObj["Outbox Max Depth"] = outbox.maxDepth;
+    mqttObj["Outbox Dropped"] = outbox.dropped;
+    mqttObj["Published"] = outbox.published;
+
+    // Flash writes of the settings since startup
+    JsonObject settingsObj = root.createNestedObject("Settings");
+    settingsObj["File writes"] = settingsStore.getFileWriteCount();
+    settingsObj["NVS writes"] = settingsStore.getNvsWriteCount();
+
+    // Read timing and fault counters of each sensor
+    JsonObject sensorsObj = root.createNestedObject("Sensors");
+    for(const std::shared_ptr<Sensor>& s : *registry) {
+        const SensorHealth& health = s->getHealth();
+        JsonObject sensorObj = sensorsObj.createNestedObject(s->getName());
+        sensorObj["Degraded"] = health.isDegraded();
+        sensorObj["Reads"] = health.getReadCount();
+        sensorObj["Failures"] = health.getFailureCount();
+        sensorObj["Overruns"] = health.getOverrunCount();
+        sensorObj["Consecutive Faults"] = health.getConsecutiveFaults();
+        sensorObj["Last Read Time us"] = health.getLastDurationUs();
+        sensorObj["Max Read Time us"] = health.getMaxDurationUs();
+        sensorObj["Time Budget us"] = health.getBudgetUs();
+        sensorObj["Backoff ms"] = health.getBackoffMs();
+        sensorObj["Sample Interval ms"] = s->getSampleIntervalMs();
+    }
+
     // serialize json
     serializeJson(doc, *response);
 }
 
+void addSensorData(JsonObject& obj, const Sensor& s) {
+    // Only the cached sample is used so that requests never wait for sensor hardware
+    // The value is formatted like in the MQTT payloads and copied into the document as raw JSON
+    SensorSample_t sample;
+    char valueStr[FLOAT_FORMAT_BUFFER_SIZE] = "";
+    if(s.getLatestSample(sample) && isfinite(sample.value) &&
+       RC_SUCCESS == formatFloat(valueStr, sizeof(valueStr), sample.value, s.getDecimals()))
+        obj[s.getName()] = serialized(static_cast<char*>(valueStr));
+    else
+        obj[s.getName()] = nullptr;
+}
+
 void getCurrentSensorData(JsonObject& obj) {
-    for(Sensor* s : sensors) {
-        obj[s->getName()] = s->readSensor();
+    const std::shared_ptr<const SensorRegistry> registry = getSensors();
+    for(const std::shared_ptr<Sensor>& s : *registry) {
+        addSensorData(obj, *s);
     }
 }
 
+bool getCurrentSensorData(JsonObject& obj, const char name[]) {
+    const std::shared_ptr<const SensorRegistry> registry = getSensors();
+    const Sensor* s = registry->find(name);
+    if(s == nullptr) return false;
+    addSensorData(obj, *s);
+    return true;
+}
+
 void getConfig(AsyncResponseStream* response) {
     DynamicJsonDocument doc(DYNAMIC_JSON_DOCUMENT_SIZE);
     JsonObject root = doc.to<JsonObject>();
@@ -146,7 +219,95 @@ void getConfig(AsyncResponseStream* response) {
     root["username"] = settings.mqtt.username;
     root["deviceTopic"] = settings.mqtt.deviceTopic;
     root["clientID"] = settings.mqtt.clientID;
+    char publishMode[SETTINGS_MAX_VALUE_LENGTH] = "";
+    getSetting(settings, SETTING_MQTT_PUBLISH_MODE, publishMode, sizeof(publishMode));
+    root["publishMode"] = publishMode;
+    char outboxDrop[SETTINGS_MAX_VALUE_LENGTH] = "";
+    getSetting(settings, SETTING_MQTT_OUTBOX_DROP, outboxDrop, sizeof(outboxDrop));
+    root["outboxDrop"] = outboxDrop;
+    char payloadFormat[SETTINGS_MAX_VALUE_LENGTH] = "";
+    getSetting(settings, SETTING_MQTT_PAYLOAD_FORMAT, payloadFormat, sizeof(payloadFormat));
+    root["payloadFormat"] = payloadFormat;
 
     // serialize json
     serializeJson(doc, *response);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Converts a from/to request parameter into an uptime in ms.
+ * Values of zero or below are relative to the current uptime.
+ */
+static uint32_t relativeToUptime(int32_t t, uint32_t now) {
+    if(t > 0) return t;
+    if(static_cast<uint32_t>(-t) > now) return 0;
+    return now + t;
+}
+
+/**
+ * @brief Formats a history value for JSON. Non-finite values become null
+ *
+ * @param str [OUT] At least FLOAT_FORMAT_BUFFER_SIZE characters
+ * @param value [IN]
+ * @param decimals [IN]
+ */
+static void formatJsonValue(char str[FLOAT_FORMAT_BUFFER_SIZE], float_t value, uint8_t decimals) {
+    if(!isfinite(value) || RC_SUCCESS != formatFloat(str, FLOAT_FORMAT_BUFFER_SIZE, value, decimals))
+        strcpy(str, "null");
+}
+
+/**
+ * @brief Writes a JSON string with quotes, backslashes and control characters escaped
+ */
+static void printJsonString(AsyncResponseStream* response, const char str[]) {
+    response->print('"');
+    for(const char* c = str; *c != '\0'; c++) {
+        if(*c == '"' || *c == '\\')
+            response->printf("\\%c", *c);
+        else if(static_cast<uint8_t>(*c) < 0x20)
+            response->printf("\\u%04x", static_cast<uint8_t>(*c));
+        else
+            response->print(*c);
+    }
+    response->print('"');
+}
+
+bool getSensorHistory(AsyncResponseStream* response, const Sensor& s, int32_t from, int32_t to, uint32_t points) {
+    const SensorHistory* history = s.getHistory();
+    if(history == nullptr) return false;
+
+    const uint32_t now = getUptimeMs();
+    const uint32_t fromMs = relativeToUptime(from, now);
+    const uint32_t toMs = relativeToUptime(to, now);
+
+    // The points are written to the response directly instead of building a
+    // JsonDocument first, which would limit the number of points to DYNAMIC_JSON_DOCUMENT_SIZE
+    response->print("{\"name\":");
+    printJsonString(response, s.getName());
+    response->printf(",\"now\":%u,\"values\":[", now);
+    bool firstPoint = true;
+    SensorHistory::Tier_t tier;
+    history->query(
+        fromMs, toMs, points,
+        [&](const HistoryPoint_t& p) {
+            char value[FLOAT_FORMAT_BUFFER_SIZE];
+            char min[FLOAT_FORMAT_BUFFER_SIZE];
+            char max[FLOAT_FORMAT_BUFFER_SIZE];
+            formatJsonValue(value, p.value, s.getDecimals());
+            formatJsonValue(min, p.min, s.getDecimals());
+            formatJsonValue(max, p.max, s.getDecimals());
+            response->printf("%s[%u,%s,%s,%s]", firstPoint ? "" : ",", p.timestamp, value, min, max);
+            firstPoint = false;
+        },
+        tier);
+    response->printf("],\"tier\":\"%s\"}", SensorHistory::tierToString(tier));
+    return true;
+}
+
+void addSensorSampleCount(JsonObject& obj, const Sensor& s) {
+    const SensorHistory* history = s.getHistory();
+    JsonObject counts = obj.createNestedObject(s.getName());
+    for(uint32_t t = 0; t < SensorHistory::TIER_COUNT; t++) {
+        const SensorHistory::Tier_t tier = static_cast<SensorHistory::Tier_t>(t);
+        counts[SensorHistory::tierToString(tier)] = (history != nullptr) ? history->size(tier) : 0;
+    }
+}
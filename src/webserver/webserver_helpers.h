@@ -6,6 +6,7 @@
 #include <WiFi.h>
 
 #include "global.h"
+#include "sensors/Sensor.h"
 
 /**
  * @brief Prints out all parameters in a request to serial
@@ -74,11 +75,54 @@ void getSystemInfo(AsyncResponseStream* response);
 void getConfig(AsyncResponseStream* response);
 
 /**
- * @brief Creates a JSON string containing sensor values which are read freshly
- * from the sensors.
+ * @brief Creates a JSON string containing the latest cached value of every sensor.
+ * Does not access the sensor hardware. Sensors which have not been sampled yet are set to null.
  *
  * @param obj [INOUT] JsonObject to which the current sensor values will be added
  */
 void getCurrentSensorData(JsonObject& obj);
 
+/**
+ * @brief Same as getCurrentSensorData but only adds the sensor with the given name
+ *
+ * @param obj [INOUT] JsonObject to which the current sensor value will be added
+ * @param name [IN] Name of the sensor
+ * @return true Sensor was found
+ * @return false No sensor with this name exists
+ */
+bool getCurrentSensorData(JsonObject& obj, const char name[]);
+
+/**
+ * @brief Adds the latest cached value of a single sensor to the given JSON object
+ * under the name of the sensor
+ *
+ * @param obj [INOUT] JsonObject to add the value to
+ * @param s [IN] Sensor
+ */
+void addSensorData(JsonObject& obj, const Sensor& s);
+
+/**
+ * @brief Creates a JSON string containing the history of a sensor within the given range
+ * and saves it in the response stream. The points are returned as
+ * [timestamp, value, min, max] arrays together with the tier they were taken from.
+ * Timestamps are the uptime in ms.
+ *
+ * @param response [OUT] Output response stream which will save the JSON string
+ * @param s [IN] Sensor
+ * @param from [IN] Start of the range. Values of zero or below are relative to the current uptime
+ * @param to [IN] End of the range. Values of zero or below are relative to the current uptime
+ * @param points [IN] Maximum number of points. Larger ranges are downsampled.
+ * @return true Success
+ * @return false The sensor has no history
+ */
+bool getSensorHistory(AsyncResponseStream* response, const Sensor& s, int32_t from, int32_t to, uint32_t points);
+
+/**
+ * @brief Adds the number of stored history entries per tier of a sensor to the given JSON object
+ *
+ * @param obj [INOUT] JsonObject to add the counts to
+ * @param s [IN] Sensor
+ */
+void addSensorSampleCount(JsonObject& obj, const Sensor& s);
+
 #endif  // WEBSERVER_HELPERS_H
\ No newline at end of file
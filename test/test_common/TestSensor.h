@@ -0,0 +1,20 @@
+#ifndef TEST_SENSOR_H
+#define TEST_SENSOR_H
+#include "sensors/Sensor.h"
+
+/**
+ * @brief Sensor for tests which returns an incrementing sequence of raw values
+ * and counts how often it was read
+ */
+class SequenceSensor : public Sensor {
+   public:
+    SequenceSensor(char name[], std::shared_ptr<Transformer> transformer = nullptr) : Sensor(name, transformer) {}
+    float_t readSensorRaw() override {
+        readCount++;
+        return nextValue++;
+    }
+    float_t nextValue = 0;
+    uint32_t readCount = 0;
+};
+
+#endif  // TEST_SENSOR_H
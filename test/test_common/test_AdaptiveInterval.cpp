@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include "TestSensor.h"
+#include "sensors/AdaptiveInterval.h"
+#include "transformers/Remapper.h"
+
+TEST(AdaptiveInterval, GrowsWhileQuietAndDropsOnChange) {
+    AdaptiveInterval adaptive(100, 1000, 1.0f, 0.0f);
+    uint32_t now = 0;
+    EXPECT_EQ(adaptive.update(20.0f, now), 100);
+
+    // Constant signal: the interval grows by the growth factor up to the maximum
+    uint32_t previous = 100;
+    for(uint32_t i = 0; i < 20; i++) {
+        now += adaptive.getIntervalMs();
+        const uint32_t interval = adaptive.update(20.0f, now);
+        EXPECT_GE(interval, previous);
+        EXPECT_LE(interval, 1000);
+        previous = interval;
+    }
+    EXPECT_EQ(adaptive.getIntervalMs(), 1000);
+
+    // 2 per second is above the rate threshold
+    now += 1000;
+    EXPECT_EQ(adaptive.update(22.0f, now), 100);
+    EXPECT_FLOAT_EQ(adaptive.getRate(), 2.0f);
+    // 0.5 per second is not
+    now += 100;
+    EXPECT_GT(adaptive.update(22.05f, now), 100);
+}
+
+TEST(AdaptiveInterval, VarianceThreshold) {
+    AdaptiveInterval adaptive(100, 800, 0.0f, 0.5f);
+    uint32_t now = 0;
+    for(uint32_t i = 0; i < 10; i++, now += 100) adaptive.update(5.0f, now);
+    EXPECT_EQ(adaptive.getIntervalMs(), 800);
+    EXPECT_FLOAT_EQ(adaptive.getVariance(), 0.0f);
+
+    // Alternating values are noisy without a trend
+    for(uint32_t i = 0; i < 10; i++, now += 100) adaptive.update((i % 2) ? 3.0f : 7.0f, now);
+    EXPECT_GT(adaptive.getVariance(), 0.5f);
+    EXPECT_EQ(adaptive.getIntervalMs(), 100);
+}
+
+TEST(AdaptiveInterval, SensorUsesTransformerOutput) {
+    char name[] = "Adaptive";
+    // Raw values rise by 1 per read, which the remapper scales down to 0.01
+    SequenceSensor sensor(name, std::make_shared<Remapper>(0.0f, 100.0f, 0.0f, 1.0f));
+    sensor.setCadence(100, 2000, 0);
+    sensor.setAdaptiveInterval(std::unique_ptr<AdaptiveInterval>(new AdaptiveInterval(100, 2000, 0.2f, 0.0f)));
+    EXPECT_EQ(sensor.getSampleIntervalMs(), 100);
+
+    uint32_t now = 0;
+    for(; now < 20000; now += 10) sensor.sampleIfDue(now);
+    EXPECT_EQ(sensor.getSampleIntervalMs(), 2000);
+    // A fixed 100ms interval would have taken 200 samples
+    EXPECT_LT(sensor.readCount, 30);
+
+    // A jump in the raw value is seen through the pipeline
+    sensor.nextValue = 100;
+    now += 2000;
+    ASSERT_TRUE(sensor.sampleIfDue(now));
+    EXPECT_EQ(sensor.getSampleIntervalMs(), 100);
+    EXPECT_FALSE(sensor.isSampleDue(now + 99));
+    EXPECT_TRUE(sensor.isSampleDue(now + 100));
+}
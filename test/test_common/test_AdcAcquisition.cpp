@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include "adc/AdcAcquisition.h"
+#include "adc/Decimator.h"
+#include "adc/FakeSampleSource.h"
+#include "sensors/Sensor.h"
+#include "transformers/SimpleMovingAverageFilter.h"
+
+TEST(DecimatorTest, AveragesBlocks) {
+    Decimator decimator(4);
+    const uint16_t input[] = {1, 2, 3, 4, 10, 10, 10, 11, 7};
+    float_t output = 0;
+    std::vector<float_t> outputs;
+    for(uint16_t sample : input) {
+        if(decimator.push(sample, output)) outputs.push_back(output);
+    }
+    ASSERT_EQ(outputs.size(), 2u);
+    EXPECT_FLOAT_EQ(outputs[0], 2.5f);
+    // Fractional part keeps the additional resolution
+    EXPECT_FLOAT_EQ(outputs[1], 10.25f);
+
+    // The partial block is discarded
+    decimator.reset();
+    for(uint32_t i = 0; i < 3; i++) EXPECT_FALSE(decimator.push(100, output));
+    EXPECT_TRUE(decimator.push(100, output));
+    EXPECT_FLOAT_EQ(output, 100.0f);
+
+    Decimator passThrough(0);
+    EXPECT_EQ(passThrough.getFactor(), 1u);
+    EXPECT_TRUE(passThrough.push(42, output));
+    EXPECT_FLOAT_EQ(output, 42.0f);
+}
+
+TEST(AdcAcquisitionTest, OpenAndCloseChannels) {
+    FakeSampleSource source;
+    AdcAcquisition acquisition(source, 1000);
+    EXPECT_EQ(acquisition.poll(0), RC_ERROR_INVALID_STATE);
+    EXPECT_EQ(acquisition.openChannel(ADC_MAX_CHANNELS, 1), nullptr);
+
+    std::shared_ptr<AdcAcquisition::Channel> a = acquisition.openChannel(2, 1);
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(source.getChannelMask(), 0x4u);
+    EXPECT_EQ(source.getSampleRateHz(), 1000u);
+    // A channel can only be used by one sensor
+    EXPECT_EQ(acquisition.openChannel(2, 4), nullptr);
+    EXPECT_EQ(source.getChannelMask(), 0x4u);
+
+    std::shared_ptr<AdcAcquisition::Channel> b = acquisition.openChannel(5, 1);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(source.getChannelMask(), 0x24u);
+    EXPECT_EQ(acquisition.getChannelSampleRateHz(), 500u);
+
+    a.reset();
+    EXPECT_EQ(source.getChannelMask(), 0x20u);
+    // Reopening the channel works once its previous user is gone
+    a = acquisition.openChannel(2, 1);
+    EXPECT_NE(a, nullptr);
+    a.reset();
+    b.reset();
+    EXPECT_EQ(source.getChannelMask(), 0u);
+    EXPECT_EQ(acquisition.poll(0), RC_ERROR_INVALID_STATE);
+}
+
+TEST(AdcAcquisitionTest, DemultiplexesAndDecimates) {
+    FakeSampleSource source;
+    AdcAcquisition acquisition(source);
+    std::shared_ptr<AdcAcquisition::Channel> fast = acquisition.openChannel(1, 1);
+    std::shared_ptr<AdcAcquisition::Channel> slow = acquisition.openChannel(3, 4);
+    ASSERT_NE(fast, nullptr);
+    ASSERT_NE(slow, nullptr);
+
+    uint16_t pattern[ADC_MAX_CHANNELS] = {};
+    for(uint16_t i = 0; i < 8; i++) {
+        pattern[1] = i;
+        pattern[3] = 1000 + i;
+        // Channel 0 is not started, so its samples never show up
+        pattern[0] = 9999;
+        source.pushPattern(pattern);
+    }
+    EXPECT_EQ(acquisition.poll(0), RC_SUCCESS);
+    EXPECT_EQ(acquisition.poll(0), RC_ERROR_BUFFER_EMPTY);
+
+    float_t values[ADC_CHANNEL_BUFFER_SIZE];
+    ASSERT_EQ(fast->read(values, ADC_CHANNEL_BUFFER_SIZE), 8u);
+    for(uint32_t i = 0; i < 8; i++) EXPECT_FLOAT_EQ(values[i], static_cast<float_t>(i));
+    ASSERT_EQ(slow->read(values, ADC_CHANNEL_BUFFER_SIZE), 2u);
+    EXPECT_FLOAT_EQ(values[0], 1001.5f);
+    EXPECT_FLOAT_EQ(values[1], 1005.5f);
+    // Values are only returned once
+    EXPECT_EQ(fast->read(values, ADC_CHANNEL_BUFFER_SIZE), 0u);
+}
+
+TEST(AdcAcquisitionTest, KeepsNewestValues) {
+    FakeSampleSource source;
+    AdcAcquisition acquisition(source);
+    std::shared_ptr<AdcAcquisition::Channel> channel = acquisition.openChannel(0, 1);
+    ASSERT_NE(channel, nullptr);
+
+    const uint32_t total = ADC_CHANNEL_BUFFER_SIZE + 10;
+    for(uint16_t i = 0; i < total; i++) source.push(0, &i, 1);
+    while(acquisition.poll(0) == RC_SUCCESS);
+    EXPECT_EQ(channel->getOverflowCount(), 10u);
+
+    // Only the newest values are returned if the buffer is smaller than the available values
+    float_t values[4];
+    ASSERT_EQ(channel->read(values, 4), 4u);
+    for(uint32_t i = 0; i < 4; i++) EXPECT_FLOAT_EQ(values[i], static_cast<float_t>(total - 4 + i));
+}
+
+/**
+ * @brief Sensor which delivers a fixed block of values per reading
+ */
+class BlockSensor : public Sensor {
+   public:
+    BlockSensor(char name[], std::shared_ptr<Transformer> transformer) : Sensor(name, transformer) {}
+    std::vector<float_t> block;
+
+   protected:
+    float_t readSensorRaw() override { return -1; }
+    uint32_t readSensorBlock(float_t values[], uint32_t maxCount) override {
+        uint32_t count = 0;
+        for(float_t v : block) {
+            if(count < maxCount) values[count++] = v;
+        }
+        return count;
+    }
+};
+
+TEST(AdcAcquisitionTest, SensorBlockPipeline) {
+    char name[] = "Block";
+    BlockSensor sensor(name, std::make_shared<SimpleMovingAverageFilter>(4));
+    // Every value of the block passes through the filter
+    sensor.block = {2, 4, 6, 8};
+    SensorSample_t sample = sensor.sample();
+    EXPECT_FLOAT_EQ(sample.rawValue, 8.0f);
+    EXPECT_FLOAT_EQ(sample.value, 5.0f);
+
+    // Without new values the sensor falls back to a single reading
+    sensor.block.clear();
+    sample = sensor.sample();
+    EXPECT_FLOAT_EQ(sample.rawValue, -1.0f);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include "sensors/DhtDecoder.h"
+
+// Answer of a DHT22 with 65.2 %RH and 23.1 °C: end of the start signal, response, 40 bits, end of frame
+static const DhtPulse_t recordedFrame[] = {
+    {23, 1}, {82, 0}, {86, 1}, {53, 0}, {24, 1}, {54, 0}, {28, 1}, {48, 0}, {23, 1}, {56, 0}, {23, 1}, {53, 0},
+    {27, 1}, {48, 0}, {27, 1}, {51, 0}, {68, 1}, {49, 0}, {26, 1}, {54, 0}, {68, 1}, {51, 0}, {23, 1}, {56, 0},
+    {26, 1}, {48, 0}, {29, 1}, {49, 0}, {69, 1}, {48, 0}, {72, 1}, {54, 0}, {23, 1}, {51, 0}, {23, 1}, {56, 0},
+    {29, 1}, {50, 0}, {25, 1}, {54, 0}, {24, 1}, {56, 0}, {23, 1}, {52, 0}, {27, 1}, {50, 0}, {23, 1}, {51, 0},
+    {25, 1}, {49, 0}, {27, 1}, {49, 0}, {72, 1}, {48, 0}, {72, 1}, {51, 0}, {71, 1}, {56, 0}, {26, 1}, {53, 0},
+    {26, 1}, {55, 0}, {70, 1}, {52, 0}, {69, 1}, {50, 0}, {73, 1}, {51, 0}, {23, 1}, {52, 0}, {72, 1}, {55, 0},
+    {70, 1}, {55, 0}, {70, 1}, {49, 0}, {23, 1}, {56, 0}, {71, 1}, {50, 0}, {29, 1}, {53, 0}, {69, 1}, {53, 0}};
+
+static const uint32_t recordedFrameLength = sizeof(recordedFrame) / sizeof(recordedFrame[0]);
+
+/**
+ * @brief Builds the pulses of an ideal frame with nominal timings
+ */
+static std::vector<DhtPulse_t> buildFrame(const uint8_t data[DHT_FRAME_BYTES]) {
+    std::vector<DhtPulse_t> pulses = {{80, 0}, {80, 1}};
+    for(uint32_t bit = 0; bit < DHT_FRAME_BYTES * 8; bit++) {
+        const bool one = data[bit / 8] & (0x80 >> (bit % 8));
+        pulses.push_back({50, 0});
+        pulses.push_back({static_cast<uint16_t>(one ? 70 : 27), 1});
+    }
+    pulses.push_back({50, 0});
+    return pulses;
+}
+
+TEST(DhtDecoderTest, RecordedFrame) {
+    uint8_t data[DHT_FRAME_BYTES];
+    EXPECT_EQ(dhtDecodePulses(recordedFrame, recordedFrameLength, data), RC_SUCCESS);
+    const uint8_t expected[DHT_FRAME_BYTES] = {0x02, 0x8C, 0x00, 0xE7, 0x75};
+    for(uint32_t i = 0; i < DHT_FRAME_BYTES; i++) EXPECT_EQ(data[i], expected[i]);
+
+    DhtReading_t reading;
+    EXPECT_EQ(dhtDecode(recordedFrame, recordedFrameLength, reading), RC_SUCCESS);
+    EXPECT_NEAR(reading.humidity, 65.2f, 1e-4f);
+    EXPECT_NEAR(reading.temperature, 23.1f, 1e-4f);
+}
+
+TEST(DhtDecoderTest, NegativeTemperature) {
+    // 45.0 %RH, -10.1 °C
+    const uint8_t data[DHT_FRAME_BYTES] = {0x01, 0xC2, 0x80, 0x65, 0xA8};
+    const std::vector<DhtPulse_t> pulses = buildFrame(data);
+    DhtReading_t reading;
+    EXPECT_EQ(dhtDecode(pulses.data(), pulses.size(), reading), RC_SUCCESS);
+    EXPECT_NEAR(reading.humidity, 45.0f, 1e-4f);
+    EXPECT_NEAR(reading.temperature, -10.1f, 1e-4f);
+}
+
+TEST(DhtDecoderTest, CorruptedFrames) {
+    DhtPulse_t pulses[recordedFrameLength];
+    DhtReading_t reading;
+
+    // Flipped bit: a 0 in the humidity became a 1
+    memcpy(pulses, recordedFrame, sizeof(recordedFrame));
+    pulses[4].durationUs = 70;
+    EXPECT_EQ(dhtDecode(pulses, recordedFrameLength, reading), RC_ERROR_CHECKSUM);
+
+    // Frame cut off in the middle
+    EXPECT_EQ(dhtDecode(recordedFrame, recordedFrameLength / 2, reading), RC_ERROR_BAD_DATA);
+    EXPECT_EQ(dhtDecode(recordedFrame, 0, reading), RC_ERROR_BAD_DATA);
+
+    // No response from the sensor
+    EXPECT_EQ(dhtDecode(recordedFrame + 3, recordedFrameLength - 3, reading), RC_ERROR_BAD_DATA);
+
+    // Pulse stretched by interference
+    memcpy(pulses, recordedFrame, sizeof(recordedFrame));
+    pulses[40].durationUs = 400;
+    EXPECT_EQ(dhtDecode(pulses, recordedFrameLength, reading), RC_ERROR_BAD_DATA);
+
+    // Glitch splitting a pulse shifts the levels of all following pulses
+    std::vector<DhtPulse_t> glitched(recordedFrame, recordedFrame + recordedFrameLength);
+    glitched.insert(glitched.begin() + 20, {2, 0});
+    EXPECT_EQ(dhtDecode(glitched.data(), glitched.size(), reading), RC_ERROR_BAD_DATA);
+
+    // Valid checksum, but humidity above 100 %
+    const uint8_t data[DHT_FRAME_BYTES] = {0x03, 0xF0, 0x00, 0xC8, 0xBB};
+    const std::vector<DhtPulse_t> outOfRange = buildFrame(data);
+    EXPECT_EQ(dhtDecode(outOfRange.data(), outOfRange.size(), reading), RC_ERROR_RANGE);
+}
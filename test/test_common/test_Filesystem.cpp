@@ -1,4 +1,9 @@
 #include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
 #ifdef ARDUINO
     #include "filesystem/LittleFilesystem.h"
 #else
@@ -60,4 +65,52 @@ TEST_F(FilesystemTest, DeleteFileTest) {
     fs.closeFile();
     ASSERT_TRUE(fs.fileExists(testFilename));
     EXPECT_EQ(fs.deleteFile(testFilename), RC_SUCCESS);
-}
\ No newline at end of file
+}
+TEST_F(FilesystemTest, OpenFileBelongsToOneTask) {
+    ASSERT_EQ(fs.openFile(testFilename, Filesystem::WRITE_TRUNCATE), RC_SUCCESS);
+    std::atomic<bool> closed{false};
+    // Another task can't close the file, it waits until the owner is done
+    std::thread other([&]() {
+        fs.closeFile();
+        closed = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(closed);
+    EXPECT_TRUE(fs.hasOpenFile());
+    const char data[] = "abc";
+    EXPECT_EQ(fs.write((uint8_t*)data, sizeof(data) - 1), RC_SUCCESS);
+    fs.closeFile();
+    other.join();
+    EXPECT_TRUE(closed);
+
+    ASSERT_EQ(fs.openFile(testFilename), RC_SUCCESS);
+    EXPECT_EQ(fs.size(), sizeof(data) - 1);
+    fs.closeFile();
+    fs.deleteFile(testFilename);
+}
+
+TEST_F(FilesystemTest, ConcurrentWriters) {
+    // Both tasks rewrite their own file. Neither may end up in the file of the other
+    const std::string otherFilename = std::string(testFilename) + "2";
+    auto writeFile = [this](const char filename[], char c) {
+        for(uint32_t i = 0; i < 50; i++) {
+            if(RC_SUCCESS != fs.openFile(filename, Filesystem::WRITE_TRUNCATE)) continue;
+            for(uint32_t j = 0; j < 16; j++) fs.write((const uint8_t*)&c, 1);
+            fs.closeFile();
+        }
+    };
+    std::thread other(writeFile, otherFilename.c_str(), 'b');
+    writeFile(testFilename, 'a');
+    other.join();
+
+    for(const std::pair<std::string, char>& f : {std::make_pair(std::string(testFilename), 'a'),
+                                                  std::make_pair(otherFilename, 'b')}) {
+        ASSERT_EQ(fs.openFile(f.first.c_str()), RC_SUCCESS);
+        char data[17] = {0};
+        EXPECT_EQ(fs.size(), 16);
+        fs.read((uint8_t*)data, 16);
+        fs.closeFile();
+        EXPECT_EQ(std::string(data), std::string(16, f.second));
+        fs.deleteFile(f.first.c_str());
+    }
+}
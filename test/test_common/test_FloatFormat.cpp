@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "helper_functions.h"
+
+/**
+ * @brief Expects formatFloat to give the same text as snprintf
+ */
+static void expectLikeSnprintf(float_t value, uint8_t decimals) {
+    char expected[64], actual[FLOAT_FORMAT_BUFFER_SIZE];
+    snprintf(expected, sizeof(expected), "%.*f", decimals, static_cast<double>(value));
+    uint32_t length = 0;
+    ASSERT_EQ(formatFloat(actual, sizeof(actual), value, decimals, &length), RC_SUCCESS);
+    EXPECT_STREQ(actual, expected) << "value " << value << ", " << static_cast<uint32_t>(decimals) << " decimals";
+    EXPECT_EQ(length, strlen(expected));
+}
+
+TEST(FloatFormat, Values) {
+    const float_t values[] = {0.0f,   -0.0f,    1.0f,     -1.0f,      0.5f,      1.5f,     2.5f,    -2.5f,
+                              0.125f, 0.375f,   21.45f,   3.14159f,   -40.05f,   1e-7f,    -1e-7f,  123456.789f,
+                              1e10f,  -4.2e12f, 1.8e19f,  FLT_MAX,    -FLT_MAX,  FLT_MIN,  65535.0f, 0.999999f};
+    for(float_t value : values) {
+        for(uint8_t decimals = 0; decimals <= FLOAT_FORMAT_MAX_DECIMALS; decimals++) {
+            expectLikeSnprintf(value, decimals);
+        }
+    }
+
+    // Random bit patterns over the whole range of finite floats
+    uint32_t rng = 12345;
+    for(uint32_t i = 0; i < 20000; i++) {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        float_t value;
+        memcpy(&value, &rng, sizeof(value));
+        if(!isfinite(value)) continue;
+        expectLikeSnprintf(value, rng % (FLOAT_FORMAT_MAX_DECIMALS + 1));
+    }
+}
+
+TEST(FloatFormat, Special) {
+    char str[FLOAT_FORMAT_BUFFER_SIZE];
+    EXPECT_EQ(formatFloat(str, sizeof(str), NAN), RC_SUCCESS);
+    EXPECT_STREQ(str, "nan");
+    EXPECT_EQ(formatFloat(str, sizeof(str), INFINITY), RC_SUCCESS);
+    EXPECT_STREQ(str, "inf");
+    EXPECT_EQ(formatFloat(str, sizeof(str), -INFINITY), RC_SUCCESS);
+    EXPECT_STREQ(str, "-inf");
+    EXPECT_EQ(formatFloat(str, sizeof(str), 1.0f, FLOAT_FORMAT_MAX_DECIMALS + 1), RC_ERROR_BAD_PARAM);
+}
+
+TEST(FloatFormat, BufferFull) {
+    char str[8];
+    // "-1.250" needs 7 bytes with null terminator
+    EXPECT_EQ(formatFloat(str, 7, -1.25f, 3), RC_SUCCESS);
+    EXPECT_STREQ(str, "-1.250");
+    EXPECT_EQ(formatFloat(str, 6, -1.25f, 3), RC_ERROR_BUFFER_FULL);
+    EXPECT_STREQ(str, "");
+    EXPECT_EQ(formatFloat(str, sizeof(str), 1e20f, 0), RC_ERROR_BUFFER_FULL);
+    EXPECT_STREQ(str, "");
+    EXPECT_EQ(formatFloat(str, 0, 1.0f), RC_ERROR_BUFFER_FULL);
+}
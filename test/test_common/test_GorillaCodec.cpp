@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+
+#include "codec/GorillaCodec.h"
+
+TEST(GorillaCodecTest, EmptyBlockTest) {
+    uint8_t block[64];
+    GorillaEncoder encoder(block, sizeof(block));
+    EXPECT_EQ(encoder.getCount(), 0u);
+    EXPECT_EQ(encoder.getSize(), static_cast<uint32_t>(GORILLA_BLOCK_HEADER_SIZE));
+
+    GorillaDecoder decoder(block, encoder.getSize());
+    uint32_t timestamp;
+    float_t value;
+    EXPECT_EQ(decoder.next(timestamp, value), RC_ERROR_BUFFER_EMPTY);
+}
+
+TEST(GorillaCodecTest, RegularIntervalTest) {
+    uint8_t block[256];
+    GorillaEncoder encoder(block, sizeof(block));
+    // Constant interval and value take 2 bits per sample after the first one
+    for(uint32_t i = 0; i < 100; i++) ASSERT_EQ(encoder.append(1000 + 10000 * i, 21.5f), RC_SUCCESS);
+    EXPECT_LT(encoder.getSize(), GORILLA_BLOCK_HEADER_SIZE + 4u + 5u + 100u * 2u / 8u + 2u);
+
+    GorillaDecoder decoder(block, encoder.getSize());
+    EXPECT_EQ(decoder.getCount(), 100u);
+    EXPECT_EQ(GorillaDecoder::getFirstTimestamp(block), 1000u);
+    for(uint32_t i = 0; i < 100; i++) {
+        uint32_t timestamp;
+        float_t value;
+        ASSERT_EQ(decoder.next(timestamp, value), RC_SUCCESS);
+        EXPECT_EQ(timestamp, 1000 + 10000 * i);
+        EXPECT_EQ(value, 21.5f);
+    }
+}
+
+TEST(GorillaCodecTest, IrregularDataTest) {
+    uint8_t block[4096];
+    GorillaEncoder encoder(block, sizeof(block));
+    // Covers all delta-of-delta ranges and value windows
+    const int32_t jitter[] = {0, 1, -1, 63, -63, 64, 200, -255, 256, 2000, -2047, 2048, 100000, -5000, 7};
+    uint32_t timestamps[200];
+    float_t values[200];
+    uint32_t t = 5;
+    for(uint32_t i = 0; i < 200; i++) {
+        t += 10000 + jitter[i % ARRAY_SIZE(jitter)];
+        timestamps[i] = t;
+        values[i] = (i % 17 == 0) ? -values[i > 0 ? i - 1 : 0] : 20.0f + sinf(i * 0.1f) * (i % 5) + 0.01f * i;
+        ASSERT_EQ(encoder.append(timestamps[i], values[i]), RC_SUCCESS);
+    }
+
+    GorillaDecoder decoder(block, encoder.getSize());
+    for(uint32_t pass = 0; pass < 2; pass++) {
+        for(uint32_t i = 0; i < 200; i++) {
+            uint32_t timestamp;
+            float_t value;
+            ASSERT_EQ(decoder.next(timestamp, value), RC_SUCCESS);
+            EXPECT_EQ(timestamp, timestamps[i]);
+            EXPECT_EQ(value, values[i]);
+        }
+        uint32_t timestamp;
+        float_t value;
+        EXPECT_EQ(decoder.next(timestamp, value), RC_ERROR_BUFFER_EMPTY);
+        decoder.rewind();
+    }
+}
+
+TEST(GorillaCodecTest, SpecialValuesTest) {
+    uint8_t block[256];
+    GorillaEncoder encoder(block, sizeof(block));
+    const float_t values[] = {0.0f, -0.0f, INFINITY, -INFINITY, 1e-40f, 3.4e38f, NAN, 1.0f};
+    for(uint32_t i = 0; i < ARRAY_SIZE(values); i++) ASSERT_EQ(encoder.append(i, values[i]), RC_SUCCESS);
+
+    GorillaDecoder decoder(block, encoder.getSize());
+    for(uint32_t i = 0; i < ARRAY_SIZE(values); i++) {
+        uint32_t timestamp;
+        float_t value;
+        ASSERT_EQ(decoder.next(timestamp, value), RC_SUCCESS);
+        EXPECT_EQ(timestamp, i);
+        // Compare bit patterns so that NaN and signed zero are checked as well
+        EXPECT_EQ(memcmp(&value, &values[i], sizeof(value)), 0);
+    }
+}
+
+TEST(GorillaCodecTest, BlockFullTest) {
+    uint8_t block[32];
+    GorillaEncoder encoder(block, sizeof(block));
+    uint32_t n = 0;
+    while(encoder.append(n * 1000 + (n * n) % 5000, static_cast<float_t>(n) * 1.37f) == RC_SUCCESS) n++;
+    EXPECT_GT(n, 0u);
+    EXPECT_LE(encoder.getSize(), sizeof(block));
+
+    GorillaDecoder decoder(block, encoder.getSize());
+    for(uint32_t i = 0; i < n; i++) {
+        uint32_t timestamp;
+        float_t value;
+        ASSERT_EQ(decoder.next(timestamp, value), RC_SUCCESS);
+        EXPECT_EQ(value, static_cast<float_t>(i) * 1.37f);
+    }
+
+    // Reset starts a new block in the same buffer
+    encoder.reset();
+    EXPECT_EQ(encoder.getCount(), 0u);
+    EXPECT_EQ(encoder.append(1, 1.0f), RC_SUCCESS);
+}
+
+TEST(GorillaCodecTest, InvalidInputTest) {
+    uint8_t block[64];
+    GorillaEncoder encoder(block, sizeof(block));
+    ASSERT_EQ(encoder.append(100, 1.0f), RC_SUCCESS);
+    EXPECT_EQ(encoder.append(99, 1.0f), RC_ERROR_BAD_PARAM);
+    ASSERT_EQ(encoder.append(200, 2.0f), RC_SUCCESS);
+
+    // Truncated block
+    GorillaDecoder decoder(block, encoder.getSize() - 1);
+    uint32_t timestamp;
+    float_t value;
+    ASSERT_EQ(decoder.next(timestamp, value), RC_SUCCESS);
+    EXPECT_EQ(decoder.next(timestamp, value), RC_ERROR_BAD_DATA);
+
+    // Block smaller than the header
+    GorillaDecoder tooShort(block, 3);
+    EXPECT_EQ(tooShort.next(timestamp, value), RC_ERROR_BUFFER_EMPTY);
+}
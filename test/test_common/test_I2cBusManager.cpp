@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "i2c/BH1750Device.h"
+#include "i2c/I2cBusManager.h"
+#include "i2c/SimulatedI2cBus.h"
+#include "sensors/BH1750_Sensor.h"
+
+/**
+ * @brief Model of a BH1750 which only delivers a result once its conversion time has passed
+ */
+class SimulatedBH1750 : public SimulatedI2cDevice {
+   public:
+    explicit SimulatedBH1750(uint16_t count) : count(count) {}
+    RC_t onWrite(uint64_t timeUs, const uint8_t data[], uint32_t length) override {
+        if(length != 1 || data[0] != BH1750_CMD_ONE_TIME_HIGH_RES) return RC_ERROR;
+        triggeredAtUs = timeUs;
+        triggered = true;
+        return RC_SUCCESS;
+    }
+    RC_t onRead(uint64_t timeUs, uint8_t data[], uint32_t length) override {
+        if(!triggered || timeUs - triggeredAtUs < BH1750_CONVERSION_TIME_US || length != 2) return RC_ERROR;
+        triggered = false;
+        data[0] = count >> 8;
+        data[1] = count & 0xFF;
+        return RC_SUCCESS;
+    }
+    uint16_t count;
+    bool triggered = false;
+    uint64_t triggeredAtUs = 0;
+};
+
+TEST(I2cBusManager, BatchesConversions) {
+    SimulatedI2cBus bus;
+    I2cBusManager manager(bus);
+    SimulatedBH1750 devices[3] = {SimulatedBH1750(120), SimulatedBH1750(1200), SimulatedBH1750(12000)};
+    std::shared_ptr<BH1750Device> handles[3];
+    for(uint8_t i = 0; i < 3; i++) {
+        ASSERT_EQ(bus.attach(0x20 + i, &devices[i]), RC_SUCCESS);
+        handles[i] = std::make_shared<BH1750Device>(0x20 + i);
+        ASSERT_EQ(manager.addDevice(handles[i]), RC_SUCCESS);
+    }
+    EXPECT_EQ(manager.getDeviceCount(), 3);
+
+    float_t lux;
+    EXPECT_FALSE(handles[0]->getLux(lux));
+    const uint64_t start = bus.getTimeUs();
+    ASSERT_EQ(manager.runCycle(), RC_SUCCESS);
+    // All three conversions overlap, so the cycle only takes a single conversion time plus the transfers
+    EXPECT_LT(bus.getTimeUs() - start, BH1750_CONVERSION_TIME_US + 5000);
+
+    ASSERT_TRUE(handles[0]->getLux(lux));
+    EXPECT_FLOAT_EQ(lux, 100.0f);
+    ASSERT_TRUE(handles[2]->getLux(lux));
+    EXPECT_FLOAT_EQ(lux, 10000.0f);
+
+    const I2cBusMetrics_t metrics = manager.getMetrics();
+    EXPECT_EQ(metrics.transactions, 6);
+    EXPECT_EQ(metrics.errors, 0);
+    EXPECT_EQ(metrics.bytes, 9);
+    EXPECT_GT(metrics.busyUs, 0);
+    EXPECT_LT(metrics.busyUs, metrics.elapsedUs / 10);
+}
+
+TEST(I2cBusManager, DevicesAndErrors) {
+    SimulatedI2cBus bus;
+    I2cBusManager manager(bus);
+    EXPECT_EQ(manager.runCycle(), RC_ERROR_BUFFER_EMPTY);
+    EXPECT_EQ(manager.addDevice(nullptr), RC_ERROR_NULL);
+
+    SimulatedBH1750 device(60);
+    bus.attach(0x23, &device);
+    std::shared_ptr<BH1750Device> present = std::make_shared<BH1750Device>(0x23);
+    std::shared_ptr<BH1750Device> missing = std::make_shared<BH1750Device>(0x5C);
+    ASSERT_EQ(manager.addDevice(present), RC_SUCCESS);
+    EXPECT_EQ(manager.addDevice(std::make_shared<BH1750Device>(0x23)), RC_ERROR_BUSY);
+    ASSERT_EQ(manager.addDevice(missing), RC_SUCCESS);
+
+    // A missing device does not keep the others from being measured
+    EXPECT_EQ(manager.runCycle(), RC_ERROR);
+    float_t lux;
+    EXPECT_TRUE(present->getLux(lux));
+    EXPECT_FALSE(missing->getLux(lux));
+    EXPECT_EQ(manager.getMetrics().errors, 1);
+
+    // Released devices leave the cycle and free their address
+    missing.reset();
+    EXPECT_EQ(manager.getDeviceCount(), 1);
+    present.reset();
+    EXPECT_EQ(manager.runCycle(), RC_ERROR_BUFFER_EMPTY);
+    EXPECT_EQ(manager.addDevice(std::make_shared<BH1750Device>(0x23)), RC_SUCCESS);
+
+    // Single transactions use the same bus
+    const uint8_t cmd = BH1750_CMD_ONE_TIME_HIGH_RES;
+    EXPECT_EQ(manager.transfer(0x23, &cmd, 1, nullptr, 0), RC_SUCCESS);
+    EXPECT_TRUE(device.triggered);
+    uint8_t data[2];
+    EXPECT_EQ(manager.transfer(0x10, nullptr, 0, data, 2), RC_ERROR_READ_FAILS);
+}
+
+TEST(I2cBusManager, BH1750Sensor) {
+    SimulatedI2cBus bus;
+    I2cBusManager manager(bus);
+    SimulatedBH1750 device(240);
+    bus.attach(BH1750_I2C_ADDRESS_LOW, &device);
+
+    char name[] = "Light";
+    BH1750_Sensor sensor(name, BH1750_I2C_ADDRESS_LOW, manager);
+    // Nothing was measured yet
+    EXPECT_TRUE(std::isnan(sensor.readSensor()));
+    ASSERT_EQ(manager.runCycle(), RC_SUCCESS);
+    EXPECT_FLOAT_EQ(sensor.readSensor(), 200.0f);
+
+    // A replacement sensor takes over the address once the previous one is gone
+    {
+        BH1750_Sensor replacement(name, BH1750_I2C_ADDRESS_LOW, manager);
+        EXPECT_TRUE(std::isnan(replacement.readSensor()));
+    }
+    EXPECT_EQ(manager.getDeviceCount(), 1);
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "filesystem/LineReader.h"
+#ifdef ARDUINO
+    #include "filesystem/LittleFilesystem.h"
+#else
+    #include "filesystem/DesktopFilesystem.h"
+#endif  // ARDUINO
+
+class LineReaderTest : public testing::Test {
+   protected:
+#ifdef ARDUINO
+    LittleFilesystem fs;
+    const char* filename = "/linereadertest.txt";
+#else
+    DesktopFilesystem fs;
+    const char* filename = "./linereadertest.txt";
+#endif  // ARDUINO
+
+    void TearDown() override {
+        fs.closeFile();
+        fs.deleteFile(filename);
+    }
+
+    void writeAndOpen(const std::string& text) {
+        ASSERT_EQ(fs.openFile(filename, Filesystem::WRITE_TRUNCATE), RC_SUCCESS);
+        ASSERT_EQ(fs.write(reinterpret_cast<const uint8_t*>(text.data()), text.size()), RC_SUCCESS);
+        fs.closeFile();
+        ASSERT_EQ(fs.openFile(filename), RC_SUCCESS);
+    }
+
+    void expectLine(LineReader& reader, const char expected[]) {
+        StringView line;
+        ASSERT_EQ(reader.next(line), RC_SUCCESS);
+        EXPECT_EQ(std::string(line.data(), line.length()), expected);
+    }
+};
+
+TEST_F(LineReaderTest, StraddlingLines) {
+    // Every line straddles at least one refill of the 8 byte buffer
+    writeAndOpen("first\nsecond\r\n\nthird");
+    char buffer[8];
+    LineReader reader(fs, buffer, sizeof(buffer));
+    expectLine(reader, "first");
+    expectLine(reader, "second");
+    expectLine(reader, "");
+    expectLine(reader, "third");
+    StringView line;
+    EXPECT_EQ(reader.next(line), RC_ERROR_BUFFER_EMPTY);
+    EXPECT_EQ(reader.next(line), RC_ERROR_BUFFER_EMPTY);
+}
+
+TEST_F(LineReaderTest, OverlongLines) {
+    writeAndOpen("short\nthis line is too long\nok\nanother long line\n");
+    char buffer[8];
+    LineReader reader(fs, buffer, sizeof(buffer));
+    StringView line;
+    expectLine(reader, "short");
+    EXPECT_EQ(reader.next(line), RC_ERROR_OVERRUN);
+    expectLine(reader, "ok");
+    EXPECT_EQ(reader.next(line), RC_ERROR_OVERRUN);
+    EXPECT_EQ(reader.next(line), RC_ERROR_BUFFER_EMPTY);
+}
+
+TEST_F(LineReaderTest, EmptyFile) {
+    writeAndOpen("");
+    char buffer[8];
+    LineReader reader(fs, buffer, sizeof(buffer));
+    StringView line;
+    EXPECT_EQ(reader.next(line), RC_ERROR_BUFFER_EMPTY);
+}
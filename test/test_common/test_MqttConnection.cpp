@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include "telemetry/MqttConnection.h"
+
+TEST(MqttConnection, Backoff) {
+    MqttConnection connection(1000, 8000, 1);
+    EXPECT_EQ(connection.getState(), MqttConnection::STATE_DISCONNECTED);
+    EXPECT_EQ(connection.getTimeUntilConnectMs(0), 0);
+
+    // The backoff doubles up to the maximum and each delay is jittered between half and all of it
+    uint32_t now = 0;
+    const uint32_t backoffs[] = {1000, 2000, 4000, 8000, 8000, 8000};
+    for(uint32_t backoff : backoffs) {
+        connection.connecting(now);
+        EXPECT_EQ(connection.getState(), MqttConnection::STATE_CONNECTING);
+        EXPECT_EQ(connection.getTimeUntilConnectMs(now), UINT32_MAX);
+        connection.connectFailed(now);
+        EXPECT_EQ(connection.getState(), MqttConnection::STATE_BACKOFF);
+        const uint32_t delay = connection.getMetrics().backoffMs;
+        EXPECT_GE(delay, backoff / 2);
+        EXPECT_LE(delay, backoff);
+        EXPECT_EQ(connection.getTimeUntilConnectMs(now), delay);
+        EXPECT_EQ(connection.getTimeUntilConnectMs(now + delay - 1), 1);
+        now += delay;
+        EXPECT_EQ(connection.getTimeUntilConnectMs(now), 0);
+    }
+
+    // Connecting resets the backoff
+    connection.connecting(now);
+    connection.connected(now + 10);
+    EXPECT_EQ(connection.getState(), MqttConnection::STATE_CONNECTED);
+    EXPECT_EQ(connection.getTimeUntilConnectMs(now), UINT32_MAX);
+    connection.connectionLost(now + 20);
+    EXPECT_EQ(connection.getState(), MqttConnection::STATE_DISCONNECTED);
+    connection.connecting(now + 20);
+    connection.connectFailed(now + 20);
+    EXPECT_LE(connection.getMetrics().backoffMs, 1000);
+
+    const MqttConnectionMetrics_t metrics = connection.getMetrics();
+    EXPECT_EQ(metrics.failedAttempts, 7);
+    EXPECT_EQ(metrics.connects, 1);
+    EXPECT_EQ(metrics.connectionLosses, 1);
+    // Disconnected -> connecting, then connecting <-> backoff, connected, disconnected, connecting, backoff
+    EXPECT_EQ(metrics.transitions, 1 + 2 * 6 + 1 + 1 + 1 + 1);
+}
+
+TEST(MqttConnection, Jitter) {
+    // Devices with different seeds do not retry in lockstep
+    MqttConnection a(1000, 60000, 1), b(1000, 60000, 2);
+    uint32_t equal = 0;
+    for(uint32_t i = 0; i < 10; i++) {
+        a.connecting(0);
+        a.connectFailed(0);
+        b.connecting(0);
+        b.connectFailed(0);
+        if(a.getMetrics().backoffMs == b.getMetrics().backoffMs) equal++;
+    }
+    EXPECT_LT(equal, 3);
+}
+
+TEST(MqttConnection, ReconnectLatency) {
+    MqttConnection connection(1000, 60000, 1);
+    // The first connect after startup counts from the first attempt
+    connection.connecting(500);
+    connection.connectFailed(500);
+    connection.connecting(1500);
+    connection.connected(1600);
+    EXPECT_EQ(connection.getMetrics().lastReconnectMs, 1100);
+
+    connection.connectionLost(10000);
+    connection.connecting(10000);
+    connection.connected(10050);
+    EXPECT_EQ(connection.getMetrics().lastReconnectMs, 50);
+    EXPECT_EQ(connection.getMetrics().maxReconnectMs, 1100);
+
+    // Only an established connection can be lost
+    connection.connectionLost(20000);
+    connection.connectionLost(20000);
+    EXPECT_EQ(connection.getMetrics().connectionLosses, 2);
+
+    // Uptime wraps during the backoff
+    connection.connecting(UINT32_MAX - 100);
+    connection.connectFailed(UINT32_MAX - 100);
+    const uint32_t delay = connection.getMetrics().backoffMs;
+    EXPECT_EQ(connection.getTimeUntilConnectMs(UINT32_MAX - 100), delay);
+    EXPECT_EQ(connection.getTimeUntilConnectMs(delay - 101), 0);
+}
+
+TEST(MqttConnection, Halted) {
+    MqttConnection connection(1000, 60000, 1);
+    connection.connecting(0);
+    connection.connectFailed(0, true);
+    EXPECT_EQ(connection.getState(), MqttConnection::STATE_HALTED);
+    EXPECT_EQ(connection.getTimeUntilConnectMs(100000), UINT32_MAX);
+    EXPECT_STREQ(MqttConnection::stateToString(connection.getState()), "halted");
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "telemetry/MqttOutbox.h"
+
+static uint32_t wakeCount = 0;
+static void countWake() { wakeCount++; }
+
+/**
+ * @brief Takes the oldest message and removes it, like the MQTT task after a successful publish
+ */
+static std::string popMessage(MqttOutbox& outbox) {
+    MqttOutboxMessage_t message;
+    if(outbox.front(message) != RC_SUCCESS) return "";
+    outbox.pop(message.sequence);
+    return std::string(message.topic) + "=" +
+           std::string(reinterpret_cast<const char*>(message.payload), message.payloadLength);
+}
+
+TEST(MqttOutbox, KeepsOrder) {
+    MqttOutbox outbox;
+    wakeCount = 0;
+    outbox.setWakeFunction(countWake);
+    EXPECT_EQ(outbox.push("a/1", "1.5"), RC_SUCCESS);
+    EXPECT_EQ(outbox.push("a/2", ""), RC_SUCCESS);
+    EXPECT_EQ(wakeCount, 2);
+
+    // A message stays until it is popped, e.g. while the broker is unreachable
+    MqttOutboxMessage_t message;
+    ASSERT_EQ(outbox.front(message), RC_SUCCESS);
+    ASSERT_EQ(outbox.front(message), RC_SUCCESS);
+    EXPECT_STREQ(message.topic, "a/1");
+    EXPECT_EQ(outbox.getMetrics().depth, 2);
+
+    EXPECT_EQ(popMessage(outbox), "a/1=1.5");
+    EXPECT_EQ(popMessage(outbox), "a/2=");
+    EXPECT_EQ(outbox.front(message), RC_ERROR_BUFFER_EMPTY);
+    const MqttOutboxMetrics_t metrics = outbox.getMetrics();
+    EXPECT_EQ(metrics.depth, 0);
+    EXPECT_EQ(metrics.bytes, 0);
+    EXPECT_EQ(metrics.maxDepth, 2);
+    EXPECT_EQ(metrics.published, 2);
+    EXPECT_EQ(outbox.getFreeBytes(), MQTT_OUTBOX_SIZE);
+}
+
+TEST(MqttOutbox, WrapsAround) {
+    MqttOutbox outbox;
+    // Messages of odd sizes straddle the end of the ring at different offsets
+    for(uint32_t i = 0; i < 10 * MQTT_OUTBOX_SIZE / 100; i++) {
+        const std::string topic = "topic/" + std::to_string(i);
+        const std::string payload(i % 97, static_cast<char>('a' + i % 26));
+        ASSERT_EQ(outbox.push(topic.c_str(), payload.c_str()), RC_SUCCESS);
+        if(i % 3 != 0) continue;
+        // Keep a few messages in the ring
+        while(outbox.getMetrics().depth > 4) popMessage(outbox);
+    }
+    while(outbox.getMetrics().depth > 1) popMessage(outbox);
+    const uint32_t last = 10 * MQTT_OUTBOX_SIZE / 100 - 1;
+    EXPECT_EQ(popMessage(outbox),
+              "topic/" + std::to_string(last) + "=" + std::string(last % 97, static_cast<char>('a' + last % 26)));
+    EXPECT_EQ(outbox.getMetrics().dropped, 0);
+}
+
+// Largest messages, topics are "t/<digit>"
+static const std::string largePayload(MQTT_OUTBOX_MAX_PAYLOAD_LENGTH, 'x');
+static const uint32_t largeMessagesPerRing = MQTT_OUTBOX_SIZE / (4 + 3 + MQTT_OUTBOX_MAX_PAYLOAD_LENGTH);
+
+TEST(MqttOutbox, DropOldest) {
+    MqttOutbox outbox;
+    for(uint32_t i = 0; i < largeMessagesPerRing + 2; i++) {
+        const std::string topic = "t/" + std::to_string(i);
+        EXPECT_EQ(outbox.push(topic.c_str(), largePayload.c_str()), RC_SUCCESS);
+    }
+    EXPECT_EQ(outbox.getMetrics().depth, largeMessagesPerRing);
+    EXPECT_EQ(outbox.getMetrics().dropped, 2);
+    MqttOutboxMessage_t message;
+    ASSERT_EQ(outbox.front(message), RC_SUCCESS);
+    EXPECT_STREQ(message.topic, "t/2");
+
+    // The message being published was dropped in the meantime. The newer message is kept
+    EXPECT_EQ(outbox.push("t/9", largePayload.c_str()), RC_SUCCESS);
+    outbox.pop(message.sequence);
+    ASSERT_EQ(outbox.front(message), RC_SUCCESS);
+    EXPECT_STREQ(message.topic, "t/3");
+    EXPECT_EQ(outbox.getMetrics().published, 0);
+}
+
+TEST(MqttOutbox, DropNewest) {
+    MqttOutbox outbox;
+    outbox.setDropPolicy(MqttOutbox::DROP_NEWEST);
+    for(uint32_t i = 0; i < largeMessagesPerRing; i++) {
+        const std::string topic = "t/" + std::to_string(i);
+        EXPECT_EQ(outbox.push(topic.c_str(), largePayload.c_str()), RC_SUCCESS);
+    }
+    EXPECT_EQ(outbox.push("t/9", largePayload.c_str()), RC_ERROR_BUFFER_FULL);
+    EXPECT_EQ(popMessage(outbox).substr(0, 4), "t/0=");
+    EXPECT_EQ(outbox.getMetrics().dropped, 1);
+
+    // Messages which can never fit
+    const std::string topic(MQTT_OUTBOX_MAX_TOPIC_LENGTH, 't');
+    EXPECT_EQ(outbox.push(topic.c_str(), ""), RC_ERROR_BAD_PARAM);
+    EXPECT_EQ(outbox.push("t", (largePayload + "x").c_str()), RC_ERROR_BAD_PARAM);
+    EXPECT_EQ(outbox.getMetrics().dropped, 3);
+    EXPECT_EQ(outbox.getMetrics().depth, largeMessagesPerRing - 1);
+}
@@ -0,0 +1,430 @@
+#include <gtest/gtest.h>
+
+#include <math.h>
+#include <string.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "TestSensor.h"
+#include "telemetry/CborPayloadEncoder.h"
+#include "telemetry/InfluxPayloadEncoder.h"
+#include "telemetry/JsonPayloadEncoder.h"
+#include "telemetry/MessagePackPayloadEncoder.h"
+
+// Values of every sensor in a decoded payload by sensor and field name
+typedef std::map<std::string, std::map<std::string, double>> Decoded_t;
+
+/**
+ * @brief Minimal decoder for the subset of CBOR and MessagePack written by the encoders
+ */
+class BinaryReader {
+   public:
+    BinaryReader(const uint8_t data[], uint32_t length) : m_data(data), m_length(length) {}
+
+    bool atEnd() const { return m_pos == m_length; }
+
+    uint8_t byte() {
+        if(m_pos >= m_length) {
+            m_error = true;
+            return 0;
+        }
+        return m_data[m_pos++];
+    }
+
+    uint32_t bigEndian(uint8_t bytes) {
+        uint32_t value = 0;
+        for(uint8_t i = 0; i < bytes; i++) value = (value << 8) | byte();
+        return value;
+    }
+
+    float_t float32() {
+        const uint32_t bits = bigEndian(4);
+        float_t value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    std::string string(uint32_t length) {
+        if(m_length - m_pos < length) {
+            m_error = true;
+            return "";
+        }
+        const std::string str(reinterpret_cast<const char*>(&m_data[m_pos]), length);
+        m_pos += length;
+        return str;
+    }
+
+    bool m_error = false;
+
+   private:
+    const uint8_t* m_data;
+    uint32_t m_length;
+    uint32_t m_pos = 0;
+};
+
+static uint32_t cborArgument(BinaryReader& r, uint8_t head) {
+    const uint8_t info = head & 0x1F;
+    if(info < 24) return info;
+    if(info == 24) return r.bigEndian(1);
+    if(info == 25) return r.bigEndian(2);
+    if(info == 26) return r.bigEndian(4);
+    r.m_error = true;
+    return 0;
+}
+
+static std::string cborText(BinaryReader& r) {
+    const uint8_t head = r.byte();
+    if((head & 0xE0) != 0x60) r.m_error = true;
+    return r.string(cborArgument(r, head));
+}
+
+static bool decodeCbor(const uint8_t data[], uint32_t length, Decoded_t& decoded) {
+    BinaryReader r(data, length);
+    const uint8_t head = r.byte();
+    if((head & 0xE0) != 0xA0) return false;
+    const uint32_t sensors = cborArgument(r, head);
+    for(uint32_t i = 0; i < sensors && !r.m_error; i++) {
+        std::map<std::string, double>& values = decoded[cborText(r)];
+        const uint8_t mapHead = r.byte();
+        if((mapHead & 0xE0) != 0xA0) return false;
+        const uint32_t count = cborArgument(r, mapHead);
+        for(uint32_t j = 0; j < count && !r.m_error; j++) {
+            const std::string key = cborText(r);
+            const uint8_t valueHead = r.byte();
+            if(valueHead == 0xFA)
+                values[key] = r.float32();
+            else if((valueHead & 0xE0) == 0x00)
+                values[key] = cborArgument(r, valueHead);
+            else
+                return false;
+        }
+    }
+    return !r.m_error && r.atEnd();
+}
+
+static uint32_t msgpackMapLength(BinaryReader& r) {
+    const uint8_t head = r.byte();
+    if((head & 0xF0) == 0x80) return head & 0x0F;
+    if(head == 0xDE) return r.bigEndian(2);
+    r.m_error = true;
+    return 0;
+}
+
+static std::string msgpackString(BinaryReader& r) {
+    const uint8_t head = r.byte();
+    if((head & 0xE0) == 0xA0) return r.string(head & 0x1F);
+    if(head == 0xD9) return r.string(r.bigEndian(1));
+    if(head == 0xDA) return r.string(r.bigEndian(2));
+    r.m_error = true;
+    return "";
+}
+
+static bool decodeMessagePack(const uint8_t data[], uint32_t length, Decoded_t& decoded) {
+    BinaryReader r(data, length);
+    const uint32_t sensors = msgpackMapLength(r);
+    for(uint32_t i = 0; i < sensors && !r.m_error; i++) {
+        std::map<std::string, double>& values = decoded[msgpackString(r)];
+        const uint32_t count = msgpackMapLength(r);
+        for(uint32_t j = 0; j < count && !r.m_error; j++) {
+            const std::string key = msgpackString(r);
+            const uint8_t head = r.byte();
+            if(head <= 0x7F)
+                values[key] = head;
+            else if(head == 0xCA)
+                values[key] = r.float32();
+            else if(head >= 0xCC && head <= 0xCE)
+                values[key] = r.bigEndian(1 << (head - 0xCC));
+            else
+                return false;
+        }
+    }
+    return !r.m_error && r.atEnd();
+}
+
+/**
+ * @brief Splits str at unescaped separators and removes the escapes
+ */
+static std::vector<std::string> splitEscaped(const std::string& str, char separator) {
+    std::vector<std::string> parts(1);
+    for(size_t i = 0; i < str.size(); i++) {
+        if(str[i] == '\\' && i + 1 < str.size())
+            parts.back() += str[++i];
+        else if(str[i] == separator)
+            parts.emplace_back();
+        else
+            parts.back() += str[i];
+    }
+    return parts;
+}
+
+/**
+ * @brief Splits a line at unescaped spaces without removing the escapes
+ */
+static std::vector<std::string> splitLine(const std::string& line) {
+    std::vector<std::string> parts(1);
+    for(size_t i = 0; i < line.size(); i++) {
+        if(line[i] == ' ' && (i == 0 || line[i - 1] != '\\'))
+            parts.emplace_back();
+        else
+            parts.back() += line[i];
+    }
+    return parts;
+}
+
+typedef struct {
+    std::string measurement;
+    std::map<std::string, std::string> tags;
+    std::map<std::string, std::string> fields;
+    std::string timestamp;
+} InfluxLine_t;
+
+static bool decodeInflux(const uint8_t data[], uint32_t length, std::vector<InfluxLine_t>& lines) {
+    const std::string text(reinterpret_cast<const char*>(data), length);
+    size_t start = 0;
+    while(start < text.size()) {
+        const size_t end = text.find('\n', start);
+        if(end == std::string::npos) return false;
+        const std::vector<std::string> parts = splitLine(text.substr(start, end - start));
+        if(parts.size() < 2 || parts.size() > 3) return false;
+        InfluxLine_t line;
+        const std::vector<std::string> series = splitEscaped(parts[0], ',');
+        line.measurement = series[0];
+        for(size_t i = 1; i < series.size(); i++) {
+            const size_t eq = series[i].find('=');
+            if(eq == std::string::npos) return false;
+            line.tags[series[i].substr(0, eq)] = series[i].substr(eq + 1);
+        }
+        for(const std::string& field : splitEscaped(parts[1], ',')) {
+            const size_t eq = field.find('=');
+            if(eq == std::string::npos) return false;
+            line.fields[field.substr(0, eq)] = field.substr(eq + 1);
+        }
+        if(parts.size() == 3) line.timestamp = parts[2];
+        lines.push_back(line);
+        start = end + 1;
+    }
+    return true;
+}
+
+/**
+ * @brief Adds the same sensors to an encoder: a plain value, aggregates and a sensor with a long name
+ */
+static void addSensors(PayloadEncoder& encoder, Decoded_t& expected) {
+    SensorSample_t sample;
+    sample.value = 21.5f;
+    sample.rawValue = 2345;
+    ASSERT_EQ(encoder.add("Temperature", sample), RC_SUCCESS);
+    expected["Temperature"] = {{"value", 21.5}, {"raw", 2345}};
+
+    SampleAggregator aggregate;
+    for(uint32_t i = 0; i < 300; i++) aggregate.add(static_cast<float_t>(i) * 0.25f);
+    sample.rawValue = 0.1f;
+    ASSERT_EQ(encoder.add("Humidity", sample, &aggregate, SampleAggregator::FIELD_ALL), RC_SUCCESS);
+    expected["Humidity"] = {{"min", aggregate.getMin()}, {"max", aggregate.getMax()}, {"mean", aggregate.getMean()},
+                            {"last", aggregate.getLast()}, {"count", 300},           {"raw", 0.1f}};
+
+    const std::string longName(40, 'L');
+    sample.value = -1e6f;
+    sample.rawValue = 3.0e-3f;
+    ASSERT_EQ(encoder.add(longName.c_str(), sample), RC_SUCCESS);
+    expected[longName] = {{"value", -1e6f}, {"raw", 3.0e-3f}};
+    EXPECT_EQ(encoder.getSensorCount(), 3);
+}
+
+TEST(PayloadEncoder, JsonFormat) {
+    uint8_t buffer[256];
+    JsonPayloadEncoder payload(buffer, sizeof(buffer));
+    EXPECT_STREQ(payload.c_str(), "{}");
+
+    SensorSample_t sample;
+    sample.value = 21.5f;
+    sample.rawValue = 2345;
+    EXPECT_EQ(payload.add("Temperature", sample), RC_SUCCESS);
+    EXPECT_STREQ(payload.c_str(), "{\"Temperature\":{\"value\":21.500000,\"raw\":2345.000000}}");
+
+    // Aggregates replace the processed value
+    SampleAggregator aggregate;
+    aggregate.add(1);
+    aggregate.add(3);
+    sample.rawValue = 7;
+    EXPECT_EQ(payload.add("Hum\"id", sample, &aggregate, SampleAggregator::FIELD_MEAN | SampleAggregator::FIELD_COUNT),
+              RC_SUCCESS);
+    EXPECT_STREQ(payload.c_str(),
+                 "{\"Temperature\":{\"value\":21.500000,\"raw\":2345.000000},"
+                 "\"Hum\\\"id\":{\"mean\":2.000000,\"count\":2,\"raw\":7.000000}}");
+    EXPECT_EQ(payload.getSensorCount(), 2);
+    EXPECT_EQ(payload.length(), strlen(payload.c_str()));
+
+    // Fewer decimals for compact documents
+    payload.clear();
+    EXPECT_EQ(payload.add("Temperature", sample, &aggregate, SampleAggregator::FIELD_MEAN, 1), RC_SUCCESS);
+    EXPECT_EQ(payload.add("Light", sample, nullptr, 0, 0), RC_SUCCESS);
+    EXPECT_STREQ(payload.c_str(), "{\"Temperature\":{\"mean\":2.0,\"raw\":7.0},\"Light\":{\"value\":22,\"raw\":7}}");
+
+    // Failed reads are written as null to keep the document valid JSON
+    payload.clear();
+    sample.value = NAN;
+    sample.rawValue = INFINITY;
+    EXPECT_EQ(payload.add("a", sample), RC_SUCCESS);
+    EXPECT_STREQ(payload.c_str(), "{\"a\":{\"value\":null,\"raw\":null}}");
+
+    // A value which can't be formatted leaves the document unchanged
+    sample.value = 1;
+    sample.rawValue = 2;
+    EXPECT_EQ(payload.add("b", sample, nullptr, 0, FLOAT_FORMAT_MAX_DECIMALS + 1), RC_ERROR_BAD_PARAM);
+    EXPECT_STREQ(payload.c_str(), "{\"a\":{\"value\":null,\"raw\":null}}");
+    EXPECT_EQ(payload.length(), strlen(payload.c_str()));
+    EXPECT_EQ(payload.getSensorCount(), 1);
+
+    payload.clear();
+    EXPECT_STREQ(payload.c_str(), "{}");
+    EXPECT_EQ(payload.getSensorCount(), 0);
+}
+
+TEST(PayloadEncoder, CborRoundTrip) {
+    uint8_t buffer[512];
+    CborPayloadEncoder payload(buffer, sizeof(buffer));
+    Decoded_t decoded;
+    ASSERT_TRUE(decodeCbor(payload.data(), payload.length(), decoded));
+    EXPECT_TRUE(decoded.empty());
+
+    Decoded_t expected;
+    addSensors(payload, expected);
+    ASSERT_TRUE(decodeCbor(payload.data(), payload.length(), decoded));
+    // Binary formats keep the values exactly
+    EXPECT_EQ(decoded, expected);
+
+    // Known encoding of a single sensor: {"T": {"value": 1.0, "raw": 2.0}}
+    payload.clear();
+    SensorSample_t sample;
+    sample.value = 1;
+    sample.rawValue = 2;
+    ASSERT_EQ(payload.add("T", sample), RC_SUCCESS);
+    const uint8_t encoded[] = {0xB9, 0x00, 0x01, 0x61, 'T',  0xA2, 0x65, 'v',  'a',  'l',  'u',  'e',  0xFA, 0x3F,
+                               0x80, 0x00, 0x00, 0x63, 'r',  'a',  'w',  0xFA, 0x40, 0x00, 0x00, 0x00};
+    ASSERT_EQ(payload.length(), sizeof(encoded));
+    EXPECT_EQ(memcmp(payload.data(), encoded, sizeof(encoded)), 0);
+}
+
+TEST(PayloadEncoder, MessagePackRoundTrip) {
+    uint8_t buffer[512];
+    MessagePackPayloadEncoder payload(buffer, sizeof(buffer));
+    Decoded_t decoded;
+    ASSERT_TRUE(decodeMessagePack(payload.data(), payload.length(), decoded));
+    EXPECT_TRUE(decoded.empty());
+
+    Decoded_t expected;
+    addSensors(payload, expected);
+    ASSERT_TRUE(decodeMessagePack(payload.data(), payload.length(), decoded));
+    EXPECT_EQ(decoded, expected);
+
+    // Known encoding of a single sensor: {"T": {"value": 1.0, "raw": 2.0}}
+    payload.clear();
+    SensorSample_t sample;
+    sample.value = 1;
+    sample.rawValue = 2;
+    ASSERT_EQ(payload.add("T", sample), RC_SUCCESS);
+    const uint8_t encoded[] = {0xDE, 0x00, 0x01, 0xA1, 'T',  0x82, 0xA5, 'v',  'a',  'l',  'u',  'e',  0xCA, 0x3F,
+                               0x80, 0x00, 0x00, 0xA3, 'r',  'a',  'w',  0xCA, 0x40, 0x00, 0x00, 0x00};
+    ASSERT_EQ(payload.length(), sizeof(encoded));
+    EXPECT_EQ(memcmp(payload.data(), encoded, sizeof(encoded)), 0);
+}
+
+TEST(PayloadEncoder, InfluxRoundTrip) {
+    uint8_t buffer[512];
+    const char device[] = "Living room";
+    InfluxPayloadEncoder payload(buffer, sizeof(buffer), "multisensor", device);
+    EXPECT_EQ(payload.length(), 0);
+
+    payload.clear(1700000000);
+    Decoded_t expected;
+    addSensors(payload, expected);
+    std::vector<InfluxLine_t> lines;
+    ASSERT_TRUE(decodeInflux(payload.data(), payload.length(), lines));
+    ASSERT_EQ(lines.size(), expected.size());
+    for(const InfluxLine_t& line : lines) {
+        EXPECT_EQ(line.measurement, "multisensor");
+        EXPECT_EQ(line.tags.at("device"), device);
+        EXPECT_EQ(line.timestamp, "1700000000000000000");
+        const std::map<std::string, double>& values = expected.at(line.tags.at("sensor"));
+        ASSERT_EQ(line.fields.size(), values.size());
+        for(const auto& v : values) {
+            const std::string& field = line.fields.at(v.first);
+            if(v.first == "count") {
+                // Integer field
+                EXPECT_EQ(field, std::to_string(static_cast<uint32_t>(v.second)) + "i");
+            } else {
+                // Text formats are rounded to the decimals of the sensor
+                EXPECT_NEAR(std::stod(field), v.second, 1e-6 * (1 + fabs(v.second)));
+            }
+        }
+    }
+
+    // Escaped tags, no timestamp and non-finite values left out
+    payload.clear();
+    SensorSample_t sample;
+    sample.value = NAN;
+    sample.rawValue = 12;
+    ASSERT_EQ(payload.add("CO2,ppm=x", sample, nullptr, 0, 0), RC_SUCCESS);
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(payload.data()), payload.length()),
+              "multisensor,device=Living\\ room,sensor=CO2\\,ppm\\=x raw=12\n");
+    sample.rawValue = INFINITY;
+    EXPECT_EQ(payload.add("Broken", sample), RC_ERROR_BAD_PARAM);
+    EXPECT_EQ(payload.getSensorCount(), 1);
+    sample.rawValue = 1;
+    EXPECT_EQ(payload.add("Broken", sample, nullptr, 0, FLOAT_FORMAT_MAX_DECIMALS + 1), RC_ERROR_BAD_PARAM);
+    EXPECT_EQ(payload.length(), strlen("multisensor,device=Living\\ room,sensor=CO2\\,ppm\\=x raw=12\n"));
+
+    // Without device tag
+    InfluxPayloadEncoder anonymous(buffer, sizeof(buffer), "m", "");
+    sample.rawValue = 1;
+    ASSERT_EQ(anonymous.add("A", sample, nullptr, 0, 0), RC_SUCCESS);
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(anonymous.data()), anonymous.length()), "m,sensor=A raw=1\n");
+
+    // Equal signs are only escaped in tags, backslashes everywhere
+    InfluxPayloadEncoder special(buffer, sizeof(buffer), "a=b c\\", "");
+    ASSERT_EQ(special.add("C:\\", sample, nullptr, 0, 0), RC_SUCCESS);
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(special.data()), special.length()),
+              "a=b\\ c\\\\,sensor=C:\\\\ raw=1\n");
+}
+
+TEST(PayloadEncoder, BufferFull) {
+    uint8_t jsonBuffer[64];
+    uint8_t cborBuffer[40];
+    uint8_t msgpackBuffer[40];
+    uint8_t influxBuffer[128];
+    JsonPayloadEncoder json(jsonBuffer, sizeof(jsonBuffer));
+    CborPayloadEncoder cbor(cborBuffer, sizeof(cborBuffer));
+    MessagePackPayloadEncoder msgpack(msgpackBuffer, sizeof(msgpackBuffer));
+    InfluxPayloadEncoder influx(influxBuffer, sizeof(influxBuffer), "multisensor", "Device");
+    SensorSample_t sample;
+    sample.value = 1;
+    sample.rawValue = 2;
+
+    for(PayloadEncoder* payload : std::vector<PayloadEncoder*>{&json, &cbor, &msgpack, &influx}) {
+        payload->clear(1700000000);
+        ASSERT_EQ(payload->add("A", sample), RC_SUCCESS);
+        const std::vector<uint8_t> before(payload->data(), payload->data() + payload->length());
+
+        // The payload stays complete and unchanged
+        EXPECT_EQ(payload->add("B", sample), RC_ERROR_BUFFER_FULL);
+        EXPECT_EQ(std::vector<uint8_t>(payload->data(), payload->data() + payload->length()), before);
+        EXPECT_EQ(payload->getSensorCount(), 1);
+    }
+    EXPECT_EQ(std::string(json.c_str()), "{\"A\":{\"value\":1.000000,\"raw\":2.000000}}");
+    Decoded_t decoded;
+    EXPECT_TRUE(decodeCbor(cbor.data(), cbor.length(), decoded));
+    EXPECT_TRUE(decodeMessagePack(msgpack.data(), msgpack.length(), decoded));
+}
+
+TEST(PayloadEncoder, SensorTopics) {
+    char name[] = "Temperature";
+    SequenceSensor sensor(name);
+    EXPECT_STREQ(sensor.getTopic(), "");
+    ASSERT_EQ(sensor.setDeviceTopic("MultiSensor-MQTT/Test"), RC_SUCCESS);
+    EXPECT_STREQ(sensor.getTopic(), "MultiSensor-MQTT/Test/Temperature");
+    EXPECT_STREQ(sensor.getRawTopic(), "MultiSensor-MQTT/Test/raw/Temperature");
+    EXPECT_STREQ(sensor.getEventTopic(), "MultiSensor-MQTT/Test/event/Temperature");
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include "gpio/SimulatedGpio.h"
+#include "sensors/PulseCounterSensor.h"
+
+#define PIN (4)
+
+TEST(PulseCounterSensorTest, CountsEdges) {
+    char name[] = "Pulses";
+    SimulatedGpio gpio;
+    PulseCounterSensor rising(name, gpio, PIN, Gpio::PULL_NONE, PulseCounterSensor::EDGE_RISING, 0,
+                              PulseCounterSensor::OUTPUT_COUNT);
+    ASSERT_TRUE(rising.isAttached());
+
+    uint32_t t = 1000;
+    for(uint32_t i = 0; i < 5; i++) {
+        gpio.injectEdge(PIN, true, t += 100);
+        gpio.injectEdge(PIN, false, t += 100);
+    }
+    gpio.advanceTimeUs(100);
+    EXPECT_FLOAT_EQ(rising.readSensor(), 5.0f);
+    // Pulses far shorter than the polling interval are not lost
+    gpio.injectEdge(PIN, true, t += 1000);
+    gpio.injectEdge(PIN, false, t += 1);
+    gpio.advanceTimeUs(10);
+    EXPECT_FLOAT_EQ(rising.readSensor(), 6.0f);
+    EXPECT_EQ(rising.getLastEdgeTimestampUs(), t - 1);
+}
+
+TEST(PulseCounterSensorTest, ManyEdgesBetweenReadings) {
+    char name[] = "Flow";
+    SimulatedGpio gpio;
+    gpio.setTimeUs(0);
+    PulseCounterSensor sensor(name, gpio, PIN, Gpio::PULL_NONE, PulseCounterSensor::EDGE_BOTH, 100,
+                              PulseCounterSensor::OUTPUT_DELTA);
+    // A 500 Hz flow meter over a 10 s interval with a bounce on every edge. Nothing is buffered, so none are lost
+    const uint32_t pulses = 5000;
+    for(uint32_t i = 0; i < pulses; i++) {
+        const uint32_t t = i * 2000;
+        gpio.injectEdge(PIN, true, t);
+        gpio.injectEdge(PIN, false, t + 20);
+        gpio.injectEdge(PIN, true, t + 40);
+        gpio.injectEdge(PIN, false, t + 1000);
+    }
+    gpio.setTimeUs(pulses * 2000);
+    EXPECT_FLOAT_EQ(sensor.readSensor(), 2.0f * pulses);
+    EXPECT_EQ(sensor.getCount(), 2 * pulses);
+}
+
+TEST(PulseCounterSensorTest, DebounceAndHysteresis) {
+    char name[] = "Debounced";
+    SimulatedGpio gpio;
+    PulseCounterSensor sensor(name, gpio, PIN, Gpio::PULL_UP, PulseCounterSensor::EDGE_FALLING, 5000,
+                              PulseCounterSensor::OUTPUT_COUNT);
+    // Button press which bounces for 1 ms before settling low
+    uint32_t t = 10000;
+    gpio.injectEdge(PIN, false, t);
+    gpio.injectEdge(PIN, true, t + 200);
+    gpio.injectEdge(PIN, false, t + 400);
+    gpio.injectEdge(PIN, true, t + 700);
+    gpio.injectEdge(PIN, false, t + 1000);
+    // Not stable for the debounce time yet
+    gpio.setTimeUs(t + 3000);
+    EXPECT_FLOAT_EQ(sensor.readSensor(), 0.0f);
+    gpio.setTimeUs(t + 6000);
+    EXPECT_FLOAT_EQ(sensor.readSensor(), 1.0f);
+    EXPECT_EQ(sensor.getLastEdgeTimestampUs(), t + 1000);
+
+    // A glitch shorter than the debounce time is ignored
+    t += 100000;
+    gpio.injectEdge(PIN, true, t);
+    gpio.injectEdge(PIN, false, t + 10);
+    gpio.setTimeUs(t + 10000);
+    EXPECT_FLOAT_EQ(sensor.readSensor(), 1.0f);
+
+    // Release and press again
+    gpio.injectEdge(PIN, true, t += 20000);
+    gpio.injectEdge(PIN, false, t += 20000);
+    gpio.setTimeUs(t + 10000);
+    EXPECT_FLOAT_EQ(sensor.readSensor(), 2.0f);
+}
+
+TEST(PulseCounterSensorTest, OutputModes) {
+    char name[] = "Outputs";
+    SimulatedGpio gpio;
+    gpio.setTimeUs(0);
+    PulseCounterSensor delta(name, gpio, 1, Gpio::PULL_NONE, PulseCounterSensor::EDGE_BOTH, 0,
+                             PulseCounterSensor::OUTPUT_DELTA);
+    PulseCounterSensor rate(name, gpio, 2, Gpio::PULL_NONE, PulseCounterSensor::EDGE_RISING, 0,
+                            PulseCounterSensor::OUTPUT_RATE);
+    PulseCounterSensor level(name, gpio, 3, Gpio::PULL_NONE, PulseCounterSensor::EDGE_RISING, 0,
+                             PulseCounterSensor::OUTPUT_LEVEL);
+
+    // 20 pulses in 2 s on every pin
+    for(uint32_t i = 0; i < 20; i++) {
+        for(uint32_t pin = 1; pin <= 3; pin++) gpio.injectEdge(pin, true, i * 100000);
+        for(uint32_t pin = 1; pin <= 3; pin++) gpio.injectEdge(pin, false, i * 100000 + 50000);
+    }
+    gpio.setTimeUs(2000000);
+    EXPECT_FLOAT_EQ(delta.readSensor(), 40.0f);
+    EXPECT_FLOAT_EQ(rate.readSensor(), 10.0f);
+    EXPECT_FLOAT_EQ(level.readSensor(), 0.0f);
+
+    gpio.injectEdge(3, true, 2500000);
+    gpio.setTimeUs(3000000);
+    EXPECT_FLOAT_EQ(delta.readSensor(), 0.0f);
+    EXPECT_FLOAT_EQ(rate.readSensor(), 0.0f);
+    EXPECT_FLOAT_EQ(level.readSensor(), 1.0f);
+}
+
+TEST(PulseCounterSensorTest, PinSharing) {
+    char name[] = "Shared";
+    SimulatedGpio gpio;
+    PulseCounterSensor* first = new PulseCounterSensor(name, gpio, PIN, Gpio::PULL_NONE,
+                                                       PulseCounterSensor::EDGE_RISING, 0,
+                                                       PulseCounterSensor::OUTPUT_COUNT);
+    // Replacement created while the first sensor still owns the pin, like on a config reload
+    PulseCounterSensor second(name, gpio, PIN, Gpio::PULL_NONE, PulseCounterSensor::EDGE_RISING, 0,
+                              PulseCounterSensor::OUTPUT_COUNT);
+    EXPECT_FALSE(second.isAttached());
+    delete first;
+    second.readSensor();
+    EXPECT_TRUE(second.isAttached());
+
+    gpio.injectEdge(PIN, true, 1000);
+    gpio.injectEdge(PIN, false, 1005);
+    gpio.advanceTimeUs(100);
+    EXPECT_FLOAT_EQ(second.readSensor(), 1.0f);
+
+    PulseCounterSensor::Edge_t edge;
+    PulseCounterSensor::Output_t output;
+    EXPECT_EQ(PulseCounterSensor::edgeFromString("Falling", edge), RC_SUCCESS);
+    EXPECT_EQ(edge, PulseCounterSensor::EDGE_FALLING);
+    EXPECT_EQ(PulseCounterSensor::outputFromString("rate", output), RC_SUCCESS);
+    EXPECT_EQ(output, PulseCounterSensor::OUTPUT_RATE);
+    EXPECT_EQ(PulseCounterSensor::outputFromString("edges", output), RC_ERROR_INVALID);
+}
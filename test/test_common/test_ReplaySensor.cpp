@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <string>
+
+#include "sensors/ReplaySensor.h"
+#ifdef ARDUINO
+    #include "filesystem/LittleFilesystem.h"
+#else
+    #include "filesystem/DesktopFilesystem.h"
+#endif  // ARDUINO
+
+class ReplaySensorTest : public testing::Test {
+   protected:
+#ifdef ARDUINO
+    LittleFilesystem fs;
+    const char csvFilename[16] = "/replay.csv";
+    const char binFilename[16] = "/replay.bin";
+#else
+    DesktopFilesystem fs;
+    const char csvFilename[16] = "./replay.csv";
+    const char binFilename[16] = "./replay.bin";
+#endif  // ARDUINO
+    char name[16] = "Replay";
+
+    void writeFile(const char filename[], const void* data, uint32_t n) {
+        ASSERT_EQ(fs.openFile(filename, Filesystem::WRITE_TRUNCATE), RC_SUCCESS);
+        fs.write(static_cast<const uint8_t*>(data), n);
+        fs.closeFile();
+    }
+
+    void TearDown() override {
+        fs.deleteFile(csvFilename);
+        fs.deleteFile(binFilename);
+    }
+};
+
+TEST_F(ReplaySensorTest, CsvTest) {
+    const char csv[] = "timestamp,value\n1000,1.5\r\n2000;-2\n\n3000,abc\n4000, 4.25\n5";
+    writeFile(csvFilename, csv, sizeof(csv) - 1);
+    ReplaySensor sensor(name, fs, csvFilename, ReplaySensor::formatFromFilename(csvFilename));
+    // Header and invalid lines are skipped, the unterminated last line is used
+    const float_t expected[] = {1.5f, -2.0f, 4.25f, 5.0f, 1.5f, -2.0f};
+    for(float_t e : expected) EXPECT_EQ(sensor.readSensor(), e);
+    EXPECT_FALSE(fs.hasOpenFile());
+}
+
+TEST_F(ReplaySensorTest, BinaryTest) {
+    const float_t values[] = {0.5f, 1.0f, -3.75f};
+    writeFile(binFilename, values, sizeof(values));
+    ASSERT_EQ(ReplaySensor::formatFromFilename(binFilename), ReplaySensor::BINARY);
+    ReplaySensor sensor(name, fs, binFilename, ReplaySensor::BINARY, false);
+    for(float_t v : values) EXPECT_EQ(sensor.readSensor(), v);
+    // No looping
+    EXPECT_TRUE(std::isnan(sensor.readSensor()));
+}
+
+TEST_F(ReplaySensorTest, LargeFileTest) {
+    // More data than fits in the buffer at once
+    std::string csv;
+    for(uint32_t i = 0; i < 500; i++) csv += std::to_string(i) + "\n";
+    writeFile(csvFilename, csv.c_str(), csv.size());
+    ReplaySensor sensor(name, fs, csvFilename, ReplaySensor::CSV);
+    for(uint32_t pass = 0; pass < 2; pass++) {
+        for(uint32_t i = 0; i < 500; i++) ASSERT_EQ(sensor.readSensor(), static_cast<float_t>(i));
+    }
+}
+
+TEST_F(ReplaySensorTest, InvalidFileTest) {
+    ReplaySensor missing(name, fs, "./does_not_exist.csv", ReplaySensor::CSV);
+    EXPECT_TRUE(std::isnan(missing.readSensor()));
+
+    const char csv[] = "no values\nin here\n";
+    writeFile(csvFilename, csv, sizeof(csv) - 1);
+    ReplaySensor empty(name, fs, csvFilename, ReplaySensor::CSV);
+    EXPECT_TRUE(std::isnan(empty.readSensor()));
+    EXPECT_TRUE(std::isnan(empty.readSensor()));
+}
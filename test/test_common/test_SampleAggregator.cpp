@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include "TestSensor.h"
+#include "sensors/SampleAggregator.h"
+
+TEST(SampleAggregator, Aggregates) {
+    SampleAggregator aggregator;
+    char json[128];
+    EXPECT_EQ(aggregator.getCount(), 0);
+    EXPECT_EQ(aggregator.toJson(json, sizeof(json), SampleAggregator::FIELD_ALL), RC_ERROR_BUFFER_EMPTY);
+
+    for(float_t v : {3.0f, -1.0f, 4.0f, 2.0f}) aggregator.add(v);
+    EXPECT_EQ(aggregator.getCount(), 4);
+    EXPECT_FLOAT_EQ(aggregator.getMin(), -1.0f);
+    EXPECT_FLOAT_EQ(aggregator.getMax(), 4.0f);
+    EXPECT_FLOAT_EQ(aggregator.getMean(), 2.0f);
+    EXPECT_FLOAT_EQ(aggregator.getLast(), 2.0f);
+
+    ASSERT_EQ(aggregator.toJson(json, sizeof(json), SampleAggregator::FIELD_ALL), RC_SUCCESS);
+    EXPECT_STREQ(json, "{\"min\":-1.000000,\"max\":4.000000,\"mean\":2.000000,\"last\":2.000000,\"count\":4}");
+    ASSERT_EQ(aggregator.toJson(json, sizeof(json), SampleAggregator::FIELD_MAX | SampleAggregator::FIELD_COUNT),
+              RC_SUCCESS);
+    EXPECT_STREQ(json, "{\"max\":4.000000,\"count\":4}");
+    EXPECT_EQ(aggregator.toJson(json, 20, SampleAggregator::FIELD_ALL), RC_ERROR_BUFFER_FULL);
+
+    // A new window does not remember the previous extremes
+    aggregator.reset();
+    aggregator.add(10.0f);
+    EXPECT_FLOAT_EQ(aggregator.getMin(), 10.0f);
+    EXPECT_FLOAT_EQ(aggregator.getMean(), 10.0f);
+    EXPECT_EQ(aggregator.getCount(), 1);
+}
+
+TEST(SampleAggregator, ParsesFieldList) {
+    uint8_t fields = 0;
+    ASSERT_EQ(SampleAggregator::fieldsFromString("min, max ,count", fields), RC_SUCCESS);
+    EXPECT_EQ(fields, SampleAggregator::FIELD_MIN | SampleAggregator::FIELD_MAX | SampleAggregator::FIELD_COUNT);
+    ASSERT_EQ(SampleAggregator::fieldsFromString("all", fields), RC_SUCCESS);
+    EXPECT_EQ(fields, SampleAggregator::FIELD_ALL);
+    EXPECT_EQ(SampleAggregator::fieldsFromString("min,median", fields), RC_ERROR_INVALID);
+    EXPECT_EQ(SampleAggregator::fieldsFromString("", fields), RC_ERROR_INVALID);
+    EXPECT_EQ(fields, SampleAggregator::FIELD_ALL);
+}
+
+TEST(SampleAggregator, SensorCadence) {
+    char name[] = "Fast";
+    SequenceSensor sensor(name);
+    sensor.setCadence(100, 1000, SampleAggregator::FIELD_ALL);
+
+    // Never sampled or published sensors are due immediately
+    uint32_t now = 5000;
+    EXPECT_TRUE(sensor.isSampleDue(now));
+    EXPECT_TRUE(sensor.isPublishDue(now));
+
+    // Run a second of a loop which checks every 10ms. The first publish only contains the first sample
+    uint32_t publishes = 0;
+    SampleAggregator last;
+    for(; now < 6000; now += 10) {
+        sensor.sampleIfDue(now);
+        if(sensor.takeAggregateIfDue(now, last)) publishes++;
+    }
+    EXPECT_EQ(publishes, 1);
+    EXPECT_EQ(last.getCount(), 1);
+    EXPECT_EQ(sensor.readCount, 10);
+    EXPECT_EQ(sensor.getTimeUntilDueMs(now), 0);
+
+    // The next window holds the ten samples taken since the first publish
+    EXPECT_TRUE(sensor.sampleIfDue(now));
+    ASSERT_TRUE(sensor.takeAggregateIfDue(now, last));
+    EXPECT_EQ(last.getCount(), 10);
+    EXPECT_FLOAT_EQ(last.getMin(), 1.0f);
+    EXPECT_FLOAT_EQ(last.getMax(), 10.0f);
+    EXPECT_FLOAT_EQ(last.getMean(), 5.5f);
+    EXPECT_FALSE(sensor.isPublishDue(now + 999));
+
+    // A missed deadline does not cause a burst of samples to catch up
+    now += 5000;
+    EXPECT_TRUE(sensor.sampleIfDue(now));
+    EXPECT_TRUE(sensor.takeAggregateIfDue(now, last));
+    EXPECT_FALSE(sensor.sampleIfDue(now + 10));
+    EXPECT_EQ(sensor.getTimeUntilDueMs(now + 10), 90);
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "TestSensor.h"
+#include "sensors/SampleCache.h"
+#include "transformers/Offset.h"
+
+TEST(SampleCache, EmptyCache) {
+    SampleCache cache;
+    SensorSample_t sample;
+    EXPECT_FALSE(cache.load(sample));
+    EXPECT_EQ(cache.getGeneration(), 0);
+}
+
+TEST(SampleCache, StoreLoad) {
+    SampleCache cache;
+    SensorSample_t sample;
+    // Store more samples than there are buffers to go through both slots
+    for(uint32_t i = 1; i <= 5; i++) {
+        SensorSample_t in = {i * 1.5f, i * 2.5f, i * 1000};
+        cache.store(in);
+        ASSERT_TRUE(cache.load(sample));
+        EXPECT_EQ(sample.value, in.value);
+        EXPECT_EQ(sample.rawValue, in.rawValue);
+        EXPECT_EQ(sample.timestamp, in.timestamp);
+        EXPECT_EQ(cache.getGeneration(), i);
+    }
+}
+
+TEST(SampleCache, SensorSampleUpdatesCache) {
+    char name[] = "test";
+    SequenceSensor sensor(name, std::make_shared<Offset>(10));
+    SensorSample_t cached;
+    EXPECT_FALSE(sensor.getLatestSample(cached));
+
+    sensor.nextValue = 5;
+    SensorSample_t sample = sensor.sample();
+    EXPECT_EQ(sample.rawValue, 5);
+    EXPECT_EQ(sample.value, 15);
+
+    // Reading the cache must not access the sensor
+    ASSERT_TRUE(sensor.getLatestSample(cached));
+    ASSERT_TRUE(sensor.getLatestSample(cached));
+    EXPECT_EQ(sensor.readCount, 1);
+    EXPECT_EQ(cached.value, 15);
+    EXPECT_EQ(cached.rawValue, 5);
+    EXPECT_EQ(cached.timestamp, sample.timestamp);
+}
+
+TEST(SampleCache, ConcurrentStoreLoad) {
+    SampleCache cache;
+    std::atomic<bool> done{false};
+    // All fields of a sample are derived from the same number, so a torn read is detectable
+    std::thread writer([&]() {
+        for(uint32_t i = 1; i <= 200000; i++) cache.store({static_cast<float_t>(i), static_cast<float_t>(2 * i), i});
+        done = true;
+    });
+    uint32_t loads = 0;
+    uint32_t torn = 0;
+    uint32_t reordered = 0;
+    uint32_t lastTimestamp = 0;
+    SensorSample_t sample;
+    while(!done || loads == 0) {
+        if(!cache.load(sample)) continue;
+        loads++;
+        if(sample.value != static_cast<float_t>(sample.timestamp) ||
+           sample.rawValue != static_cast<float_t>(2 * sample.timestamp))
+            torn++;
+        // Samples are never seen out of order
+        if(sample.timestamp < lastTimestamp) reordered++;
+        lastTimestamp = sample.timestamp;
+    }
+    writer.join();
+    EXPECT_EQ(torn, 0);
+    EXPECT_EQ(reordered, 0);
+    ASSERT_TRUE(cache.load(sample));
+    EXPECT_EQ(sample.timestamp, 200000);
+}
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+
+#include "storage/SampleLog.h"
+#ifdef ARDUINO
+    #include "filesystem/LittleFilesystem.h"
+#else
+    #include "filesystem/DesktopFilesystem.h"
+#endif  // ARDUINO
+
+class SampleLogTest : public testing::Test {
+   protected:
+#ifdef ARDUINO
+    LittleFilesystem fs;
+    const char prefix[16] = "/slogtest_";
+#else
+    DesktopFilesystem fs;
+    const char prefix[16] = "./slogtest_";
+#endif  // ARDUINO
+    static const uint32_t maxSegments = 4;
+
+    void removeSegments() {
+        for(uint32_t i = 0; i < maxSegments; i++) {
+            char filename[32];
+            snprintf(filename, sizeof(filename), "%s%u.bin", prefix, i);
+            if(fs.fileExists(filename)) fs.deleteFile(filename);
+        }
+    }
+
+    void SetUp() override { removeSegments(); }
+    void TearDown() override { removeSegments(); }
+
+    static SampleLog::Entry_t makeEntry(uint32_t id, uint32_t i) {
+        return {id, 20.0f + 0.1f * i, 400.0f + i};
+    }
+};
+
+TEST_F(SampleLogTest, EmptyLogTest) {
+    SampleLog log(fs, prefix, 1024, maxSegments);
+    ASSERT_EQ(log.begin(), RC_SUCCESS);
+    EXPECT_FALSE(log.hasUnreadRecords());
+    uint32_t timestamp, count;
+    SampleLog::Entry_t entries[4];
+    EXPECT_EQ(log.read(timestamp, entries, 4, count), RC_ERROR_BUFFER_EMPTY);
+    EXPECT_EQ(log.append(0, entries, 0), RC_ERROR_BAD_PARAM);
+}
+
+TEST_F(SampleLogTest, RoundTripTest) {
+    SampleLog log(fs, prefix, 4096, maxSegments);
+    ASSERT_EQ(log.begin(), RC_SUCCESS);
+    for(uint32_t i = 0; i < 50; i++) {
+        const SampleLog::Entry_t entries[2] = {makeEntry(0xAABBCCDD, i), makeEntry(42, 2 * i)};
+        ASSERT_EQ(log.append(1700000000 + 10 * i, entries, 2), RC_SUCCESS);
+    }
+    // Buffered records are not readable before they were flushed
+    EXPECT_GT(log.getBufferedBytes(), 0u);
+    ASSERT_EQ(log.flush(), RC_SUCCESS);
+    EXPECT_EQ(log.getBufferedBytes(), 0u);
+    EXPECT_TRUE(log.hasUnreadRecords());
+
+    for(uint32_t i = 0; i < 50; i++) {
+        uint32_t timestamp = 0, count = 0;
+        SampleLog::Entry_t entries[SAMPLE_LOG_MAX_ENTRIES_PER_RECORD];
+        ASSERT_EQ(log.read(timestamp, entries, SAMPLE_LOG_MAX_ENTRIES_PER_RECORD, count), RC_SUCCESS);
+        EXPECT_EQ(timestamp, 1700000000 + 10 * i);
+        ASSERT_EQ(count, 2u);
+        EXPECT_EQ(entries[0].sensorId, 0xAABBCCDD);
+        EXPECT_EQ(entries[0].value, makeEntry(0, i).value);
+        EXPECT_EQ(entries[0].rawValue, makeEntry(0, i).rawValue);
+        EXPECT_EQ(entries[1].sensorId, 42u);
+        EXPECT_EQ(entries[1].value, makeEntry(0, 2 * i).value);
+    }
+    uint32_t timestamp, count;
+    SampleLog::Entry_t entries[2];
+    EXPECT_EQ(log.read(timestamp, entries, 2, count), RC_ERROR_BUFFER_EMPTY);
+    EXPECT_FALSE(log.hasUnreadRecords());
+    EXPECT_EQ(log.getStatistics().recordsRead, 50u);
+}
+
+TEST_F(SampleLogTest, SpecialValuesTest) {
+    SampleLog log(fs, prefix, 4096, maxSegments);
+    ASSERT_EQ(log.begin(), RC_SUCCESS);
+    const float_t values[] = {0.0f, -0.0f, INFINITY, -1e30f, 1e-30f, NAN};
+    for(float_t v : values) {
+        const SampleLog::Entry_t entry = {1, v, -v};
+        ASSERT_EQ(log.append(5, &entry, 1), RC_SUCCESS);
+    }
+    ASSERT_EQ(log.flush(), RC_SUCCESS);
+    for(float_t v : values) {
+        uint32_t timestamp, count;
+        SampleLog::Entry_t entry;
+        ASSERT_EQ(log.read(timestamp, &entry, 1, count), RC_SUCCESS);
+        EXPECT_EQ(timestamp, 5u);
+        if(std::isnan(v)) {
+            EXPECT_TRUE(std::isnan(entry.value));
+        } else {
+            EXPECT_EQ(entry.value, v);
+            EXPECT_EQ(std::signbit(entry.rawValue), std::signbit(-v));
+        }
+    }
+}
+
+TEST_F(SampleLogTest, SegmentRotationTest) {
+    // Small segments so that the log has to rotate and drop the oldest segments
+    SampleLog log(fs, prefix, 256, maxSegments);
+    ASSERT_EQ(log.begin(), RC_SUCCESS);
+    const uint32_t n = 200;
+    for(uint32_t i = 0; i < n; i++) {
+        const SampleLog::Entry_t entry = makeEntry(7, i);
+        ASSERT_EQ(log.append(i, &entry, 1), RC_SUCCESS);
+    }
+    ASSERT_EQ(log.flush(), RC_SUCCESS);
+    EXPECT_GT(log.getStatistics().segmentsDropped, 0u);
+
+    // Only the newest records are left, in order and without gaps
+    uint32_t timestamp, count, expected = 0;
+    uint32_t readRecords = 0;
+    SampleLog::Entry_t entry;
+    while(log.read(timestamp, &entry, 1, count) == RC_SUCCESS) {
+        if(readRecords > 0) {
+            EXPECT_EQ(timestamp, expected);
+        }
+        EXPECT_EQ(entry.value, makeEntry(7, timestamp).value);
+        expected = timestamp + 1;
+        readRecords++;
+    }
+    EXPECT_EQ(expected, n);
+    EXPECT_LT(readRecords, n);
+    EXPECT_GT(readRecords, 0u);
+}
+
+TEST_F(SampleLogTest, ReopenTest) {
+    {
+        SampleLog log(fs, prefix, 512, maxSegments);
+        ASSERT_EQ(log.begin(), RC_SUCCESS);
+        for(uint32_t i = 0; i < 30; i++) {
+            const SampleLog::Entry_t entry = makeEntry(3, i);
+            ASSERT_EQ(log.append(i, &entry, 1), RC_SUCCESS);
+        }
+        ASSERT_EQ(log.flush(), RC_SUCCESS);
+    }
+    // Simulates a reboot. Records of before and after have to be read in order.
+    SampleLog log(fs, prefix, 512, maxSegments);
+    ASSERT_EQ(log.begin(), RC_SUCCESS);
+    EXPECT_TRUE(log.hasUnreadRecords());
+    for(uint32_t i = 30; i < 40; i++) {
+        const SampleLog::Entry_t entry = makeEntry(3, i);
+        ASSERT_EQ(log.append(i, &entry, 1), RC_SUCCESS);
+    }
+    ASSERT_EQ(log.flush(), RC_SUCCESS);
+
+    for(uint32_t i = 0; i < 40; i++) {
+        uint32_t timestamp, count;
+        SampleLog::Entry_t entry;
+        ASSERT_EQ(log.read(timestamp, &entry, 1, count), RC_SUCCESS);
+        EXPECT_EQ(timestamp, i);
+        EXPECT_EQ(entry.value, makeEntry(3, i).value);
+    }
+    EXPECT_FALSE(log.hasUnreadRecords());
+}
+
+TEST_F(SampleLogTest, InterleavedReadWriteTest) {
+    SampleLog log(fs, prefix, 300, maxSegments);
+    ASSERT_EQ(log.begin(), RC_SUCCESS);
+    uint32_t next = 0;
+    for(uint32_t i = 0; i < 60; i++) {
+        const SampleLog::Entry_t entry = makeEntry(9, i);
+        ASSERT_EQ(log.append(i, &entry, 1), RC_SUCCESS);
+        if(i % 7 == 0) {
+            ASSERT_EQ(log.flush(), RC_SUCCESS);
+            uint32_t timestamp, count;
+            SampleLog::Entry_t out;
+            while(log.read(timestamp, &out, 1, count) == RC_SUCCESS) {
+                EXPECT_EQ(timestamp, next);
+                next++;
+            }
+        }
+    }
+    EXPECT_EQ(next, 57u);
+    EXPECT_EQ(log.getStatistics().segmentsDropped, 0u);
+}
@@ -0,0 +1,282 @@
+#include <gtest/gtest.h>
+
+#include <string.h>
+
+#include <string>
+
+#include "config/SensorConfigParser.h"
+#ifdef ARDUINO
+    #include "filesystem/LittleFilesystem.h"
+#else
+    #include "filesystem/DesktopFilesystem.h"
+#endif  // ARDUINO
+
+static const char exampleConfig[] =
+    "//This is a comment//\n"
+    "RandomSensor[\n"
+    "    name: Test Thermometer\n"
+    "    lowerBound: 0   \n"
+    "    upperBound: 255 //trailing comment//\n"
+    "    Remapper{\n"
+    "        inMin: 0\n"
+    "        outMax: 40\n"
+    "    }\n"
+    "    SimpleMovingAverageFilter{ n: 4 }\n"
+    "]\r\n"
+    "ADCSensor [ name: Light\r\n pin: 4 ]\n";
+
+TEST(ConfigTokenizer, Tokens) {
+    const char text[] = "Type[\n  key:  some value \n Filter{a:1}]";
+    ConfigTokenizer tokenizer(text, strlen(text));
+    ConfigTokenizer::Token_t token;
+
+    ASSERT_EQ(tokenizer.next(token), RC_SUCCESS);
+    EXPECT_EQ(token.type, ConfigTokenizer::TOKEN_NAME);
+    EXPECT_TRUE(token.text.equals("Type"));
+    ASSERT_EQ(tokenizer.next(token), RC_SUCCESS);
+    EXPECT_EQ(token.type, ConfigTokenizer::TOKEN_SENSOR_OPEN);
+    ASSERT_EQ(tokenizer.next(token), RC_SUCCESS);
+    EXPECT_EQ(token.type, ConfigTokenizer::TOKEN_KEY_VALUE);
+    EXPECT_TRUE(token.text.equals("key"));
+    EXPECT_TRUE(token.value.equals("some value"));
+    EXPECT_EQ(token.line, 2);
+    EXPECT_EQ(token.column, 3);
+    // Views point into the original text
+    EXPECT_EQ(token.value.data(), strstr(text, "some"));
+    ASSERT_EQ(tokenizer.next(token), RC_SUCCESS);
+    EXPECT_EQ(token.type, ConfigTokenizer::TOKEN_NAME);
+    EXPECT_TRUE(token.text.equals("Filter"));
+    ASSERT_EQ(tokenizer.next(token), RC_SUCCESS);
+    EXPECT_EQ(token.type, ConfigTokenizer::TOKEN_TRANSFORMER_OPEN);
+    ASSERT_EQ(tokenizer.next(token), RC_SUCCESS);
+    EXPECT_TRUE(token.value.equals("1"));
+    ASSERT_EQ(tokenizer.next(token), RC_SUCCESS);
+    EXPECT_EQ(token.type, ConfigTokenizer::TOKEN_TRANSFORMER_CLOSE);
+    ASSERT_EQ(tokenizer.next(token), RC_SUCCESS);
+    EXPECT_EQ(token.type, ConfigTokenizer::TOKEN_SENSOR_CLOSE);
+    ASSERT_EQ(tokenizer.next(token), RC_SUCCESS);
+    EXPECT_EQ(token.type, ConfigTokenizer::TOKEN_END);
+}
+
+TEST(ConfigTokenizer, UnclosedComment) {
+    const char text[] = "Type[\n  //open comment\n]";
+    ConfigTokenizer tokenizer(text, strlen(text));
+    ConfigTokenizer::Token_t token;
+    ASSERT_EQ(tokenizer.next(token), RC_SUCCESS);
+    ASSERT_EQ(tokenizer.next(token), RC_SUCCESS);
+    EXPECT_EQ(tokenizer.next(token), RC_ERROR_BAD_DATA);
+    EXPECT_EQ(tokenizer.getErrorLine(), 2);
+    EXPECT_EQ(tokenizer.getErrorColumn(), 3);
+}
+
+TEST(StringView, Numbers) {
+    const struct {
+        const char* text;
+        RC_t err;
+        float_t value;
+    } floats[] = {{"1.5", RC_SUCCESS, 1.5f},
+                  {"-0.25", RC_SUCCESS, -0.25f},
+                  {"+3", RC_SUCCESS, 3.0f},
+                  {".5", RC_SUCCESS, 0.5f},
+                  {"2e3", RC_SUCCESS, 2000.0f},
+                  {"1.25E-2", RC_SUCCESS, 0.0125f},
+                  {"3.3333333333", RC_SUCCESS, 3.3333333333f},
+                  {"1e30", RC_SUCCESS, 1e30f},
+                  {"1e40", RC_ERROR_INVALID, 0},
+                  {"1e", RC_ERROR_INVALID, 0},
+                  {"12abc", RC_ERROR_INVALID, 0},
+                  {"-", RC_ERROR_INVALID, 0}};
+    for(const auto& f : floats) {
+        float_t value = 0;
+        EXPECT_EQ(StringView(f.text, strlen(f.text)).toFloat(value), f.err) << f.text;
+        if(RC_SUCCESS == f.err) {
+            EXPECT_FLOAT_EQ(value, f.value) << f.text;
+        }
+    }
+
+    int32_t i = 0;
+    EXPECT_EQ(StringView("-2147483648", 11).toInt(i), RC_SUCCESS);
+    EXPECT_EQ(i, INT32_MIN);
+    EXPECT_EQ(StringView("2147483648", 10).toInt(i), RC_ERROR_INVALID);
+    EXPECT_EQ(StringView("+42", 3).toInt(i), RC_SUCCESS);
+    EXPECT_EQ(i, 42);
+    EXPECT_EQ(StringView("4.2", 3).toInt(i), RC_ERROR_INVALID);
+    // The view ends in front of the following digits
+    EXPECT_EQ(StringView("12345", 2).toInt(i), RC_SUCCESS);
+    EXPECT_EQ(i, 12);
+    float_t f = 0;
+    EXPECT_EQ(StringView("1.2345", 3).toFloat(f), RC_SUCCESS);
+    EXPECT_FLOAT_EQ(f, 1.2f);
+}
+
+TEST(SensorConfigParser, ParsesSensors) {
+    SensorConfigParser parser(exampleConfig, strlen(exampleConfig));
+    SensorConfig_t config;
+
+    ASSERT_EQ(parser.next(config), RC_SUCCESS);
+    EXPECT_TRUE(config.sensor.type.equals("RandomSensor"));
+    EXPECT_EQ(config.sensor.line, 2);
+    char name[32];
+    EXPECT_EQ(config.sensor.getString("name", name, sizeof(name)), RC_SUCCESS);
+    EXPECT_STREQ(name, "Test Thermometer");
+    float_t f = 0;
+    EXPECT_EQ(config.sensor.getFloat("upperBound", f), RC_SUCCESS);
+    EXPECT_EQ(f, 255);
+    int32_t i = 0;
+    EXPECT_EQ(config.sensor.getInt("lowerBound", i), RC_SUCCESS);
+    EXPECT_EQ(config.sensor.getInt("upper", i), RC_ERROR_ZERO);
+    EXPECT_EQ(config.sensor.getString("name", name, 4), RC_ERROR_BUFFER_FULL);
+    ASSERT_EQ(config.transformers.size(), 2);
+    EXPECT_TRUE(config.transformers[0].type.equals("Remapper"));
+    EXPECT_EQ(config.transformers[0].values.size(), 2);
+    EXPECT_TRUE(config.transformers[1].type.equals("SimpleMovingAverageFilter"));
+    EXPECT_EQ(config.transformers[1].getInt("n", i), RC_SUCCESS);
+    EXPECT_EQ(i, 4);
+
+    ASSERT_EQ(parser.next(config), RC_SUCCESS);
+    EXPECT_TRUE(config.sensor.type.equals("ADCSensor"));
+    EXPECT_EQ(config.sensor.getInt("pin", i), RC_SUCCESS);
+    EXPECT_EQ(i, 4);
+    EXPECT_EQ(config.transformers.size(), 0);
+    EXPECT_EQ(parser.next(config), RC_ERROR_BUFFER_EMPTY);
+}
+
+TEST(SensorConfigParser, KeysMatchExactly) {
+    // A key which is the prefix of another key or contained in a value is not mixed up
+    const char text[] = "PulseCounterSensor[\npinMode: Input\npin: 5\n]\nSyntheticSensor[\nwaveform: noise\nnoise: 2\n]";
+    SensorConfigParser parser(text, strlen(text));
+    SensorConfig_t config;
+    ASSERT_EQ(parser.next(config), RC_SUCCESS);
+    int32_t pin = 0;
+    EXPECT_EQ(config.sensor.getInt("pin", pin), RC_SUCCESS);
+    EXPECT_EQ(pin, 5);
+    ASSERT_EQ(parser.next(config), RC_SUCCESS);
+    float_t noise = 0;
+    EXPECT_EQ(config.sensor.getFloat("noise", noise), RC_SUCCESS);
+    EXPECT_EQ(noise, 2);
+}
+
+TEST(SensorConfigParser, InvalidValues) {
+    const char text[] = "T[\nempty:\nnumber: 12abc\n]";
+    SensorConfigParser parser(text, strlen(text));
+    SensorConfig_t config;
+    ASSERT_EQ(parser.next(config), RC_SUCCESS);
+    int32_t i = 0;
+    char str[8];
+    EXPECT_EQ(config.sensor.getString("empty", str, sizeof(str)), RC_ERROR_BAD_DATA);
+    EXPECT_EQ(config.sensor.getInt("number", i), RC_ERROR_INVALID);
+}
+
+TEST(SensorConfigParser, SyntaxErrors) {
+    const struct {
+        const char* text;
+        uint32_t line;
+        uint32_t column;
+    } cases[] = {{"RandomSensor\n  name: x\n]", 2, 3},
+                 {"RandomSensor[\n  name: x\n", 1, 1},
+                 {"RandomSensor[\n  Remapper{\n  inMin: 0\n]", 4, 1},
+                 {"RandomSensor[\n  : 5\n]", 2, 3},
+                 {"]", 1, 1}};
+    for(const auto& c : cases) {
+        SensorConfigParser parser(c.text, strlen(c.text));
+        SensorConfig_t config;
+        EXPECT_EQ(parser.next(config), RC_ERROR_BAD_DATA) << c.text;
+        EXPECT_EQ(parser.getErrorLine(), c.line) << c.text;
+        EXPECT_EQ(parser.getErrorColumn(), c.column) << c.text;
+        EXPECT_STRNE(parser.getErrorMessage(), "") << c.text;
+    }
+}
+
+TEST(SensorConfigParser, HashIgnoresFormatting) {
+    const char a[] = "T[\n  name: x //comment//\n  F{ n: 4 }\n]";
+    const char b[] = "T [name:x\nF{\nn:4\n}]";
+    const char c[] = "T[\n  name: y\n  F{ n: 4 }\n]";
+    uint32_t hashes[3];
+    const char* texts[] = {a, b, c};
+    for(uint32_t i = 0; i < 3; i++) {
+        SensorConfigParser parser(texts[i], strlen(texts[i]));
+        SensorConfig_t config;
+        ASSERT_EQ(parser.next(config), RC_SUCCESS);
+        hashes[i] = config.sensor.hash();
+        for(const ConfigSection& t : config.transformers) hashes[i] = t.hash(hashes[i]);
+    }
+    EXPECT_EQ(hashes[0], hashes[1]);
+    EXPECT_NE(hashes[0], hashes[2]);
+}
+
+class SensorConfigFileTest : public testing::Test {
+   protected:
+#ifdef ARDUINO
+    LittleFilesystem fs;
+    const char* filename = "/sensorconfigtest.txt";
+#else
+    DesktopFilesystem fs;
+    const char* filename = "./sensorconfigtest.txt";
+#endif  // ARDUINO
+
+    void TearDown() override {
+        fs.closeFile();
+        fs.deleteFile(filename);
+    }
+
+    void write(const std::string& text) {
+        ASSERT_EQ(fs.openFile(filename, Filesystem::WRITE_TRUNCATE), RC_SUCCESS);
+        ASSERT_EQ(fs.write(reinterpret_cast<const uint8_t*>(text.data()), text.size()), RC_SUCCESS);
+        fs.closeFile();
+    }
+};
+
+TEST_F(SensorConfigFileTest, SameAsInMemory) {
+    std::string text;
+    for(uint32_t i = 0; i < 20; i++) text += exampleConfig;
+    write(text);
+
+    // Buffers which are refilled in the middle of every kind of token
+    for(uint32_t size = 200; size < 260; size++) {
+        ASSERT_EQ(fs.openFile(filename), RC_SUCCESS);
+        char buffer[260];
+        SensorConfigParser fromFile(fs, buffer, size);
+        SensorConfigParser inMemory(text.data(), text.size());
+        SensorConfig_t expected, config;
+        uint32_t sensors = 0;
+        while(true) {
+            const RC_t err = inMemory.next(expected);
+            ASSERT_EQ(fromFile.next(config), err) << size;
+            if(RC_SUCCESS != err) break;
+            sensors++;
+            EXPECT_EQ(config.sensor.line, expected.sensor.line);
+            uint32_t hash = config.sensor.hash(), expectedHash = expected.sensor.hash();
+            for(const ConfigSection& t : config.transformers) hash = t.hash(hash);
+            for(const ConfigSection& t : expected.transformers) expectedHash = t.hash(expectedHash);
+            EXPECT_EQ(hash, expectedHash) << size;
+        }
+        EXPECT_EQ(sensors, 40);
+        fs.closeFile();
+    }
+}
+
+TEST_F(SensorConfigFileTest, DefinitionLongerThanBuffer) {
+    write("A[ name: a ]\n  B[\n name: b\n pin: 4\n]");
+    ASSERT_EQ(fs.openFile(filename), RC_SUCCESS);
+    char buffer[16];
+    SensorConfigParser parser(fs, buffer, sizeof(buffer));
+    SensorConfig_t config;
+    ASSERT_EQ(parser.next(config), RC_SUCCESS);
+    EXPECT_TRUE(config.sensor.type.equals("A"));
+    EXPECT_EQ(parser.next(config), RC_ERROR_OVERRUN);
+    EXPECT_EQ(parser.getErrorLine(), 2);
+    EXPECT_EQ(parser.getErrorColumn(), 3);
+    EXPECT_STRNE(parser.getErrorMessage(), "");
+}
+
+TEST_F(SensorConfigFileTest, SyntaxErrorPositions) {
+    write("A[ name: a ]\n//comment\n//\nB[\n  : 5\n]");
+    ASSERT_EQ(fs.openFile(filename), RC_SUCCESS);
+    char buffer[24];
+    SensorConfigParser parser(fs, buffer, sizeof(buffer));
+    SensorConfig_t config;
+    ASSERT_EQ(parser.next(config), RC_SUCCESS);
+    EXPECT_EQ(parser.next(config), RC_ERROR_BAD_DATA);
+    EXPECT_EQ(parser.getErrorLine(), 5);
+    EXPECT_EQ(parser.getErrorColumn(), 3);
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <string.h>
+
+#include <memory>
+
+#include "adc/FakeSampleSource.h"
+#include "gpio/SimulatedGpio.h"
+#include "i2c/SimulatedI2cBus.h"
+#include "sensors/SensorFactory.h"
+#ifdef ARDUINO
+    #include "filesystem/LittleFilesystem.h"
+#else
+    #include "filesystem/DesktopFilesystem.h"
+#endif  // ARDUINO
+
+class SensorFactoryTest : public testing::Test {
+   protected:
+#ifdef ARDUINO
+    LittleFilesystem fs;
+#else
+    DesktopFilesystem fs;
+#endif  // ARDUINO
+    SimulatedGpio gpio;
+    FakeSampleSource source;
+    AdcAcquisition acquisition{source};
+    SimulatedI2cBus bus;
+    I2cBusManager i2cBusManager{bus};
+    UrgentEventQueue events;
+    const SensorContext_t context = {fs, gpio, acquisition, i2cBusManager, &events};
+
+    /**
+     * @brief Parses the first sensor definition of text and creates the sensor
+     */
+    std::unique_ptr<Sensor> create(const char text[], StringView* errorKey = nullptr) {
+        SensorConfigParser parser(text, strlen(text));
+        if(RC_SUCCESS != parser.next(m_config)) return nullptr;
+        return std::unique_ptr<Sensor>(SensorFactory::sensorFromConfig(m_config, context, errorKey));
+    }
+
+   private:
+    SensorConfig_t m_config;
+};
+
+TEST_F(SensorFactoryTest, RandomSensorWithTransformers) {
+    std::unique_ptr<Sensor> sensor = create(
+        "RandomSensor[ name: Constant\n lowerBound: 10\n upperBound: 10\n publishIntervalS: 5\n"
+        "  Offset{ offset: 4 }\n  Remapper{ inMin: 0\n inMax: 100\n outMin: 0\n outMax: 50 }\n]");
+    ASSERT_NE(sensor, nullptr);
+    EXPECT_STREQ(sensor->getName(), "Constant");
+    EXPECT_EQ(sensor->getNumPipelineStages(), 2);
+    EXPECT_EQ(sensor->getPublishIntervalMs(), 5000);
+    EXPECT_EQ(create("RandomSensor[ name: R\n lowerBound: 0\n upperBound: 1\n decimals: 2 ]")->getDecimals(), 2);
+    // The remapper is applied first, the topmost transformer last
+    EXPECT_FLOAT_EQ(sensor->readSensor(), 9);
+}
+
+TEST_F(SensorFactoryTest, DefaultValues) {
+    std::unique_ptr<Sensor> sensor = create("SyntheticSensor[ name: Wave\n waveform: step\n amplitude: 2 ]");
+    ASSERT_NE(sensor, nullptr);
+    EXPECT_EQ(sensor->getPublishIntervalMs(), SENSOR_POLLING_INTERVAL_S * 1000);
+    EXPECT_EQ(sensor->getSampleIntervalMs(), SENSOR_POLLING_INTERVAL_S * 1000);
+    EXPECT_EQ(sensor->getAdaptiveInterval(), nullptr);
+    EXPECT_EQ(sensor->getDecimals(), FLOAT_FORMAT_MAX_DECIMALS);
+
+    // Invalid values are rejected by the constructor function
+    EXPECT_EQ(create("SyntheticSensor[ name: Wave\n waveform: step\n amplitude: 2\n period: 0 ]"), nullptr);
+}
+
+TEST_F(SensorFactoryTest, Errors) {
+    StringView errorKey;
+    // Misspelled key
+    EXPECT_EQ(create("RandomSensor[ name: R\n lowerBound: 0\n upperBound: 1\n upperbound: 2 ]", &errorKey), nullptr);
+    EXPECT_TRUE(errorKey.equals("upperbound"));
+    // Missing required key
+    EXPECT_EQ(create("RandomSensor[ name: R\n lowerBound: 0 ]", &errorKey), nullptr);
+    EXPECT_TRUE(errorKey.equals("upperBound"));
+    // Value of the wrong type
+    EXPECT_EQ(create("RandomSensor[ name: R\n lowerBound: low\n upperBound: 1 ]", &errorKey), nullptr);
+    EXPECT_TRUE(errorKey.equals("lowerBound"));
+    // Invalid common parameter
+    EXPECT_EQ(create("RandomSensor[ name: R\n lowerBound: 0\n upperBound: 1\n sampleIntervalMs: 1 ]", &errorKey),
+              nullptr);
+    EXPECT_TRUE(errorKey.equals("sampleIntervalMs"));
+    EXPECT_EQ(create("RandomSensor[ name: R\n lowerBound: 0\n upperBound: 1\n decimals: 7 ]", &errorKey), nullptr);
+    EXPECT_TRUE(errorKey.equals("decimals"));
+    // Unknown sensor and transformer types
+    EXPECT_EQ(create("Thermometer[ name: T ]", &errorKey), nullptr);
+    EXPECT_TRUE(errorKey.equals("Thermometer"));
+    EXPECT_EQ(create("RandomSensor[ name: R\n lowerBound: 0\n upperBound: 1\n Lowpass{ n: 4 } ]", &errorKey), nullptr);
+    EXPECT_TRUE(errorKey.equals("Lowpass"));
+    // Unknown key of a transformer
+    EXPECT_EQ(create("RandomSensor[ name: R\n lowerBound: 0\n upperBound: 1\n Offset{ offset: 1\n n: 4 } ]", &errorKey),
+              nullptr);
+    EXPECT_TRUE(errorKey.equals("n"));
+}
+
+TEST(SensorTypes, Registration) {
+    // Registered from static objects in the source files of the types
+    const SensorType_t* type = SensorTypes::find(StringView("SyntheticSensor", 15));
+    ASSERT_NE(type, nullptr);
+    EXPECT_STREQ(type->name, "SyntheticSensor");
+    EXPECT_EQ(type->nameHash, hashString("SyntheticSensor"));
+    EXPECT_EQ(SensorTypes::find(StringView("Synthetic", 9)), nullptr);
+    EXPECT_NE(TransformerTypes::find(StringView("DigitalThreshold", 16)), nullptr);
+
+    // Names have to be unique
+    const SensorType_t duplicate = *type;
+    EXPECT_EQ(SensorTypes::add(duplicate), RC_ERROR_BUSY);
+    EXPECT_LE(2 * SensorTypes::size(), SENSOR_TYPE_TABLE_SIZE);
+}
+
+TEST(ConfigParams, Schema) {
+    static const ConfigParam_t schema[] = {
+        {"count", CONFIG_PARAM_INT, true, nullptr},
+        {"gain", CONFIG_PARAM_FLOAT, false, "1.5"},
+        {"label", CONFIG_PARAM_STRING, false, nullptr},
+    };
+    const char text[] = "Type[ count: 3 ]";
+    SensorConfigParser parser(text, strlen(text));
+    SensorConfig_t config;
+    ASSERT_EQ(parser.next(config), RC_SUCCESS);
+
+    ConfigParams params;
+    ASSERT_EQ(params.parse(config.sensor, schema, ARRAY_SIZE(schema)), RC_SUCCESS);
+    EXPECT_EQ(params.getInt("count"), 3);
+    EXPECT_FLOAT_EQ(params.getFloat("gain"), 1.5);
+    EXPECT_FALSE(params.isSet("label"));
+    char label[8] = "x";
+    EXPECT_EQ(params.getString("label", label, sizeof(label)), RC_SUCCESS);
+    EXPECT_STREQ(label, "");
+    EXPECT_TRUE(params.contains(StringView("gain", 4)));
+    EXPECT_FALSE(params.contains(StringView("gai", 3)));
+
+    // The value of a required key has to be convertible
+    const char bad[] = "Type[ count: 3.5 ]";
+    SensorConfigParser badParser(bad, strlen(bad));
+    ASSERT_EQ(badParser.next(config), RC_SUCCESS);
+    EXPECT_EQ(params.parse(config.sensor, schema, ARRAY_SIZE(schema)), RC_ERROR_INVALID);
+    EXPECT_STREQ(params.getErrorKey(), "count");
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include "helper_functions.h"
+#include "sensors/Sensor.h"
+
+/**
+ * @brief Sensor whose reads can be made to fail or to take a given time
+ */
+class FlakySensor : public Sensor {
+   public:
+    FlakySensor(char name[]) : Sensor(name) {}
+    float_t readSensorRaw() override {
+        const uint32_t start = getUptimeUs();
+        while(getUptimeUs() - start < readTimeUs) {
+        }
+        if(fail) reportReadFailure();
+        return 1.0f;
+    }
+    bool fail = false;
+    uint32_t readTimeUs = 0;
+};
+
+TEST(SensorHealth, BackoffAfterRepeatedFailures) {
+    SensorHealth health;
+    // Single failures are tolerated
+    for(uint32_t i = 1; i < SENSOR_FAULT_THRESHOLD; i++) {
+        EXPECT_TRUE(health.record(1000, 10, true, 100));
+        EXPECT_FALSE(health.isDegraded());
+    }
+    EXPECT_EQ(health.getConsecutiveFaults(), SENSOR_FAULT_THRESHOLD - 1);
+    EXPECT_FALSE(health.record(1000, 10, false, 100));
+    EXPECT_EQ(health.getConsecutiveFaults(), 0);
+
+    // The backoff starts at twice the interval and doubles with each further fault
+    for(uint32_t i = 0; i < SENSOR_FAULT_THRESHOLD; i++) health.record(2000, 10, true, 100);
+    EXPECT_TRUE(health.isDegraded());
+    EXPECT_EQ(health.getBackoffMs(), 200);
+    EXPECT_EQ(health.getTimeUntilRetryMs(2050), 150);
+    EXPECT_EQ(health.getTimeUntilRetryMs(2200), 0);
+    health.record(2200, 10, true, 100);
+    EXPECT_EQ(health.getBackoffMs(), 400);
+    EXPECT_EQ(health.getTimeUntilRetryMs(2200), 400);
+    EXPECT_EQ(health.getFailureCount(), 2 * SENSOR_FAULT_THRESHOLD);
+
+    // The backoff is limited
+    for(uint32_t i = 0; i < 32; i++) health.record(3000, 10, true, 100);
+    EXPECT_EQ(health.getBackoffMs(), SENSOR_MAX_BACKOFF_MS);
+
+    // One good read ends it
+    EXPECT_FALSE(health.record(4000, 10, false, 100));
+    EXPECT_FALSE(health.isDegraded());
+    EXPECT_EQ(health.getBackoffMs(), 0);
+    EXPECT_EQ(health.getTimeUntilRetryMs(4000), 0);
+    EXPECT_EQ(health.getReadCount(), 2 * SENSOR_FAULT_THRESHOLD + 34);
+}
+
+TEST(SensorHealth, OverrunSkipsSensor) {
+    SensorHealth health;
+    health.setBudgetUs(1000);
+    EXPECT_FALSE(health.record(0, 1000, false, 50));
+    EXPECT_TRUE(health.record(0, 1001, false, 50));
+    EXPECT_TRUE(health.isDegraded());
+    EXPECT_EQ(health.getOverrunCount(), 1);
+    EXPECT_EQ(health.getFailureCount(), 0);
+    EXPECT_EQ(health.getMaxDurationUs(), 1001);
+    EXPECT_EQ(health.getLastDurationUs(), 1001);
+
+    // Without a budget nothing is too slow
+    health.setBudgetUs(0);
+    EXPECT_FALSE(health.record(0, UINT32_MAX, false, 50));
+}
+
+TEST(SensorHealth, DegradedSensorKeepsOthersOnCadence) {
+    char slowName[] = "Slow";
+    char fastName[] = "Fast";
+    FlakySensor slow(slowName);
+    FlakySensor fast(fastName);
+    slow.setCadence(100, 1000, 0);
+    fast.setCadence(100, 1000, 0);
+    slow.setTimeBudget(1);
+    slow.readTimeUs = 2000;
+
+    uint32_t now = 0;
+    EXPECT_TRUE(slow.sampleIfDue(now));
+    EXPECT_TRUE(fast.sampleIfDue(now));
+    EXPECT_TRUE(slow.getHealth().isDegraded());
+    EXPECT_EQ(slow.getHealth().getOverrunCount(), 1);
+
+    // The slow sensor is skipped for twice its interval while the other one continues
+    uint32_t slowReads = 0, fastReads = 0;
+    for(now = 10; now < 200; now += 10) {
+        if(slow.sampleIfDue(now)) slowReads++;
+        if(fast.sampleIfDue(now)) fastReads++;
+    }
+    EXPECT_EQ(slowReads, 0);
+    EXPECT_EQ(fastReads, 1);
+    EXPECT_FALSE(slow.isSampleDue(150));
+
+    // Failed reads are not aggregated
+    SampleAggregator aggregate;
+    slow.readTimeUs = 0;
+    slow.fail = true;
+    EXPECT_TRUE(slow.takeAggregateIfDue(now, aggregate));
+    EXPECT_TRUE(slow.sampleIfDue(200));
+    EXPECT_TRUE(slow.takeAggregateIfDue(1200, aggregate));
+    EXPECT_EQ(aggregate.getCount(), 0);
+    EXPECT_EQ(slow.getHealth().getConsecutiveFaults(), 2);
+
+    // A good read clears the fault state
+    slow.fail = false;
+    EXPECT_TRUE(slow.sampleIfDue(1300));
+    EXPECT_FALSE(slow.getHealth().isDegraded());
+    EXPECT_EQ(slow.getHealth().getConsecutiveFaults(), 0);
+}
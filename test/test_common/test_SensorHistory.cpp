@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "TestSensor.h"
+#include "history/Lttb.h"
+#include "history/SensorHistory.h"
+
+#define MS_PER_MINUTE (60UL * 1000UL)
+
+static std::vector<HistoryPoint_t> runQuery(const SensorHistory& history, uint32_t from, uint32_t to,
+                                            uint32_t maxPoints, SensorHistory::Tier_t& tier) {
+    std::vector<HistoryPoint_t> points;
+    history.query(
+        from, to, maxPoints, [&points](const HistoryPoint_t& p) { points.push_back(p); }, tier);
+    return points;
+}
+
+TEST(SensorHistory, MinuteAggregation) {
+    SensorHistory history(1000, 10, 10);
+    // One sample every 10 seconds for three minutes. Values count up within each minute
+    for(uint32_t t = 0; t < 3 * MS_PER_MINUTE; t += 10000) {
+        history.add({static_cast<float_t>((t % MS_PER_MINUTE) / 10000), 0, t});
+    }
+    EXPECT_EQ(history.size(SensorHistory::TIER_RAW), 18);
+    // The third minute is still open
+    ASSERT_EQ(history.size(SensorHistory::TIER_MINUTE), 2);
+    EXPECT_EQ(history.size(SensorHistory::TIER_HOUR), 0);
+
+    SensorHistory::Tier_t tier;
+    // Only 2 points are requested and the minute tier can provide them
+    std::vector<HistoryPoint_t> points = runQuery(history, 0, 2 * MS_PER_MINUTE, 2, tier);
+    EXPECT_EQ(tier, SensorHistory::TIER_MINUTE);
+    ASSERT_EQ(points.size(), 2);
+    EXPECT_EQ(points[1].timestamp, MS_PER_MINUTE);
+    EXPECT_FLOAT_EQ(points[1].min, 0);
+    EXPECT_FLOAT_EQ(points[1].max, 5);
+    EXPECT_FLOAT_EQ(points[1].value, 2.5);
+}
+
+TEST(SensorHistory, PicksRawTierForSmallRanges) {
+    SensorHistory history(1000, 10, 10);
+    for(uint32_t i = 0; i < 100; i++) history.add({static_cast<float_t>(i), 0, i * 1000});
+
+    SensorHistory::Tier_t tier;
+    std::vector<HistoryPoint_t> points = runQuery(history, 10000, 19000, 100, tier);
+    EXPECT_EQ(tier, SensorHistory::TIER_RAW);
+    ASSERT_EQ(points.size(), 10);
+    EXPECT_EQ(points.front().timestamp, 10000);
+    EXPECT_EQ(points.back().timestamp, 19000);
+    EXPECT_EQ(points.back().value, points.back().max);
+}
+
+TEST(SensorHistory, FallsBackToCoarserTierForOverwrittenData) {
+    // Raw tier only holds the last minute
+    SensorHistory history(60, 100, 10);
+    for(uint32_t t = 0; t < 10 * MS_PER_MINUTE; t += 1000) history.add({1, 0, t});
+    EXPECT_EQ(history.size(SensorHistory::TIER_RAW), 60);
+
+    SensorHistory::Tier_t tier;
+    std::vector<HistoryPoint_t> points = runQuery(history, 0, UINT32_MAX, 100, tier);
+    EXPECT_EQ(tier, SensorHistory::TIER_MINUTE);
+    EXPECT_EQ(points.size(), 9);
+}
+
+TEST(SensorHistory, MinuteTierCoversEarlyUptime) {
+    // The first sample is taken a while after boot, so the first minute starts after the requested range
+    SensorHistory history(60, 100, 10);
+    for(uint32_t t = 65000; t < 10 * MS_PER_MINUTE; t += 1000) history.add({1, 0, t});
+
+    SensorHistory::Tier_t tier;
+    std::vector<HistoryPoint_t> points = runQuery(history, 0, UINT32_MAX, 100, tier);
+    EXPECT_EQ(tier, SensorHistory::TIER_MINUTE);
+    EXPECT_EQ(points.size(), 8);
+}
+
+TEST(SensorHistory, SkipsFailedReads) {
+    char name[] = "test";
+    SequenceSensor sensor(name);
+    sensor.setHistory(std::make_shared<SensorHistory>(10, 10, 10));
+    sensor.nextValue = NAN;
+    sensor.sample();
+    EXPECT_EQ(sensor.getHistory()->size(SensorHistory::TIER_RAW), 0);
+    sensor.nextValue = 1;
+    sensor.sample();
+    EXPECT_EQ(sensor.getHistory()->size(SensorHistory::TIER_RAW), 1);
+}
+
+TEST(SensorHistory, DownsamplesToRequestedPoints) {
+    SensorHistory history(2000, 10, 10);
+    for(uint32_t i = 0; i < 2000; i++) history.add({static_cast<float_t>(i % 50), 0, i * 100});
+
+    SensorHistory::Tier_t tier;
+    std::vector<HistoryPoint_t> points = runQuery(history, 0, UINT32_MAX, 20, tier);
+    ASSERT_EQ(points.size(), 20);
+    EXPECT_EQ(points.front().timestamp, 0);
+    EXPECT_EQ(points.back().timestamp, 1999 * 100);
+    for(uint32_t i = 1; i < points.size(); i++) EXPECT_LT(points[i - 1].timestamp, points[i].timestamp);
+}
+
+TEST(SensorHistory, MemoryBudget) {
+    const uint32_t budget = 8192;
+    std::shared_ptr<SensorHistory> history = SensorHistory::createWithBudget(budget);
+    EXPECT_LE(history->getMemoryUsage(), budget);
+    EXPECT_GT(history->getMemoryUsage(), budget * 9 / 10);
+
+    // Budgets smaller than the hour tier must not overflow
+    history = SensorHistory::createWithBudget(64);
+    EXPECT_LE(history->getMemoryUsage(), 64);
+}
+
+TEST(Lttb, KeepsPeaks) {
+    // Flat line with a single spike which has to survive downsampling
+    std::vector<HistoryPoint_t> in;
+    for(uint32_t i = 0; i < 1000; i++) {
+        float_t v = (i == 500) ? 100 : 0;
+        in.push_back({i, v, v, v});
+    }
+    std::vector<HistoryPoint_t> out;
+    uint32_t n = downsampleLttb(
+        in.size(), 10, [&in](uint32_t i) { return in[i]; }, [&out](const HistoryPoint_t& p) { out.push_back(p); });
+    ASSERT_EQ(n, 10);
+    ASSERT_EQ(out.size(), 10);
+    bool spikeFound = false;
+    for(const HistoryPoint_t& p : out) spikeFound |= (p.value == 100);
+    EXPECT_TRUE(spikeFound);
+}
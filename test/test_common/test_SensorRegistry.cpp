@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "TestSensor.h"
+#include "helper_functions.h"
+#include "sensors/SensorRegistry.h"
+
+static std::shared_ptr<Sensor> makeSensor(const char name[]) {
+    char buf[SENSOR_NAME_MAX_LENGTH];
+    strncpy(buf, name, sizeof(buf) - 1);
+    buf[sizeof(buf) - 1] = '\0';
+    return std::make_shared<SequenceSensor>(buf);
+}
+
+TEST(SensorRegistry, AddAndFind) {
+    SensorRegistry registry;
+    EXPECT_EQ(registry.find("missing"), nullptr);
+    EXPECT_EQ(registry.find(static_cast<uint32_t>(0)), nullptr);
+
+    ASSERT_EQ(registry.add(makeSensor("Temperature")), RC_SUCCESS);
+    ASSERT_EQ(registry.add(makeSensor("Humidity")), RC_SUCCESS);
+    EXPECT_EQ(registry.size(), 2);
+
+    Sensor* s = registry.find("Humidity");
+    ASSERT_NE(s, nullptr);
+    EXPECT_STREQ(s->getName(), "Humidity");
+    EXPECT_EQ(registry.find(s->getId()), s);
+    EXPECT_EQ(s->getId(), hashString("Humidity"));
+    EXPECT_EQ(registry.find("Pressure"), nullptr);
+
+    // Iteration keeps insertion order
+    EXPECT_STREQ(registry.at(0)->getName(), "Temperature");
+    EXPECT_STREQ(registry.at(1)->getName(), "Humidity");
+}
+
+TEST(SensorRegistry, RejectsDuplicateNames) {
+    SensorRegistry registry;
+    ASSERT_EQ(registry.add(makeSensor("Light")), RC_SUCCESS);
+    EXPECT_EQ(registry.add(makeSensor("Light")), RC_ERROR_INVALID);
+    EXPECT_EQ(registry.add(nullptr), RC_ERROR_NULL);
+    EXPECT_EQ(registry.size(), 1);
+}
+
+TEST(SensorRegistry, GrowsIndex) {
+    SensorRegistry registry;
+    const uint32_t count = 500;
+    for(uint32_t i = 0; i < count; i++) {
+        std::string name = "Sensor" + std::to_string(i);
+        ASSERT_EQ(registry.add(makeSensor(name.c_str())), RC_SUCCESS);
+    }
+    ASSERT_EQ(registry.size(), count);
+    for(uint32_t i = 0; i < count; i++) {
+        std::string name = "Sensor" + std::to_string(i);
+        Sensor* s = registry.find(name.c_str());
+        ASSERT_NE(s, nullptr);
+        EXPECT_STREQ(s->getName(), name.c_str());
+    }
+
+    registry.clear();
+    EXPECT_EQ(registry.size(), 0);
+    EXPECT_EQ(registry.find("Sensor1"), nullptr);
+}
+
+TEST(SensorRegistry, FindByConfigHash) {
+    SensorRegistry active;
+    std::shared_ptr<Sensor> light = makeSensor("Light");
+    light->setConfigHash(hashIgnoringWhitespace("BH1750 name: Light"));
+    ASSERT_EQ(active.add(light), RC_SUCCESS);
+    ASSERT_EQ(active.add(makeSensor("Temperature")), RC_SUCCESS);
+
+    // Formatting changes don't change the hash
+    const uint32_t hash = hashIgnoringWhitespace("BH1750\n  name:Light\n");
+    EXPECT_EQ(active.findByConfigHash(hash), light);
+    EXPECT_EQ(active.findByConfigHash(hashIgnoringWhitespace("BH1750 name: Light2")), nullptr);
+
+    // A sensor can be shared by the active and a new registry, keeping its state
+    SensorRegistry next;
+    ASSERT_EQ(next.add(active.findByConfigHash(hash)), RC_SUCCESS);
+    EXPECT_EQ(next.find("Light"), light.get());
+    EXPECT_EQ(next.find("Temperature"), nullptr);
+}
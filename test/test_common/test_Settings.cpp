@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "settings.h"
+#ifdef ARDUINO
+    #include "filesystem/LittleFilesystem.h"
+#else
+    #include "filesystem/DesktopFilesystem.h"
+#endif  // ARDUINO
+
+class SettingsTest : public testing::Test {
+   protected:
+#ifdef ARDUINO
+    LittleFilesystem fs;
+    const char* filename = "/settingstest.txt";
+#else
+    DesktopFilesystem fs;
+    const char* filename = "./settingstest.txt";
+#endif  // ARDUINO
+    settings_t settings;
+    uint32_t found = 0;
+    uint32_t invalid = 0;
+
+    void TearDown() override { fs.deleteFile(filename); }
+
+    void write(const std::string& text) {
+        ASSERT_EQ(fs.openFile(filename, Filesystem::WRITE_TRUNCATE), RC_SUCCESS);
+        ASSERT_EQ(fs.write(reinterpret_cast<const uint8_t*>(text.data()), text.size()), RC_SUCCESS);
+        fs.closeFile();
+    }
+
+    std::string read() {
+        EXPECT_EQ(fs.openFile(filename), RC_SUCCESS);
+        std::string text(fs.size(), '\0');
+        fs.read(reinterpret_cast<uint8_t*>(&text[0]), text.size());
+        fs.closeFile();
+        return text;
+    }
+};
+
+TEST_F(SettingsTest, Parse) {
+    write(
+        "WIFI_SSID: Example SSID \r\n"
+        "//WiFi password is stored separately\n"
+        "WIFI_Password: in a comment\n"
+        "until here//\n"
+        "MQTT_Broker_Address:192.168.1.103 //inline comment//\n"
+        "MQTT_Broker_Port: 1883\n"
+        "MQTT_Username:\n"
+        "Unknown_Key: value\n"
+        "no key-value pair\n"
+        "MQTT_Device_Topic: Test");
+    ASSERT_EQ(parseSettingsFile(fs, filename, settings, &found, &invalid), RC_SUCCESS);
+    EXPECT_STREQ(settings.wifi.ssid, "Example SSID");
+    EXPECT_STREQ(settings.wifi.password, "");
+    EXPECT_STREQ(settings.mqtt.brokerAddress, "192.168.1.103");
+    EXPECT_EQ(settings.mqtt.brokerPort, 1883);
+    EXPECT_STREQ(settings.mqtt.username, "");
+    EXPECT_STREQ(settings.mqtt.deviceTopic, "Test");
+    EXPECT_EQ(found, SETTING_BIT(SETTING_WIFI_SSID) | SETTING_BIT(SETTING_MQTT_BROKER_ADDRESS) |
+                         SETTING_BIT(SETTING_MQTT_BROKER_PORT) | SETTING_BIT(SETTING_MQTT_DEVICE_TOPIC));
+    EXPECT_EQ(invalid, 0);
+}
+
+TEST_F(SettingsTest, InvalidValues) {
+    write("MQTT_Broker_Port: 18x3\nMQTT_Broker_Address: 192.168.100.100:1883\n");
+    ASSERT_EQ(parseSettingsFile(fs, filename, settings, &found, &invalid), RC_SUCCESS);
+    EXPECT_EQ(found, 0);
+    EXPECT_EQ(invalid, SETTING_BIT(SETTING_MQTT_BROKER_PORT) | SETTING_BIT(SETTING_MQTT_BROKER_ADDRESS));
+    EXPECT_EQ(settings.mqtt.brokerPort, 0);
+    EXPECT_STREQ(settings.mqtt.brokerAddress, "0.0.0.0");
+}
+
+TEST_F(SettingsTest, Write) {
+    ASSERT_EQ(setSetting(settings, SETTING_WIFI_SSID, StringView("Net", 3)), RC_SUCCESS);
+    ASSERT_EQ(setSetting(settings, SETTING_WIFI_PASSWORD, StringView("secret", 6)), RC_SUCCESS);
+    ASSERT_EQ(setSetting(settings, SETTING_MQTT_BROKER_PORT, StringView("1883", 4)), RC_SUCCESS);
+    write("previous contents");
+    ASSERT_EQ(writeToSettingsFile(fs, filename, settings), RC_SUCCESS);
+    // Secrets are left out, the temporary file is gone
+    EXPECT_EQ(read().find("secret"), std::string::npos);
+    EXPECT_FALSE(fs.fileExists((std::string(filename) + SETTINGS_TEMP_FILE_SUFFIX).c_str()));
+
+    // The written file is read back the same
+    settings_t reread;
+    ASSERT_EQ(parseSettingsFile(fs, filename, reread, &found, &invalid), RC_SUCCESS);
+    EXPECT_EQ(invalid, 0);
+    EXPECT_FALSE(found & SETTING_BIT(SETTING_WIFI_PASSWORD));
+    EXPECT_STREQ(reread.wifi.ssid, "Net");
+    EXPECT_EQ(reread.mqtt.brokerPort, 1883);
+    EXPECT_STREQ(reread.mqtt.brokerAddress, "0.0.0.0");
+}
+
+TEST_F(SettingsTest, SetAndGet) {
+    bool changed = false;
+    char value[SETTINGS_MAX_VALUE_LENGTH];
+    EXPECT_EQ(setSetting(settings, SETTING_MQTT_BROKER_PORT, StringView("8883", 4), &changed), RC_SUCCESS);
+    EXPECT_TRUE(changed);
+    EXPECT_EQ(setSetting(settings, SETTING_MQTT_BROKER_PORT, StringView("8883", 4), &changed), RC_SUCCESS);
+    EXPECT_FALSE(changed);
+    EXPECT_EQ(getSetting(settings, SETTING_MQTT_BROKER_PORT, value, sizeof(value)), RC_SUCCESS);
+    EXPECT_STREQ(value, "8883");
+    EXPECT_EQ(setSetting(settings, SETTING_MQTT_BROKER_PORT, StringView("70000", 5)), RC_ERROR_RANGE);
+    EXPECT_EQ(setSetting(settings, SETTING_MQTT_BROKER_PORT, StringView()), RC_ERROR_BAD_DATA);
+
+    const std::string tooLong(sizeof(settings.mqtt.brokerAddress), '1');
+    EXPECT_EQ(setSetting(settings, SETTING_MQTT_BROKER_ADDRESS, StringView(tooLong.data(), tooLong.size())),
+              RC_ERROR_BUFFER_FULL);
+    EXPECT_STREQ(settings.mqtt.brokerAddress, "0.0.0.0");
+    EXPECT_EQ(setSetting(settings, SETTING_MQTT_USERNAME, StringView("user", 4), &changed), RC_SUCCESS);
+    EXPECT_TRUE(changed);
+    EXPECT_EQ(getSetting(settings, SETTING_MQTT_USERNAME, value, 4), RC_ERROR_BUFFER_FULL);
+    EXPECT_EQ(setSetting(settings, SETTING_COUNT, StringView("x", 1)), RC_ERROR_BAD_PARAM);
+    EXPECT_STREQ(getSettingKey(SETTING_MQTT_PASSWORD), "MQTT_Password");
+    EXPECT_TRUE(isSecretSetting(SETTING_MQTT_PASSWORD));
+    EXPECT_FALSE(isSecretSetting(SETTING_MQTT_USERNAME));
+
+    // Choices are stored as their index
+    EXPECT_EQ(setSetting(settings, SETTING_MQTT_PUBLISH_MODE, StringView("device", 6), &changed), RC_SUCCESS);
+    EXPECT_TRUE(changed);
+    EXPECT_EQ(settings.mqtt.publishMode, MQTT_PUBLISH_PER_DEVICE);
+    EXPECT_EQ(getSetting(settings, SETTING_MQTT_PUBLISH_MODE, value, sizeof(value)), RC_SUCCESS);
+    EXPECT_STREQ(value, "device");
+    EXPECT_EQ(setSetting(settings, SETTING_MQTT_PUBLISH_MODE, StringView("both", 4)), RC_ERROR_INVALID);
+    EXPECT_EQ(settings.mqtt.publishMode, MQTT_PUBLISH_PER_DEVICE);
+    EXPECT_EQ(setSetting(settings, SETTING_MQTT_OUTBOX_DROP, StringView("newest", 6)), RC_SUCCESS);
+    EXPECT_EQ(settings.mqtt.outboxDrop, MQTT_OUTBOX_DROP_NEWEST);
+    EXPECT_EQ(setSetting(settings, SETTING_MQTT_PAYLOAD_FORMAT, StringView("msgpack", 7)), RC_SUCCESS);
+    EXPECT_EQ(settings.mqtt.payloadFormat, MQTT_PAYLOAD_MSGPACK);
+    EXPECT_EQ(getSetting(settings, SETTING_MQTT_PAYLOAD_FORMAT, value, sizeof(value)), RC_SUCCESS);
+    EXPECT_STREQ(value, "msgpack");
+}
+
+TEST_F(SettingsTest, LargeFile) {
+    // Keys are spread over a file many times larger than the read buffer, so that lines straddle
+    // refills at every possible offset
+    std::string text;
+    for(uint32_t i = 0; text.size() < 16 * SETTINGS_FILE_MAX_LINE_LENGTH; i++) {
+        text += "//Comment " + std::string(i % 97, '-') + "//\n";
+        text += "MQTT_ClientID: client" + std::to_string(i) + "\n";
+    }
+    text += "MQTT_Broker_Port: 8883\n";
+    text += "MQTT_Device_Topic: " + std::string(63, 't') + "\n";
+    text += "WIFI_Hostname: " + std::string(SETTINGS_FILE_MAX_LINE_LENGTH, 'h') + "\n";
+    text += "WIFI_SSID: last line without line ending";
+    write(text);
+
+    ASSERT_EQ(parseSettingsFile(fs, filename, settings, &found, &invalid), RC_SUCCESS);
+    EXPECT_EQ(found, SETTING_BIT(SETTING_MQTT_CLIENT_ID) | SETTING_BIT(SETTING_MQTT_BROKER_PORT) |
+                         SETTING_BIT(SETTING_MQTT_DEVICE_TOPIC) | SETTING_BIT(SETTING_WIFI_SSID));
+    EXPECT_EQ(invalid, 0);
+    EXPECT_EQ(settings.mqtt.brokerPort, 8883);
+    EXPECT_EQ(std::string(settings.mqtt.deviceTopic), std::string(63, 't'));
+    // The overlong line is skipped
+    EXPECT_STREQ(settings.wifi.hostname, "");
+    EXPECT_STREQ(settings.wifi.ssid, "last line without line ending");
+    const std::string lastClient = text.substr(text.rfind("client"));
+    EXPECT_EQ(std::string(settings.mqtt.clientID), lastClient.substr(0, lastClient.find('\n')));
+}
+
+TEST_F(SettingsTest, MissingFile) {
+    fs.deleteFile(filename);
+    EXPECT_EQ(parseSettingsFile(fs, filename, settings), RC_ERROR_OPEN);
+}
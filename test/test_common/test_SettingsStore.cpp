@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+
+#include "storage/SettingsStore.h"
+#include "storage/SimulatedKeyValueStore.h"
+#ifdef ARDUINO
+    #include "filesystem/LittleFilesystem.h"
+#else
+    #include "filesystem/DesktopFilesystem.h"
+#endif  // ARDUINO
+
+#define WRITE_DELAY_MS (1000)
+
+class SettingsStoreTest : public testing::Test {
+   protected:
+#ifdef ARDUINO
+    LittleFilesystem fs;
+    const char* filename = "/settingsstoretest.txt";
+#else
+    DesktopFilesystem fs;
+    const char* filename = "./settingsstoretest.txt";
+#endif  // ARDUINO
+    SimulatedKeyValueStore nvs;
+    settings_t settings;
+    SettingsStore store{fs, nvs, filename, settings, WRITE_DELAY_MS};
+
+    void TearDown() override { fs.deleteFile(filename); }
+
+    void write(const std::string& text) {
+        ASSERT_EQ(fs.openFile(filename, Filesystem::WRITE_TRUNCATE), RC_SUCCESS);
+        ASSERT_EQ(fs.write(reinterpret_cast<const uint8_t*>(text.data()), text.size()), RC_SUCCESS);
+        fs.closeFile();
+    }
+
+    std::string read() {
+        EXPECT_EQ(fs.openFile(filename), RC_SUCCESS);
+        std::string text(fs.size(), '\0');
+        fs.read(reinterpret_cast<uint8_t*>(&text[0]), text.size());
+        fs.closeFile();
+        return text;
+    }
+};
+
+TEST_F(SettingsStoreTest, LoadMovesSecrets) {
+    write("WIFI_SSID: Net\nWIFI_Password: secret\nMQTT_Password: mqttsecret\n");
+    uint32_t found = 0;
+    ASSERT_EQ(store.load(&found), RC_SUCCESS);
+    EXPECT_TRUE(found & SETTING_BIT(SETTING_WIFI_PASSWORD));
+    EXPECT_FALSE(store.isDirty());
+    EXPECT_EQ(store.getNvsWriteCount(), 2);
+    EXPECT_EQ(nvs.getWriteCount(), 2);
+    EXPECT_EQ(store.getFileWriteCount(), 1);
+    EXPECT_EQ(read().find("secret"), std::string::npos);
+
+    // Next boot takes the secrets from the non-volatile storage without writing anything
+    settings_t rebooted;
+    SettingsStore next(fs, nvs, filename, rebooted, WRITE_DELAY_MS);
+    ASSERT_EQ(next.load(), RC_SUCCESS);
+    EXPECT_STREQ(rebooted.wifi.ssid, "Net");
+    EXPECT_STREQ(rebooted.wifi.password, "secret");
+    EXPECT_STREQ(rebooted.mqtt.password, "mqttsecret");
+    EXPECT_EQ(next.getFileWriteCount(), 0);
+    EXPECT_EQ(next.getNvsWriteCount(), 0);
+}
+
+TEST_F(SettingsStoreTest, ProvisionedSecretUnchanged) {
+    ASSERT_EQ(nvs.putString("WIFI_Password", "secret"), RC_SUCCESS);
+    write("WIFI_Password: secret\n");
+    ASSERT_EQ(store.load(), RC_SUCCESS);
+    // The file is cleaned up, but the stored value is not written again
+    EXPECT_EQ(store.getNvsWriteCount(), 0);
+    EXPECT_EQ(store.getFileWriteCount(), 1);
+    EXPECT_EQ(read().find("secret"), std::string::npos);
+}
+
+TEST_F(SettingsStoreTest, CoalescedWrites) {
+    write("WIFI_SSID: Net\nMQTT_Broker_Port: 1883\n");
+    ASSERT_EQ(store.load(), RC_SUCCESS);
+    EXPECT_EQ(store.getFileWriteCount(), 0);
+
+    // Unchanged values are not recorded
+    bool changed = true;
+    ASSERT_EQ(store.set(SETTING_WIFI_SSID, "Net", 0, &changed), RC_SUCCESS);
+    EXPECT_FALSE(changed);
+    EXPECT_FALSE(store.isDirty());
+
+    // Changes within the write delay end up in one write
+    ASSERT_EQ(store.set(SETTING_WIFI_SSID, "Other", 100, &changed), RC_SUCCESS);
+    EXPECT_TRUE(changed);
+    ASSERT_EQ(store.set(SETTING_MQTT_BROKER_PORT, "8883", 200), RC_SUCCESS);
+    ASSERT_EQ(store.set(SETTING_WIFI_PASSWORD, "first", 300), RC_SUCCESS);
+    ASSERT_EQ(store.set(SETTING_WIFI_PASSWORD, "second", 400), RC_SUCCESS);
+    ASSERT_EQ(store.set(SETTING_MQTT_PASSWORD, "temporary", 500), RC_SUCCESS);
+    ASSERT_EQ(store.set(SETTING_MQTT_PASSWORD, "", 600), RC_SUCCESS);
+    EXPECT_EQ(store.set(SETTING_MQTT_BROKER_PORT, "invalid", 700), RC_ERROR_INVALID);
+    EXPECT_EQ(store.update(100 + WRITE_DELAY_MS - 1), RC_SUCCESS);
+    EXPECT_TRUE(store.isDirty());
+    EXPECT_EQ(store.getFileWriteCount(), 0);
+
+    EXPECT_EQ(store.update(100 + WRITE_DELAY_MS), RC_SUCCESS);
+    EXPECT_FALSE(store.isDirty());
+    EXPECT_EQ(store.getFileWriteCount(), 1);
+    // The MQTT password is back at its stored (missing) value, only the WiFi password is written
+    EXPECT_EQ(store.getNvsWriteCount(), 1);
+
+    settings_t reread;
+    ASSERT_EQ(parseSettingsFile(fs, filename, reread), RC_SUCCESS);
+    EXPECT_STREQ(reread.wifi.ssid, "Other");
+    EXPECT_EQ(reread.mqtt.brokerPort, 8883);
+    char password[SETTINGS_MAX_VALUE_LENGTH];
+    ASSERT_EQ(nvs.getString("WIFI_Password", password, sizeof(password)), RC_SUCCESS);
+    EXPECT_STREQ(password, "second");
+
+    // Nothing to write afterwards
+    EXPECT_EQ(store.update(10 * WRITE_DELAY_MS), RC_SUCCESS);
+    EXPECT_EQ(store.getFileWriteCount(), 1);
+}
+
+TEST_F(SettingsStoreTest, Commit) {
+    ASSERT_EQ(store.load(), RC_ERROR_OPEN);
+    ASSERT_EQ(store.set(SETTING_MQTT_USERNAME, "user", 0), RC_SUCCESS);
+    ASSERT_EQ(store.commit(), RC_SUCCESS);
+    EXPECT_FALSE(store.isDirty());
+    EXPECT_EQ(store.getFileWriteCount(), 1);
+    EXPECT_NE(read().find("MQTT_Username: user\n"), std::string::npos);
+}
+
+TEST_F(SettingsStoreTest, ConcurrentSetAndCommit) {
+    ASSERT_EQ(store.load(), RC_ERROR_OPEN);
+    // Changes of another task during the commits are either written or stay unsaved, never lost
+    const uint32_t changes = 200;
+    std::thread other([&]() {
+        for(uint32_t i = 1; i <= changes; i++) {
+            const std::string value = "Net" + std::to_string(i);
+            EXPECT_EQ(store.set(SETTING_WIFI_SSID, value.c_str(), i), RC_SUCCESS);
+        }
+    });
+    for(uint32_t i = 0; i < changes / 10; i++) EXPECT_EQ(store.update(i * WRITE_DELAY_MS), RC_SUCCESS);
+    other.join();
+    if(store.isDirty()) {
+        ASSERT_EQ(store.commit(), RC_SUCCESS);
+    }
+
+    settings_t reread;
+    ASSERT_EQ(parseSettingsFile(fs, filename, reread), RC_SUCCESS);
+    EXPECT_STREQ(reread.wifi.ssid, ("Net" + std::to_string(changes)).c_str());
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include "helper_functions.h"
+#include "sensors/RandomSensor.h"
+#include "sensors/SyntheticSensor.h"
+#include "sensors/XorShift32.h"
+
+TEST(XorShift32Test, RangeAndDeterminism) {
+    XorShift32 a(1234), b(1234), zero(0);
+    for(uint32_t i = 0; i < 1000; i++) {
+        EXPECT_EQ(a.next(), b.next());
+        const float_t f = a.nextFloat();
+        b.nextFloat();
+        EXPECT_GE(f, 0.0f);
+        EXPECT_LT(f, 1.0f);
+        // A seed of 0 must not get stuck at 0
+        EXPECT_NE(zero.next(), 0u);
+    }
+}
+
+TEST(SyntheticSensorTest, WaveformsTest) {
+    char name[] = "Synthetic";
+    SyntheticSensor sine(name, SyntheticSensor::SINE, 2.0f, 10.0f, 4);
+    const float_t expectedSine[] = {10.0f, 12.0f, 10.0f, 8.0f, 10.0f};
+    for(float_t expected : expectedSine) EXPECT_NEAR(sine.readSensor(), expected, 1e-5f);
+
+    SyntheticSensor step(name, SyntheticSensor::STEP, 5.0f, 1.0f, 4);
+    const float_t expectedStep[] = {1.0f, 1.0f, 6.0f, 6.0f, 1.0f};
+    for(float_t expected : expectedStep) EXPECT_FLOAT_EQ(step.readSensor(), expected);
+
+    SyntheticSensor ramp(name, SyntheticSensor::RAMP, 4.0f, 0.0f, 4);
+    const float_t expectedRamp[] = {0.0f, 1.0f, 2.0f, 3.0f, 0.0f};
+    for(float_t expected : expectedRamp) EXPECT_FLOAT_EQ(ramp.readSensor(), expected);
+
+    SyntheticSensor noise(name, SyntheticSensor::NOISE, 1.0f, 50.0f, 1);
+    float_t sum = 0;
+    for(uint32_t i = 0; i < 10000; i++) {
+        const float_t v = noise.readSensor();
+        EXPECT_GE(v, 49.0f);
+        EXPECT_LT(v, 51.0f);
+        sum += v;
+    }
+    EXPECT_NEAR(sum / 10000, 50.0f, 0.05f);
+}
+
+TEST(SyntheticSensorTest, AddedNoiseTest) {
+    char name[] = "Noisy";
+    SyntheticSensor ramp(name, SyntheticSensor::RAMP, 10.0f, 0.0f, 10, 0.5f);
+    for(uint32_t i = 0; i < 100; i++) EXPECT_NEAR(ramp.readSensor(), static_cast<float_t>(i % 10), 0.5f);
+}
+
+TEST(SyntheticSensorTest, WaveformFromStringTest) {
+    SyntheticSensor::Waveform_t waveform;
+    EXPECT_EQ(SyntheticSensor::waveformFromString("Sine", waveform), RC_SUCCESS);
+    EXPECT_EQ(waveform, SyntheticSensor::SINE);
+    EXPECT_EQ(SyntheticSensor::waveformFromString("noise", waveform), RC_SUCCESS);
+    EXPECT_EQ(waveform, SyntheticSensor::NOISE);
+    EXPECT_EQ(SyntheticSensor::waveformFromString("triangle", waveform), RC_ERROR_INVALID);
+}
+
+TEST(RandomSensorTest, BoundsTest) {
+    char name[] = "Random";
+    RandomSensor sensor(name, -5.0f, 5.0f);
+    for(uint32_t i = 0; i < 1000; i++) {
+        const float_t v = sensor.readSensor();
+        EXPECT_GE(v, -5.0f);
+        EXPECT_LE(v, 5.0f);
+    }
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include "TestSensor.h"
+#include "sensors/UrgentEventQueue.h"
+#include "transformers/DigitalThreshold.h"
+
+TEST(UrgentEventQueue, KeepsOrder) {
+    UrgentEventQueue queue;
+    UrgentEvent_t event;
+    EXPECT_FALSE(queue.pop(event));
+    for(uint32_t i = 0; i < 3; i++) queue.push({i, static_cast<float_t>(i), i * 10});
+    EXPECT_EQ(queue.size(), 3);
+    for(uint32_t i = 0; i < 3; i++) {
+        ASSERT_TRUE(queue.pop(event));
+        EXPECT_EQ(event.sensorId, i);
+        EXPECT_EQ(event.timestamp, i * 10);
+    }
+    EXPECT_FALSE(queue.pop(event));
+}
+
+TEST(UrgentEventQueue, DropsOldestWhenFull) {
+    UrgentEventQueue queue;
+    for(uint32_t i = 0; i < URGENT_EVENT_QUEUE_SIZE + 2; i++) queue.push({i, 0, 0});
+    EXPECT_EQ(queue.size(), URGENT_EVENT_QUEUE_SIZE);
+    EXPECT_EQ(queue.getDroppedCount(), 2);
+    UrgentEvent_t event;
+    ASSERT_TRUE(queue.pop(event));
+    EXPECT_EQ(event.sensorId, 2);
+    uint32_t last = 0;
+    while(queue.pop(event)) last = event.sensorId;
+    EXPECT_EQ(last, URGENT_EVENT_QUEUE_SIZE + 1);
+}
+
+TEST(UrgentEventQueue, WaitTimesOut) {
+    UrgentEventQueue queue;
+    EXPECT_FALSE(queue.waitForEvent(5));
+    queue.push({1, 0, 0});
+    EXPECT_TRUE(queue.waitForEvent(0));
+}
+
+static uint32_t wakeCount = 0;
+
+TEST(UrgentEventQueue, WakeFunction) {
+    UrgentEventQueue queue;
+    wakeCount = 0;
+    queue.setWakeFunction([] { wakeCount++; });
+    queue.push({1, 0, 0});
+    queue.push({2, 0, 0});
+    EXPECT_EQ(wakeCount, 2);
+    queue.setWakeFunction(nullptr);
+    queue.push({3, 0, 0});
+    EXPECT_EQ(wakeCount, 2);
+}
+
+TEST(UrgentEventQueue, ThresholdChangeRaisesEvent) {
+    UrgentEventQueue queue;
+    char name[] = "Door";
+    SequenceSensor sensor(name, std::make_shared<DigitalThreshold>(2, true));
+    sensor.setUrgentEventQueue(&queue);
+
+    // The initial state is not an event
+    sensor.readSensor();
+    sensor.readSensor();
+    EXPECT_EQ(queue.size(), 0);
+    // Raw value 2 crosses the threshold
+    EXPECT_EQ(sensor.readSensor(), 1);
+    UrgentEvent_t event;
+    ASSERT_TRUE(queue.pop(event));
+    EXPECT_EQ(event.sensorId, sensor.getId());
+    EXPECT_EQ(event.value, 1);
+    sensor.readSensor();
+    EXPECT_EQ(queue.size(), 0);
+    sensor.nextValue = 0;
+    sensor.readSensor();
+    ASSERT_TRUE(queue.pop(event));
+    EXPECT_EQ(event.value, 0);
+
+    // Without the urgent flag a threshold never raises events
+    SequenceSensor quiet(name, std::make_shared<DigitalThreshold>(2));
+    quiet.setUrgentEventQueue(&queue);
+    for(uint32_t i = 0; i < 5; i++) quiet.readSensor();
+    EXPECT_EQ(queue.size(), 0);
+}
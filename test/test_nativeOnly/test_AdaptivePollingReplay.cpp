@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+#include "filesystem/DesktopFilesystem.h"
+#include "sensors/ReplaySensor.h"
+
+// Evaluates adaptive polling against a fixed interval on a replayed recording.
+// The recording has one value per RECORDING_STEP_MS, a quiet signal with a transient in the middle.
+
+#define RECORDING_STEP_MS (100)
+#define RECORDING_VALUES (36000)
+
+/**
+ * @brief Sensor which returns the value of the recording at the time it is sampled
+ */
+class HeldValueSensor : public Sensor {
+   public:
+    HeldValueSensor(char name[]) : Sensor(name) {}
+    float_t readSensorRaw() override { return value; }
+    float_t value = 0;
+};
+
+typedef struct {
+    uint32_t samples;
+    float_t maxError;
+    float_t meanError;
+} PollingResult_t;
+
+/**
+ * @brief Replays the recording and samples the sensor whenever it is due. The error is the
+ * difference between the recording and the latest sample held until the next one.
+ */
+static PollingResult_t replay(Filesystem& fs, const char filename[], HeldValueSensor& sensor) {
+    char name[] = "Recording";
+    ReplaySensor recording(name, fs, filename, ReplaySensor::CSV, false);
+    PollingResult_t result = {0, 0, 0};
+    float_t held = 0;
+    double errorSum = 0;
+    for(uint32_t i = 0; i < RECORDING_VALUES; i++) {
+        const uint32_t now = i * RECORDING_STEP_MS;
+        sensor.value = recording.readSensor();
+        if(sensor.sampleIfDue(now)) {
+            result.samples++;
+            held = sensor.value;
+        }
+        const float_t error = fabsf(sensor.value - held);
+        if(error > result.maxError) result.maxError = error;
+        errorSum += error;
+    }
+    result.meanError = errorSum / RECORDING_VALUES;
+    return result;
+}
+
+TEST(AdaptivePollingReplay, QuietSignalWithTransient) {
+    DesktopFilesystem fs;
+    const char filename[] = "./adaptive_replay.csv";
+
+    // One hour of an indoor temperature which rises by 5 degrees within a minute after 30 minutes
+    std::string csv = "timestamp,value\n";
+    for(uint32_t i = 0; i < RECORDING_VALUES; i++) {
+        const float_t t = i * RECORDING_STEP_MS / 1000.0f;
+        float_t v = 21.0f + 0.02f * sinf(t / 60.0f);
+        if(t > 1800.0f) v += (t < 1860.0f) ? 5.0f * (t - 1800.0f) / 60.0f : 5.0f;
+        csv += std::to_string(i * RECORDING_STEP_MS) + "," + std::to_string(v) + "\n";
+    }
+    ASSERT_EQ(fs.openFile(filename, Filesystem::WRITE_TRUNCATE), RC_SUCCESS);
+    fs.write(reinterpret_cast<const uint8_t*>(csv.c_str()), csv.size());
+    fs.closeFile();
+
+    char name[] = "Temperature";
+    HeldValueSensor fast(name);
+    fast.setCadence(1000, 60000, 0);
+    const PollingResult_t fastResult = replay(fs, filename, fast);
+
+    HeldValueSensor slow(name);
+    slow.setCadence(30000, 60000, 0);
+    const PollingResult_t slowResult = replay(fs, filename, slow);
+
+    HeldValueSensor adaptive(name);
+    adaptive.setCadence(1000, 60000, 0);
+    adaptive.setAdaptiveInterval(std::unique_ptr<AdaptiveInterval>(new AdaptiveInterval(1000, 30000, 0.01f, 0.0f)));
+    const PollingResult_t adaptiveResult = replay(fs, filename, adaptive);
+    fs.deleteFile(filename);
+
+    printf("[ BENCHMARK] %-20s %6u samples, max error %.3f, mean error %.4f\n", "fixed 1s", fastResult.samples,
+           fastResult.maxError, fastResult.meanError);
+    printf("[ BENCHMARK] %-20s %6u samples, max error %.3f, mean error %.4f\n", "fixed 30s", slowResult.samples,
+           slowResult.maxError, slowResult.meanError);
+    printf("[ BENCHMARK] %-20s %6u samples, max error %.3f, mean error %.4f\n", "adaptive 1s..30s",
+           adaptiveResult.samples, adaptiveResult.maxError, adaptiveResult.meanError);
+
+    // Far fewer samples than the fixed fast interval, while the transient is followed
+    // much more closely than with the fixed slow interval
+    EXPECT_LT(adaptiveResult.samples, fastResult.samples / 5);
+    EXPECT_LT(adaptiveResult.maxError, slowResult.maxError / 2);
+}
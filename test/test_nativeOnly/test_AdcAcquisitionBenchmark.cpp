@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "adc/AdcAcquisition.h"
+#include "adc/FakeSampleSource.h"
+#include "sensors/XorShift32.h"
+
+// Throughput of the continuous ADC buffering and the noise reduction gained by oversampling
+
+#define BENCHMARK_SAMPLES (4000000)
+// Samples pushed to the fake source per poll, like one DMA block
+#define BENCHMARK_CHUNK (ADC_READ_BLOCK_SIZE)
+
+/**
+ * @brief Feeds a constant signal with uniform noise of +-noise LSB through a channel
+ * and returns the standard deviation of the decimated values
+ */
+static double measureNoise(uint32_t oversampling, uint32_t noise) {
+    FakeSampleSource source;
+    AdcAcquisition acquisition(source);
+    std::shared_ptr<AdcAcquisition::Channel> channel = acquisition.openChannel(0, oversampling);
+    XorShift32 rng(oversampling);
+    std::vector<float_t> outputs;
+    float_t values[ADC_CHANNEL_BUFFER_SIZE];
+    uint16_t chunk[BENCHMARK_CHUNK];
+
+    while(outputs.size() < 2000) {
+        for(uint16_t& s : chunk) s = static_cast<uint16_t>(2048 - noise + rng.next() % (2 * noise + 1));
+        source.push(0, chunk, BENCHMARK_CHUNK);
+        acquisition.poll(0);
+        const uint32_t count = channel->read(values, ADC_CHANNEL_BUFFER_SIZE);
+        outputs.insert(outputs.end(), values, values + count);
+    }
+    double mean = 0, variance = 0;
+    for(float_t v : outputs) mean += v;
+    mean /= outputs.size();
+    for(float_t v : outputs) variance += (v - mean) * (v - mean);
+    return std::sqrt(variance / outputs.size());
+}
+
+TEST(AdcAcquisitionBenchmark, Throughput) {
+    for(uint32_t channels = 1; channels <= 4; channels *= 2) {
+        FakeSampleSource source;
+        AdcAcquisition acquisition(source);
+        std::vector<std::shared_ptr<AdcAcquisition::Channel>> open;
+        for(uint32_t c = 0; c < channels; c++) open.push_back(acquisition.openChannel(c, 16));
+
+        uint16_t pattern[ADC_MAX_CHANNELS] = {};
+        float_t values[ADC_CHANNEL_BUFFER_SIZE];
+        double checksum = 0;
+        std::chrono::duration<double> elapsed(0);
+        for(uint32_t done = 0; done < BENCHMARK_SAMPLES; done += BENCHMARK_CHUNK) {
+            // Filling the fake source is not part of the measurement
+            for(uint32_t i = 0; i < BENCHMARK_CHUNK / channels; i++) {
+                for(uint32_t c = 0; c < channels; c++) pattern[c] = static_cast<uint16_t>((done + i + c) & 0xFFF);
+                source.pushPattern(pattern);
+            }
+            const auto start = std::chrono::steady_clock::now();
+            acquisition.poll(0);
+            for(const std::shared_ptr<AdcAcquisition::Channel>& ch : open) {
+                const uint32_t count = ch->read(values, ADC_CHANNEL_BUFFER_SIZE);
+                for(uint32_t i = 0; i < count; i++) checksum += values[i];
+            }
+            elapsed += std::chrono::steady_clock::now() - start;
+        }
+        // Printing the checksum keeps the compiler from optimizing the processing away
+        printf("[ BENCHMARK] %u channel(s), oversampling 16  %7.2f Msamples/s (checksum %g)\n", channels,
+               BENCHMARK_SAMPLES / elapsed.count() / 1e6, checksum);
+    }
+}
+
+TEST(AdcAcquisitionBenchmark, OversamplingNoise) {
+    const double baseline = measureNoise(1, 8);
+    double previous = baseline;
+    for(uint32_t oversampling = 4; oversampling <= 256; oversampling *= 4) {
+        const double stddev = measureNoise(oversampling, 8);
+        printf("[ BENCHMARK] oversampling %3u  noise %.3f LSB of %.3f  (%.1f effective bits gained)\n", oversampling,
+               stddev, baseline, std::log2(baseline / stddev));
+        // Every factor of 4 halves the noise
+        EXPECT_NEAR(stddev, previous / 2, previous * 0.2);
+        previous = stddev;
+    }
+}
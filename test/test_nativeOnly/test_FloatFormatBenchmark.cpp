@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "helper_functions.h"
+#include "sensors/SampleAggregator.h"
+
+// Time it takes to format published values with formatFloat and with snprintf("%.*f").
+// On the desktop both use hardware floating point, so the gap is smaller than on the
+// FPU-less microcontroller where snprintf goes through soft-float printf.
+
+#define BENCHMARK_VALUES (200000)
+#define BENCHMARK_REPETITIONS (5)
+
+static std::vector<float_t> generateValues() {
+    std::vector<float_t> values;
+    uint32_t rng = 12345;
+    for(uint32_t i = 0; i < BENCHMARK_VALUES; i++) {
+        rng = rng * 1664525u + 1013904223u;
+        // Typical sensor values: temperatures, humidity, raw ADC readings and light
+        const float_t scale[] = {0.01f, 0.1f, 1.0f, 10.0f};
+        values.push_back(static_cast<float_t>(static_cast<int32_t>(rng >> 16) - 16384) * scale[rng & 3]);
+    }
+    return values;
+}
+
+/**
+ * @brief Returns the shortest time in ns per value of BENCHMARK_REPETITIONS runs
+ */
+template <typename F>
+static double measure(const std::vector<float_t>& values, F format) {
+    double best = 1e9;
+    for(uint32_t r = 0; r < BENCHMARK_REPETITIONS; r++) {
+        const auto start = std::chrono::steady_clock::now();
+        for(float_t v : values) format(v);
+        const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        best = std::min(best, ns / values.size());
+    }
+    return best;
+}
+
+TEST(FloatFormatBenchmark, FormatFloat) {
+    const std::vector<float_t> values = generateValues();
+    char str[FLOAT_FORMAT_BUFFER_SIZE];
+    // Keeps the compiler from dropping the formatting
+    volatile uint32_t checksum = 0;
+
+    for(uint8_t decimals : {0, 2, FLOAT_FORMAT_MAX_DECIMALS}) {
+        const double fastNs = measure(values, [&](float_t v) {
+            formatFloat(str, sizeof(str), v, decimals);
+            checksum = checksum + str[0];
+        });
+        const double snprintfNs = measure(values, [&](float_t v) {
+            snprintf(str, sizeof(str), "%.*f", decimals, static_cast<double>(v));
+            checksum = checksum + str[0];
+        });
+        printf("[ BENCHMARK] %u decimals   formatFloat %6.1f ns, snprintf %6.1f ns (%.1fx)\n", decimals, fastNs,
+               snprintfNs, snprintfNs / fastNs);
+    }
+}
+
+TEST(FloatFormatBenchmark, AggregateJson) {
+    SampleAggregator aggregate;
+    aggregate.add(21.5f);
+    aggregate.add(23.25f);
+    char str[SENSOR_AGGREGATE_PAYLOAD_SIZE];
+    const std::vector<float_t> values(BENCHMARK_VALUES / 10, 0.0f);
+    const double ns =
+        measure(values, [&](float_t) { aggregate.toJson(str, sizeof(str), SampleAggregator::FIELD_ALL); });
+    printf("[ BENCHMARK] aggregate JSON of all fields %6.1f ns\n", ns);
+}
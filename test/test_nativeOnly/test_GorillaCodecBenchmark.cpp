@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "codec/GorillaCodec.h"
+
+// Compression benchmark of the Gorilla codec.
+// A recorded series can be replayed by pointing the environment variable GORILLA_BENCH_CSV
+// to a file with one "timestamp_ms,value" pair per line. Otherwise traces are generated
+// that mimic the supported sensors: quantized to their resolution, polled every
+// SENSOR_POLLING_INTERVAL_S with a few ms of scheduling jitter.
+
+#define BENCHMARK_BLOCK_SIZE (256)
+#define BENCHMARK_SAMPLES (100000)
+
+typedef struct {
+    uint32_t timestamp;
+    float_t value;
+} Sample_t;
+
+static float_t quantize(float_t value, float_t resolution) { return roundf(value / resolution) * resolution; }
+
+static std::vector<Sample_t> generateTrace(const char name[]) {
+    std::vector<Sample_t> trace;
+    uint32_t rng = 12345;
+    uint32_t t = 0;
+    for(uint32_t i = 0; i < BENCHMARK_SAMPLES; i++) {
+        rng = rng * 1664525u + 1013904223u;
+        t += SENSOR_POLLING_INTERVAL_S * 1000 + (rng >> 30);
+        const float_t day = static_cast<float_t>(i) / (86400.0f / SENSOR_POLLING_INTERVAL_S);
+        const float_t noise = static_cast<float_t>((rng >> 8) % 1000) / 1000.0f - 0.5f;
+        float_t value;
+        if(strcmp(name, "temperature") == 0) {
+            // DHT22: 0.1 degC resolution
+            value = quantize(21.0f + 3.0f * sinf(day * 6.2832f) + 0.2f * noise, 0.1f);
+        } else if(strcmp(name, "light") == 0) {
+            // BH1750: 1 lx resolution, dark at night
+            const float_t sun = sinf(day * 6.2832f);
+            value = quantize(sun > 0 ? 800.0f * sun + 20.0f * noise : 0.0f, 1.0f);
+        } else {
+            // 12 bit ADC raw value
+            value = quantize(2048.0f + 200.0f * sinf(day * 40.0f) + 8.0f * noise, 1.0f);
+        }
+        trace.push_back({t, value});
+    }
+    return trace;
+}
+
+static std::vector<Sample_t> loadCsv(const char filename[]) {
+    std::vector<Sample_t> trace;
+    FILE* f = fopen(filename, "r");
+    if(f == nullptr) return trace;
+    unsigned long t;
+    float value;
+    while(fscanf(f, "%lu,%f", &t, &value) == 2) trace.push_back({static_cast<uint32_t>(t), value});
+    fclose(f);
+    return trace;
+}
+
+static void runBenchmark(const char name[], const std::vector<Sample_t>& trace) {
+    const uint32_t maxBlocks = trace.size() / 2 + 1;
+    std::vector<uint8_t> blocks(maxBlocks * BENCHMARK_BLOCK_SIZE);
+    std::vector<uint32_t> blockSizes;
+
+    auto start = std::chrono::steady_clock::now();
+    uint32_t encodedBytes = 0;
+    uint32_t idx = 0;
+    while(idx < trace.size()) {
+        // Fill one block after another
+        GorillaEncoder encoder(&blocks[blockSizes.size() * BENCHMARK_BLOCK_SIZE], BENCHMARK_BLOCK_SIZE);
+        while(idx < trace.size() && encoder.append(trace[idx].timestamp, trace[idx].value) == RC_SUCCESS) idx++;
+        ASSERT_GT(encoder.getCount(), 0u);
+        blockSizes.push_back(encoder.getSize());
+        encodedBytes += encoder.getSize();
+    }
+    const double encodeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    uint32_t decoded = 0;
+    bool equal = true;
+    for(uint32_t b = 0; b < blockSizes.size(); b++) {
+        GorillaDecoder decoder(&blocks[b * BENCHMARK_BLOCK_SIZE], blockSizes[b]);
+        uint32_t timestamp;
+        float_t value;
+        while(decoder.next(timestamp, value) == RC_SUCCESS) {
+            equal &= (timestamp == trace[decoded].timestamp) && (value == trace[decoded].value);
+            decoded++;
+        }
+    }
+    const double decodeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    EXPECT_EQ(decoded, trace.size());
+    EXPECT_TRUE(equal);
+
+    // Uncompressed size: 32 bit timestamp and 32 bit float
+    const double rawMB = trace.size() * 8.0 / 1e6;
+    printf("[ BENCHMARK] %-12s %7u samples, %.2f bytes/sample, ratio %.1fx, encode %.1f MB/s, decode %.1f MB/s\n", name,
+           static_cast<uint32_t>(trace.size()), static_cast<double>(encodedBytes) / trace.size(),
+           trace.size() * 8.0 / encodedBytes, rawMB / encodeSeconds, rawMB / decodeSeconds);
+}
+
+TEST(GorillaCodecBenchmark, CompressionRatio) {
+    const char* csv = getenv("GORILLA_BENCH_CSV");
+    if(csv != nullptr) {
+        const std::vector<Sample_t> trace = loadCsv(csv);
+        ASSERT_GT(trace.size(), 0u) << "Could not read " << csv;
+        runBenchmark("csv", trace);
+    }
+    const char* traces[] = {"temperature", "light", "adc"};
+    for(const char* name : traces) runBenchmark(name, generateTrace(name));
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+
+#include "cfg.h"
+#include "telemetry/CborPayloadEncoder.h"
+#include "telemetry/InfluxPayloadEncoder.h"
+#include "telemetry/JsonPayloadEncoder.h"
+#include "telemetry/MessagePackPayloadEncoder.h"
+
+// Size of a device payload with BENCHMARK_SENSORS sensors and the time it takes to encode it
+// in every payload format. Half of the sensors publish all aggregates instead of the processed value.
+
+#define BENCHMARK_SENSORS (8)
+#define BENCHMARK_DOCUMENTS (20000)
+#define BENCHMARK_REPETITIONS (5)
+#define BENCHMARK_DECIMALS (2)
+
+static const char* const sensorNames[BENCHMARK_SENSORS] = {"Temperature", "Humidity", "Pressure", "Light",
+                                                           "CO2",         "Noise",    "Soil",     "Battery"};
+
+/**
+ * @brief Encodes one document and returns its length
+ */
+static uint32_t encode(PayloadEncoder& encoder, const SampleAggregator& aggregate, uint32_t document) {
+    encoder.clear(1700000000 + document);
+    for(uint32_t i = 0; i < BENCHMARK_SENSORS; i++) {
+        SensorSample_t sample;
+        sample.value = 20.0f + static_cast<float_t>((document + i) % 1000) * 0.01f;
+        sample.rawValue = static_cast<float_t>(2000 + (document * 7 + i) % 2048);
+        const bool aggregated = (i % 2 == 1);
+        EXPECT_EQ(encoder.add(sensorNames[i], sample, aggregated ? &aggregate : nullptr,
+                              aggregated ? SampleAggregator::FIELD_ALL : 0, BENCHMARK_DECIMALS),
+                  RC_SUCCESS);
+    }
+    return encoder.length();
+}
+
+/**
+ * @brief Returns the shortest time in ns per document of BENCHMARK_REPETITIONS runs
+ */
+static double measure(PayloadEncoder& encoder, const SampleAggregator& aggregate) {
+    double best = 1e12;
+    // Keeps the compiler from dropping the encoding
+    volatile uint32_t checksum = 0;
+    for(uint32_t r = 0; r < BENCHMARK_REPETITIONS; r++) {
+        const auto start = std::chrono::steady_clock::now();
+        for(uint32_t d = 0; d < BENCHMARK_DOCUMENTS; d++) checksum = checksum + encode(encoder, aggregate, d);
+        const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        best = std::min(best, ns / BENCHMARK_DOCUMENTS);
+    }
+    return best;
+}
+
+TEST(PayloadEncoderBenchmark, Formats) {
+    static uint8_t buffer[MQTT_DEVICE_PAYLOAD_SIZE];
+    JsonPayloadEncoder json(buffer, sizeof(buffer));
+    CborPayloadEncoder cbor(buffer, sizeof(buffer));
+    MessagePackPayloadEncoder msgpack(buffer, sizeof(buffer));
+    InfluxPayloadEncoder influx(buffer, sizeof(buffer), "multisensor", "Livingroom");
+    SampleAggregator aggregate;
+    for(uint32_t i = 0; i < 12; i++) aggregate.add(20.0f + static_cast<float_t>(i) * 0.37f);
+
+    const struct {
+        const char* name;
+        PayloadEncoder& encoder;
+    } formats[] = {{"json", json}, {"cbor", cbor}, {"msgpack", msgpack}, {"influx", influx}};
+    const uint32_t jsonBytes = encode(json, aggregate, 0);
+    for(const auto& f : formats) {
+        const uint32_t bytes = encode(f.encoder, aggregate, 0);
+        const double ns = measure(f.encoder, aggregate);
+        printf("[ BENCHMARK] %-8s %4u bytes (%3.0f%% of json), %7.1f ns per document, %6.1f MB/s\n", f.name, bytes,
+               100.0 * bytes / jsonBytes, ns, bytes * 1e3 / ns);
+        EXPECT_GT(bytes, 0);
+    }
+    // The binary formats are smaller than JSON
+    EXPECT_LT(encode(cbor, aggregate, 0), jsonBytes);
+    EXPECT_LT(encode(msgpack, aggregate, 0), jsonBytes);
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+
+#include "filesystem/DesktopFilesystem.h"
+#include "storage/SampleLog.h"
+
+// Benchmarks of the sample log on the desktop filesystem.
+// Absolute numbers are not comparable to flash, but the encoded size per sample is.
+
+static const char prefix[] = "./slogbench_";
+static const uint32_t sensorCount = 6;
+static const uint32_t recordCount = 20000;
+
+static void removeSegments() {
+    DesktopFilesystem fs;
+    for(uint32_t i = 0; i < SAMPLE_LOG_MAX_SEGMENTS; i++) {
+        char filename[32];
+        snprintf(filename, sizeof(filename), "%s%u.bin", prefix, i);
+        if(fs.fileExists(filename)) fs.deleteFile(filename);
+    }
+}
+
+/**
+ * @brief Generates slowly changing sensor values with some noise, similar to real measurements
+ */
+static void generateRecord(uint32_t i, SampleLog::Entry_t entries[sensorCount]) {
+    for(uint32_t s = 0; s < sensorCount; s++) {
+        const float_t noise = static_cast<float_t>((i * 2654435761u + s * 40503u) % 100) / 100.0f;
+        entries[s].sensorId = 0x1000 + s;
+        entries[s].value = 20.0f + s * 10.0f + static_cast<float_t>(i % 600) / 60.0f + noise;
+        entries[s].rawValue = static_cast<float_t>(static_cast<int32_t>(entries[s].value * 100));
+    }
+}
+
+TEST(SampleLogBenchmark, AppendReadThroughput) {
+    removeSegments();
+    DesktopFilesystem fs;
+    // Large segments so that no data is dropped during the benchmark
+    SampleLog log(fs, prefix, 1024 * 1024, SAMPLE_LOG_MAX_SEGMENTS);
+    ASSERT_EQ(log.begin(), RC_SUCCESS);
+
+    SampleLog::Entry_t entries[SAMPLE_LOG_MAX_ENTRIES_PER_RECORD];
+    auto start = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < recordCount; i++) {
+        generateRecord(i, entries);
+        ASSERT_EQ(log.append(1700000000 + i * SENSOR_POLLING_INTERVAL_S, entries, sensorCount), RC_SUCCESS);
+    }
+    ASSERT_EQ(log.flush(), RC_SUCCESS);
+    const double writeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    uint32_t timestamp, count, readRecords = 0;
+    start = std::chrono::steady_clock::now();
+    while(log.read(timestamp, entries, SAMPLE_LOG_MAX_ENTRIES_PER_RECORD, count) == RC_SUCCESS) readRecords++;
+    const double readSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    EXPECT_EQ(readRecords, recordCount);
+
+    const SampleLog::Statistics_t& stats = log.getStatistics();
+    const uint32_t samples = recordCount * sensorCount;
+    // Unencoded size of a sample: ID, value, raw value and timestamp
+    const double rawBytes = samples * 16.0;
+    printf("[ BENCHMARK] %u samples, %u bytes written in %u flushes\n", samples, stats.bytesWritten, stats.flushes);
+    printf("[ BENCHMARK] %.2f bytes/sample (%.1f%% of unencoded size)\n",
+           static_cast<double>(stats.bytesWritten) / samples, 100.0 * stats.bytesWritten / rawBytes);
+    printf("[ BENCHMARK] append: %.2f Msamples/s, read: %.2f Msamples/s\n", samples / writeSeconds / 1e6,
+           samples / readSeconds / 1e6);
+    // Delta encoding has to beat the unencoded representation
+    EXPECT_LT(stats.bytesWritten, rawBytes / 2);
+    removeSegments();
+}
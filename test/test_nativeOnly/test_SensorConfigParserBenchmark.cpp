@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "config/SensorConfigParser.h"
+#include "helper_functions.h"
+#include "sensors/Sensor.h"
+
+// Parsing speed of large sensor config files with the single pass tokenizer, compared to the
+// previous approach of cutting each definition into a stack buffer and extracting the keys with
+// strstr and memmove
+
+#define BENCHMARK_SENSORS (5000)
+#define BENCHMARK_REPETITIONS (5)
+
+static const char* const sensorKeys[] = {"name", "lowerBound", "upperBound", "sampleIntervalMs", "publishIntervalS"};
+static const char* const transformerKeys[] = {"inMin", "inMax", "outMin", "outMax", "n"};
+
+static std::string generateConfig(uint32_t sensors) {
+    std::string config;
+    char buf[512];
+    for(uint32_t i = 0; i < sensors; i++) {
+        snprintf(buf, sizeof(buf),
+                 "//Sensor %u//\n"
+                 "RandomSensor[\n"
+                 "    name: Sensor %u\n"
+                 "    lowerBound: 0\n"
+                 "    upperBound: %u\n"
+                 "    sampleIntervalMs: 1000\n"
+                 "    publishIntervalS: 60\n"
+                 "    Remapper{\n"
+                 "        inMin: 0\n"
+                 "        inMax: 255\n"
+                 "        outMin: -10\n"
+                 "        outMax: 40\n"
+                 "    }\n"
+                 "    SimpleMovingAverageFilter{\n"
+                 "        n: 4\n"
+                 "    }\n"
+                 "]\n",
+                 i, i, 100 + i);
+        config += buf;
+    }
+    return config;
+}
+
+/**
+ * @brief Reads every key of every sensor and returns a checksum so that nothing is optimized away
+ */
+static float_t parseWithTokenizer(const std::string& text, uint32_t& sensors) {
+    SensorConfigParser parser(text.data(), text.size());
+    SensorConfig_t config;
+    float_t checksum = 0;
+    sensors = 0;
+    while(parser.next(config) == RC_SUCCESS) {
+        char name[SENSOR_NAME_MAX_LENGTH];
+        config.sensor.getString("name", name, sizeof(name));
+        for(uint32_t k = 1; k < sizeof(sensorKeys) / sizeof(sensorKeys[0]); k++) {
+            float_t v = 0;
+            config.sensor.getFloat(sensorKeys[k], v);
+            checksum += v;
+        }
+        for(const ConfigSection& t : config.transformers) {
+            for(const char* key : transformerKeys) {
+                float_t v = 0;
+                t.getFloat(key, v);
+                checksum += v;
+            }
+        }
+        sensors++;
+    }
+    return checksum;
+}
+
+static float_t parseLegacy(const std::string& text, uint32_t& sensors) {
+    float_t checksum = 0;
+    sensors = 0;
+    const char* pos = text.c_str();
+    while(true) {
+        // Equivalent of reading the file until the open and close characters
+        const char* open = strchr(pos, SENSOR_CFG_OPEN_CHAR[0]);
+        if(open == nullptr) break;
+        const char* close = strchr(open, SENSOR_CFG_CLOSE_CHAR[0]);
+        if(close == nullptr) break;
+        char data[1024];
+        const uint32_t len = std::min<uint32_t>(close - open - 1, sizeof(data) - 1);
+        memcpy(data, open + 1, len);
+        data[len] = '\0';
+        trimComments(data, CONFIG_FILE_COMMENT_DELIMITER);
+        trimLeadingWhitespace(data);
+
+        char name[SENSOR_NAME_MAX_LENGTH];
+        readKeyValue(data, "name", name, sizeof(name), true);
+        for(uint32_t k = 1; k < sizeof(sensorKeys) / sizeof(sensorKeys[0]); k++) {
+            float_t v = 0;
+            readKeyValueFloat(data, sensorKeys[k], v, true);
+            checksum += v;
+        }
+        // Cut out the transformers one by one like the previous transformer chain parsing
+        while(true) {
+            trimLeadingWhitespace(data);
+            const uint32_t typenameLen = strcspn(data, TRANSFORMER_CFG_OPEN_CHAR);
+            if(typenameLen == strlen(data)) break;
+            memmove(data, data + typenameLen, strlen(data + typenameLen) + 1);
+            char transformerCfg[256];
+            const uint32_t cfgLen = strcspn(data, TRANSFORMER_CFG_CLOSE_CHAR);
+            strncpy(transformerCfg, data, cfgLen + 1);
+            transformerCfg[cfgLen] = '\0';
+            memmove(data, data + cfgLen + 1, strlen(data + cfgLen) + 1);
+            for(const char* key : transformerKeys) {
+                float_t v = 0;
+                if(RC_SUCCESS == readKeyValueFloat(transformerCfg, key, v, true)) checksum += v;
+            }
+        }
+        sensors++;
+        pos = close + 1;
+    }
+    return checksum;
+}
+
+static uint32_t tokenize(const std::string& text) {
+    ConfigTokenizer tokenizer(text.data(), text.size());
+    ConfigTokenizer::Token_t token;
+    uint32_t tokens = 0;
+    while(tokenizer.next(token) == RC_SUCCESS && token.type != ConfigTokenizer::TOKEN_END) tokens++;
+    return tokens;
+}
+
+/**
+ * @brief Returns the shortest time in s of BENCHMARK_REPETITIONS runs of f
+ */
+template <typename F>
+static double measure(F f) {
+    double best = 1e12;
+    for(uint32_t r = 0; r < BENCHMARK_REPETITIONS; r++) {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+TEST(SensorConfigParserBenchmark, ThousandsOfSensors) {
+    const std::string text = generateConfig(BENCHMARK_SENSORS);
+    const double megabytes = text.size() / 1e6;
+
+    uint32_t sensors = 0;
+    float_t checksum = 0;
+    const double tokenizerS = measure([&]() { checksum = parseWithTokenizer(text, sensors); });
+    EXPECT_EQ(sensors, BENCHMARK_SENSORS);
+
+    // Tokenizing alone, without converting the values
+    uint32_t tokens = 0;
+    const double tokenizeS = measure([&]() { tokens = tokenize(text); });
+    EXPECT_EQ(tokens, BENCHMARK_SENSORS * 19);
+
+    uint32_t legacySensors = 0;
+    float_t legacyChecksum = 0;
+    const double legacyS = measure([&]() { legacyChecksum = parseLegacy(text, legacySensors); });
+    EXPECT_EQ(legacySensors, BENCHMARK_SENSORS);
+    // Both read the same values
+    EXPECT_FLOAT_EQ(checksum, legacyChecksum);
+    // Parsing with the tokenizer is no slower than the approach it replaces
+    EXPECT_LE(tokenizerS, legacyS);
+
+    printf("[ BENCHMARK] %-22s %u sensors, %.2f MB in %.2f ms (%.1f MB/s)\n", "single pass tokenizer", sensors,
+           megabytes, tokenizerS * 1e3, megabytes / tokenizerS);
+    printf("[ BENCHMARK] %-22s %u tokens, %.2f MB in %.2f ms (%.1f MB/s)\n", "tokenize only", tokens, megabytes,
+           tokenizeS * 1e3, megabytes / tokenizeS);
+    printf("[ BENCHMARK] %-22s %u sensors, %.2f MB in %.2f ms (%.1f MB/s)\n", "strstr and memmove", legacySensors,
+           megabytes, legacyS * 1e3, megabytes / legacyS);
+}
+
+TEST(SensorConfigParserBenchmark, LongDefinition) {
+    // A single definition far larger than the previous 1024 byte buffer is parsed completely
+    std::string text = "RandomSensor[\n";
+    char buf[64];
+    for(uint32_t i = 0; i < 2000; i++) {
+        snprintf(buf, sizeof(buf), "    key%u: %u\n", i, i);
+        text += buf;
+    }
+    text += "    name: last\n]\n";
+
+    SensorConfigParser parser(text.data(), text.size());
+    SensorConfig_t config;
+    ASSERT_EQ(parser.next(config), RC_SUCCESS);
+    EXPECT_EQ(config.sensor.values.size(), 2001);
+    char name[SENSOR_NAME_MAX_LENGTH];
+    EXPECT_EQ(config.sensor.getString("name", name, sizeof(name)), RC_SUCCESS);
+    EXPECT_STREQ(name, "last");
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include "filesystem/DesktopFilesystem.h"
+#include "sensors/ReplaySensor.h"
+#include "sensors/SyntheticSensor.h"
+#include "transformers/Remapper.h"
+#include "transformers/SimpleMovingAverageFilter.h"
+
+// Throughput of full sensor pipelines driven by the hardware-free sensors
+
+#define BENCHMARK_READINGS (2000000)
+
+/**
+ * @brief Reads the sensor BENCHMARK_READINGS times and prints the achieved rate
+ */
+static void runBenchmark(const char label[], Sensor& sensor, uint32_t readings = BENCHMARK_READINGS) {
+    float_t sum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < readings; i++) sum += sensor.readSensor();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    // Printing the sum keeps the compiler from optimizing the readings away
+    printf("[ BENCHMARK] %-32s %7.2f Msamples/s (checksum %g)\n", label, readings / seconds / 1e6, sum);
+}
+
+static std::shared_ptr<Transformer> createPipeline() {
+    std::shared_ptr<Transformer> filter = std::make_shared<SimpleMovingAverageFilter>(8);
+    std::shared_ptr<Transformer> remapper = std::make_shared<Remapper>(-1.0f, 1.0f, 0.0f, 100.0f);
+    remapper->setNextTransformer(filter);
+    return remapper;
+}
+
+TEST(SensorPipelineBenchmark, SyntheticSensor) {
+    char name[] = "Synthetic";
+    SyntheticSensor sine(name, SyntheticSensor::SINE, 1.0f, 0.0f, 1000);
+    runBenchmark("SyntheticSensor sine", sine);
+    SyntheticSensor noise(name, SyntheticSensor::NOISE, 1.0f, 0.0f, 1);
+    runBenchmark("SyntheticSensor noise", noise);
+    SyntheticSensor pipeline(name, SyntheticSensor::SINE, 1.0f, 0.0f, 1000, 0.1f, createPipeline());
+    runBenchmark("SyntheticSensor sine+noise+pipe", pipeline);
+}
+
+TEST(SensorPipelineBenchmark, ReplaySensor) {
+    DesktopFilesystem fs;
+    const char csvFilename[] = "./replay_bench.csv";
+    const char binFilename[] = "./replay_bench.bin";
+    const uint32_t count = 100000;
+
+    std::string csv;
+    ASSERT_EQ(fs.openFile(binFilename, Filesystem::WRITE_TRUNCATE), RC_SUCCESS);
+    for(uint32_t i = 0; i < count; i++) {
+        const float_t v = 20.0f + static_cast<float_t>(i % 1000) / 100.0f;
+        fs.write(reinterpret_cast<const uint8_t*>(&v), sizeof(v));
+        csv += std::to_string(i * 10000) + "," + std::to_string(v) + "\n";
+    }
+    fs.closeFile();
+    ASSERT_EQ(fs.openFile(csvFilename, Filesystem::WRITE_TRUNCATE), RC_SUCCESS);
+    fs.write(reinterpret_cast<const uint8_t*>(csv.c_str()), csv.size());
+    fs.closeFile();
+
+    char name[] = "Replay";
+    ReplaySensor bin(name, fs, binFilename, ReplaySensor::BINARY, true, createPipeline());
+    runBenchmark("ReplaySensor binary+pipe", bin);
+    ReplaySensor text(name, fs, csvFilename, ReplaySensor::CSV, true, createPipeline());
+    runBenchmark("ReplaySensor csv+pipe", text);
+
+    fs.deleteFile(csvFilename);
+    fs.deleteFile(binFilename);
+}
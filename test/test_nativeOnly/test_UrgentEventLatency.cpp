@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "sensors/UrgentEventQueue.h"
+
+// Time from raising an urgent event until a publisher blocked in waitForEvent has taken it.
+// The publisher waits with a long timeout, so the latency shows that events wake it up
+// instead of waiting for the timeout.
+
+#define BENCHMARK_EVENTS (2000)
+#define PUBLISHER_TIMEOUT_MS (5000)
+
+TEST(UrgentEventLatency, PublisherWakesImmediately) {
+    using Clock = std::chrono::steady_clock;
+    UrgentEventQueue queue;
+    std::vector<Clock::time_point> pushed(BENCHMARK_EVENTS);
+    std::vector<double> latencyUs;
+    latencyUs.reserve(BENCHMARK_EVENTS);
+    std::atomic<uint32_t> taken{0};
+
+    std::thread publisher([&] {
+        UrgentEvent_t event;
+        while(taken.load() < BENCHMARK_EVENTS) {
+            if(!queue.waitForEvent(PUBLISHER_TIMEOUT_MS)) continue;
+            while(queue.pop(event)) {
+                const Clock::time_point now = Clock::now();
+                latencyUs.push_back(std::chrono::duration<double, std::micro>(now - pushed[event.sensorId]).count());
+                taken++;
+            }
+        }
+    });
+
+    for(uint32_t i = 0; i < BENCHMARK_EVENTS; i++) {
+        pushed[i] = Clock::now();
+        queue.push({i, 1.0f, i});
+        // Let the publisher go back to sleep before the next event, like sparse alarms
+        while(taken.load() <= i) std::this_thread::yield();
+    }
+    publisher.join();
+
+    ASSERT_EQ(latencyUs.size(), BENCHMARK_EVENTS);
+    std::sort(latencyUs.begin(), latencyUs.end());
+    const double p50 = latencyUs[BENCHMARK_EVENTS / 2];
+    const double p99 = latencyUs[BENCHMARK_EVENTS * 99 / 100];
+    printf("[ BENCHMARK] urgent event wake-up latency: p50 %.1fus, p99 %.1fus, max %.1fus (timeout %ums)\n", p50, p99,
+           latencyUs.back(), PUBLISHER_TIMEOUT_MS);
+    EXPECT_EQ(queue.getDroppedCount(), 0);
+    // Far below the timeout the publisher would otherwise sleep for
+    EXPECT_LT(p99, 10000.0);
+}